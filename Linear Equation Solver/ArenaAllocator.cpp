@@ -0,0 +1,218 @@
+#include <stdlib.h>
+#include <new>
+#include "ArenaAllocator.h"
+
+namespace
+{
+    //------------------------------------------------------------------
+    //  The slabs start small, so that small containers stay small, and
+    //  double in size up to the maximum slab size. Every block is
+    //  aligned for any fundamental type.
+    //------------------------------------------------------------------
+
+    const size_t f_INITIAL_SLAB_SIZE = 4096;
+    const size_t f_MAXIMUM_SLAB_SIZE = 1 << 20;
+    const size_t f_BLOCK_ALIGNMENT = 16;
+}
+
+//======================================================================
+//  Constructor: MemoryArena::MemoryArena
+//======================================================================
+
+MemoryArena::MemoryArena()
+  : m_current_ptr(0),
+    m_end_ptr(0),
+    m_next_slab_size(f_INITIAL_SLAB_SIZE),
+    m_reserved_size(0),
+    m_free_list_ptr(0),
+    m_free_block_size(0)
+{
+}
+
+//======================================================================
+//  Destructor: MemoryArena::~MemoryArena
+//
+//  Every block that was allocated from the arena is freed.
+//======================================================================
+
+MemoryArena::~MemoryArena()
+{
+    for (size_t i = 0; i < m_slab_vector.size(); ++i)
+    {
+        free(m_slab_vector[i]);
+    }
+}
+
+//======================================================================
+//  Member Function: MemoryArena::Allocate
+//
+//  Abstract:
+//
+//    This function allocates a block of memory. A block of the free
+//    list size is taken from the free list if possible. Otherwise the
+//    block is taken from the end of the current slab.
+//
+//
+//  Input:
+//
+//    size              The size of the block in bytes.
+//
+//
+//  Output:
+//
+//    This function returns a pointer to the block. If there is not
+//    enough memory then std::bad_alloc is thrown.
+//
+//======================================================================
+
+void * MemoryArena::Allocate(size_t size)
+{
+    size = RoundSize(size);
+
+    if ((m_free_list_ptr != 0) && (size == m_free_block_size))
+    {
+        FreeBlock_T * block_ptr = m_free_list_ptr;
+        m_free_list_ptr = block_ptr->m_next_ptr;
+        return block_ptr;
+    }
+
+    if ((size_t)(m_end_ptr - m_current_ptr) < size)
+    {
+        return AllocateFromNewSlab(size);
+    }
+
+    void * block_ptr = m_current_ptr;
+    m_current_ptr += size;
+    return block_ptr;
+}
+
+//======================================================================
+//  Member Function: MemoryArena::Deallocate
+//
+//  Abstract:
+//
+//    This function returns a block to the arena. The free list holds
+//    blocks of a single size, which is set by the first block that is
+//    freed. A block of any other size is only freed when the arena is
+//    destroyed.
+//
+//
+//  Input:
+//
+//    block_ptr         A pointer to the block.
+//
+//    size              The size of the block in bytes.
+//
+//
+//  Output:
+//
+//    This function has no return value.
+//
+//======================================================================
+
+void MemoryArena::Deallocate(void * block_ptr, size_t size)
+{
+    size = RoundSize(size);
+
+    if (m_free_list_ptr == 0)
+    {
+        m_free_block_size = size;
+    }
+
+    if (size == m_free_block_size)
+    {
+        FreeBlock_T * free_block_ptr = static_cast<FreeBlock_T *>(block_ptr);
+        free_block_ptr->m_next_ptr = m_free_list_ptr;
+        m_free_list_ptr = free_block_ptr;
+    }
+
+    return;
+}
+
+//======================================================================
+//  Member Function: MemoryArena::GetReservedSize
+//
+//  Abstract:
+//
+//    This function returns the total size of all slabs in bytes.
+//
+//======================================================================
+
+size_t MemoryArena::GetReservedSize() const
+{
+    return m_reserved_size;
+}
+
+//======================================================================
+//  Member Function: MemoryArena::RoundSize
+//
+//  Abstract:
+//
+//    This function rounds a block size up to a multiple of the block
+//    alignment. Every block can hold a free list link.
+//
+//======================================================================
+
+size_t MemoryArena::RoundSize(size_t size)
+{
+    if (size < sizeof(FreeBlock_T))
+    {
+        size = sizeof(FreeBlock_T);
+    }
+
+    return (size + f_BLOCK_ALIGNMENT - 1) & ~(f_BLOCK_ALIGNMENT - 1);
+}
+
+//======================================================================
+//  Member Function: MemoryArena::AllocateFromNewSlab
+//
+//  Abstract:
+//
+//    This function allocates a new slab and returns a block from the
+//    start of the slab. A block that is larger than a quarter of the
+//    slab size gets a slab of its own, so the current slab can still
+//    be used for smaller blocks.
+//
+//
+//  Input:
+//
+//    size              The rounded size of the block in bytes.
+//
+//
+//  Output:
+//
+//    This function returns a pointer to the block. If there is not
+//    enough memory then std::bad_alloc is thrown.
+//
+//======================================================================
+
+void * MemoryArena::AllocateFromNewSlab(size_t size)
+{
+    bool dedicated_slab_flag = size > m_next_slab_size / 4;
+    size_t slab_size = dedicated_slab_flag ? size : m_next_slab_size;
+
+    m_slab_vector.reserve(m_slab_vector.size() + 1);
+
+    void * slab_ptr = malloc(slab_size);
+
+    if (slab_ptr == 0)
+    {
+        throw std::bad_alloc();
+    }
+
+    m_slab_vector.push_back(slab_ptr);
+    m_reserved_size += slab_size;
+
+    if (! dedicated_slab_flag)
+    {
+        m_current_ptr = static_cast<char *>(slab_ptr) + size;
+        m_end_ptr = static_cast<char *>(slab_ptr) + slab_size;
+
+        if (m_next_slab_size < f_MAXIMUM_SLAB_SIZE)
+        {
+            m_next_slab_size *= 2;
+        }
+    }
+
+    return slab_ptr;
+}
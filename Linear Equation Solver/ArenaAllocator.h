@@ -0,0 +1,184 @@
+#ifndef ARENAALLOCATOR_H
+#define ARENAALLOCATOR_H
+
+#include <stddef.h>
+#include <memory>
+#include <vector>
+#include <type_traits>
+
+//======================================================================
+//  Class Definition
+//
+//  This class hands out memory from large slabs. The slabs are only
+//  returned to the system when the arena is destroyed, so a container
+//  with millions of nodes is freed with a few calls instead of one
+//  call per node.
+//
+//  Freed blocks of the most common size are kept on a free list and
+//  reused. This is the node size for a node based container.
+//
+//  The arena is not thread safe.
+//======================================================================
+
+class MemoryArena
+{
+public:
+
+    MemoryArena();
+
+    virtual ~MemoryArena();
+
+    void * Allocate(size_t size);
+
+    void Deallocate(void * block_ptr, size_t size);
+
+    size_t GetReservedSize() const;
+
+private:
+
+    //------------------------------------------------------------------
+    //  Copying an arena is not allowed.
+    //------------------------------------------------------------------
+
+    MemoryArena(const MemoryArena &);
+
+    MemoryArena & operator =(const MemoryArena &);
+
+    static size_t RoundSize(size_t size);
+
+    void * AllocateFromNewSlab(size_t size);
+
+private:
+
+    struct FreeBlock_T
+    {
+        FreeBlock_T * m_next_ptr;
+    };
+
+    char * m_current_ptr;
+    char * m_end_ptr;
+    size_t m_next_slab_size;
+    size_t m_reserved_size;
+    std::vector<void *> m_slab_vector;
+    FreeBlock_T * m_free_list_ptr;
+    size_t m_free_block_size;
+};
+
+//======================================================================
+//  Class Definition
+//
+//  This is a standard library allocator that allocates from a
+//  MemoryArena. A default constructed allocator creates a new arena,
+//  so each container gets its own arena. Copies of an allocator, and
+//  the rebound allocators that a container makes for its nodes, share
+//  the arena. The arena is destroyed with the last allocator that
+//  uses it.
+//
+//  A container that is copy constructed or copy assigned keeps its
+//  own arena, so two containers never share an arena through a copy.
+//  The allocator goes with the container when the container is moved
+//  or swapped, so memory is always freed to the arena that allocated
+//  it. Moving an allocator copies it, as the standard requires, so a
+//  moved-from container can still be cleared and reused. It then
+//  shares the arena of the container it was moved to, and the two
+//  must be used from the same thread until one of them is destroyed.
+//======================================================================
+
+template <typename T>
+
+class ArenaAllocator
+{
+public:
+
+    typedef T value_type;
+    typedef T * pointer;
+    typedef const T * const_pointer;
+    typedef T & reference;
+    typedef const T & const_reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+
+    typedef std::false_type propagate_on_container_copy_assignment;
+    typedef std::true_type propagate_on_container_move_assignment;
+    typedef std::true_type propagate_on_container_swap;
+
+    template <typename U>
+
+    struct rebind
+    {
+        typedef ArenaAllocator<U> other;
+    };
+
+    ArenaAllocator()
+      : m_arena_ptr(std::make_shared<MemoryArena>())
+    {
+    }
+
+    //------------------------------------------------------------------
+    //  There is no move constructor or move assignment, so a moved-from
+    //  allocator keeps its arena.
+    //------------------------------------------------------------------
+
+    ArenaAllocator(const ArenaAllocator & allocator)
+      : m_arena_ptr(allocator.m_arena_ptr)
+    {
+    }
+
+    ArenaAllocator & operator =(const ArenaAllocator & allocator)
+    {
+        m_arena_ptr = allocator.m_arena_ptr;
+        return *this;
+    }
+
+    template <typename U>
+
+    ArenaAllocator(const ArenaAllocator<U> & allocator)
+      : m_arena_ptr(allocator.GetArena())
+    {
+    }
+
+    //------------------------------------------------------------------
+    //  A copy of a container gets a new arena.
+    //------------------------------------------------------------------
+
+    ArenaAllocator select_on_container_copy_construction() const
+    {
+        return ArenaAllocator();
+    }
+
+    T * allocate(size_t count)
+    {
+        return static_cast<T *>(m_arena_ptr->Allocate(count * sizeof(T)));
+    }
+
+    void deallocate(T * block_ptr, size_t count)
+    {
+        m_arena_ptr->Deallocate(block_ptr, count * sizeof(T));
+        return;
+    }
+
+    const std::shared_ptr<MemoryArena> & GetArena() const
+    {
+        return m_arena_ptr;
+    }
+
+private:
+
+    std::shared_ptr<MemoryArena> m_arena_ptr;
+};
+
+template <typename T, typename U>
+
+bool operator ==(const ArenaAllocator<T> & left_allocator, const ArenaAllocator<U> & right_allocator)
+{
+    return left_allocator.GetArena() == right_allocator.GetArena();
+}
+
+template <typename T, typename U>
+
+bool operator !=(const ArenaAllocator<T> & left_allocator, const ArenaAllocator<U> & right_allocator)
+{
+    return left_allocator.GetArena() != right_allocator.GetArena();
+}
+
+#endif
@@ -0,0 +1,736 @@
+#include <math.h>
+#include "BatchSolver.h"
+#include "MatrixKernels.h"
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define BATCH_SOLVER_X86
+#include <immintrin.h>
+#endif
+
+//----------------------------------------------------------------------
+//  The compiler generates AVX2 and AVX-512 instructions only in the
+//  functions marked with these macros, so the rest of the program runs
+//  on any processor. Each product must be rounded before it is
+//  subtracted, as in the plain C++ kernel. FMA is not enabled for the
+//  AVX2 kernel. AVX-512 always has FMA, and the compiler may fuse a
+//  plain multiply and subtract, so the AVX-512 kernel uses the
+//  intrinsics with an explicit rounding mode, which are never fused.
+//----------------------------------------------------------------------
+
+#if defined(_MSC_VER)
+#define BATCH_SOLVER_TARGET_AVX2
+#define BATCH_SOLVER_TARGET_AVX512
+#else
+#define BATCH_SOLVER_TARGET_AVX2 __attribute__((target("avx2")))
+#define BATCH_SOLVER_TARGET_AVX512 __attribute__((target("avx512f")))
+#endif
+
+namespace
+{
+    //------------------------------------------------------------------
+    //  The number of systems that are solved together. Eight double
+    //  precision lanes fill one AVX-512 register or two AVX2
+    //  registers.
+    //------------------------------------------------------------------
+
+    const int f_NUMBER_OF_LANES = 8;
+
+    //------------------------------------------------------------------
+    //  The number of columns of the pivot row that are copied to a
+    //  local array at a time during elimination.
+    //------------------------------------------------------------------
+
+    const int f_NUMBER_OF_COLUMNS = 8;
+
+    //------------------------------------------------------------------
+    //  Exchange row k with the pivot row in each lane. Only the two
+    //  rows are touched, so the lanes are exchanged one at a time, and
+    //  a lane whose pivot row is row k exchanges row k with itself. The
+    //  columns before k are not used again.
+    //------------------------------------------------------------------
+
+    inline void ExchangeLaneRows(int size,
+                                 int k,
+                                 double * lane_ptr,
+                                 const double * pivot_row_array)
+    {
+        const int row_length = size + 1;
+        double * pivot_ptr = &lane_ptr[(size_t)(k * row_length) * f_NUMBER_OF_LANES];
+
+        for (int lane = 0; lane < f_NUMBER_OF_LANES; ++lane)
+        {
+            double * row_ptr = &lane_ptr[(size_t)((int)(pivot_row_array[lane]) * row_length) * f_NUMBER_OF_LANES + lane];
+            double * row_k_ptr = &pivot_ptr[lane];
+
+            for (int j = k; j <= size; ++j)
+            {
+                double element = row_k_ptr[j * f_NUMBER_OF_LANES];
+                row_k_ptr[j * f_NUMBER_OF_LANES] = row_ptr[j * f_NUMBER_OF_LANES];
+                row_ptr[j * f_NUMBER_OF_LANES] = element;
+            }
+        }
+
+        return;
+    }
+
+    //------------------------------------------------------------------
+    //  Solve the systems in the lanes in plain C++, for a processor
+    //  without AVX2. If T_SIZE is not zero then it is
+    //  the number of equations, so the compiler knows every loop bound
+    //  and unrolls the loops, otherwise the number of equations is n.
+    //
+    //  A lane loop that reads one part of the lane array and writes
+    //  another reads or writes a local array instead. The compiler can
+    //  not tell whether two parts of the lane array overlap, so it
+    //  would need a run time overlap test before each lane loop.
+    //------------------------------------------------------------------
+
+    template <int T_SIZE>
+    void EliminateLaneArrays(int n,
+                             double * lane_ptr,
+                             double * singular_ptr)
+    {
+        const int size = (T_SIZE > 0) ? T_SIZE : n;
+        const int row_length = size + 1;
+        double pivot_row_array[f_NUMBER_OF_LANES];
+        double pivot_magnitude_array[f_NUMBER_OF_LANES];
+        double singular_array[f_NUMBER_OF_LANES];
+        double multiplier_array[f_NUMBER_OF_LANES];
+        double element_array[f_NUMBER_OF_LANES];
+        double pivot_column_array[f_NUMBER_OF_COLUMNS * f_NUMBER_OF_LANES];
+        int lane = 0;
+        int i = 0;
+        int j = 0;
+        int k = 0;
+
+        for (lane = 0; lane < f_NUMBER_OF_LANES; ++lane)
+        {
+            singular_array[lane] = 0.0;
+        }
+
+        for (k = 0; k < size; ++k)
+        {
+            double * pivot_ptr = &lane_ptr[(size_t)(k * row_length) * f_NUMBER_OF_LANES];
+
+            //----------------------------------------------------------
+            //  Find the first row with the largest element in column k
+            //  in each lane. The row numbers are kept as doubles so
+            //  that the comparisons are the same width as the elements.
+            //----------------------------------------------------------
+
+            for (lane = 0; lane < f_NUMBER_OF_LANES; ++lane)
+            {
+                pivot_row_array[lane] = (double)(k);
+                pivot_magnitude_array[lane] = fabs(pivot_ptr[k * f_NUMBER_OF_LANES + lane]);
+            }
+
+            for (i = k + 1; i < size; ++i)
+            {
+                const double * column_ptr = &lane_ptr[(size_t)(i * row_length + k) * f_NUMBER_OF_LANES];
+                double row_number = (double)(i);
+
+                for (lane = 0; lane < f_NUMBER_OF_LANES; ++lane)
+                {
+                    double magnitude = fabs(column_ptr[lane]);
+                    bool larger_flag = magnitude > pivot_magnitude_array[lane];
+                    pivot_row_array[lane] = larger_flag ? row_number : pivot_row_array[lane];
+                    pivot_magnitude_array[lane] = larger_flag ? magnitude : pivot_magnitude_array[lane];
+                }
+            }
+
+            for (lane = 0; lane < f_NUMBER_OF_LANES; ++lane)
+            {
+                singular_array[lane] = (pivot_magnitude_array[lane] == 0.0) ? 1.0 : singular_array[lane];
+            }
+
+            ExchangeLaneRows(size, k, lane_ptr, pivot_row_array);
+
+            //----------------------------------------------------------
+            //  Eliminate column k from the rows below row k, including
+            //  the B vector in column n. The multipliers replace column
+            //  k, which is not used again. The pivot row is copied to a
+            //  local array a few columns at a time, and each row is
+            //  changed in place using the local copy.
+            //----------------------------------------------------------
+
+            for (i = k + 1; i < size; ++i)
+            {
+                double * multiplier_ptr = &lane_ptr[(size_t)(i * row_length + k) * f_NUMBER_OF_LANES];
+
+                for (lane = 0; lane < f_NUMBER_OF_LANES; ++lane)
+                {
+                    element_array[lane] = multiplier_ptr[lane] / pivot_ptr[k * f_NUMBER_OF_LANES + lane];
+                }
+
+                for (lane = 0; lane < f_NUMBER_OF_LANES; ++lane)
+                {
+                    multiplier_ptr[lane] = element_array[lane];
+                }
+            }
+
+            for (int first_column = k + 1; first_column <= size; first_column += f_NUMBER_OF_COLUMNS)
+            {
+                int number_of_columns = size + 1 - first_column;
+
+                if (number_of_columns > f_NUMBER_OF_COLUMNS)
+                {
+                    number_of_columns = f_NUMBER_OF_COLUMNS;
+                }
+
+                for (j = 0; j < number_of_columns * f_NUMBER_OF_LANES; ++j)
+                {
+                    pivot_column_array[j] = pivot_ptr[first_column * f_NUMBER_OF_LANES + j];
+                }
+
+                for (i = k + 1; i < size; ++i)
+                {
+                    double * row_ptr = &lane_ptr[(size_t)(i * row_length) * f_NUMBER_OF_LANES];
+
+                    for (lane = 0; lane < f_NUMBER_OF_LANES; ++lane)
+                    {
+                        multiplier_array[lane] = row_ptr[k * f_NUMBER_OF_LANES + lane];
+                    }
+
+                    for (j = 0; j < number_of_columns; ++j)
+                    {
+                        double * row_element_ptr = &row_ptr[(first_column + j) * f_NUMBER_OF_LANES];
+                        const double * pivot_element_ptr = &pivot_column_array[j * f_NUMBER_OF_LANES];
+
+                        for (lane = 0; lane < f_NUMBER_OF_LANES; ++lane)
+                        {
+                            row_element_ptr[lane] -= multiplier_array[lane] * pivot_element_ptr[lane];
+                        }
+                    }
+                }
+            }
+        }
+
+        //--------------------------------------------------------------
+        //  Back substitute in column n.
+        //--------------------------------------------------------------
+
+        for (i = size - 1; i >= 0; --i)
+        {
+            double * row_ptr = &lane_ptr[(size_t)(i * row_length) * f_NUMBER_OF_LANES];
+            double * x_ptr = &row_ptr[size * f_NUMBER_OF_LANES];
+
+            for (lane = 0; lane < f_NUMBER_OF_LANES; ++lane)
+            {
+                element_array[lane] = x_ptr[lane];
+            }
+
+            for (j = i + 1; j < size; ++j)
+            {
+                const double * element_ptr = &row_ptr[j * f_NUMBER_OF_LANES];
+                const double * x_column_ptr = &lane_ptr[(size_t)(j * row_length + size) * f_NUMBER_OF_LANES];
+
+                for (lane = 0; lane < f_NUMBER_OF_LANES; ++lane)
+                {
+                    element_array[lane] -= element_ptr[lane] * x_column_ptr[lane];
+                }
+            }
+
+            for (lane = 0; lane < f_NUMBER_OF_LANES; ++lane)
+            {
+                x_ptr[lane] = element_array[lane] / row_ptr[i * f_NUMBER_OF_LANES + lane];
+            }
+        }
+
+        for (lane = 0; lane < f_NUMBER_OF_LANES; ++lane)
+        {
+            singular_ptr[lane] = singular_array[lane];
+        }
+
+        return;
+    }
+
+#ifdef BATCH_SOLVER_X86
+
+    //------------------------------------------------------------------
+    //  The AVX2 kernel. The eight lanes are two registers of four, and
+    //  each register is handled as in the plain C++ kernel. A lane
+    //  takes a new pivot row by blending where the comparison is true.
+    //------------------------------------------------------------------
+
+    template <int T_SIZE>
+    BATCH_SOLVER_TARGET_AVX2 void EliminateLaneArraysAvx2(int n,
+                                                          double * lane_ptr,
+                                                          double * singular_ptr)
+    {
+        const int size = (T_SIZE > 0) ? T_SIZE : n;
+        const int row_length = size + 1;
+        const int half = f_NUMBER_OF_LANES / 2;
+        const __m256d sign_mask = _mm256_set1_pd(-0.0);
+        const __m256d zero = _mm256_setzero_pd();
+        double pivot_row_array[f_NUMBER_OF_LANES];
+        __m256d singular[2] = { zero, zero };
+        int h = 0;
+        int i = 0;
+        int j = 0;
+        int k = 0;
+
+        for (k = 0; k < size; ++k)
+        {
+            double * pivot_ptr = &lane_ptr[(size_t)(k * row_length) * f_NUMBER_OF_LANES];
+
+            //----------------------------------------------------------
+            //  Find the first row with the largest element in column k
+            //  in each lane.
+            //----------------------------------------------------------
+
+            for (h = 0; h < 2; ++h)
+            {
+                __m256d pivot_row = _mm256_set1_pd((double)(k));
+                __m256d pivot_magnitude = _mm256_andnot_pd(sign_mask, _mm256_loadu_pd(&pivot_ptr[k * f_NUMBER_OF_LANES + h * half]));
+
+                for (i = k + 1; i < size; ++i)
+                {
+                    const double * column_ptr = &lane_ptr[(size_t)(i * row_length + k) * f_NUMBER_OF_LANES + h * half];
+                    __m256d magnitude = _mm256_andnot_pd(sign_mask, _mm256_loadu_pd(column_ptr));
+                    __m256d larger = _mm256_cmp_pd(magnitude, pivot_magnitude, _CMP_GT_OQ);
+                    pivot_row = _mm256_blendv_pd(pivot_row, _mm256_set1_pd((double)(i)), larger);
+                    pivot_magnitude = _mm256_blendv_pd(pivot_magnitude, magnitude, larger);
+                }
+
+                singular[h] = _mm256_blendv_pd(singular[h],
+                                               _mm256_set1_pd(1.0),
+                                               _mm256_cmp_pd(pivot_magnitude, zero, _CMP_EQ_OQ));
+                _mm256_storeu_pd(&pivot_row_array[h * half], pivot_row);
+            }
+
+            ExchangeLaneRows(size, k, lane_ptr, pivot_row_array);
+
+            //----------------------------------------------------------
+            //  Eliminate column k from the rows below row k, including
+            //  the B vector in column n. The multipliers replace column
+            //  k.
+            //----------------------------------------------------------
+
+            for (i = k + 1; i < size; ++i)
+            {
+                double * row_ptr = &lane_ptr[(size_t)(i * row_length) * f_NUMBER_OF_LANES];
+
+                for (h = 0; h < 2; ++h)
+                {
+                    __m256d multiplier = _mm256_div_pd(_mm256_loadu_pd(&row_ptr[k * f_NUMBER_OF_LANES + h * half]),
+                                                       _mm256_loadu_pd(&pivot_ptr[k * f_NUMBER_OF_LANES + h * half]));
+                    _mm256_storeu_pd(&row_ptr[k * f_NUMBER_OF_LANES + h * half], multiplier);
+
+                    for (j = k + 1; j <= size; ++j)
+                    {
+                        double * element_ptr = &row_ptr[j * f_NUMBER_OF_LANES + h * half];
+                        __m256d product = _mm256_mul_pd(multiplier, _mm256_loadu_pd(&pivot_ptr[j * f_NUMBER_OF_LANES + h * half]));
+                        _mm256_storeu_pd(element_ptr, _mm256_sub_pd(_mm256_loadu_pd(element_ptr), product));
+                    }
+                }
+            }
+        }
+
+        //--------------------------------------------------------------
+        //  Back substitute in column n.
+        //--------------------------------------------------------------
+
+        for (i = size - 1; i >= 0; --i)
+        {
+            double * row_ptr = &lane_ptr[(size_t)(i * row_length) * f_NUMBER_OF_LANES];
+
+            for (h = 0; h < 2; ++h)
+            {
+                double * x_ptr = &row_ptr[size * f_NUMBER_OF_LANES + h * half];
+                __m256d element = _mm256_loadu_pd(x_ptr);
+
+                for (j = i + 1; j < size; ++j)
+                {
+                    const double * x_column_ptr = &lane_ptr[(size_t)(j * row_length + size) * f_NUMBER_OF_LANES + h * half];
+                    __m256d product = _mm256_mul_pd(_mm256_loadu_pd(&row_ptr[j * f_NUMBER_OF_LANES + h * half]),
+                                                    _mm256_loadu_pd(x_column_ptr));
+                    element = _mm256_sub_pd(element, product);
+                }
+
+                _mm256_storeu_pd(x_ptr, _mm256_div_pd(element, _mm256_loadu_pd(&row_ptr[i * f_NUMBER_OF_LANES + h * half])));
+            }
+        }
+
+        for (h = 0; h < 2; ++h)
+        {
+            _mm256_storeu_pd(&singular_ptr[h * half], singular[h]);
+        }
+
+        return;
+    }
+
+    //------------------------------------------------------------------
+    //  The AVX-512 kernel. The eight lanes are one register, and a lane
+    //  takes a new pivot row by a blend under the comparison mask.
+    //------------------------------------------------------------------
+
+    template <int T_SIZE>
+    BATCH_SOLVER_TARGET_AVX512 void EliminateLaneArraysAvx512(int n,
+                                                              double * lane_ptr,
+                                                              double * singular_ptr)
+    {
+        const int size = (T_SIZE > 0) ? T_SIZE : n;
+        const int row_length = size + 1;
+        const __m512d zero = _mm512_setzero_pd();
+        double pivot_row_array[f_NUMBER_OF_LANES];
+        __m512d singular = zero;
+        int i = 0;
+        int j = 0;
+        int k = 0;
+
+        for (k = 0; k < size; ++k)
+        {
+            double * pivot_ptr = &lane_ptr[(size_t)(k * row_length) * f_NUMBER_OF_LANES];
+
+            //----------------------------------------------------------
+            //  Find the first row with the largest element in column k
+            //  in each lane.
+            //----------------------------------------------------------
+
+            __m512d pivot_row = _mm512_set1_pd((double)(k));
+            __m512d pivot_magnitude = _mm512_abs_pd(_mm512_loadu_pd(&pivot_ptr[k * f_NUMBER_OF_LANES]));
+
+            for (i = k + 1; i < size; ++i)
+            {
+                const double * column_ptr = &lane_ptr[(size_t)(i * row_length + k) * f_NUMBER_OF_LANES];
+                __m512d magnitude = _mm512_abs_pd(_mm512_loadu_pd(column_ptr));
+                __mmask8 larger_mask = _mm512_cmp_pd_mask(magnitude, pivot_magnitude, _CMP_GT_OQ);
+                pivot_row = _mm512_mask_blend_pd(larger_mask, pivot_row, _mm512_set1_pd((double)(i)));
+                pivot_magnitude = _mm512_mask_blend_pd(larger_mask, pivot_magnitude, magnitude);
+            }
+
+            singular = _mm512_mask_blend_pd(_mm512_cmp_pd_mask(pivot_magnitude, zero, _CMP_EQ_OQ),
+                                            singular,
+                                            _mm512_set1_pd(1.0));
+            _mm512_storeu_pd(pivot_row_array, pivot_row);
+
+            ExchangeLaneRows(size, k, lane_ptr, pivot_row_array);
+
+            //----------------------------------------------------------
+            //  Eliminate column k from the rows below row k, including
+            //  the B vector in column n. The multipliers replace column
+            //  k.
+            //----------------------------------------------------------
+
+            __m512d pivot = _mm512_loadu_pd(&pivot_ptr[k * f_NUMBER_OF_LANES]);
+
+            for (i = k + 1; i < size; ++i)
+            {
+                double * row_ptr = &lane_ptr[(size_t)(i * row_length) * f_NUMBER_OF_LANES];
+                __m512d multiplier = _mm512_div_pd(_mm512_loadu_pd(&row_ptr[k * f_NUMBER_OF_LANES]), pivot);
+                _mm512_storeu_pd(&row_ptr[k * f_NUMBER_OF_LANES], multiplier);
+
+                for (j = k + 1; j <= size; ++j)
+                {
+                    double * element_ptr = &row_ptr[j * f_NUMBER_OF_LANES];
+                    __m512d product = _mm512_mul_round_pd(multiplier,
+                                                          _mm512_loadu_pd(&pivot_ptr[j * f_NUMBER_OF_LANES]),
+                                                          _MM_FROUND_CUR_DIRECTION);
+                    _mm512_storeu_pd(element_ptr,
+                                     _mm512_sub_round_pd(_mm512_loadu_pd(element_ptr), product, _MM_FROUND_CUR_DIRECTION));
+                }
+            }
+        }
+
+        //--------------------------------------------------------------
+        //  Back substitute in column n.
+        //--------------------------------------------------------------
+
+        for (i = size - 1; i >= 0; --i)
+        {
+            double * row_ptr = &lane_ptr[(size_t)(i * row_length) * f_NUMBER_OF_LANES];
+            double * x_ptr = &row_ptr[size * f_NUMBER_OF_LANES];
+            __m512d element = _mm512_loadu_pd(x_ptr);
+
+            for (j = i + 1; j < size; ++j)
+            {
+                const double * x_column_ptr = &lane_ptr[(size_t)(j * row_length + size) * f_NUMBER_OF_LANES];
+                __m512d product = _mm512_mul_round_pd(_mm512_loadu_pd(&row_ptr[j * f_NUMBER_OF_LANES]),
+                                                      _mm512_loadu_pd(x_column_ptr),
+                                                      _MM_FROUND_CUR_DIRECTION);
+                element = _mm512_sub_round_pd(element, product, _MM_FROUND_CUR_DIRECTION);
+            }
+
+            _mm512_storeu_pd(x_ptr, _mm512_div_pd(element, _mm512_loadu_pd(&row_ptr[i * f_NUMBER_OF_LANES])));
+        }
+
+        _mm512_storeu_pd(singular_ptr, singular);
+
+        return;
+    }
+
+#endif
+
+    //------------------------------------------------------------------
+    //  Solve the systems in the lanes with the kernel of the level of
+    //  the MatrixKernels functions, which is the widest level that the
+    //  processor supports unless MatrixKernels::setLevel was called.
+    //------------------------------------------------------------------
+
+    template <int T_SIZE>
+    void EliminateLaneLevel(int n,
+                            double * lane_ptr,
+                            double * singular_ptr)
+    {
+#ifdef BATCH_SOLVER_X86
+        MatrixKernels::Level level = MatrixKernels::getLevel();
+
+        if (level == MatrixKernels::avx512)
+        {
+            EliminateLaneArraysAvx512<T_SIZE>(n, lane_ptr, singular_ptr);
+            return;
+        }
+
+        if (level == MatrixKernels::avx2)
+        {
+            EliminateLaneArraysAvx2<T_SIZE>(n, lane_ptr, singular_ptr);
+            return;
+        }
+#endif
+
+        EliminateLaneArrays<T_SIZE>(n, lane_ptr, singular_ptr);
+
+        return;
+    }
+}
+
+//======================================================================
+//  Constructor: BatchSolver::BatchSolver
+//======================================================================
+
+BatchSolver::BatchSolver()
+{
+}
+
+//======================================================================
+//  Destructor: BatchSolver::~BatchSolver
+//======================================================================
+
+BatchSolver::~BatchSolver()
+{
+}
+
+//======================================================================
+//  Member Function: BatchSolver::Solve
+//
+//  Abstract:
+//
+//    This function solves every system of the batch.
+//
+//
+//  Input:
+//
+//    n                     The number of equations and variables of
+//                          each system.
+//
+//    number_of_systems     The number of systems.
+//
+//    a_batch_vector        The A matrices, with number_of_systems
+//                          * n * n elements.
+//
+//    b_batch_vector        The B vectors, with number_of_systems * n
+//                          elements.
+//
+//    x_batch_vector        The solutions, stored in the same way as
+//                          the B vectors.
+//
+//    singular_vector       For each system, one if the system is
+//                          singular, otherwise zero.
+//
+//  Output:
+//
+//    This function returns a value of type 'int' that is the number
+//    of singular systems.
+//
+//======================================================================
+
+int BatchSolver::Solve(int n,
+                       int number_of_systems,
+                       const std::vector<double> & a_batch_vector,
+                       const std::vector<double> & b_batch_vector,
+                       std::vector<double> & x_batch_vector,
+                       std::vector<char> & singular_vector)
+{
+    int number_of_singular_systems = 0;
+
+    x_batch_vector.resize((size_t)(n) * number_of_systems);
+    singular_vector.assign(number_of_systems, 0);
+    m_lane_vector.resize((size_t)(n) * (n + 1) * f_NUMBER_OF_LANES);
+    m_singular_lane_vector.resize(f_NUMBER_OF_LANES);
+
+    for (int first_system = 0; first_system < number_of_systems; first_system += f_NUMBER_OF_LANES)
+    {
+        LoadLanes(n, number_of_systems, first_system, a_batch_vector, b_batch_vector);
+        EliminateLanes(n);
+        StoreLanes(n, number_of_systems, first_system, x_batch_vector, singular_vector);
+    }
+
+    for (int s = 0; s < number_of_systems; ++s)
+    {
+        number_of_singular_systems += singular_vector[s];
+    }
+
+    return number_of_singular_systems;
+}
+
+//======================================================================
+//  Member Function: BatchSolver::LoadLanes
+//
+//  Abstract:
+//
+//    This function copies the augmented matrices of the systems from
+//    first_system on to the lanes.
+//
+//======================================================================
+
+void BatchSolver::LoadLanes(int n,
+                            int number_of_systems,
+                            int first_system,
+                            const std::vector<double> & a_batch_vector,
+                            const std::vector<double> & b_batch_vector)
+{
+    size_t batch_stride = (size_t)(number_of_systems);
+    int row_length = n + 1;
+    int number_of_lanes = number_of_systems - first_system;
+    int lane = 0;
+
+    if (number_of_lanes > f_NUMBER_OF_LANES)
+    {
+        number_of_lanes = f_NUMBER_OF_LANES;
+    }
+
+    for (int i = 0; i < n; ++i)
+    {
+        for (int j = 0; j <= n; ++j)
+        {
+            double * lane_ptr = &m_lane_vector[(size_t)(i * row_length + j) * f_NUMBER_OF_LANES];
+            const double * batch_ptr = (j < n)
+                ? &a_batch_vector[(size_t)(i * n + j) * batch_stride + first_system]
+                : &b_batch_vector[(size_t)(i) * batch_stride + first_system];
+
+            for (lane = 0; lane < number_of_lanes; ++lane)
+            {
+                lane_ptr[lane] = batch_ptr[lane];
+            }
+
+            for (; lane < f_NUMBER_OF_LANES; ++lane)
+            {
+                lane_ptr[lane] = (i == j) ? 1.0 : 0.0;
+            }
+        }
+    }
+
+    return;
+}
+
+//======================================================================
+//  Member Function: BatchSolver::EliminateLanes
+//
+//  Abstract:
+//
+//    This function solves the systems in the lanes by Gaussian
+//    elimination with partial pivoting on the augmented matrices,
+//    followed by back substitution. The solutions replace column n.
+//
+//======================================================================
+
+void BatchSolver::EliminateLanes(int n)
+{
+    double * lane_ptr = &m_lane_vector[0];
+    double * singular_ptr = &m_singular_lane_vector[0];
+
+    switch (n)
+    {
+    case 1:
+
+        EliminateLaneLevel<1>(n, lane_ptr, singular_ptr);
+        break;
+
+    case 2:
+
+        EliminateLaneLevel<2>(n, lane_ptr, singular_ptr);
+        break;
+
+    case 3:
+
+        EliminateLaneLevel<3>(n, lane_ptr, singular_ptr);
+        break;
+
+    case 4:
+
+        EliminateLaneLevel<4>(n, lane_ptr, singular_ptr);
+        break;
+
+    case 5:
+
+        EliminateLaneLevel<5>(n, lane_ptr, singular_ptr);
+        break;
+
+    case 6:
+
+        EliminateLaneLevel<6>(n, lane_ptr, singular_ptr);
+        break;
+
+    case 7:
+
+        EliminateLaneLevel<7>(n, lane_ptr, singular_ptr);
+        break;
+
+    case 8:
+
+        EliminateLaneLevel<8>(n, lane_ptr, singular_ptr);
+        break;
+
+    default:
+
+        EliminateLaneLevel<0>(n, lane_ptr, singular_ptr);
+        break;
+    }
+
+    return;
+}
+
+//======================================================================
+//  Member Function: BatchSolver::StoreLanes
+//
+//  Abstract:
+//
+//    This function copies the solutions in the lanes to the systems
+//    from first_system on.
+//
+//======================================================================
+
+void BatchSolver::StoreLanes(int n,
+                             int number_of_systems,
+                             int first_system,
+                             std::vector<double> & x_batch_vector,
+                             std::vector<char> & singular_vector) const
+{
+    size_t batch_stride = (size_t)(number_of_systems);
+    int row_length = n + 1;
+    int number_of_lanes = number_of_systems - first_system;
+    int lane = 0;
+
+    if (number_of_lanes > f_NUMBER_OF_LANES)
+    {
+        number_of_lanes = f_NUMBER_OF_LANES;
+    }
+
+    for (int i = 0; i < n; ++i)
+    {
+        const double * lane_ptr = &m_lane_vector[(size_t)(i * row_length + n) * f_NUMBER_OF_LANES];
+        double * x_ptr = &x_batch_vector[(size_t)(i) * batch_stride + first_system];
+
+        for (lane = 0; lane < number_of_lanes; ++lane)
+        {
+            x_ptr[lane] = lane_ptr[lane];
+        }
+    }
+
+    for (lane = 0; lane < number_of_lanes; ++lane)
+    {
+        singular_vector[first_system + lane] = (m_singular_lane_vector[lane] != 0.0) ? 1 : 0;
+    }
+
+    return;
+}
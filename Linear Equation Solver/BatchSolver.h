@@ -0,0 +1,93 @@
+#ifndef BATCHSOLVER_H
+#define BATCHSOLVER_H
+
+#include <stddef.h>
+#include <vector>
+
+//======================================================================
+//  Class Definition
+//
+//  This class solves many independent systems of simultaneous linear
+//  equations A x = B that all have the same number of equations.
+//
+//  The systems are passed in structure of arrays layout, where the
+//  same element of every system is stored together. Element (i, j)
+//  of the A matrix of system s is at index
+//
+//      (i * n + j) * number_of_systems + s
+//
+//  and element i of the B vector or of the solution of system s is at
+//  index i * number_of_systems + s.
+//
+//  The systems are solved in groups of lanes, one system per lane.
+//  The augmented matrices of a group are copied so that the lanes of
+//  each element are adjacent, and every step of the elimination is a
+//  loop over the lanes with no branches, which the compiler turns
+//  into vector instructions where each element of a vector register
+//  belongs to a different system. Each lane chooses its own pivot row
+//  by comparing and selecting, and then each lane exchanges its pivot
+//  row with the current row, even when they are the same row, so the
+//  lanes never take different paths. Lanes past the last system are
+//  filled with the identity matrix. For up to eight equations the elimination is
+//  compiled for each number of equations, so its loops have constant
+//  bounds.
+//
+//  The elimination is written with AVX-512 and with AVX2 intrinsics as
+//  well as in plain C++. The kernel is chosen when the lanes are
+//  solved from the level of the MatrixKernels functions, which is the
+//  widest level the processor supports unless MatrixKernels::setLevel
+//  selects another. Every kernel does the same operations in the same
+//  order, without fused multiply-add, so the solutions do not depend
+//  on the kernel.
+//
+//  Each system is solved by Gaussian elimination with partial
+//  pivoting, with the same pivots and the same operations, in the
+//  same order, as the dense elimination of class LinearSystemSolver,
+//  so the solutions are the same. A system with a zero pivot is
+//  marked as singular, and its solution is meaningless.
+//======================================================================
+
+class BatchSolver
+{
+public:
+
+    BatchSolver();
+
+    virtual ~BatchSolver();
+
+    int Solve(int n,
+              int number_of_systems,
+              const std::vector<double> & a_batch_vector,
+              const std::vector<double> & b_batch_vector,
+              std::vector<double> & x_batch_vector,
+              std::vector<char> & singular_vector);
+
+protected:
+
+    void LoadLanes(int n,
+                   int number_of_systems,
+                   int first_system,
+                   const std::vector<double> & a_batch_vector,
+                   const std::vector<double> & b_batch_vector);
+
+    void EliminateLanes(int n);
+
+    void StoreLanes(int n,
+                    int number_of_systems,
+                    int first_system,
+                    std::vector<double> & x_batch_vector,
+                    std::vector<char> & singular_vector) const;
+
+protected:
+
+    //------------------------------------------------------------------
+    //  The augmented matrices of one group of lanes. Lane r of element
+    //  (i, j) is at index (i * (n + 1) + j) * number of lanes + r,
+    //  where column n is the B vector and then the solution.
+    //------------------------------------------------------------------
+
+    std::vector<double> m_lane_vector;
+    std::vector<double> m_singular_lane_vector;
+};
+
+#endif
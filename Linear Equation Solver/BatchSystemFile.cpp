@@ -0,0 +1,456 @@
+#include "DecimalNumber.h"
+#include "BatchSystemFile.h"
+
+namespace
+{
+    //------------------------------------------------------------------
+    //  The largest number of digits in a value, in the number of
+    //  equations, and in an exponent.
+    //------------------------------------------------------------------
+
+    const unsigned int f_MAXIMUM_NUMBER_LENGTH = 20;
+    const unsigned int f_MAXIMUM_SIZE_LENGTH = 6;
+    const unsigned int f_MAXIMUM_EXPONENT_LENGTH = 3;
+
+    const char * f_SUCCESS = "The batch file was read successfully.";
+    const char * f_ERROR_ILLEGAL_NUMBER = "A value is not a legal number.";
+    const char * f_ERROR_MISSING_EXPONENT = "A number contains an exponent character and is missing an exponent.";
+    const char * f_ERROR_ILLEGAL_NUMBER_OF_EQUATIONS = "The first value must be the number of equations of each system.";
+    const char * f_ERROR_INCOMPLETE_SYSTEM = "The last system does not have every coefficient and right side.";
+
+    //------------------------------------------------------------------
+    //  Values are separated by white space or commas.
+    //------------------------------------------------------------------
+
+    bool IsSeparator(char c)
+    {
+        return (c == ' ') || (c == '\t') || (c == '\r') || (c == ',');
+    }
+}
+
+//======================================================================
+//  Constructor: BatchSystemFile::BatchSystemFile
+//======================================================================
+
+BatchSystemFile::BatchSystemFile()
+  : m_n(0),
+    m_number_of_systems(0),
+    m_number_of_values(0),
+    m_error_line(0),
+    m_error_position(0)
+{
+}
+
+//======================================================================
+//  Destructor: BatchSystemFile::~BatchSystemFile
+//======================================================================
+
+BatchSystemFile::~BatchSystemFile()
+{
+}
+
+//======================================================================
+//  Member Function: BatchSystemFile::Parse
+//
+//  Abstract:
+//
+//    This function reads the systems from the contents of a batch
+//    file, such as a memory-mapped file.
+//
+//
+//  Input:
+//
+//    data_ptr              The contents of the file.
+//
+//    data_size             The number of characters.
+//
+//  Output:
+//
+//    This function returns a value of type 'Status_T'. If the status
+//    is not SUCCESS then GetErrorLine and GetErrorPosition return the
+//    line and the position in the line of the error.
+//
+//======================================================================
+
+BatchSystemFile::Status_T BatchSystemFile::Parse(const char * data_ptr,
+                                                 size_t data_size)
+{
+    const char * end_ptr = data_ptr + data_size;
+    CharSpan input_line_span;
+    int file_line = 0;
+
+    m_n = 0;
+    m_number_of_systems = 0;
+    m_number_of_values = 0;
+    m_error_line = 0;
+    m_error_position = 0;
+    m_value_vector.clear();
+
+    while (GetNextInputLine(data_ptr, end_ptr, input_line_span))
+    {
+        int length = (int)(input_line_span.Length());
+        int position = 0;
+
+        ++file_line;
+
+        while (position < length)
+        {
+            if (IsSeparator(input_line_span[position]))
+            {
+                ++position;
+                continue;
+            }
+
+            int value_position = position;
+            double value = 0.0;
+            bool integer_flag = false;
+            Status_T status = ScanValue(input_line_span, position, value, integer_flag);
+
+            if ((status == SUCCESS) && (m_n == 0) && ((! integer_flag) || (value < 1.0)))
+            {
+                status = ERROR_ILLEGAL_NUMBER_OF_EQUATIONS;
+            }
+
+            if (status != SUCCESS)
+            {
+                m_error_line = file_line;
+                m_error_position = (status == ERROR_ILLEGAL_NUMBER_OF_EQUATIONS) ? value_position : position;
+                return status;
+            }
+
+            if (m_n == 0)
+            {
+                m_n = (int)(value);
+            }
+            else
+            {
+                AddValue(value);
+                ++m_number_of_values;
+            }
+        }
+    }
+
+    //------------------------------------------------------------------
+    //  The file must have the number of equations and at least one
+    //  whole system, and no partial system.
+    //------------------------------------------------------------------
+
+    m_error_line = file_line;
+
+    if (m_n == 0)
+    {
+        return ERROR_ILLEGAL_NUMBER_OF_EQUATIONS;
+    }
+
+    size_t system_size = (size_t)(m_n) * (m_n + 1);
+
+    if ((m_number_of_values == 0) || (m_number_of_values % system_size != 0))
+    {
+        return ERROR_INCOMPLETE_SYSTEM;
+    }
+
+    m_number_of_systems = (int)(m_number_of_values / system_size);
+    m_error_line = 0;
+
+    MakeBatch();
+
+    return SUCCESS;
+}
+
+//======================================================================
+//  Member Function: BatchSystemFile::GetNumberOfEquations
+//======================================================================
+
+int BatchSystemFile::GetNumberOfEquations() const
+{
+    return m_n;
+}
+
+//======================================================================
+//  Member Function: BatchSystemFile::GetNumberOfSystems
+//======================================================================
+
+int BatchSystemFile::GetNumberOfSystems() const
+{
+    return m_number_of_systems;
+}
+
+//======================================================================
+//  Member Function: BatchSystemFile::GetAMatrices
+//======================================================================
+
+const std::vector<double> & BatchSystemFile::GetAMatrices() const
+{
+    return m_a_batch_vector;
+}
+
+//======================================================================
+//  Member Function: BatchSystemFile::GetBVectors
+//======================================================================
+
+const std::vector<double> & BatchSystemFile::GetBVectors() const
+{
+    return m_b_batch_vector;
+}
+
+//======================================================================
+//  Member Function: BatchSystemFile::GetErrorLine
+//======================================================================
+
+int BatchSystemFile::GetErrorLine() const
+{
+    return m_error_line;
+}
+
+//======================================================================
+//  Member Function: BatchSystemFile::GetErrorPosition
+//======================================================================
+
+int BatchSystemFile::GetErrorPosition() const
+{
+    return m_error_position;
+}
+
+//======================================================================
+//  Member Function: BatchSystemFile::GetStatusString
+//======================================================================
+
+const char * BatchSystemFile::GetStatusString(Status_T status)
+{
+    const char * status_ptr = "";
+
+    switch (status)
+    {
+    case SUCCESS:
+
+        status_ptr = f_SUCCESS;
+        break;
+
+    case ERROR_ILLEGAL_NUMBER:
+
+        status_ptr = f_ERROR_ILLEGAL_NUMBER;
+        break;
+
+    case ERROR_MISSING_EXPONENT:
+
+        status_ptr = f_ERROR_MISSING_EXPONENT;
+        break;
+
+    case ERROR_ILLEGAL_NUMBER_OF_EQUATIONS:
+
+        status_ptr = f_ERROR_ILLEGAL_NUMBER_OF_EQUATIONS;
+        break;
+
+    case ERROR_INCOMPLETE_SYSTEM:
+
+        status_ptr = f_ERROR_INCOMPLETE_SYSTEM;
+        break;
+
+    default:
+
+        status_ptr = f_ERROR_ILLEGAL_NUMBER;
+        break;
+    }
+
+    return status_ptr;
+}
+
+//======================================================================
+//  Member Function: BatchSystemFile::ScanValue
+//
+//  Abstract:
+//
+//    This function scans one value, which must be followed by a
+//    separator or the end of the line.
+//
+//
+//  Input:
+//
+//    input_line_span       The line.
+//
+//    position              The position of the value. On return this
+//                          is the position after the value, or of the
+//                          error.
+//
+//    value                 The value.
+//
+//    integer_flag          Set to true if the value has no more than
+//                          f_MAXIMUM_SIZE_LENGTH digits and no sign,
+//                          decimal point or exponent.
+//
+//  Output:
+//
+//    This function returns a value of type 'Status_T'.
+//
+//======================================================================
+
+BatchSystemFile::Status_T BatchSystemFile::ScanValue(const CharSpan & input_line_span,
+                                                     int & position,
+                                                     double & value,
+                                                     bool & integer_flag)
+{
+    int length = (int)(input_line_span.Length());
+    bool negative_flag = false;
+    bool sign_flag = false;
+    DecimalNumber number;
+
+    integer_flag = false;
+
+    if ((input_line_span[position] == '+') || (input_line_span[position] == '-'))
+    {
+        sign_flag = true;
+        negative_flag = input_line_span[position] == '-';
+        ++position;
+    }
+
+    //------------------------------------------------------------------
+    //  Scan the digits and the decimal point.
+    //------------------------------------------------------------------
+
+    while (position < length)
+    {
+        char c = input_line_span[position];
+
+        if ((c >= '0') && (c <= '9'))
+        {
+            number.AppendDigit(c);
+        }
+        else if ((c == '.') && (! number.HasDecimalPoint()))
+        {
+            number.AppendDecimalPoint();
+        }
+        else
+        {
+            break;
+        }
+
+        ++position;
+    }
+
+    if ((number.GetDigitCount() == 0) || (number.GetLength() > f_MAXIMUM_NUMBER_LENGTH))
+    {
+        return ERROR_ILLEGAL_NUMBER;
+    }
+
+    integer_flag = (! sign_flag)
+        && (! number.HasDecimalPoint())
+        && (number.GetDigitCount() <= f_MAXIMUM_SIZE_LENGTH);
+
+    //------------------------------------------------------------------
+    //  Scan the exponent.
+    //------------------------------------------------------------------
+
+    if ((position < length)
+        && ((input_line_span[position] == '^')
+            || (input_line_span[position] == 'e')
+            || (input_line_span[position] == 'E')))
+    {
+        bool negative_exponent_flag = false;
+        DecimalNumber exponent;
+
+        integer_flag = false;
+        ++position;
+
+        if ((position < length) && ((input_line_span[position] == '+') || (input_line_span[position] == '-')))
+        {
+            negative_exponent_flag = input_line_span[position] == '-';
+            ++position;
+        }
+
+        while ((position < length) && (input_line_span[position] >= '0') && (input_line_span[position] <= '9'))
+        {
+            exponent.AppendDigit(input_line_span[position]);
+            ++position;
+        }
+
+        if (exponent.GetDigitCount() == 0)
+        {
+            return ERROR_MISSING_EXPONENT;
+        }
+
+        if (exponent.GetDigitCount() > f_MAXIMUM_EXPONENT_LENGTH)
+        {
+            return ERROR_ILLEGAL_NUMBER;
+        }
+
+        number.SetExponent(negative_exponent_flag ? - exponent.GetIntegerValue() : exponent.GetIntegerValue());
+    }
+
+    if ((position < length) && (! IsSeparator(input_line_span[position])))
+    {
+        return ERROR_ILLEGAL_NUMBER;
+    }
+
+    value = number.ToDouble();
+
+    if (negative_flag)
+    {
+        value = - value;
+    }
+
+    return SUCCESS;
+}
+
+//======================================================================
+//  Member Function: BatchSystemFile::AddValue
+//
+//  Abstract:
+//
+//    This function is passed each value after the number of equations,
+//    in file order, and keeps it for MakeBatch.
+//
+//
+//  Input:
+//
+//    value                 The value.
+//
+//  Output:
+//
+//    This function has no return value.
+//
+//======================================================================
+
+void BatchSystemFile::AddValue(double value)
+{
+    m_value_vector.push_back(value);
+    return;
+}
+
+//======================================================================
+//  Member Function: BatchSystemFile::MakeBatch
+//
+//  Abstract:
+//
+//    This function stores the values, which are in file order, in the
+//    structure of arrays layout.
+//
+//======================================================================
+
+void BatchSystemFile::MakeBatch()
+{
+    size_t n = (size_t)(m_n);
+    size_t number_of_systems = (size_t)(m_number_of_systems);
+    size_t system_size = n * (n + 1);
+
+    m_a_batch_vector.resize(n * n * number_of_systems);
+    m_b_batch_vector.resize(n * number_of_systems);
+
+    for (size_t s = 0; s < number_of_systems; ++s)
+    {
+        const double * value_ptr = &m_value_vector[s * system_size];
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            for (size_t j = 0; j < n; ++j)
+            {
+                m_a_batch_vector[(i * n + j) * number_of_systems + s] = value_ptr[i * (n + 1) + j];
+            }
+
+            m_b_batch_vector[i * number_of_systems + s] = value_ptr[i * (n + 1) + n];
+        }
+    }
+
+    std::vector<double>().swap(m_value_vector);
+
+    return;
+}
@@ -0,0 +1,88 @@
+#ifndef BATCHSYSTEMFILE_H
+#define BATCHSYSTEMFILE_H
+
+#include <stddef.h>
+#include <vector>
+#include "CharSpan.h"
+
+//======================================================================
+//  Class Definition
+//
+//  This class reads a batch file, which holds many systems of
+//  simultaneous linear equations with the same number of equations,
+//  without variable names. The first value in the file is the number
+//  of equations n of each system. Each system follows as n rows of n
+//  coefficients and the right side of the equation, so each system
+//  has n * (n + 1) values. The values are separated by white space or
+//  commas and can be split between lines in any way. Comments are
+//  started by the characters "//".
+//
+//  A value is a number with an optional sign, a decimal point and an
+//  exponent. The exponent is started by the '^' character, as in the
+//  equation files, or by the character 'e' or 'E'.
+//
+//  The systems are stored in the structure of arrays layout of class
+//  BatchSolver. A derived class can use the values in another way by
+//  overriding AddValue, which is passed each value after the number of
+//  equations, and MakeBatch, which is called after the whole file is
+//  read.
+//======================================================================
+
+class BatchSystemFile
+{
+public:
+
+    enum Status_T
+    {
+        SUCCESS,
+        ERROR_ILLEGAL_NUMBER,
+        ERROR_MISSING_EXPONENT,
+        ERROR_ILLEGAL_NUMBER_OF_EQUATIONS,
+        ERROR_INCOMPLETE_SYSTEM
+    };
+
+    BatchSystemFile();
+
+    virtual ~BatchSystemFile();
+
+    Status_T Parse(const char * data_ptr,
+                   size_t data_size);
+
+    int GetNumberOfEquations() const;
+
+    int GetNumberOfSystems() const;
+
+    const std::vector<double> & GetAMatrices() const;
+
+    const std::vector<double> & GetBVectors() const;
+
+    int GetErrorLine() const;
+
+    int GetErrorPosition() const;
+
+    static const char * GetStatusString(Status_T status);
+
+protected:
+
+    Status_T ScanValue(const CharSpan & input_line_span,
+                       int & position,
+                       double & value,
+                       bool & integer_flag);
+
+    virtual void AddValue(double value);
+
+    virtual void MakeBatch();
+
+protected:
+
+    int m_n;
+    int m_number_of_systems;
+    size_t m_number_of_values;
+    int m_error_line;
+    int m_error_position;
+    std::vector<double> m_value_vector;
+    std::vector<double> m_a_batch_vector;
+    std::vector<double> m_b_batch_vector;
+};
+
+#endif
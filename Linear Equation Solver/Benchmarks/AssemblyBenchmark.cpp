@@ -0,0 +1,170 @@
+//======================================================================
+//  Benchmark for the assembly of the A matrix.
+//
+//  This compares adding each term to a SparseMatrix, which is what
+//  the parser did for every term, against appending the terms to a
+//  TripletBuilder and assembling a CompressedSparseMatrix with one
+//  sort-and-sum pass. The terms are generated in parse order, one
+//  equation at a time, and some elements receive more than one term.
+//  Both paths must produce bit-identical values.
+//
+//  Usage:
+//
+//      AssemblyBenchmark [number_of_equations] [terms_per_equation]
+//======================================================================
+
+#include <stdlib.h>
+#include <string.h>
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include "MatrixPackage.h"
+#include "LinearSystemBuilder.h"
+#include "CompressedSparseMatrix.h"
+
+namespace
+{
+    //------------------------------------------------------------------
+    //  Generate the terms of the equations in parse order.
+    //------------------------------------------------------------------
+
+    void MakeTerms(int number_of_equations,
+                   int terms_per_equation,
+                   std::vector<TripletBuilder::Triplet_T> & term_vector)
+    {
+        unsigned int seed = 12345;
+
+        term_vector.clear();
+        term_vector.reserve((size_t)(number_of_equations) * terms_per_equation);
+
+        for (int row = 0; row < number_of_equations; ++row)
+        {
+            for (int k = 0; k < terms_per_equation; ++k)
+            {
+                TripletBuilder::Triplet_T term;
+                term.m_row = row;
+
+                seed = seed * 1103515245U + 12345U;
+
+                if ((k > 0) && ((seed >> 16) % 8 == 0))
+                {
+                    term.m_column = term_vector.back().m_column;
+                }
+                else
+                {
+                    seed = seed * 1103515245U + 12345U;
+                    term.m_column = (int)((seed >> 8) % (unsigned int)(number_of_equations));
+                }
+
+                seed = seed * 1103515245U + 12345U;
+                term.m_value = (double)((int)((seed >> 16) % 2001) - 1000) / 8.0;
+
+                term_vector.push_back(term);
+            }
+        }
+
+        return;
+    }
+}
+
+int main(int argc, char * argv[])
+{
+    int number_of_equations = 200000;
+    int terms_per_equation = 8;
+
+    if (argc > 1)
+    {
+        number_of_equations = atoi(argv[1]);
+    }
+
+    if (argc > 2)
+    {
+        terms_per_equation = atoi(argv[2]);
+    }
+
+    std::vector<TripletBuilder::Triplet_T> term_vector;
+    MakeTerms(number_of_equations, terms_per_equation, term_vector);
+    size_t number_of_terms = term_vector.size();
+
+    //------------------------------------------------------------------
+    //  The SparseMatrix path.
+    //------------------------------------------------------------------
+
+    std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+
+    MatrixPackage::SparseMatrix a_matrix;
+    MatrixPackage::SparseVector b_vector;
+
+    {
+        SparseMatrixBuilder builder(a_matrix, b_vector);
+
+        for (size_t i = 0; i < number_of_terms; ++i)
+        {
+            const TripletBuilder::Triplet_T & term = term_vector[i];
+            builder.AddToAMatrix(term.m_row, term.m_column, term.m_value);
+        }
+    }
+
+    std::chrono::steady_clock::time_point middle_time = std::chrono::steady_clock::now();
+
+    //------------------------------------------------------------------
+    //  The triplet path.
+    //------------------------------------------------------------------
+
+    CompressedSparseMatrix a_csr_matrix;
+
+    {
+        TripletBuilder builder;
+
+        for (size_t i = 0; i < number_of_terms; ++i)
+        {
+            const TripletBuilder::Triplet_T & term = term_vector[i];
+            builder.AddToAMatrix(term.m_row, term.m_column, term.m_value);
+        }
+
+        builder.Assemble(number_of_equations, number_of_equations, a_csr_matrix);
+    }
+
+    std::chrono::steady_clock::time_point end_time = std::chrono::steady_clock::now();
+
+    //------------------------------------------------------------------
+    //  Compare the results.
+    //------------------------------------------------------------------
+
+    unsigned int mismatch_count = 0;
+
+    if (a_csr_matrix.GetNumberOfNonzeros() != a_matrix.size())
+    {
+        std::cout << "The number of elements differs." << std::endl;
+        ++mismatch_count;
+    }
+
+    const size_t * row_start_array = a_csr_matrix.GetRowStartArray();
+    const int * column_index_array = a_csr_matrix.GetColumnIndexArray();
+    const double * value_array = a_csr_matrix.GetValueArray();
+
+    for (int row = 0; row < a_csr_matrix.GetNumberOfRows(); ++row)
+    {
+        for (size_t k = row_start_array[row]; k < row_start_array[row + 1]; ++k)
+        {
+            double value = a_matrix[DoubleIndex(row, column_index_array[k])];
+
+            if (memcmp(&value, &value_array[k], sizeof(double)) != 0)
+            {
+                ++mismatch_count;
+            }
+        }
+    }
+
+    double old_seconds = std::chrono::duration<double>(middle_time - start_time).count();
+    double new_seconds = std::chrono::duration<double>(end_time - middle_time).count();
+
+    std::cout << "Terms:                 " << number_of_terms << std::endl;
+    std::cout << "Stored elements:       " << a_csr_matrix.GetNumberOfNonzeros() << std::endl;
+    std::cout << "SparseMatrix path:     " << number_of_terms / old_seconds << " nonzeros/s" << std::endl;
+    std::cout << "Triplet + CSR path:    " << number_of_terms / new_seconds << " nonzeros/s" << std::endl;
+    std::cout << "Speedup:               " << old_seconds / new_seconds << std::endl;
+    std::cout << "Mismatches:            " << mismatch_count << std::endl;
+
+    return mismatch_count == 0 ? 0 : 1;
+}
@@ -0,0 +1,404 @@
+//======================================================================
+//  Benchmark for the batch solver.
+//
+//  For each size from 2 to 8, and for 12 and 16, many random systems
+//  are solved one at a time with Gaussian elimination with partial
+//  pivoting on a matrix whose size is only known at run time, one at
+//  a time with FixedSizeSolver for the sizes it supports, and together,
+//  one system per lane, with BatchSolver and each set of kernels the
+//  processor supports, from plain C++ to AVX-512. The systems are
+//  stored one after another for the first two and in the structure of
+//  arrays layout for BatchSolver, and the layouts are made before the
+//  timing starts. The throughput of each is reported in systems per
+//  second. All must produce bit-identical solutions.
+//
+//  The benchmark is built with the file MatrixKernels.cpp.
+//
+//  Usage:
+//
+//      BatchSolverBenchmark [number_of_systems]
+//======================================================================
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include "FixedSizeSolver.h"
+#include "BatchSolver.h"
+#include "MatrixKernels.h"
+
+namespace
+{
+    //------------------------------------------------------------------
+    //  Generate the A matrices and B vectors, one after another.
+    //------------------------------------------------------------------
+
+    void MakeSystems(int n,
+                     int number_of_systems,
+                     std::vector<double> & a_vector,
+                     std::vector<double> & b_vector)
+    {
+        unsigned int seed = 12345;
+
+        a_vector.resize((size_t)(number_of_systems) * n * n);
+        b_vector.resize((size_t)(number_of_systems) * n);
+
+        for (size_t i = 0; i < a_vector.size(); ++i)
+        {
+            seed = seed * 1103515245U + 12345U;
+            a_vector[i] = (double)((int)((seed >> 16) % 2001) - 1000) / 64.0;
+        }
+
+        for (size_t i = 0; i < b_vector.size(); ++i)
+        {
+            seed = seed * 1103515245U + 12345U;
+            b_vector[i] = (double)((int)((seed >> 16) % 2001) - 1000) / 64.0;
+        }
+
+        return;
+    }
+
+    //------------------------------------------------------------------
+    //  Solve one system whose size is only known at run time. Returns
+    //  false if a pivot is zero.
+    //------------------------------------------------------------------
+
+    bool SolveRunTimeSize(int n,
+                          const double * a_ptr,
+                          const double * b_ptr,
+                          std::vector<double> & lu_vector,
+                          std::vector<int> & row_order_vector,
+                          std::vector<double> & y_vector,
+                          double * x_ptr)
+    {
+        int i = 0;
+        int j = 0;
+        int k = 0;
+
+        lu_vector.assign(a_ptr, a_ptr + n * n);
+        row_order_vector.resize(n);
+        y_vector.resize(n);
+
+        for (i = 0; i < n; ++i)
+        {
+            row_order_vector[i] = i;
+        }
+
+        for (k = 0; k < n; ++k)
+        {
+            int pivot_row = k;
+
+            for (i = k + 1; i < n; ++i)
+            {
+                if (fabs(lu_vector[i * n + k]) > fabs(lu_vector[pivot_row * n + k]))
+                {
+                    pivot_row = i;
+                }
+            }
+
+            if (lu_vector[pivot_row * n + k] == 0.0)
+            {
+                return false;
+            }
+
+            if (pivot_row != k)
+            {
+                for (j = 0; j < n; ++j)
+                {
+                    std::swap(lu_vector[k * n + j], lu_vector[pivot_row * n + j]);
+                }
+
+                std::swap(row_order_vector[k], row_order_vector[pivot_row]);
+            }
+
+            for (i = k + 1; i < n; ++i)
+            {
+                if (lu_vector[i * n + k] != 0.0)
+                {
+                    double multiplier = lu_vector[i * n + k] / lu_vector[k * n + k];
+
+                    for (j = k + 1; j < n; ++j)
+                    {
+                        lu_vector[i * n + j] -= multiplier * lu_vector[k * n + j];
+                    }
+
+                    lu_vector[i * n + k] = multiplier;
+                }
+            }
+        }
+
+        for (i = 0; i < n; ++i)
+        {
+            double y_value = b_ptr[row_order_vector[i]];
+
+            for (j = 0; j < i; ++j)
+            {
+                y_value -= lu_vector[i * n + j] * y_vector[j];
+            }
+
+            y_vector[i] = y_value;
+        }
+
+        for (i = n - 1; i >= 0; --i)
+        {
+            double sum = y_vector[i];
+
+            for (j = i + 1; j < n; ++j)
+            {
+                sum -= lu_vector[i * n + j] * x_ptr[j];
+            }
+
+            x_ptr[i] = sum / lu_vector[i * n + i];
+        }
+
+        return true;
+    }
+
+    //------------------------------------------------------------------
+    //  Solve one system with the fixed size solver. Returns false if a
+    //  pivot is zero. A size of zero means there is no fixed size
+    //  solver for the size.
+    //------------------------------------------------------------------
+
+    template <int T_SIZE>
+    bool SolveFixedSize(const double * a_ptr,
+                        const double * b_ptr,
+                        double * x_ptr)
+    {
+        typedef FixedSizeSolver<T_SIZE> Solver_T;
+
+        typename Solver_T::Matrix_T a_array;
+        typename Solver_T::Vector_T b_array;
+        typename Solver_T::Vector_T x_array;
+
+        memcpy(a_array.data(), a_ptr, sizeof(a_array));
+        memcpy(b_array.data(), b_ptr, sizeof(b_array));
+
+        if (! Solver_T::Solve(a_array, b_array, x_array))
+        {
+            return false;
+        }
+
+        memcpy(x_ptr, x_array.data(), sizeof(x_array));
+
+        return true;
+    }
+
+    template <>
+    bool SolveFixedSize<0>(const double *,
+                           const double *,
+                           double *)
+    {
+        return false;
+    }
+
+    //------------------------------------------------------------------
+    //  Copy systems stored one after another to the structure of arrays
+    //  layout, where element e of system s is at e * number_of_systems
+    //  + s.
+    //------------------------------------------------------------------
+
+    void MakeBatch(int elements_per_system,
+                   int number_of_systems,
+                   const std::vector<double> & system_vector,
+                   std::vector<double> & batch_vector)
+    {
+        batch_vector.resize(system_vector.size());
+
+        for (int s = 0; s < number_of_systems; ++s)
+        {
+            for (int e = 0; e < elements_per_system; ++e)
+            {
+                batch_vector[(size_t)(e) * number_of_systems + s] =
+                    system_vector[(size_t)(s) * elements_per_system + e];
+            }
+        }
+
+        return;
+    }
+
+    //------------------------------------------------------------------
+    //  Count the elements of a solution stored one system after another
+    //  that differ from the batch solution.
+    //------------------------------------------------------------------
+
+    unsigned int CountMismatches(int n,
+                                 int number_of_systems,
+                                 const std::vector<double> & x_vector,
+                                 const std::vector<double> & x_batch_vector,
+                                 const std::vector<char> & singular_vector)
+    {
+        unsigned int mismatch_count = 0;
+
+        for (int s = 0; s < number_of_systems; ++s)
+        {
+            if (singular_vector[s] == 0)
+            {
+                for (int i = 0; i < n; ++i)
+                {
+                    if (memcmp(&x_vector[(size_t)(s) * n + i],
+                               &x_batch_vector[(size_t)(i) * number_of_systems + s],
+                               sizeof(double)) != 0)
+                    {
+                        ++mismatch_count;
+                    }
+                }
+            }
+        }
+
+        return mismatch_count;
+    }
+
+    //------------------------------------------------------------------
+    //  Time the solvers for one size and return the number of solutions
+    //  that differ. T_FIXED_SIZE is the size if FixedSizeSolver supports
+    //  it, otherwise zero.
+    //------------------------------------------------------------------
+
+    template <int T_FIXED_SIZE>
+    unsigned int RunSize(int n,
+                         int number_of_systems)
+    {
+        std::vector<double> a_vector;
+        std::vector<double> b_vector;
+        std::vector<double> a_batch_vector;
+        std::vector<double> b_batch_vector;
+        MakeSystems(n, number_of_systems, a_vector, b_vector);
+        MakeBatch(n * n, number_of_systems, a_vector, a_batch_vector);
+        MakeBatch(n, number_of_systems, b_vector, b_batch_vector);
+
+        std::vector<double> run_time_x_vector(b_vector.size(), 0.0);
+        std::vector<double> fixed_x_vector(b_vector.size(), 0.0);
+        std::vector<double> x_batch_vector;
+        std::vector<char> singular_vector;
+        std::vector<double> lu_vector;
+        std::vector<int> row_order_vector;
+        std::vector<double> y_vector;
+        BatchSolver batch_solver;
+        int singular_count = 0;
+        int s = 0;
+
+        //--------------------------------------------------------------
+        //  The run time size path.
+        //--------------------------------------------------------------
+
+        std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+
+        for (s = 0; s < number_of_systems; ++s)
+        {
+            if (! SolveRunTimeSize(n,
+                                   &a_vector[(size_t)(s) * n * n],
+                                   &b_vector[(size_t)(s) * n],
+                                   lu_vector,
+                                   row_order_vector,
+                                   y_vector,
+                                   &run_time_x_vector[(size_t)(s) * n]))
+            {
+                ++singular_count;
+            }
+        }
+
+        std::chrono::steady_clock::time_point fixed_start_time = std::chrono::steady_clock::now();
+
+        //--------------------------------------------------------------
+        //  The fixed size path.
+        //--------------------------------------------------------------
+
+        if (T_FIXED_SIZE > 0)
+        {
+            for (s = 0; s < number_of_systems; ++s)
+            {
+                SolveFixedSize<T_FIXED_SIZE>(&a_vector[(size_t)(s) * n * n],
+                                             &b_vector[(size_t)(s) * n],
+                                             &fixed_x_vector[(size_t)(s) * n]);
+            }
+        }
+
+        std::chrono::steady_clock::time_point fixed_end_time = std::chrono::steady_clock::now();
+
+        double run_time_seconds = std::chrono::duration<double>(fixed_start_time - start_time).count();
+        double fixed_seconds = std::chrono::duration<double>(fixed_end_time - fixed_start_time).count();
+        unsigned int mismatch_count = 0;
+
+        std::cout << n << " x " << n << ":  run time size "
+            << number_of_systems / run_time_seconds << " systems/s";
+
+        if (T_FIXED_SIZE > 0)
+        {
+            std::cout << ", fixed size " << number_of_systems / fixed_seconds << " systems/s";
+        }
+
+        //--------------------------------------------------------------
+        //  The batch path with each set of kernels.
+        //--------------------------------------------------------------
+
+        for (int level = MatrixKernels::scalar; level <= MatrixKernels::supportedLevel(); ++level)
+        {
+            MatrixKernels::setLevel((MatrixKernels::Level)(level));
+
+            std::chrono::steady_clock::time_point batch_start_time = std::chrono::steady_clock::now();
+
+            int batch_singular_count = batch_solver.Solve(n,
+                                                          number_of_systems,
+                                                          a_batch_vector,
+                                                          b_batch_vector,
+                                                          x_batch_vector,
+                                                          singular_vector);
+
+            std::chrono::steady_clock::time_point end_time = std::chrono::steady_clock::now();
+
+            //----------------------------------------------------------
+            //  Compare the solutions of the systems that are not
+            //  singular.
+            //----------------------------------------------------------
+
+            mismatch_count += (batch_singular_count == singular_count) ? 0 : 1;
+            mismatch_count += CountMismatches(n, number_of_systems, run_time_x_vector, x_batch_vector, singular_vector);
+
+            if (T_FIXED_SIZE > 0)
+            {
+                mismatch_count += CountMismatches(n, number_of_systems, fixed_x_vector, x_batch_vector, singular_vector);
+            }
+
+            double batch_seconds = std::chrono::duration<double>(end_time - batch_start_time).count();
+
+            std::cout << ", batch " << MatrixKernels::levelName((MatrixKernels::Level)(level))
+                << " " << number_of_systems / batch_seconds << " systems/s, speedup "
+                << run_time_seconds / batch_seconds;
+        }
+
+        MatrixKernels::setLevel(MatrixKernels::supportedLevel());
+
+        std::cout << ", singular " << singular_count
+            << ", mismatches " << mismatch_count << std::endl;
+
+        return mismatch_count;
+    }
+}
+
+int main(int argc, char * argv[])
+{
+    int number_of_systems = 1000000;
+
+    if (argc > 1)
+    {
+        number_of_systems = atoi(argv[1]);
+    }
+
+    unsigned int mismatch_count = 0;
+
+    mismatch_count += RunSize<2>(2, number_of_systems);
+    mismatch_count += RunSize<3>(3, number_of_systems);
+    mismatch_count += RunSize<4>(4, number_of_systems);
+    mismatch_count += RunSize<5>(5, number_of_systems);
+    mismatch_count += RunSize<6>(6, number_of_systems);
+    mismatch_count += RunSize<7>(7, number_of_systems);
+    mismatch_count += RunSize<8>(8, number_of_systems);
+    mismatch_count += RunSize<0>(12, number_of_systems);
+    mismatch_count += RunSize<0>(16, number_of_systems);
+
+    return mismatch_count == 0 ? 0 : 1;
+}
@@ -0,0 +1,251 @@
+//======================================================================
+//  Benchmark for the block triangular form.
+//
+//  Sparse systems made of a chain of diagonal blocks, where each block
+//  also depends on a few variables of the blocks before it, are
+//  factored by LinearSystemSolver with and without the block
+//  triangular form. The variables are numbered in a random order, so
+//  that the blocks have to be found. For each block size the time of
+//  the analysis and factorization, the method, the fill-in and the
+//  number of floating point operations of each are reported, with the
+//  time saved by the block triangular form. Both solutions must agree
+//  to within a relative difference of 1.0E-8.
+//
+//  Usage:
+//
+//      BlockTriangularBenchmark [number_of_equations [number_of_repetitions]]
+//======================================================================
+
+#include <stdlib.h>
+#include <math.h>
+#include <algorithm>
+#include <iostream>
+#include <utility>
+#include <vector>
+#include <chrono>
+#include "CompressedSparseMatrix.h"
+#include "FrozenSparseMatrix.h"
+#include "LinearSystemSolver.h"
+
+namespace
+{
+    double NextValue(unsigned int & seed)
+    {
+        seed = seed * 1103515245U + 12345U;
+        return (double)((int)((seed >> 16) % 2001) - 1000) / 1000.0;
+    }
+
+    //------------------------------------------------------------------
+    //  Make a system of n equations in blocks of block_size equations.
+    //  Each row has a large diagonal, four other elements in its own
+    //  block and two elements in earlier blocks. The columns are
+    //  renumbered by a random permutation.
+    //------------------------------------------------------------------
+
+    void MakeSystem(int n,
+                    int block_size,
+                    FrozenSparseMatrix & a_matrix,
+                    std::vector<double> & b_vector)
+    {
+        unsigned int seed = 12345 + block_size;
+        std::vector<int> column_number_vector(n);
+        int i = 0;
+
+        for (i = 0; i < n; ++i)
+        {
+            column_number_vector[i] = i;
+        }
+
+        for (i = n - 1; i > 0; --i)
+        {
+            seed = seed * 1103515245U + 12345U;
+            std::swap(column_number_vector[i], column_number_vector[(seed >> 8) % (unsigned int)(i + 1)]);
+        }
+
+        std::vector<size_t> row_start_vector(1, 0);
+        std::vector<int> column_index_vector;
+        std::vector<double> value_vector;
+        std::vector< std::pair<int, double> > row_element_vector;
+
+        b_vector.resize(n);
+
+        for (i = 0; i < n; ++i)
+        {
+            int block_start = i - i % block_size;
+            int this_block_size = std::min(block_size, n - block_start);
+
+            row_element_vector.clear();
+            row_element_vector.push_back(std::make_pair(i, 8.0 + NextValue(seed)));
+
+            for (int e = 0; (e < 4) && (this_block_size > 1); ++e)
+            {
+                seed = seed * 1103515245U + 12345U;
+                int j = block_start + (int)((seed >> 8) % (unsigned int)(this_block_size));
+                row_element_vector.push_back(std::make_pair(j, NextValue(seed)));
+            }
+
+            for (int e = 0; (e < 2) && (block_start > 0); ++e)
+            {
+                seed = seed * 1103515245U + 12345U;
+                int j = (int)((seed >> 8) % (unsigned int)(block_start));
+                row_element_vector.push_back(std::make_pair(j, NextValue(seed)));
+            }
+
+            //----------------------------------------------------------
+            //  Renumber the columns, sort them and add the values of
+            //  repeated columns.
+            //----------------------------------------------------------
+
+            for (size_t e = 0; e < row_element_vector.size(); ++e)
+            {
+                row_element_vector[e].first = column_number_vector[row_element_vector[e].first];
+            }
+
+            std::sort(row_element_vector.begin(), row_element_vector.end());
+
+            for (size_t e = 0; e < row_element_vector.size(); ++e)
+            {
+                if ((e > 0) && (row_element_vector[e].first == column_index_vector.back()))
+                {
+                    value_vector.back() += row_element_vector[e].second;
+                }
+                else
+                {
+                    column_index_vector.push_back(row_element_vector[e].first);
+                    value_vector.push_back(row_element_vector[e].second);
+                }
+            }
+
+            row_start_vector.push_back(column_index_vector.size());
+            b_vector[i] = NextValue(seed);
+        }
+
+        CompressedSparseMatrix a_csr_matrix;
+
+        a_csr_matrix.Assign(n,
+                            n,
+                            row_start_vector,
+                            column_index_vector,
+                            value_vector);
+        a_matrix.Freeze(a_csr_matrix);
+
+        return;
+    }
+
+    //------------------------------------------------------------------
+    //  Analyze, factor and solve, and return the mean time of the
+    //  analysis and factorization.
+    //------------------------------------------------------------------
+
+    double FactorAndSolve(int n,
+                          const FrozenSparseMatrix & a_matrix,
+                          const std::vector<double> & b_vector,
+                          int number_of_repetitions,
+                          LinearSystemSolver & solver,
+                          std::vector<double> & x_vector)
+    {
+        double seconds = 0.0;
+
+        for (int repetition = 0; repetition < number_of_repetitions; ++repetition)
+        {
+            std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+
+            solver.Analyze(n, a_matrix, 0);
+            solver.Factor(a_matrix);
+
+            seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+        }
+
+        solver.Solve(b_vector, x_vector);
+
+        return seconds / number_of_repetitions;
+    }
+
+    //------------------------------------------------------------------
+    //  Time both factorizations for one block size and return the
+    //  number of solutions that differ.
+    //------------------------------------------------------------------
+
+    unsigned int RunBlockSize(int n,
+                              int block_size,
+                              int number_of_repetitions)
+    {
+        FrozenSparseMatrix a_matrix;
+        std::vector<double> b_vector;
+        MakeSystem(n, block_size, a_matrix, b_vector);
+
+        LinearSystemSolver block_solver;
+        LinearSystemSolver whole_solver;
+        whole_solver.SetBlockTriangularForm(false);
+
+        std::vector<double> block_x_vector;
+        std::vector<double> whole_x_vector;
+
+        double block_seconds = FactorAndSolve(n,
+                                              a_matrix,
+                                              b_vector,
+                                              number_of_repetitions,
+                                              block_solver,
+                                              block_x_vector);
+
+        double whole_seconds = FactorAndSolve(n,
+                                              a_matrix,
+                                              b_vector,
+                                              number_of_repetitions,
+                                              whole_solver,
+                                              whole_x_vector);
+
+        double x_norm = 0.0;
+        double difference_norm = 0.0;
+
+        for (int i = 0; i < n; ++i)
+        {
+            x_norm = (fabs(whole_x_vector[i]) > x_norm) ? fabs(whole_x_vector[i]) : x_norm;
+            difference_norm = (fabs(whole_x_vector[i] - block_x_vector[i]) > difference_norm)
+                ? fabs(whole_x_vector[i] - block_x_vector[i]) : difference_norm;
+        }
+
+        unsigned int mismatch_count = (difference_norm > 1.0E-8 * x_norm) ? 1 : 0;
+
+        std::cout << "Block size " << block_size
+            << ":  " << block_solver.GetNumberOfBlocks() << " blocks, largest "
+            << block_solver.GetLargestBlockSize() << std::endl;
+        std::cout << "    Block triangular form:  " << block_seconds
+            << " s, fill-in " << block_solver.GetFillIn()
+            << ", floating point operations " << block_solver.GetFlopCount() << std::endl;
+        std::cout << "    Whole matrix:  " << whole_seconds << " s, "
+            << LinearSystemSolver::GetMethodString(whole_solver.GetMethod())
+            << ", fill-in " << whole_solver.GetFillIn()
+            << ", floating point operations " << whole_solver.GetFlopCount() << std::endl;
+        std::cout << "    Time saved " << whole_seconds - block_seconds
+            << " s, difference " << difference_norm / x_norm << std::endl;
+
+        return mismatch_count;
+    }
+}
+
+int main(int argc, char * argv[])
+{
+    int n = 4000;
+    int number_of_repetitions = 3;
+
+    if (argc > 1)
+    {
+        n = atoi(argv[1]);
+    }
+
+    if (argc > 2)
+    {
+        number_of_repetitions = atoi(argv[2]);
+    }
+
+    unsigned int mismatch_count = 0;
+    const int block_size_array[] = { 1, 4, 16, 64 };
+
+    for (size_t index = 0; index < sizeof(block_size_array) / sizeof(block_size_array[0]); ++index)
+    {
+        mismatch_count += RunBlockSize(n, block_size_array[index], number_of_repetitions);
+    }
+
+    return mismatch_count == 0 ? 0 : 1;
+}
@@ -0,0 +1,263 @@
+//======================================================================
+//  Benchmark for the fixed size solvers.
+//
+//  For each size from 2 to 8, many random systems are solved with
+//  FixedSizeSolver and with the same Gaussian elimination with
+//  partial pivoting on a matrix whose size is only known at run time,
+//  which is what LinearSystemSolver did for a dense system of any
+//  size. The throughput of each is reported in systems per second.
+//  Both must produce bit-identical solutions.
+//
+//  Usage:
+//
+//      FixedSizeSolverBenchmark [number_of_systems]
+//======================================================================
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include "FixedSizeSolver.h"
+
+namespace
+{
+    //------------------------------------------------------------------
+    //  Generate the A matrices and B vectors, one after another.
+    //------------------------------------------------------------------
+
+    void MakeSystems(int n,
+                     int number_of_systems,
+                     std::vector<double> & a_vector,
+                     std::vector<double> & b_vector)
+    {
+        unsigned int seed = 12345;
+
+        a_vector.resize((size_t)(number_of_systems) * n * n);
+        b_vector.resize((size_t)(number_of_systems) * n);
+
+        for (size_t i = 0; i < a_vector.size(); ++i)
+        {
+            seed = seed * 1103515245U + 12345U;
+            a_vector[i] = (double)((int)((seed >> 16) % 2001) - 1000) / 64.0;
+        }
+
+        for (size_t i = 0; i < b_vector.size(); ++i)
+        {
+            seed = seed * 1103515245U + 12345U;
+            b_vector[i] = (double)((int)((seed >> 16) % 2001) - 1000) / 64.0;
+        }
+
+        return;
+    }
+
+    //------------------------------------------------------------------
+    //  Solve one system whose size is only known at run time. Returns
+    //  false if a pivot is zero.
+    //------------------------------------------------------------------
+
+    bool SolveRunTimeSize(int n,
+                          const double * a_ptr,
+                          const double * b_ptr,
+                          std::vector<double> & lu_vector,
+                          std::vector<int> & row_order_vector,
+                          std::vector<double> & y_vector,
+                          double * x_ptr)
+    {
+        int i = 0;
+        int j = 0;
+        int k = 0;
+
+        lu_vector.assign(a_ptr, a_ptr + n * n);
+        row_order_vector.resize(n);
+        y_vector.resize(n);
+
+        for (i = 0; i < n; ++i)
+        {
+            row_order_vector[i] = i;
+        }
+
+        for (k = 0; k < n; ++k)
+        {
+            int pivot_row = k;
+
+            for (i = k + 1; i < n; ++i)
+            {
+                if (fabs(lu_vector[i * n + k]) > fabs(lu_vector[pivot_row * n + k]))
+                {
+                    pivot_row = i;
+                }
+            }
+
+            if (lu_vector[pivot_row * n + k] == 0.0)
+            {
+                return false;
+            }
+
+            if (pivot_row != k)
+            {
+                for (j = 0; j < n; ++j)
+                {
+                    std::swap(lu_vector[k * n + j], lu_vector[pivot_row * n + j]);
+                }
+
+                std::swap(row_order_vector[k], row_order_vector[pivot_row]);
+            }
+
+            for (i = k + 1; i < n; ++i)
+            {
+                if (lu_vector[i * n + k] != 0.0)
+                {
+                    double multiplier = lu_vector[i * n + k] / lu_vector[k * n + k];
+
+                    for (j = k + 1; j < n; ++j)
+                    {
+                        lu_vector[i * n + j] -= multiplier * lu_vector[k * n + j];
+                    }
+
+                    lu_vector[i * n + k] = multiplier;
+                }
+            }
+        }
+
+        for (i = 0; i < n; ++i)
+        {
+            double y_value = b_ptr[row_order_vector[i]];
+
+            for (j = 0; j < i; ++j)
+            {
+                y_value -= lu_vector[i * n + j] * y_vector[j];
+            }
+
+            y_vector[i] = y_value;
+        }
+
+        for (i = n - 1; i >= 0; --i)
+        {
+            double sum = y_vector[i];
+
+            for (j = i + 1; j < n; ++j)
+            {
+                sum -= lu_vector[i * n + j] * x_ptr[j];
+            }
+
+            x_ptr[i] = sum / lu_vector[i * n + i];
+        }
+
+        return true;
+    }
+
+    //------------------------------------------------------------------
+    //  Time both solvers for one size and return the number of
+    //  solutions that differ.
+    //------------------------------------------------------------------
+
+    template <int T_SIZE>
+    unsigned int RunSize(int number_of_systems)
+    {
+        typedef FixedSizeSolver<T_SIZE> Solver_T;
+
+        std::vector<double> a_vector;
+        std::vector<double> b_vector;
+        MakeSystems(T_SIZE, number_of_systems, a_vector, b_vector);
+
+        std::vector<double> fixed_x_vector(b_vector.size(), 0.0);
+        std::vector<double> run_time_x_vector(b_vector.size(), 0.0);
+        std::vector<double> lu_vector;
+        std::vector<int> row_order_vector;
+        std::vector<double> y_vector;
+        int singular_count = 0;
+        int s = 0;
+
+        //--------------------------------------------------------------
+        //  The run time size path.
+        //--------------------------------------------------------------
+
+        std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+
+        for (s = 0; s < number_of_systems; ++s)
+        {
+            if (! SolveRunTimeSize(T_SIZE,
+                                   &a_vector[(size_t)(s) * T_SIZE * T_SIZE],
+                                   &b_vector[(size_t)(s) * T_SIZE],
+                                   lu_vector,
+                                   row_order_vector,
+                                   y_vector,
+                                   &run_time_x_vector[(size_t)(s) * T_SIZE]))
+            {
+                ++singular_count;
+            }
+        }
+
+        std::chrono::steady_clock::time_point middle_time = std::chrono::steady_clock::now();
+
+        //--------------------------------------------------------------
+        //  The fixed size path.
+        //--------------------------------------------------------------
+
+        for (s = 0; s < number_of_systems; ++s)
+        {
+            typename Solver_T::Matrix_T a_array;
+            typename Solver_T::Vector_T b_array;
+            typename Solver_T::Vector_T x_array;
+
+            memcpy(a_array.data(), &a_vector[(size_t)(s) * T_SIZE * T_SIZE], sizeof(a_array));
+            memcpy(b_array.data(), &b_vector[(size_t)(s) * T_SIZE], sizeof(b_array));
+
+            if (Solver_T::Solve(a_array, b_array, x_array))
+            {
+                memcpy(&fixed_x_vector[(size_t)(s) * T_SIZE], x_array.data(), sizeof(x_array));
+            }
+        }
+
+        std::chrono::steady_clock::time_point end_time = std::chrono::steady_clock::now();
+
+        //--------------------------------------------------------------
+        //  Compare the solutions.
+        //--------------------------------------------------------------
+
+        unsigned int mismatch_count = 0;
+
+        for (size_t i = 0; i < b_vector.size(); ++i)
+        {
+            if (memcmp(&fixed_x_vector[i], &run_time_x_vector[i], sizeof(double)) != 0)
+            {
+                ++mismatch_count;
+            }
+        }
+
+        double run_time_seconds = std::chrono::duration<double>(middle_time - start_time).count();
+        double fixed_seconds = std::chrono::duration<double>(end_time - middle_time).count();
+
+        std::cout << T_SIZE << " x " << T_SIZE << ":  run time size "
+            << number_of_systems / run_time_seconds << " systems/s, fixed size "
+            << number_of_systems / fixed_seconds << " systems/s, speedup "
+            << run_time_seconds / fixed_seconds << ", singular " << singular_count
+            << ", mismatches " << mismatch_count << std::endl;
+
+        return mismatch_count;
+    }
+}
+
+int main(int argc, char * argv[])
+{
+    int number_of_systems = 1000000;
+
+    if (argc > 1)
+    {
+        number_of_systems = atoi(argv[1]);
+    }
+
+    unsigned int mismatch_count = 0;
+
+    mismatch_count += RunSize<2>(number_of_systems);
+    mismatch_count += RunSize<3>(number_of_systems);
+    mismatch_count += RunSize<4>(number_of_systems);
+    mismatch_count += RunSize<5>(number_of_systems);
+    mismatch_count += RunSize<6>(number_of_systems);
+    mismatch_count += RunSize<7>(number_of_systems);
+    mismatch_count += RunSize<8>(number_of_systems);
+
+    return mismatch_count == 0 ? 0 : 1;
+}
@@ -0,0 +1,284 @@
+//======================================================================
+//  Benchmark for the low rank update solver.
+//
+//  A dense system and a sparse system from a square grid are factored
+//  once. Then k coefficients are changed, for several values of k,
+//  and the new system is solved both by factoring it again with
+//  LinearSystemSolver and by LowRankUpdateSolver from the factors of
+//  the first system. The time of each is reported, with the rank of
+//  the correction and whether the update solver factored the system
+//  again instead. Both solutions must agree to within a relative
+//  difference of 1.0E-8.
+//
+//  Usage:
+//
+//      LowRankUpdateBenchmark [number_of_repetitions]
+//======================================================================
+
+#include <stdlib.h>
+#include <math.h>
+#include <algorithm>
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include "CompressedSparseMatrix.h"
+#include "FrozenSparseMatrix.h"
+#include "LinearSystemSolver.h"
+#include "LowRankUpdateSolver.h"
+
+namespace
+{
+    //------------------------------------------------------------------
+    //  A system whose A matrix is stored by rows, with the columns of
+    //  each row in increasing order.
+    //------------------------------------------------------------------
+
+    struct TestSystem_T
+    {
+        int m_n;
+        std::vector<size_t> m_row_start_vector;
+        std::vector<int> m_column_index_vector;
+        std::vector<double> m_value_vector;
+        std::vector<double> m_b_vector;
+    };
+
+    double NextValue(unsigned int & seed)
+    {
+        seed = seed * 1103515245U + 12345U;
+        return (double)((int)((seed >> 16) % 2001) - 1000) / 1000.0;
+    }
+
+    //------------------------------------------------------------------
+    //  A dense system with a large diagonal.
+    //------------------------------------------------------------------
+
+    void MakeDenseSystem(int n,
+                         TestSystem_T & system)
+    {
+        unsigned int seed = 12345;
+
+        system.m_n = n;
+        system.m_row_start_vector.assign(1, 0);
+        system.m_column_index_vector.clear();
+        system.m_value_vector.clear();
+        system.m_b_vector.resize(n);
+
+        for (int i = 0; i < n; ++i)
+        {
+            for (int j = 0; j < n; ++j)
+            {
+                system.m_column_index_vector.push_back(j);
+                system.m_value_vector.push_back((i == j) ? (double)(n) : NextValue(seed));
+            }
+
+            system.m_row_start_vector.push_back(system.m_column_index_vector.size());
+            system.m_b_vector[i] = NextValue(seed);
+        }
+
+        return;
+    }
+
+    //------------------------------------------------------------------
+    //  The five point Laplacian on a square grid, plus a small random
+    //  part so that the matrix is not symmetric.
+    //------------------------------------------------------------------
+
+    void MakeGridSystem(int grid_size,
+                        TestSystem_T & system)
+    {
+        unsigned int seed = 54321;
+        int n = grid_size * grid_size;
+
+        system.m_n = n;
+        system.m_row_start_vector.assign(1, 0);
+        system.m_column_index_vector.clear();
+        system.m_value_vector.clear();
+        system.m_b_vector.resize(n);
+
+        for (int i = 0; i < n; ++i)
+        {
+            int row = i / grid_size;
+            int column = i % grid_size;
+            int neighbor_array[5] = { i - grid_size, i - 1, i, i + 1, i + grid_size };
+            bool present_array[5] = { row > 0, column > 0, true, column < grid_size - 1, row < grid_size - 1 };
+
+            for (int e = 0; e < 5; ++e)
+            {
+                if (present_array[e])
+                {
+                    system.m_column_index_vector.push_back(neighbor_array[e]);
+                    system.m_value_vector.push_back((e == 2) ? 4.0 : -1.0 + 0.1 * NextValue(seed));
+                }
+            }
+
+            system.m_row_start_vector.push_back(system.m_column_index_vector.size());
+            system.m_b_vector[i] = NextValue(seed);
+        }
+
+        return;
+    }
+
+    void FreezeSystem(const TestSystem_T & system,
+                      FrozenSparseMatrix & a_matrix)
+    {
+        std::vector<size_t> row_start_vector = system.m_row_start_vector;
+        std::vector<int> column_index_vector = system.m_column_index_vector;
+        std::vector<double> value_vector = system.m_value_vector;
+        CompressedSparseMatrix a_csr_matrix;
+
+        a_csr_matrix.Assign(system.m_n,
+                            system.m_n,
+                            row_start_vector,
+                            column_index_vector,
+                            value_vector);
+        a_matrix.Freeze(a_csr_matrix);
+
+        return;
+    }
+
+    //------------------------------------------------------------------
+    //  Time both ways of solving after k changes and return the number
+    //  of solutions that differ.
+    //------------------------------------------------------------------
+
+    unsigned int RunChanges(const char * name_ptr,
+                            const TestSystem_T & system,
+                            int k,
+                            int number_of_repetitions)
+    {
+        FrozenSparseMatrix a_matrix;
+        FreezeSystem(system, a_matrix);
+
+        //--------------------------------------------------------------
+        //  Change k stored coefficients, spread over the matrix.
+        //--------------------------------------------------------------
+
+        TestSystem_T changed_system = system;
+        std::vector<int> change_position_vector;
+        unsigned int seed = 999 + k;
+
+        for (int c = 0; c < k; ++c)
+        {
+            int row = (int)(((size_t)(c) * 7919 + 13) % (size_t)(system.m_n));
+            size_t row_start = system.m_row_start_vector[row];
+            size_t row_size = system.m_row_start_vector[row + 1] - row_start;
+            size_t position = row_start + ((size_t)(c) * 31) % row_size;
+
+            changed_system.m_value_vector[position] += 0.5 * NextValue(seed);
+            change_position_vector.push_back((int)(position));
+        }
+
+        FrozenSparseMatrix changed_matrix;
+        FreezeSystem(changed_system, changed_matrix);
+
+        double full_seconds = 0.0;
+        double update_seconds = 0.0;
+        std::vector<double> full_x_vector;
+        std::vector<double> update_x_vector;
+        int rank = 0;
+        int break_even_rank = 0;
+        int number_of_refactorizations = 0;
+
+        for (int repetition = 0; repetition < number_of_repetitions; ++repetition)
+        {
+            LinearSystemSolver full_solver;
+            LowRankUpdateSolver update_solver;
+
+            update_solver.Factor(system.m_n, a_matrix);
+
+            //----------------------------------------------------------
+            //  Factor the changed system again.
+            //----------------------------------------------------------
+
+            std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+
+            full_solver.Analyze(system.m_n, changed_matrix, 0);
+            full_solver.Factor(changed_matrix);
+            full_solver.Solve(system.m_b_vector, full_x_vector);
+
+            std::chrono::steady_clock::time_point middle_time = std::chrono::steady_clock::now();
+
+            //----------------------------------------------------------
+            //  Correct the factors of the first system.
+            //----------------------------------------------------------
+
+            for (int c = 0; c < k; ++c)
+            {
+                size_t position = change_position_vector[c];
+                int row = (int)(std::upper_bound(system.m_row_start_vector.begin(),
+                                                 system.m_row_start_vector.end(),
+                                                 position) - system.m_row_start_vector.begin()) - 1;
+
+                update_solver.ChangeCoefficient(row,
+                                                system.m_column_index_vector[position],
+                                                changed_system.m_value_vector[position]);
+            }
+
+            update_solver.Solve(system.m_b_vector, update_x_vector);
+
+            std::chrono::steady_clock::time_point end_time = std::chrono::steady_clock::now();
+
+            full_seconds += std::chrono::duration<double>(middle_time - start_time).count();
+            update_seconds += std::chrono::duration<double>(end_time - middle_time).count();
+            rank = update_solver.GetRank();
+            break_even_rank = update_solver.GetBreakEvenRank();
+            number_of_refactorizations = update_solver.GetNumberOfRefactorizations();
+        }
+
+        //--------------------------------------------------------------
+        //  Compare the solutions.
+        //--------------------------------------------------------------
+
+        double x_norm = 0.0;
+        double difference_norm = 0.0;
+
+        for (int i = 0; i < system.m_n; ++i)
+        {
+            x_norm = (fabs(full_x_vector[i]) > x_norm) ? fabs(full_x_vector[i]) : x_norm;
+            difference_norm = (fabs(full_x_vector[i] - update_x_vector[i]) > difference_norm)
+                ? fabs(full_x_vector[i] - update_x_vector[i]) : difference_norm;
+        }
+
+        unsigned int mismatch_count = (difference_norm > 1.0E-8 * x_norm) ? 1 : 0;
+
+        std::cout << name_ptr << " k = " << k << ":  refactor "
+            << full_seconds / number_of_repetitions << " s, update "
+            << update_seconds / number_of_repetitions << " s, speedup "
+            << full_seconds / update_seconds << ", rank " << rank
+            << " (break-even " << break_even_rank << ")"
+            << (number_of_refactorizations > 0 ? ", refactored" : "")
+            << ", difference " << difference_norm / x_norm << std::endl;
+
+        return mismatch_count;
+    }
+}
+
+int main(int argc, char * argv[])
+{
+    int number_of_repetitions = 3;
+
+    if (argc > 1)
+    {
+        number_of_repetitions = atoi(argv[1]);
+    }
+
+    TestSystem_T dense_system;
+    TestSystem_T grid_system;
+    MakeDenseSystem(400, dense_system);
+    MakeGridSystem(100, grid_system);
+
+    unsigned int mismatch_count = 0;
+    const int k_array[] = { 1, 2, 4, 8, 16, 32, 64, 128 };
+
+    for (size_t index = 0; index < sizeof(k_array) / sizeof(k_array[0]); ++index)
+    {
+        mismatch_count += RunChanges("Dense 400", dense_system, k_array[index], number_of_repetitions);
+    }
+
+    for (size_t index = 0; index < sizeof(k_array) / sizeof(k_array[0]); ++index)
+    {
+        mismatch_count += RunChanges("Grid 100 x 100", grid_system, k_array[index], number_of_repetitions);
+    }
+
+    return mismatch_count == 0 ? 0 : 1;
+}
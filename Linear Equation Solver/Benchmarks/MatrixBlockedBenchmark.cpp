@@ -0,0 +1,127 @@
+//======================================================================
+//  Benchmark for the blocked LU factorization of class Matrix.
+//
+//  Dense systems from n = 256 up to the largest size, doubling each
+//  time, are solved by Matrix::gaussElimination, which updates every
+//  remaining row once for each pivot, and by Matrix::
+//  gaussEliminationBlocked, which factors panels of columns and then
+//  updates the trailing matrix once for each panel. The rate of each
+//  is reported in GFLOP/s, counting 2/3 n^3 operations. Both must
+//  choose the same pivot rows, and the solutions must agree to
+//  within a relative difference of 1.0E-8.
+//
+//  The benchmark is built with the files matrix.cpp,
+//  MatrixKernels.cpp, MatrixThreadPool.cpp and MatrixTaskGraph.cpp.
+//
+//  Usage:
+//
+//      MatrixBlockedBenchmark [largest_size [panel_width]]
+//======================================================================
+
+#include <stdlib.h>
+#include <math.h>
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include "Matrix.h"
+
+namespace
+{
+    double NextValue(unsigned int & seed)
+    {
+        seed = seed * 1103515245U + 12345U;
+        return (double)((int)((seed >> 16) % 2001) - 1000) / 1000.0;
+    }
+
+    double ElapsedSeconds(std::chrono::steady_clock::time_point start_time)
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+    }
+
+    //------------------------------------------------------------------
+    //  Time both factorizations for one size and return the number of
+    //  results that differ.
+    //------------------------------------------------------------------
+
+    unsigned int RunSize(int n,
+                         int panel_width)
+    {
+        unsigned int seed = 12345 + n;
+        Matrix matrix;
+        matrix.reserve(n, n + 1);
+
+        for (int i = 0; i < n; ++i)
+        {
+            double * row_ptr = matrix.appendRow(n + 1);
+
+            for (int j = 0; j <= n; ++j)
+            {
+                row_ptr[j] = NextValue(seed);
+            }
+        }
+
+        Matrix blocked_matrix(matrix);
+
+        std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+        matrix.gaussElimination();
+        double unblocked_seconds = ElapsedSeconds(start_time);
+
+        start_time = std::chrono::steady_clock::now();
+        blocked_matrix.gaussEliminationBlocked(panel_width);
+        double blocked_seconds = ElapsedSeconds(start_time);
+
+        //--------------------------------------------------------------
+        //  Compare the pivot rows and the solutions.
+        //--------------------------------------------------------------
+
+        const std::vector<double> & x_vector = matrix.getGaussEliminationResults();
+        const std::vector<double> & blocked_x_vector = blocked_matrix.getGaussEliminationResults();
+        bool same_pivots_flag = matrix.getPivotRows() == blocked_matrix.getPivotRows();
+        double x_norm = 0.0;
+        double difference_norm = 0.0;
+
+        for (int i = 0; i < n; ++i)
+        {
+            x_norm = (fabs(x_vector[i]) > x_norm) ? fabs(x_vector[i]) : x_norm;
+            difference_norm = (fabs(x_vector[i] - blocked_x_vector[i]) > difference_norm)
+                ? fabs(x_vector[i] - blocked_x_vector[i]) : difference_norm;
+        }
+
+        unsigned int mismatch_count = ((! same_pivots_flag) || (difference_norm > 1.0E-8 * x_norm)) ? 1 : 0;
+        double flop_count = 2.0 / 3.0 * (double)(n) * n * n;
+
+        std::cout << "n = " << n
+            << ":  unblocked " << unblocked_seconds << " s, " << flop_count / unblocked_seconds * 1.0E-9
+            << " GFLOP/s, blocked " << blocked_seconds << " s, " << flop_count / blocked_seconds * 1.0E-9
+            << " GFLOP/s, speedup " << unblocked_seconds / blocked_seconds
+            << (same_pivots_flag ? ", same pivots" : ", pivots differ")
+            << ", difference " << difference_norm / x_norm << std::endl;
+
+        return mismatch_count;
+    }
+}
+
+int main(int argc, char * argv[])
+{
+    int largest_size = 8192;
+    int panel_width = 0;
+
+    if (argc > 1)
+    {
+        largest_size = atoi(argv[1]);
+    }
+
+    if (argc > 2)
+    {
+        panel_width = atoi(argv[2]);
+    }
+
+    unsigned int mismatch_count = 0;
+
+    for (int n = 256; n <= largest_size; n *= 2)
+    {
+        mismatch_count += RunSize(n, panel_width);
+    }
+
+    return mismatch_count == 0 ? 0 : 1;
+}
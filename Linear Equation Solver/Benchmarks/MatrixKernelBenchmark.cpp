@@ -0,0 +1,177 @@
+//======================================================================
+//  Benchmark for the row kernels of class Matrix.
+//
+//  Dense systems of several sizes are solved by Matrix::
+//  gaussElimination and by Matrix::gaussSeidel with each set of
+//  kernels the processor supports, from plain C++ to AVX-512. The
+//  time and the rate of each elimination are reported together with
+//  the speedup over the plain C++ kernels. The pivots must be the
+//  same for every set of kernels and the solutions must agree to
+//  within a relative difference of 1.0E-8.
+//
+//  The benchmark is built with the files matrix.cpp,
+//  MatrixKernels.cpp, MatrixThreadPool.cpp and MatrixTaskGraph.cpp.
+//
+//  Usage:
+//
+//      MatrixKernelBenchmark [largest_size]
+//======================================================================
+
+#include <stdlib.h>
+#include <math.h>
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include "Matrix.h"
+#include "MatrixKernels.h"
+
+namespace
+{
+    double NextValue(unsigned int & seed)
+    {
+        seed = seed * 1103515245U + 12345U;
+        return (double)((int)((seed >> 16) % 2001) - 1000) / 1000.0;
+    }
+
+    double ElapsedSeconds(std::chrono::steady_clock::time_point start_time)
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+    }
+
+    //------------------------------------------------------------------
+    //  Make a dense system with a large diagonal, so that gaussSeidel,
+    //  which does not pivot, is stable.
+    //------------------------------------------------------------------
+
+    void MakeSystem(int n,
+                    Matrix & matrix)
+    {
+        unsigned int seed = 12345 + n;
+        matrix.reserve(n, n + 1);
+
+        for (int i = 0; i < n; ++i)
+        {
+            double * row_ptr = matrix.appendRow(n + 1);
+
+            for (int j = 0; j <= n; ++j)
+            {
+                row_ptr[j] = NextValue(seed);
+            }
+
+            row_ptr[i] = (double)(n);
+        }
+
+        return;
+    }
+
+    double RelativeDifference(const std::vector<double> & reference_x_vector,
+                              const std::vector<double> & x_vector)
+    {
+        double x_norm = 0.0;
+        double difference_norm = 0.0;
+
+        for (size_t i = 0; i < reference_x_vector.size(); ++i)
+        {
+            x_norm = (fabs(reference_x_vector[i]) > x_norm) ? fabs(reference_x_vector[i]) : x_norm;
+            difference_norm = (fabs(reference_x_vector[i] - x_vector[i]) > difference_norm)
+                ? fabs(reference_x_vector[i] - x_vector[i]) : difference_norm;
+        }
+
+        return difference_norm / x_norm;
+    }
+
+    //------------------------------------------------------------------
+    //  Time both eliminations with each set of kernels for one size and
+    //  return the number of results that differ from the plain C++
+    //  kernels.
+    //------------------------------------------------------------------
+
+    unsigned int RunSize(int n)
+    {
+        double flops = 2.0 / 3.0 * n * (double)(n) * n;
+        double scalar_elimination_seconds = 0.0;
+        double scalar_seidel_seconds = 0.0;
+        std::vector<int> scalar_pivot_vector;
+        std::vector<double> scalar_elimination_x_vector;
+        std::vector<double> scalar_seidel_x_vector;
+        unsigned int mismatch_count = 0;
+
+        for (int level = MatrixKernels::scalar; level <= MatrixKernels::supportedLevel(); ++level)
+        {
+            MatrixKernels::setLevel((MatrixKernels::Level)(level));
+
+            Matrix elimination_matrix;
+            MakeSystem(n, elimination_matrix);
+            Matrix seidel_matrix(elimination_matrix);
+
+            std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+            elimination_matrix.gaussElimination();
+            double elimination_seconds = ElapsedSeconds(start_time);
+
+            start_time = std::chrono::steady_clock::now();
+            seidel_matrix.gaussSeidel();
+            double seidel_seconds = ElapsedSeconds(start_time);
+
+            //----------------------------------------------------------
+            //  The plain C++ kernels are the reference.
+            //----------------------------------------------------------
+
+            if (level == MatrixKernels::scalar)
+            {
+                scalar_elimination_seconds = elimination_seconds;
+                scalar_seidel_seconds = seidel_seconds;
+                scalar_pivot_vector = elimination_matrix.getPivotRows();
+                scalar_elimination_x_vector = elimination_matrix.getGaussEliminationResults();
+                scalar_seidel_x_vector = seidel_matrix.getGaussSeidelResults();
+            }
+
+            bool same_pivots = (elimination_matrix.getPivotRows() == scalar_pivot_vector);
+            double elimination_difference = RelativeDifference(scalar_elimination_x_vector,
+                                                               elimination_matrix.getGaussEliminationResults());
+            double seidel_difference = RelativeDifference(scalar_seidel_x_vector,
+                                                          seidel_matrix.getGaussSeidelResults());
+
+            if ((!same_pivots) || (elimination_difference > 1.0E-8) || (seidel_difference > 1.0E-8))
+            {
+                ++mismatch_count;
+            }
+
+            std::cout << "n = " << n << ", " << MatrixKernels::levelName((MatrixKernels::Level)(level))
+                << ":  gaussElimination " << elimination_seconds
+                << " s, " << flops / elimination_seconds * 1.0E-9
+                << " GFLOP/s, speedup " << scalar_elimination_seconds / elimination_seconds
+                << ", gaussSeidel " << seidel_seconds
+                << " s, " << flops / seidel_seconds * 1.0E-9
+                << " GFLOP/s, speedup " << scalar_seidel_seconds / seidel_seconds
+                << (same_pivots ? "" : ", pivots differ")
+                << ", difference " << elimination_difference
+                << " " << seidel_difference << std::endl;
+        }
+
+        MatrixKernels::setLevel(MatrixKernels::supportedLevel());
+
+        return mismatch_count;
+    }
+}
+
+int main(int argc, char * argv[])
+{
+    int largest_size = 2048;
+
+    if (argc > 1)
+    {
+        largest_size = atoi(argv[1]);
+    }
+
+    std::cout << "Supported kernels: "
+        << MatrixKernels::levelName(MatrixKernels::supportedLevel()) << std::endl;
+
+    unsigned int mismatch_count = 0;
+
+    for (int n = 256; n <= largest_size; n *= 2)
+    {
+        mismatch_count += RunSize(n);
+    }
+
+    return mismatch_count == 0 ? 0 : 1;
+}
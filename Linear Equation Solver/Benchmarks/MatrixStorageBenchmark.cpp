@@ -0,0 +1,272 @@
+//======================================================================
+//  Benchmark for the storage of class Matrix.
+//
+//  Dense systems of several sizes are solved by Matrix::
+//  gaussElimination, which stores the augmented matrix in one 64 byte
+//  aligned buffer, and by the same elimination on a matrix stored as
+//  a vector of row vectors, which is how class Matrix stored it
+//  before. The time to build each matrix and the time of each
+//  elimination are reported. Matrix uses its plain C++ kernels, so
+//  the operations are done in the same order and both solutions must
+//  be equal. Matrices of different shapes are also assigned to each
+//  other, and each copy must equal its source.
+//
+//  The benchmark is built with the files matrix.cpp,
+//  MatrixKernels.cpp, MatrixThreadPool.cpp and MatrixTaskGraph.cpp.
+//
+//  Usage:
+//
+//      MatrixStorageBenchmark [number_of_repetitions]
+//======================================================================
+
+#include <stdlib.h>
+#include <math.h>
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include "Matrix.h"
+#include "MatrixKernels.h"
+
+namespace
+{
+    typedef std::vector<std::vector<double> > RowVectors_T;
+
+    double NextValue(unsigned int & seed)
+    {
+        seed = seed * 1103515245U + 12345U;
+        return (double)((int)((seed >> 16) % 2001) - 1000) / 1000.0;
+    }
+
+    double ElapsedSeconds(std::chrono::steady_clock::time_point start_time)
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+    }
+
+    //------------------------------------------------------------------
+    //  The elimination of Matrix::gaussElimination on a vector of row
+    //  vectors.
+    //------------------------------------------------------------------
+
+    void EliminateRowVectors(int n,
+                             RowVectors_T & m,
+                             std::vector<double> & x_vector)
+    {
+        for (int i = 0; i < n - 1; i++)
+        {
+            double max_element = fabs(m[i][i]);
+            int row_with_max = i;
+
+            for (int k = i + 1; k < n; k++)
+            {
+                if (fabs(m[k][i]) > max_element)
+                {
+                    max_element = fabs(m[k][i]);
+                    row_with_max = k;
+                }
+            }
+
+            for (int k = i; k <= n; k++)
+            {
+                double temporary = m[row_with_max][k];
+                m[row_with_max][k] = m[i][k];
+                m[i][k] = temporary;
+            }
+
+            for (int k = i + 1; k < n; k++)
+            {
+                double c = - m[k][i] / m[i][i];
+
+                for (int j = i; j < n + 1; j++)
+                {
+                    if (i == j)
+                    {
+                        m[k][j] = 0;
+                    }
+                    else
+                    {
+                        m[k][j] += c * m[i][j];
+                    }
+                }
+            }
+        }
+
+        x_vector.assign(n, 0.0);
+
+        for (int i = n - 1; i >= 0; i--)
+        {
+            double sum = 0.0;
+
+            for (int j = i + 1; j < n; j++)
+            {
+                sum += m[i][j] * x_vector[j];
+            }
+
+            x_vector[i] = (m[i][n] - sum) / m[i][i];
+        }
+
+        return;
+    }
+
+    //------------------------------------------------------------------
+    //  Assign between matrices that already have rows of a different
+    //  length and return the number of copies that differ from their
+    //  source.
+    //------------------------------------------------------------------
+
+    unsigned int CheckAssignment()
+    {
+        unsigned int seed = 54321;
+        const int shape_array[][2] = { { 2, 3 }, { 3, 2 }, { 5, 9 }, { 9, 5 }, { 1, 40 } };
+        const int number_of_shapes = (int)(sizeof(shape_array) / sizeof(shape_array[0]));
+        std::vector<Matrix> matrix_vector(number_of_shapes);
+
+        for (int shape = 0; shape < number_of_shapes; ++shape)
+        {
+            for (int i = 0; i < shape_array[shape][0]; ++i)
+            {
+                std::vector<double> row_vector(shape_array[shape][1]);
+
+                for (size_t j = 0; j < row_vector.size(); ++j)
+                {
+                    row_vector[j] = NextValue(seed);
+                }
+
+                matrix_vector[shape].pushRow(row_vector);
+            }
+        }
+
+        unsigned int mismatch_count = 0;
+
+        for (int target = 0; target < number_of_shapes; ++target)
+        {
+            for (int source = 0; source < number_of_shapes; ++source)
+            {
+                Matrix copy(matrix_vector[target]);
+                copy = matrix_vector[source];
+
+                if (copy.getMatrix() != matrix_vector[source].getMatrix())
+                {
+                    ++mismatch_count;
+                }
+            }
+        }
+
+        std::cout << "Assignment between shapes:  "
+            << (mismatch_count == 0 ? "copies equal" : "copies differ") << std::endl;
+
+        return mismatch_count;
+    }
+
+    //------------------------------------------------------------------
+    //  Time both storages for one size and return the number of
+    //  solutions that differ.
+    //------------------------------------------------------------------
+
+    unsigned int RunSize(int n,
+                         int number_of_repetitions)
+    {
+        double build_row_vectors_seconds = 0.0;
+        double build_matrix_seconds = 0.0;
+        double row_vectors_seconds = 0.0;
+        double matrix_seconds = 0.0;
+        std::vector<double> row_vectors_x_vector;
+        std::vector<double> matrix_x_vector;
+
+        for (int repetition = 0; repetition < number_of_repetitions; ++repetition)
+        {
+            //----------------------------------------------------------
+            //  Build the matrix as pushRow did before, one row vector
+            //  at a time.
+            //----------------------------------------------------------
+
+            unsigned int seed = 12345 + n;
+            std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+
+            RowVectors_T row_vectors;
+
+            for (int i = 0; i < n; ++i)
+            {
+                std::vector<double> row_vector(n + 1);
+
+                for (int j = 0; j <= n; ++j)
+                {
+                    row_vector[j] = NextValue(seed);
+                }
+
+                row_vectors.push_back(row_vector);
+            }
+
+            build_row_vectors_seconds += ElapsedSeconds(start_time);
+
+            //----------------------------------------------------------
+            //  Build the same matrix in place.
+            //----------------------------------------------------------
+
+            seed = 12345 + n;
+            start_time = std::chrono::steady_clock::now();
+
+            Matrix matrix;
+            matrix.reserve(n, n + 1);
+
+            for (int i = 0; i < n; ++i)
+            {
+                double * row_ptr = matrix.appendRow(n + 1);
+
+                for (int j = 0; j <= n; ++j)
+                {
+                    row_ptr[j] = NextValue(seed);
+                }
+            }
+
+            build_matrix_seconds += ElapsedSeconds(start_time);
+
+            //----------------------------------------------------------
+            //  Eliminate.
+            //----------------------------------------------------------
+
+            start_time = std::chrono::steady_clock::now();
+            EliminateRowVectors(n, row_vectors, row_vectors_x_vector);
+            row_vectors_seconds += ElapsedSeconds(start_time);
+
+            start_time = std::chrono::steady_clock::now();
+            matrix.gaussElimination();
+            matrix_seconds += ElapsedSeconds(start_time);
+
+            matrix_x_vector = matrix.getGaussEliminationResults();
+        }
+
+        unsigned int mismatch_count = (row_vectors_x_vector == matrix_x_vector) ? 0 : 1;
+
+        std::cout << "n = " << n
+            << ":  build row vectors " << build_row_vectors_seconds / number_of_repetitions
+            << " s, build aligned " << build_matrix_seconds / number_of_repetitions
+            << " s, eliminate row vectors " << row_vectors_seconds / number_of_repetitions
+            << " s, eliminate aligned " << matrix_seconds / number_of_repetitions
+            << " s, speedup " << row_vectors_seconds / matrix_seconds
+            << (mismatch_count == 0 ? "" : ", solutions differ") << std::endl;
+
+        return mismatch_count;
+    }
+}
+
+int main(int argc, char * argv[])
+{
+    int number_of_repetitions = 3;
+
+    if (argc > 1)
+    {
+        number_of_repetitions = atoi(argv[1]);
+    }
+
+    MatrixKernels::setLevel(MatrixKernels::scalar);
+
+    unsigned int mismatch_count = CheckAssignment();
+    const int size_array[] = { 128, 256, 512, 1000, 1024, 2000, 2048 };
+
+    for (size_t index = 0; index < sizeof(size_array) / sizeof(size_array[0]); ++index)
+    {
+        mismatch_count += RunSize(size_array[index], number_of_repetitions);
+    }
+
+    return mismatch_count == 0 ? 0 : 1;
+}
@@ -0,0 +1,155 @@
+//======================================================================
+//  Strong scaling benchmark for the threads of class Matrix.
+//
+//  One dense system is solved by Matrix::gaussElimination and by
+//  Matrix::gaussSeidel on 1, 2, 4 ... threads up to the number of
+//  hardware threads. The time, the rate, the speedup over one thread
+//  and the parallel efficiency are reported for each thread count.
+//  Each row is updated by one thread in the same order as on a single
+//  thread, so the pivots and the solutions must be the same for every
+//  thread count.
+//
+//  The benchmark is built with the files matrix.cpp,
+//  MatrixKernels.cpp, MatrixThreadPool.cpp and MatrixTaskGraph.cpp.
+//
+//  Usage:
+//
+//      MatrixThreadBenchmark [number_of_equations [largest_thread_count]]
+//======================================================================
+
+#include <stdlib.h>
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include "Matrix.h"
+
+namespace
+{
+    double NextValue(unsigned int & seed)
+    {
+        seed = seed * 1103515245U + 12345U;
+        return (double)((int)((seed >> 16) % 2001) - 1000) / 1000.0;
+    }
+
+    double ElapsedSeconds(std::chrono::steady_clock::time_point start_time)
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+    }
+
+    //------------------------------------------------------------------
+    //  Make a dense system with a large diagonal, so that gaussSeidel,
+    //  which does not pivot, is stable.
+    //------------------------------------------------------------------
+
+    void MakeSystem(int n,
+                    Matrix & matrix)
+    {
+        unsigned int seed = 12345 + n;
+        matrix.reserve(n, n + 1);
+
+        for (int i = 0; i < n; ++i)
+        {
+            double * row_ptr = matrix.appendRow(n + 1);
+
+            for (int j = 0; j <= n; ++j)
+            {
+                row_ptr[j] = NextValue(seed);
+            }
+
+            row_ptr[i] = (double)(n);
+        }
+
+        return;
+    }
+}
+
+int main(int argc, char * argv[])
+{
+    int n = 2048;
+    int largest_thread_count = (int)(std::thread::hardware_concurrency());
+
+    if (argc > 1)
+    {
+        n = atoi(argv[1]);
+    }
+
+    if (argc > 2)
+    {
+        largest_thread_count = atoi(argv[2]);
+    }
+
+    if (largest_thread_count < 1)
+    {
+        largest_thread_count = 1;
+    }
+
+    double flops = 2.0 / 3.0 * n * (double)(n) * n;
+    double single_elimination_seconds = 0.0;
+    double single_seidel_seconds = 0.0;
+    std::vector<int> single_pivot_vector;
+    std::vector<double> single_elimination_x_vector;
+    std::vector<double> single_seidel_x_vector;
+    unsigned int mismatch_count = 0;
+
+    std::cout << "Equations " << n << ", hardware threads "
+        << std::thread::hardware_concurrency() << std::endl;
+
+    for (int thread_count = 1; thread_count <= largest_thread_count; thread_count *= 2)
+    {
+        Matrix elimination_matrix;
+        MakeSystem(n, elimination_matrix);
+        Matrix seidel_matrix(elimination_matrix);
+
+        //--------------------------------------------------------------
+        //  Start the threads before the timing.
+        //--------------------------------------------------------------
+
+        elimination_matrix.setThreadCount(thread_count);
+        seidel_matrix.setThreadCount(thread_count);
+        elimination_matrix.getThreadCount();
+        seidel_matrix.getThreadCount();
+
+        std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+        elimination_matrix.gaussElimination();
+        double elimination_seconds = ElapsedSeconds(start_time);
+
+        start_time = std::chrono::steady_clock::now();
+        seidel_matrix.gaussSeidel();
+        double seidel_seconds = ElapsedSeconds(start_time);
+
+        if (thread_count == 1)
+        {
+            single_elimination_seconds = elimination_seconds;
+            single_seidel_seconds = seidel_seconds;
+            single_pivot_vector = elimination_matrix.getPivotRows();
+            single_elimination_x_vector = elimination_matrix.getGaussEliminationResults();
+            single_seidel_x_vector = seidel_matrix.getGaussSeidelResults();
+        }
+
+        bool same_flag = (elimination_matrix.getPivotRows() == single_pivot_vector)
+            && (elimination_matrix.getGaussEliminationResults() == single_elimination_x_vector)
+            && (seidel_matrix.getGaussSeidelResults() == single_seidel_x_vector);
+
+        if (! same_flag)
+        {
+            ++mismatch_count;
+        }
+
+        double elimination_speedup = single_elimination_seconds / elimination_seconds;
+        double seidel_speedup = single_seidel_seconds / seidel_seconds;
+
+        std::cout << "Threads " << thread_count
+            << ":  gaussElimination " << elimination_seconds
+            << " s, " << flops / elimination_seconds * 1.0E-9
+            << " GFLOP/s, speedup " << elimination_speedup
+            << ", efficiency " << elimination_speedup / thread_count
+            << ", gaussSeidel " << seidel_seconds
+            << " s, " << flops / seidel_seconds * 1.0E-9
+            << " GFLOP/s, speedup " << seidel_speedup
+            << ", efficiency " << seidel_speedup / thread_count
+            << (same_flag ? "" : ", results differ") << std::endl;
+    }
+
+    return mismatch_count == 0 ? 0 : 1;
+}
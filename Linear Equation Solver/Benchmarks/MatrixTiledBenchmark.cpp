@@ -0,0 +1,171 @@
+//======================================================================
+//  Benchmark for the tiled LU of class Matrix.
+//
+//  One dense system is solved by Matrix::gaussElimination, which
+//  synchronizes the threads at every pivot, and by Matrix::
+//  gaussEliminationTiled with several tile sizes, which runs panel
+//  factorizations, triangular solves and updates of tiles as tasks of
+//  a dependency graph. For each tile size the time, the rate, the
+//  thread utilization, the number of tasks stolen by idle threads and
+//  the number, total time, mean time and longest time of each kind of
+//  task are reported. Both eliminations must choose the same pivot
+//  rows, and the solutions must agree to within a relative difference
+//  of 1.0E-8.
+//
+//  The benchmark is built with the files matrix.cpp,
+//  MatrixKernels.cpp, MatrixThreadPool.cpp and MatrixTaskGraph.cpp.
+//
+//  Usage:
+//
+//      MatrixTiledBenchmark [number_of_equations [number_of_threads]]
+//======================================================================
+
+#include <stdlib.h>
+#include <math.h>
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include "Matrix.h"
+
+namespace
+{
+    const char * f_TASK_NAME_ARRAY[] = { "panel", "solve", "update" };
+
+    double NextValue(unsigned int & seed)
+    {
+        seed = seed * 1103515245U + 12345U;
+        return (double)((int)((seed >> 16) % 2001) - 1000) / 1000.0;
+    }
+
+    double ElapsedSeconds(std::chrono::steady_clock::time_point start_time)
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+    }
+
+    void MakeSystem(int n,
+                    Matrix & matrix)
+    {
+        unsigned int seed = 12345 + n;
+        matrix.reserve(n, n + 1);
+
+        for (int i = 0; i < n; ++i)
+        {
+            double * row_ptr = matrix.appendRow(n + 1);
+
+            for (int j = 0; j <= n; ++j)
+            {
+                row_ptr[j] = NextValue(seed);
+            }
+        }
+
+        return;
+    }
+
+    //------------------------------------------------------------------
+    //  Solve with one tile size and return the number of results that
+    //  differ from gaussElimination.
+    //------------------------------------------------------------------
+
+    unsigned int RunTileSize(int n,
+                             int number_of_threads,
+                             int tile_size,
+                             const std::vector<int> & pivot_vector,
+                             const std::vector<double> & x_vector)
+    {
+        double flops = 2.0 / 3.0 * n * (double)(n) * n;
+        Matrix matrix;
+        MakeSystem(n, matrix);
+        matrix.setThreadCount(number_of_threads);
+        matrix.getThreadCount();
+
+        std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+        matrix.gaussEliminationTiled(tile_size);
+        double seconds = ElapsedSeconds(start_time);
+
+        //--------------------------------------------------------------
+        //  Compare the solutions.
+        //--------------------------------------------------------------
+
+        const std::vector<double> & tiled_x_vector = matrix.getGaussEliminationResults();
+        double x_norm = 0.0;
+        double difference_norm = 0.0;
+
+        for (int i = 0; i < n; ++i)
+        {
+            x_norm = (fabs(x_vector[i]) > x_norm) ? fabs(x_vector[i]) : x_norm;
+            difference_norm = (fabs(x_vector[i] - tiled_x_vector[i]) > difference_norm)
+                ? fabs(x_vector[i] - tiled_x_vector[i]) : difference_norm;
+        }
+
+        bool same_pivots_flag = (matrix.getPivotRows() == pivot_vector);
+        unsigned int mismatch_count = ((! same_pivots_flag) || (difference_norm > 1.0E-8 * x_norm)) ? 1 : 0;
+        const MatrixTaskReport & report = matrix.getTaskReport();
+
+        std::cout << "Tile size " << tile_size
+            << ":  " << seconds << " s, " << flops / seconds * 1.0E-9
+            << " GFLOP/s, " << report.tasks << " tasks, utilization " << report.utilization
+            << ", steals " << report.steals
+            << (same_pivots_flag ? ", same pivots" : ", pivots differ")
+            << ", difference " << difference_norm / x_norm << std::endl;
+
+        for (size_t kind = 0; kind < report.kinds.size(); ++kind)
+        {
+            const MatrixTaskTimes & times = report.kinds[kind];
+
+            std::cout << "    " << f_TASK_NAME_ARRAY[kind]
+                << ":  " << times.count << " tasks, total " << times.seconds
+                << " s, mean " << (times.count > 0 ? times.seconds / times.count : 0.0)
+                << " s, longest " << times.longest << " s" << std::endl;
+        }
+
+        return mismatch_count;
+    }
+}
+
+int main(int argc, char * argv[])
+{
+    int n = 2048;
+    int number_of_threads = 0;
+
+    if (argc > 1)
+    {
+        n = atoi(argv[1]);
+    }
+
+    if (argc > 2)
+    {
+        number_of_threads = atoi(argv[2]);
+    }
+
+    //------------------------------------------------------------------
+    //  The reference, with the threads synchronized at every pivot.
+    //------------------------------------------------------------------
+
+    double flops = 2.0 / 3.0 * n * (double)(n) * n;
+    Matrix matrix;
+    MakeSystem(n, matrix);
+    matrix.setThreadCount(number_of_threads);
+
+    std::cout << "Equations " << n << ", threads " << matrix.getThreadCount() << std::endl;
+
+    std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+    matrix.gaussElimination();
+    double seconds = ElapsedSeconds(start_time);
+
+    std::cout << "gaussElimination:  " << seconds << " s, "
+        << flops / seconds * 1.0E-9 << " GFLOP/s" << std::endl;
+
+    unsigned int mismatch_count = 0;
+    const int tile_size_array[] = { 32, 64, 128, 256 };
+
+    for (size_t index = 0; index < sizeof(tile_size_array) / sizeof(tile_size_array[0]); ++index)
+    {
+        mismatch_count += RunTileSize(n,
+                                      number_of_threads,
+                                      tile_size_array[index],
+                                      matrix.getPivotRows(),
+                                      matrix.getGaussEliminationResults());
+    }
+
+    return mismatch_count == 0 ? 0 : 1;
+}
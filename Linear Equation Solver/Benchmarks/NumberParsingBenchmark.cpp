@@ -0,0 +1,226 @@
+//======================================================================
+//  Microbenchmark for numeric literal parsing.
+//
+//  This compares the previous parser path, which appended each
+//  character of a number to a CharString, appended the '^' exponent
+//  as "E<exponent>", and then called atof(), against the DecimalNumber
+//  scanner that the parser now uses. Both paths must produce
+//  bit-identical values.
+//
+//  Usage:
+//
+//      NumberParsingBenchmark [number_of_literals]
+//======================================================================
+
+#include <stdlib.h>
+#include <string.h>
+#include <iostream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include "CharString.h"
+#include "DecimalNumber.h"
+
+namespace
+{
+    //------------------------------------------------------------------
+    //  Make a literal in the parser syntax, for example "12.5^-03".
+    //------------------------------------------------------------------
+
+    std::string MakeLiteral(unsigned int & seed)
+    {
+        std::string literal;
+
+        seed = seed * 1103515245U + 12345U;
+        unsigned int digit_count = 1 + (seed >> 16) % 20;
+        seed = seed * 1103515245U + 12345U;
+        unsigned int point_position = (seed >> 16) % (digit_count + 1);
+
+        for (unsigned int i = 0; i < digit_count; ++i)
+        {
+            if ((i == point_position) && (i != 0))
+            {
+                literal += '.';
+            }
+
+            seed = seed * 1103515245U + 12345U;
+            literal += (char)('0' + (seed >> 16) % 10);
+        }
+
+        seed = seed * 1103515245U + 12345U;
+
+        if ((seed >> 16) % 3 == 0)
+        {
+            literal += '^';
+
+            seed = seed * 1103515245U + 12345U;
+
+            if ((seed >> 16) % 2 == 0)
+            {
+                literal += '-';
+            }
+
+            seed = seed * 1103515245U + 12345U;
+            unsigned int exponent = (seed >> 16) % 100;
+            literal += (char)('0' + exponent / 10);
+            literal += (char)('0' + exponent % 10);
+        }
+
+        return literal;
+    }
+
+    //------------------------------------------------------------------
+    //  The previous parser path.
+    //------------------------------------------------------------------
+
+    double ParseWithCharString(const std::string & literal)
+    {
+        CharString number_string;
+        CharString exponent_string;
+        bool negative_exponent_flag = false;
+        size_t position = 0;
+
+        while ((position < literal.size()) && (literal[position] != '^'))
+        {
+            number_string += literal[position++];
+        }
+
+        if (position < literal.size())
+        {
+            ++position;
+
+            if (literal[position] == '-')
+            {
+                negative_exponent_flag = true;
+                ++position;
+            }
+
+            while (position < literal.size())
+            {
+                exponent_string += literal[position++];
+            }
+
+            number_string += 'E';
+
+            if (negative_exponent_flag)
+            {
+                number_string += '-';
+            }
+
+            number_string += exponent_string;
+        }
+
+        return atof(number_string.CString());
+    }
+
+    //------------------------------------------------------------------
+    //  The DecimalNumber scanner path.
+    //------------------------------------------------------------------
+
+    double ParseWithDecimalNumber(const std::string & literal)
+    {
+        DecimalNumber number;
+        size_t position = 0;
+
+        while ((position < literal.size()) && (literal[position] != '^'))
+        {
+            char c = literal[position++];
+
+            if (c == '.')
+            {
+                number.AppendDecimalPoint();
+            }
+            else
+            {
+                number.AppendDigit(c);
+            }
+        }
+
+        if (position < literal.size())
+        {
+            ++position;
+
+            bool negative_exponent_flag = literal[position] == '-';
+
+            if (negative_exponent_flag)
+            {
+                ++position;
+            }
+
+            DecimalNumber exponent;
+
+            while (position < literal.size())
+            {
+                exponent.AppendDigit(literal[position++]);
+            }
+
+            int exponent_value = exponent.GetIntegerValue();
+            number.SetExponent(negative_exponent_flag ? - exponent_value : exponent_value);
+        }
+
+        return number.ToDouble();
+    }
+}
+
+int main(int argc, char * argv[])
+{
+    unsigned int number_of_literals = 1000000;
+
+    if (argc > 1)
+    {
+        number_of_literals = (unsigned int)(atoi(argv[1]));
+    }
+
+    std::vector<std::string> literal_vector(number_of_literals);
+    unsigned int seed = 12345;
+
+    for (unsigned int i = 0; i < number_of_literals; ++i)
+    {
+        literal_vector[i] = MakeLiteral(seed);
+    }
+
+    std::vector<double> old_value_vector(number_of_literals);
+    std::vector<double> new_value_vector(number_of_literals);
+
+    std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+
+    for (unsigned int i = 0; i < number_of_literals; ++i)
+    {
+        old_value_vector[i] = ParseWithCharString(literal_vector[i]);
+    }
+
+    std::chrono::steady_clock::time_point middle_time = std::chrono::steady_clock::now();
+
+    for (unsigned int i = 0; i < number_of_literals; ++i)
+    {
+        new_value_vector[i] = ParseWithDecimalNumber(literal_vector[i]);
+    }
+
+    std::chrono::steady_clock::time_point end_time = std::chrono::steady_clock::now();
+
+    unsigned int mismatch_count = 0;
+
+    for (unsigned int i = 0; i < number_of_literals; ++i)
+    {
+        if (memcmp(&old_value_vector[i], &new_value_vector[i], sizeof(double)) != 0)
+        {
+            if (mismatch_count < 10)
+            {
+                std::cout << "Mismatch for " << literal_vector[i] << std::endl;
+            }
+
+            ++mismatch_count;
+        }
+    }
+
+    double old_seconds = std::chrono::duration<double>(middle_time - start_time).count();
+    double new_seconds = std::chrono::duration<double>(end_time - middle_time).count();
+
+    std::cout << "Literals:              " << number_of_literals << std::endl;
+    std::cout << "CharString + atof:     " << old_seconds * 1.0e9 / number_of_literals << " ns/literal" << std::endl;
+    std::cout << "DecimalNumber scanner: " << new_seconds * 1.0e9 / number_of_literals << " ns/literal" << std::endl;
+    std::cout << "Speedup:               " << old_seconds / new_seconds << std::endl;
+    std::cout << "Mismatches:            " << mismatch_count << std::endl;
+
+    return mismatch_count == 0 ? 0 : 1;
+}
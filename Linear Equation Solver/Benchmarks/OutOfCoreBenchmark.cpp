@@ -0,0 +1,184 @@
+//======================================================================
+//  Benchmark for the out of core dense solver.
+//
+//  A dense system is solved in memory by LinearSystemSolver and then
+//  by OutOfCoreSolver with memory budgets from the size of the whole
+//  augmented matrix down to a small fraction of it. The time, the
+//  tile size, the peak memory and the number of bytes read from and
+//  written to the tile file are reported for each budget. Both
+//  solutions must agree to within a relative difference of 1.0E-8.
+//
+//  Usage:
+//
+//      OutOfCoreBenchmark [number_of_equations]
+//======================================================================
+
+#include <stdlib.h>
+#include <math.h>
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include "CompressedSparseMatrix.h"
+#include "FrozenSparseMatrix.h"
+#include "LinearSystemSolver.h"
+#include "OutOfCoreSolver.h"
+
+namespace
+{
+    const char * f_TILE_FILE_NAME = "OutOfCoreBenchmark.tiles";
+
+    double NextValue(unsigned int & seed)
+    {
+        seed = seed * 1103515245U + 12345U;
+        return (double)((int)((seed >> 16) % 2001) - 1000) / 1000.0;
+    }
+
+    //------------------------------------------------------------------
+    //  Solve the system in memory.
+    //------------------------------------------------------------------
+
+    double SolveInMemory(int n,
+                         const std::vector<double> & augmented_vector,
+                         std::vector<double> & x_vector)
+    {
+        std::vector<size_t> row_start_vector(1, 0);
+        std::vector<int> column_index_vector;
+        std::vector<double> value_vector;
+        std::vector<double> b_vector(n);
+
+        for (int i = 0; i < n; ++i)
+        {
+            for (int j = 0; j < n; ++j)
+            {
+                column_index_vector.push_back(j);
+                value_vector.push_back(augmented_vector[(size_t)(i) * (n + 1) + j]);
+            }
+
+            row_start_vector.push_back(column_index_vector.size());
+            b_vector[i] = augmented_vector[(size_t)(i) * (n + 1) + n];
+        }
+
+        CompressedSparseMatrix a_csr_matrix;
+        FrozenSparseMatrix a_matrix;
+
+        a_csr_matrix.Assign(n, n, row_start_vector, column_index_vector, value_vector);
+        a_matrix.Freeze(a_csr_matrix);
+
+        std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+
+        LinearSystemSolver solver;
+        solver.Solve(n, a_matrix, b_vector, x_vector);
+
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+    }
+
+    //------------------------------------------------------------------
+    //  Solve the system out of core and return the number of solutions
+    //  that differ from the solution in memory.
+    //------------------------------------------------------------------
+
+    unsigned int SolveOutOfCore(int n,
+                                const std::vector<double> & augmented_vector,
+                                size_t memory_budget,
+                                const std::vector<double> & reference_x_vector)
+    {
+        OutOfCoreSolver solver;
+        std::vector<double> x_vector;
+
+        solver.SetMemoryBudget(memory_budget);
+
+        std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+
+        OutOfCoreSolver::Status_T status = solver.Create(n, 1, f_TILE_FILE_NAME);
+
+        for (int i = 0; (i < n) && (status == OutOfCoreSolver::SUCCESS); ++i)
+        {
+            status = solver.AppendRow(&augmented_vector[(size_t)(i) * (n + 1)]);
+        }
+
+        if (status == OutOfCoreSolver::SUCCESS)
+        {
+            status = solver.Solve(x_vector);
+        }
+
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+
+        if (status != OutOfCoreSolver::SUCCESS)
+        {
+            std::cout << "Budget " << memory_budget << " bytes:  "
+                << OutOfCoreSolver::GetStatusString(status) << std::endl;
+            return 1;
+        }
+
+        //--------------------------------------------------------------
+        //  Compare the solutions.
+        //--------------------------------------------------------------
+
+        double x_norm = 0.0;
+        double difference_norm = 0.0;
+
+        for (int i = 0; i < n; ++i)
+        {
+            x_norm = (fabs(reference_x_vector[i]) > x_norm) ? fabs(reference_x_vector[i]) : x_norm;
+            difference_norm = (fabs(reference_x_vector[i] - x_vector[i]) > difference_norm)
+                ? fabs(reference_x_vector[i] - x_vector[i]) : difference_norm;
+        }
+
+        unsigned int mismatch_count = (difference_norm > 1.0E-8 * x_norm) ? 1 : 0;
+
+        std::cout << "Budget " << memory_budget << " bytes:  "
+            << seconds << " s, tile size " << solver.GetTileSize()
+            << ", peak memory " << solver.GetPeakMemory()
+            << ", read " << solver.GetBytesRead()
+            << ", written " << solver.GetBytesWritten()
+            << ", difference " << difference_norm / x_norm << std::endl;
+
+        return mismatch_count;
+    }
+}
+
+int main(int argc, char * argv[])
+{
+    int n = 1200;
+
+    if (argc > 1)
+    {
+        n = atoi(argv[1]);
+    }
+
+    //------------------------------------------------------------------
+    //  Make a dense system with a large diagonal, stored by rows with
+    //  the right side after the coefficients of each row.
+    //------------------------------------------------------------------
+
+    std::vector<double> augmented_vector((size_t)(n) * (n + 1));
+    unsigned int seed = 12345;
+
+    for (int i = 0; i < n; ++i)
+    {
+        for (int j = 0; j <= n; ++j)
+        {
+            augmented_vector[(size_t)(i) * (n + 1) + j] = (i == j) ? (double)(n) : NextValue(seed);
+        }
+    }
+
+    std::vector<double> reference_x_vector;
+    double in_memory_seconds = SolveInMemory(n, augmented_vector, reference_x_vector);
+    size_t matrix_bytes = augmented_vector.size() * sizeof(double);
+
+    std::cout << "Equations " << n << ", augmented matrix " << matrix_bytes
+        << " bytes, in memory " << in_memory_seconds << " s" << std::endl;
+
+    unsigned int mismatch_count = 0;
+    const size_t divisor_array[] = { 1, 4, 16, 64 };
+
+    for (size_t index = 0; index < sizeof(divisor_array) / sizeof(divisor_array[0]); ++index)
+    {
+        mismatch_count += SolveOutOfCore(n,
+                                         augmented_vector,
+                                         3 * matrix_bytes / divisor_array[index],
+                                         reference_x_vector);
+    }
+
+    return mismatch_count == 0 ? 0 : 1;
+}
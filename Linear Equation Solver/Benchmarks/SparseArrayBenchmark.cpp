@@ -0,0 +1,232 @@
+//======================================================================
+//  Benchmark for the SparseArray storage backends.
+//
+//  This compares the std::map based SparseArray against the sorted
+//  vector based FlatSparseArray through the proxy interface. Build
+//  this benchmark without SPARSE_ARRAY_FLAT_STORAGE defined, so that
+//  SparseArray uses the std::map backend.
+//
+//  The workloads are:
+//
+//    Random insert     a[key] = a[key] + value for random keys.
+//
+//    Row insert        The same, but the keys are generated one row
+//                      at a time with random columns in each row,
+//                      which is the order that the parser produces.
+//
+//    Read              Random reads of a filled array, half of which
+//                      are for keys that are not stored.
+//
+//  Usage:
+//
+//      SparseArrayBenchmark [number_of_elements] [number_of_reads]
+//======================================================================
+
+#include <stdlib.h>
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include "SparseArray.h"
+#include "FlatSparseArray.h"
+
+namespace
+{
+    //------------------------------------------------------------------
+    //  Generate random keys, or keys one row at a time.
+    //------------------------------------------------------------------
+
+    void MakeKeys(int number_of_keys,
+                  bool row_order_flag,
+                  std::vector<int> & key_vector)
+    {
+        const int row_length = 64;
+        unsigned int seed = 12345;
+
+        key_vector.resize(number_of_keys);
+
+        for (int i = 0; i < number_of_keys; ++i)
+        {
+            seed = seed * 1103515245U + 12345U;
+
+            if (row_order_flag)
+            {
+                int row = i / 8;
+                key_vector[i] = row * row_length + (int)((seed >> 16) % row_length);
+            }
+            else
+            {
+                key_vector[i] = (int)((seed >> 1) % (unsigned int)(number_of_keys * 4));
+            }
+        }
+
+        return;
+    }
+
+    //------------------------------------------------------------------
+    //  Add a value at each key through the proxy.
+    //------------------------------------------------------------------
+
+    template <typename T_ARRAY>
+
+    double TimeInserts(T_ARRAY & sparse_array,
+                       const std::vector<int> & key_vector)
+    {
+        std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+
+        for (size_t i = 0; i < key_vector.size(); ++i)
+        {
+            sparse_array[key_vector[i]] = sparse_array[key_vector[i]] + 1.0;
+        }
+
+        std::chrono::steady_clock::time_point end_time = std::chrono::steady_clock::now();
+
+        return std::chrono::duration<double>(end_time - start_time).count();
+    }
+
+    //------------------------------------------------------------------
+    //  Read a value at each key through the proxy.
+    //------------------------------------------------------------------
+
+    template <typename T_ARRAY>
+
+    double TimeReads(const T_ARRAY & sparse_array,
+                     const std::vector<int> & key_vector,
+                     double & sum)
+    {
+        std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+
+        sum = 0.0;
+
+        for (size_t i = 0; i < key_vector.size(); ++i)
+        {
+            double value = sparse_array[key_vector[i]];
+            sum += value;
+        }
+
+        std::chrono::steady_clock::time_point end_time = std::chrono::steady_clock::now();
+
+        return std::chrono::duration<double>(end_time - start_time).count();
+    }
+
+    //------------------------------------------------------------------
+    //  Test that both arrays hold the same elements in the same order.
+    //------------------------------------------------------------------
+
+    bool IsSame(const SparseArray<int, double> & map_array,
+                const FlatSparseArray<int, double> & flat_array)
+    {
+        if (map_array.size() != flat_array.size())
+        {
+            return false;
+        }
+
+        SparseArray<int, double>::const_iterator map_iter = map_array.begin();
+        FlatSparseArray<int, double>::const_iterator flat_iter = flat_array.begin();
+
+        for (; map_iter != map_array.end(); ++map_iter, ++flat_iter)
+        {
+            if (((*map_iter).first != (*flat_iter).first)
+                || ((*map_iter).second != (*flat_iter).second))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    //------------------------------------------------------------------
+    //  Report one workload.
+    //------------------------------------------------------------------
+
+    void Report(const char * name_ptr,
+                size_t number_of_operations,
+                double map_seconds,
+                double flat_seconds)
+    {
+        std::cout << name_ptr << std::endl;
+        std::cout << "    std::map backend:  " << map_seconds * 1.0e9 / number_of_operations << " ns/op" << std::endl;
+        std::cout << "    Flat backend:      " << flat_seconds * 1.0e9 / number_of_operations << " ns/op" << std::endl;
+        std::cout << "    Speedup:           " << map_seconds / flat_seconds << std::endl;
+        return;
+    }
+}
+
+int main(int argc, char * argv[])
+{
+    int number_of_elements = 1000000;
+    int number_of_reads = 4000000;
+
+    if (argc > 1)
+    {
+        number_of_elements = atoi(argv[1]);
+    }
+
+    if (argc > 2)
+    {
+        number_of_reads = atoi(argv[2]);
+    }
+
+    unsigned int mismatch_count = 0;
+    std::vector<int> key_vector;
+
+    //------------------------------------------------------------------
+    //  Random insert.
+    //------------------------------------------------------------------
+
+    MakeKeys(number_of_elements, false, key_vector);
+
+    SparseArray<int, double> map_array;
+    FlatSparseArray<int, double> flat_array;
+
+    double map_seconds = TimeInserts(map_array, key_vector);
+    double flat_seconds = TimeInserts(flat_array, key_vector);
+
+    Report("Random insert", key_vector.size(), map_seconds, flat_seconds);
+
+    mismatch_count += IsSame(map_array, flat_array) ? 0 : 1;
+
+    //------------------------------------------------------------------
+    //  Read. Half of the keys are not stored.
+    //------------------------------------------------------------------
+
+    std::vector<int> read_key_vector(number_of_reads);
+    unsigned int seed = 54321;
+
+    for (int i = 0; i < number_of_reads; ++i)
+    {
+        seed = seed * 1103515245U + 12345U;
+        int key = key_vector[(seed >> 4) % key_vector.size()];
+        read_key_vector[i] = ((seed >> 2) & 1) ? key : -1 - key;
+    }
+
+    double map_sum = 0.0;
+    double flat_sum = 0.0;
+
+    map_seconds = TimeReads(map_array, read_key_vector, map_sum);
+    flat_seconds = TimeReads(flat_array, read_key_vector, flat_sum);
+
+    Report("Read", read_key_vector.size(), map_seconds, flat_seconds);
+
+    mismatch_count += (map_sum == flat_sum) ? 0 : 1;
+
+    //------------------------------------------------------------------
+    //  Row insert.
+    //------------------------------------------------------------------
+
+    MakeKeys(number_of_elements, true, key_vector);
+
+    map_array.clear();
+    flat_array.clear();
+
+    map_seconds = TimeInserts(map_array, key_vector);
+    flat_seconds = TimeInserts(flat_array, key_vector);
+
+    Report("Row insert", key_vector.size(), map_seconds, flat_seconds);
+
+    mismatch_count += IsSame(map_array, flat_array) ? 0 : 1;
+
+    std::cout << "Mismatches:            " << mismatch_count << std::endl;
+
+    return mismatch_count == 0 ? 0 : 1;
+}
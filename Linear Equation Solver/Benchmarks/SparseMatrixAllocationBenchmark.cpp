@@ -0,0 +1,127 @@
+//======================================================================
+//  Benchmark for the SparseArray node allocator.
+//
+//  This builds a SparseMatrix one element at a time through the
+//  proxy, in the order that the parser produces the elements, and
+//  then destroys it. The build time, the destroy time and the peak
+//  resident set size of the process are reported.
+//
+//  Run the benchmark once for each allocator, because the peak
+//  resident set size is for the whole process.
+//
+//  Usage:
+//
+//      SparseMatrixAllocationBenchmark standard|arena [number_of_nonzeros]
+//======================================================================
+
+#include <stdlib.h>
+#include <string.h>
+#include <iostream>
+#include <memory>
+#include <chrono>
+#include "SparseArray.h"
+#include "DoubleIndex.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace
+{
+    //------------------------------------------------------------------
+    //  Return the peak resident set size of the process in megabytes.
+    //------------------------------------------------------------------
+
+    double GetPeakResidentSetSize()
+    {
+#ifdef _WIN32
+        PROCESS_MEMORY_COUNTERS memory_counters;
+        GetProcessMemoryInfo(GetCurrentProcess(), &memory_counters, sizeof(memory_counters));
+        return (double)(memory_counters.PeakWorkingSetSize) / (1024.0 * 1024.0);
+#else
+        struct rusage resource_usage;
+        getrusage(RUSAGE_SELF, &resource_usage);
+#ifdef __APPLE__
+        return (double)(resource_usage.ru_maxrss) / (1024.0 * 1024.0);
+#else
+        return (double)(resource_usage.ru_maxrss) / 1024.0;
+#endif
+#endif
+    }
+
+    //------------------------------------------------------------------
+    //  Build and destroy a matrix with the given allocator.
+    //------------------------------------------------------------------
+
+    template <typename T_ALLOCATOR>
+
+    void RunBenchmark(long long number_of_nonzeros)
+    {
+        typedef SparseArray<DoubleIndex, double, T_ALLOCATOR> Matrix_T;
+
+        const int row_length = 10;
+        unsigned int seed = 12345;
+
+        std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+
+        Matrix_T * a_matrix_ptr = new Matrix_T;
+        Matrix_T & a_matrix = *a_matrix_ptr;
+        int number_of_rows = (int)(number_of_nonzeros / row_length);
+
+        for (int row = 0; row < number_of_rows; ++row)
+        {
+            for (int k = 0; k < row_length; ++k)
+            {
+                seed = seed * 1103515245U + 12345U;
+                int column = (int)((seed >> 4) % (unsigned int)(number_of_rows));
+                a_matrix[DoubleIndex(row, column)] = a_matrix[DoubleIndex(row, column)] + 1.0;
+            }
+        }
+
+        std::chrono::steady_clock::time_point middle_time = std::chrono::steady_clock::now();
+
+        size_t number_of_elements = a_matrix.size();
+        delete a_matrix_ptr;
+
+        std::chrono::steady_clock::time_point end_time = std::chrono::steady_clock::now();
+
+        std::cout << "Elements:              " << number_of_elements << std::endl;
+        std::cout << "Build time:            " << std::chrono::duration<double>(middle_time - start_time).count() << " s" << std::endl;
+        std::cout << "Destroy time:          " << std::chrono::duration<double>(end_time - middle_time).count() << " s" << std::endl;
+        std::cout << "Peak RSS:              " << GetPeakResidentSetSize() << " MB" << std::endl;
+
+        return;
+    }
+}
+
+int main(int argc, char * argv[])
+{
+    bool arena_flag = true;
+    long long number_of_nonzeros = 10000000;
+
+    if (argc > 1)
+    {
+        arena_flag = strcmp(argv[1], "standard") != 0;
+    }
+
+    if (argc > 2)
+    {
+        number_of_nonzeros = atoll(argv[2]);
+    }
+
+    if (arena_flag)
+    {
+        std::cout << "Allocator:             ArenaAllocator" << std::endl;
+        RunBenchmark< ArenaAllocator< std::pair<const DoubleIndex, double> > >(number_of_nonzeros);
+    }
+    else
+    {
+        std::cout << "Allocator:             std::allocator" << std::endl;
+        RunBenchmark< std::allocator< std::pair<const DoubleIndex, double> > >(number_of_nonzeros);
+    }
+
+    return 0;
+}
@@ -0,0 +1,376 @@
+#include <algorithm>
+#include "BlockTriangularForm.h"
+
+//======================================================================
+//  Constructor: BlockTriangularForm::BlockTriangularForm
+//======================================================================
+
+BlockTriangularForm::BlockTriangularForm()
+{
+}
+
+//======================================================================
+//  Destructor: BlockTriangularForm::~BlockTriangularForm
+//======================================================================
+
+BlockTriangularForm::~BlockTriangularForm()
+{
+}
+
+//======================================================================
+//  Member Function: BlockTriangularForm::Compute
+//
+//  Abstract:
+//
+//    This function computes the block triangular form.
+//
+//
+//  Input:
+//
+//    a_matrix              The matrix. Only the elements in the first
+//                          n rows and the first n columns are used.
+//
+//    n                     The size of the matrix.
+//
+//  Output:
+//
+//    This function returns a value of type 'bool' that is false if
+//    the matrix is structurally singular, in which case there is no
+//    block triangular form.
+//
+//======================================================================
+
+bool BlockTriangularForm::Compute(const FrozenSparseMatrix & a_matrix, int n)
+{
+    m_row_order_vector.clear();
+    m_column_order_vector.clear();
+    m_block_start_vector.assign(1, 0);
+
+    if (! FindMaximumTransversal(a_matrix, n))
+    {
+        return false;
+    }
+
+    FindStrongComponents(a_matrix, n);
+
+    return true;
+}
+
+//======================================================================
+//  Member Function: BlockTriangularForm::GetNumberOfBlocks
+//======================================================================
+
+int BlockTriangularForm::GetNumberOfBlocks() const
+{
+    return (int)(m_block_start_vector.size()) - 1;
+}
+
+//======================================================================
+//  Member Function: BlockTriangularForm::GetRowOrder
+//======================================================================
+
+const std::vector<int> & BlockTriangularForm::GetRowOrder() const
+{
+    return m_row_order_vector;
+}
+
+//======================================================================
+//  Member Function: BlockTriangularForm::GetColumnOrder
+//======================================================================
+
+const std::vector<int> & BlockTriangularForm::GetColumnOrder() const
+{
+    return m_column_order_vector;
+}
+
+//======================================================================
+//  Member Function: BlockTriangularForm::GetBlockStart
+//======================================================================
+
+const std::vector<int> & BlockTriangularForm::GetBlockStart() const
+{
+    return m_block_start_vector;
+}
+
+//======================================================================
+//  Member Function: BlockTriangularForm::FindMaximumTransversal
+//
+//  Abstract:
+//
+//    This function matches each column to a row. For each column in
+//    turn, a depth-first search looks for an augmenting path, which
+//    goes from the column through a row to the column matched to that
+//    row, and so on, until it reaches a column that has an unmatched
+//    row. Each row is visited at most once per search. The matches
+//    along the path are then shifted by one, which matches the new
+//    column and keeps every other column matched.
+//
+//    The cheap search for an unmatched row in a column continues from
+//    where it stopped the last time, because a row that has been
+//    matched stays matched.
+//
+//
+//  Input:
+//
+//    a_matrix              The matrix.
+//
+//    n                     The size of the matrix.
+//
+//  Output:
+//
+//    This function returns a value of type 'bool' that is false if a
+//    column could not be matched.
+//
+//======================================================================
+
+bool BlockTriangularForm::FindMaximumTransversal(const FrozenSparseMatrix & a_matrix, int n)
+{
+    int number_of_columns = std::min(n, a_matrix.GetNumberOfColumns());
+
+    if (number_of_columns < n)
+    {
+        return false;
+    }
+
+    std::vector<int> row_match_vector(n, -1);
+    std::vector<int> row_visited_vector(n, -1);
+    std::vector<size_t> cheap_position_vector(n, 0);
+    std::vector<int> column_stack_vector(n);
+    std::vector<size_t> position_stack_vector(n);
+    std::vector<int> path_row_vector(n);
+
+    m_column_match_vector.assign(n, -1);
+
+    for (int start_column = 0; start_column < n; ++start_column)
+    {
+        int top = 0;
+        int free_row = -1;
+
+        column_stack_vector[0] = start_column;
+        position_stack_vector[0] = 0;
+
+        while ((top >= 0) && (free_row == -1))
+        {
+            int column = column_stack_vector[top];
+            SparseSlice column_slice = a_matrix.GetColumn(column);
+            size_t size = column_slice.GetSize();
+
+            //----------------------------------------------------------
+            //  Look for an unmatched row in the column.
+            //----------------------------------------------------------
+
+            size_t & cheap_position = cheap_position_vector[column];
+
+            for (; cheap_position < size; ++cheap_position)
+            {
+                int row = column_slice.GetIndex(cheap_position);
+
+                if ((row < n) && (row_match_vector[row] == -1))
+                {
+                    free_row = row;
+                    break;
+                }
+            }
+
+            if (free_row != -1)
+            {
+                break;
+            }
+
+            //----------------------------------------------------------
+            //  Continue the search through the next row of the column
+            //  that has not been visited in this search.
+            //----------------------------------------------------------
+
+            size_t & position = position_stack_vector[top];
+            int next_column = -1;
+
+            for (; position < size; ++position)
+            {
+                int row = column_slice.GetIndex(position);
+
+                if ((row < n) && (row_visited_vector[row] != start_column))
+                {
+                    row_visited_vector[row] = start_column;
+                    path_row_vector[top] = row;
+                    next_column = row_match_vector[row];
+                    ++position;
+                    break;
+                }
+            }
+
+            if (next_column == -1)
+            {
+                --top;
+            }
+            else
+            {
+                ++top;
+                column_stack_vector[top] = next_column;
+                position_stack_vector[top] = 0;
+            }
+        }
+
+        if (free_row == -1)
+        {
+            return false;
+        }
+
+        //--------------------------------------------------------------
+        //  Shift the matches along the augmenting path.
+        //--------------------------------------------------------------
+
+        int row = free_row;
+
+        for (; top >= 0; --top)
+        {
+            int column = column_stack_vector[top];
+            m_column_match_vector[column] = row;
+            row_match_vector[row] = column;
+
+            if (top > 0)
+            {
+                row = path_row_vector[top - 1];
+            }
+        }
+    }
+
+    return true;
+}
+
+//======================================================================
+//  Member Function: BlockTriangularForm::FindStrongComponents
+//
+//  Abstract:
+//
+//    This function finds the strongly connected components of the
+//    column graph with Tarjan's algorithm and stores the orderings.
+//
+//
+//  Input:
+//
+//    a_matrix              The matrix.
+//
+//    n                     The size of the matrix.
+//
+//  Output:
+//
+//    This function has no return value.
+//
+//======================================================================
+
+void BlockTriangularForm::FindStrongComponents(const FrozenSparseMatrix & a_matrix, int n)
+{
+    //------------------------------------------------------------------
+    //  The order of a column is the order in which it was visited, -1
+    //  if it has not been visited, or n once its component is found.
+    //------------------------------------------------------------------
+
+    int done_order = n;
+    std::vector<int> order_vector(n, -1);
+    std::vector<int> low_vector(n, 0);
+    std::vector<int> component_stack_vector;
+    std::vector<int> call_stack_vector;
+    std::vector<size_t> position_stack_vector;
+    int next_order = 0;
+
+    m_row_order_vector.reserve(n);
+    m_column_order_vector.reserve(n);
+    component_stack_vector.reserve(n);
+
+    for (int start_column = 0; start_column < n; ++start_column)
+    {
+        if (order_vector[start_column] != -1)
+        {
+            continue;
+        }
+
+        order_vector[start_column] = next_order;
+        low_vector[start_column] = next_order;
+        ++next_order;
+        component_stack_vector.push_back(start_column);
+        call_stack_vector.push_back(start_column);
+        position_stack_vector.push_back(0);
+
+        while (! call_stack_vector.empty())
+        {
+            int column = call_stack_vector.back();
+            SparseSlice row_slice = a_matrix.GetRow(m_column_match_vector[column]);
+            size_t & position = position_stack_vector.back();
+            int next_column = -1;
+
+            //----------------------------------------------------------
+            //  Follow the next edge to a column that has not been
+            //  visited. An edge to a column that is on the component
+            //  stack lowers the low link of this column.
+            //----------------------------------------------------------
+
+            for (; position < row_slice.GetSize(); ++position)
+            {
+                int other_column = row_slice.GetIndex(position);
+
+                if ((other_column >= n) || (other_column == column))
+                {
+                    continue;
+                }
+
+                if (order_vector[other_column] == -1)
+                {
+                    next_column = other_column;
+                    ++position;
+                    break;
+                }
+
+                if (order_vector[other_column] != done_order)
+                {
+                    low_vector[column] = std::min(low_vector[column], order_vector[other_column]);
+                }
+            }
+
+            if (next_column != -1)
+            {
+                order_vector[next_column] = next_order;
+                low_vector[next_column] = next_order;
+                ++next_order;
+                component_stack_vector.push_back(next_column);
+                call_stack_vector.push_back(next_column);
+                position_stack_vector.push_back(0);
+                continue;
+            }
+
+            //----------------------------------------------------------
+            //  Every edge of the column has been followed. If the
+            //  column is the root of a component then the component is
+            //  the columns above it on the component stack.
+            //----------------------------------------------------------
+
+            call_stack_vector.pop_back();
+            position_stack_vector.pop_back();
+
+            if (low_vector[column] == order_vector[column])
+            {
+                int member_column = -1;
+
+                do
+                {
+                    member_column = component_stack_vector.back();
+                    component_stack_vector.pop_back();
+                    order_vector[member_column] = done_order;
+                    m_column_order_vector.push_back(member_column);
+                    m_row_order_vector.push_back(m_column_match_vector[member_column]);
+                }
+                while (member_column != column);
+
+                m_block_start_vector.push_back((int)(m_column_order_vector.size()));
+            }
+
+            if (! call_stack_vector.empty())
+            {
+                int parent_column = call_stack_vector.back();
+                low_vector[parent_column] = std::min(low_vector[parent_column], low_vector[column]);
+            }
+        }
+    }
+
+    return;
+}
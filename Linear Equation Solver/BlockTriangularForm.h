@@ -0,0 +1,79 @@
+#ifndef BLOCKTRIANGULARFORM_H
+#define BLOCKTRIANGULARFORM_H
+
+#include <vector>
+#include "FrozenSparseMatrix.h"
+
+//======================================================================
+//  Class Definition
+//
+//  This class computes row and column orderings that permute a square
+//  sparse matrix to block lower triangular form. This is the fine
+//  part of the Dulmage-Mendelsohn decomposition of a matrix with a
+//  zero-free diagonal.
+//
+//  First a maximum transversal is found, which matches each column to
+//  a row that has an element in that column, so that the matched
+//  elements can be put on the diagonal. The matching is found by
+//  depth-first searches for augmenting paths, with a cheap search for
+//  an unmatched row in each column before the depth-first search, as
+//  in Duff's MC21 algorithm. If some column cannot be matched then
+//  the matrix is structurally singular.
+//
+//  Then the strongly connected components of the directed graph with
+//  an edge from column j to column k when the row matched to column j
+//  has an element in column k are found with Tarjan's algorithm. Each
+//  component is a diagonal block. Tarjan's algorithm finds a component
+//  only after every component that it has an edge to, so in the order
+//  in which the components are found, the rows of each block only
+//  have elements in the columns of that block and of earlier blocks.
+//
+//  Both searches use explicit stacks, so a long chain of equations
+//  does not overflow the call stack.
+//======================================================================
+
+class BlockTriangularForm
+{
+public:
+
+    BlockTriangularForm();
+
+    virtual ~BlockTriangularForm();
+
+    bool Compute(const FrozenSparseMatrix & a_matrix, int n);
+
+    int GetNumberOfBlocks() const;
+
+    const std::vector<int> & GetRowOrder() const;
+
+    const std::vector<int> & GetColumnOrder() const;
+
+    const std::vector<int> & GetBlockStart() const;
+
+protected:
+
+    bool FindMaximumTransversal(const FrozenSparseMatrix & a_matrix, int n);
+
+    void FindStrongComponents(const FrozenSparseMatrix & a_matrix, int n);
+
+protected:
+
+    //------------------------------------------------------------------
+    //  The row matched to each column.
+    //------------------------------------------------------------------
+
+    std::vector<int> m_column_match_vector;
+
+    //------------------------------------------------------------------
+    //  Position k of the block triangular form holds row
+    //  m_row_order_vector[k] and column m_column_order_vector[k]. Block
+    //  b is positions m_block_start_vector[b] up to, but not including,
+    //  m_block_start_vector[b + 1].
+    //------------------------------------------------------------------
+
+    std::vector<int> m_row_order_vector;
+    std::vector<int> m_column_order_vector;
+    std::vector<int> m_block_start_vector;
+};
+
+#endif
@@ -0,0 +1,112 @@
+#include <stdio.h>
+#include "CacheFileSection.h"
+
+//======================================================================
+//  Member Function: CacheFileSection::AlignOffset
+//
+//  Abstract:
+//
+//    This function rounds a file position up to the next 8 byte
+//    boundary.
+//
+//======================================================================
+
+uint64_t CacheFileSection::AlignOffset(uint64_t offset)
+{
+    return (offset + 7) & ~(uint64_t)(7);
+}
+
+//======================================================================
+//  Member Function: CacheFileSection::Write
+//
+//  Abstract:
+//
+//    This function writes an array at the current position followed
+//    by zero bytes up to the next 8 byte boundary.
+//
+//
+//  Input:
+//
+//    cache_file        The open cache file.
+//
+//    data_ptr          A pointer to the array.
+//
+//    data_size         The size of the array in bytes.
+//
+//    position          The current position in the file, which is
+//                      advanced past the array and the padding.
+//
+//  Output:
+//
+//    This function has no return value.
+//
+//======================================================================
+
+void CacheFileSection::Write(std::ofstream & cache_file,
+                             const void * data_ptr,
+                             uint64_t data_size,
+                             uint64_t & position)
+{
+    static const char zero_array[8] = { 0 };
+
+    if (data_size != 0)
+    {
+        cache_file.write((const char *)(data_ptr), (std::streamsize)(data_size));
+    }
+
+    uint64_t end_position = AlignOffset(position + data_size);
+    cache_file.write(zero_array, (std::streamsize)(end_position - position - data_size));
+    position = end_position;
+    return;
+}
+
+//======================================================================
+//  Member Function: CacheFileSection::IsInFile
+//
+//  Abstract:
+//
+//    This function tests that an array lies entirely inside the file
+//    and starts on an 8 byte boundary.
+//
+//======================================================================
+
+bool CacheFileSection::IsInFile(uint64_t offset,
+                                uint64_t number_of_items,
+                                uint64_t item_size,
+                                uint64_t file_size)
+{
+    return ((offset & 7) == 0)
+        && (offset <= file_size)
+        && (number_of_items <= (file_size - offset) / item_size);
+}
+
+//======================================================================
+//  Member Function: CacheFileSection::ReplaceFile
+//
+//  Abstract:
+//
+//    This function replaces any previous cache file with the file that
+//    was written under a temporary name. The temporary file is removed
+//    if it cannot be renamed.
+//
+//
+//  Output:
+//
+//    This function returns a value of type 'bool' that is the value
+//    true if and only if the cache file was replaced.
+//
+//======================================================================
+
+bool CacheFileSection::ReplaceFile(const char * temporary_file_name_ptr,
+                                   const char * cache_file_name_ptr)
+{
+    remove(cache_file_name_ptr);
+
+    if (rename(temporary_file_name_ptr, cache_file_name_ptr) != 0)
+    {
+        remove(temporary_file_name_ptr);
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,39 @@
+#ifndef CACHEFILESECTION_H
+#define CACHEFILESECTION_H
+
+#include <stdint.h>
+#include <fstream>
+
+//======================================================================
+//  Class Definition
+//
+//  This class has the functions that are shared by the binary cache
+//  files. Each cache file is a fixed size header followed by arrays
+//  that each start on an 8 byte boundary. The readers map the whole
+//  file into memory and check the arrays where they lie, then copy
+//  each array once into the structure that is returned. A cache file
+//  is written under a temporary name and then renamed, so a partly
+//  written file is never read.
+//======================================================================
+
+class CacheFileSection
+{
+public:
+
+    static uint64_t AlignOffset(uint64_t offset);
+
+    static void Write(std::ofstream & cache_file,
+                      const void * data_ptr,
+                      uint64_t data_size,
+                      uint64_t & position);
+
+    static bool IsInFile(uint64_t offset,
+                         uint64_t number_of_items,
+                         uint64_t item_size,
+                         uint64_t file_size);
+
+    static bool ReplaceFile(const char * temporary_file_name_ptr,
+                            const char * cache_file_name_ptr);
+};
+
+#endif
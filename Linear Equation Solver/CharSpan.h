@@ -0,0 +1,157 @@
+#ifndef CHARSPAN_H
+#define CHARSPAN_H
+
+#include <string.h>
+#include <ostream>
+#include "CharString.h"
+
+//======================================================================
+//  Class Definition
+//
+//  This class is a non-owning view of a run of characters. It is
+//  used by the parser so that lines can be parsed directly out of
+//  a memory-mapped input file without copying each line into a
+//  CharString. The characters are not required to be terminated
+//  by a null character, so the CString() style of access is not
+//  provided.
+//
+//  The viewed characters must outlive the span.
+//======================================================================
+
+class CharSpan
+{
+public:
+
+    CharSpan()
+      : m_data_ptr(""),
+        m_length(0)
+    {
+    }
+
+    CharSpan(const char * data_ptr, unsigned int length)
+      : m_data_ptr(data_ptr),
+        m_length(length)
+    {
+    }
+
+    CharSpan(const CharString & char_string)
+      : m_data_ptr(char_string.CString()),
+        m_length(char_string.Length())
+    {
+    }
+
+    unsigned int Length() const
+    {
+        return m_length;
+    }
+
+    const char * Data() const
+    {
+        return m_data_ptr;
+    }
+
+    char operator [](int index) const
+    {
+        return m_data_ptr[index];
+    }
+
+    //------------------------------------------------------------------
+    //  Return the index of the first occurrence of the passed string
+    //  or -1 if the string does not occur in the span.
+    //------------------------------------------------------------------
+
+    int Find(const char * find_ptr) const
+    {
+        unsigned int find_length = (unsigned int)(strlen(find_ptr));
+
+        if ((find_length == 0) || (find_length > m_length))
+        {
+            return -1;
+        }
+
+        unsigned int last_start = m_length - find_length;
+
+        for (unsigned int i = 0; i <= last_start; ++i)
+        {
+            if ((m_data_ptr[i] == find_ptr[0])
+                && (memcmp(m_data_ptr + i, find_ptr, find_length) == 0))
+            {
+                return (int)(i);
+            }
+        }
+
+        return -1;
+    }
+
+    //------------------------------------------------------------------
+    //  Return a span of the first 'length' characters.
+    //------------------------------------------------------------------
+
+    CharSpan ExtractLeading(int length) const
+    {
+        if (length < 0)
+        {
+            length = 0;
+        }
+        else if ((unsigned int)(length) > m_length)
+        {
+            length = (int)(m_length);
+        }
+
+        return CharSpan(m_data_ptr, (unsigned int)(length));
+    }
+
+private:
+
+    const char * m_data_ptr;
+    unsigned int m_length;
+};
+
+inline std::ostream & operator <<(std::ostream & output_stream,
+                                  const CharSpan & char_span)
+{
+    return output_stream.write(char_span.Data(), char_span.Length());
+}
+
+//----------------------------------------------------------------------
+//  Get the next line from a block of characters such as a
+//  memory-mapped file. The line is returned without the terminating
+//  newline character and with any comment removed. A comment is
+//  started by the character sequence "//". On return 'data_ptr'
+//  points to the start of the following line.
+//
+//  This returns false if there are no more lines.
+//----------------------------------------------------------------------
+
+inline bool GetNextInputLine(const char * & data_ptr,
+                             const char * end_ptr,
+                             CharSpan & input_line_span)
+{
+    if (data_ptr >= end_ptr)
+    {
+        return false;
+    }
+
+    const char * line_end_ptr = (const char *)(memchr(data_ptr,
+                                                      '\n',
+                                                      end_ptr - data_ptr));
+
+    if (line_end_ptr == 0)
+    {
+        line_end_ptr = end_ptr;
+    }
+
+    input_line_span = CharSpan(data_ptr, (unsigned int)(line_end_ptr - data_ptr));
+    data_ptr = line_end_ptr + 1;
+
+    int comment_delimiter = input_line_span.Find("//");
+
+    if (comment_delimiter != -1)
+    {
+        input_line_span = input_line_span.ExtractLeading(comment_delimiter);
+    }
+
+    return true;
+}
+
+#endif
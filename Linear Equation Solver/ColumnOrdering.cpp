@@ -0,0 +1,395 @@
+#include <math.h>
+#include <algorithm>
+#include "ColumnOrdering.h"
+
+namespace
+{
+    //------------------------------------------------------------------
+    //  A row or a column with more than this many elements, or more
+    //  than ten times the square root of the matrix size, is dense.
+    //------------------------------------------------------------------
+
+    const int f_MINIMUM_DENSE_COUNT = 16;
+}
+
+//======================================================================
+//  Constructor: ColumnOrdering::ColumnOrdering
+//======================================================================
+
+ColumnOrdering::ColumnOrdering()
+  : m_minimum_degree(0)
+{
+}
+
+//======================================================================
+//  Destructor: ColumnOrdering::~ColumnOrdering
+//======================================================================
+
+ColumnOrdering::~ColumnOrdering()
+{
+}
+
+//======================================================================
+//  Member Function: ColumnOrdering::Compute
+//
+//  Abstract:
+//
+//    This function computes the column ordering.
+//
+//
+//  Input:
+//
+//    a_matrix              The matrix. Only the elements in the first
+//                          n rows and the first n columns are used.
+//
+//    n                     The size of the matrix.
+//
+//    column_order_vector   The returned ordering. Element k is the
+//                          column that is eliminated k'th.
+//
+//  Output:
+//
+//    This function has no return value.
+//
+//======================================================================
+
+void ColumnOrdering::Compute(const FrozenSparseMatrix & a_matrix,
+                             int n,
+                             std::vector<int> & column_order_vector)
+{
+    column_order_vector.clear();
+    column_order_vector.reserve(n);
+
+    int dense_count = std::max(f_MINIMUM_DENSE_COUNT, (int)(10.0 * sqrt((double)(n))));
+    int number_of_rows = std::min(n, a_matrix.GetNumberOfRows());
+    int i = 0;
+    int row = 0;
+
+    //------------------------------------------------------------------
+    //  Find the dense rows and count the elements of each column in the
+    //  remaining rows.
+    //------------------------------------------------------------------
+
+    std::vector<bool> dense_row_vector(n, false);
+    std::vector<int> column_count_vector(n, 0);
+
+    for (row = 0; row < number_of_rows; ++row)
+    {
+        SparseSlice row_slice = a_matrix.GetRow(row);
+        int count = 0;
+        SparseSlice::Iterator row_iter = row_slice.begin();
+
+        for (row_iter = row_slice.begin(); row_iter != row_slice.end(); ++row_iter)
+        {
+            if (row_iter.GetIndex() < n)
+            {
+                ++count;
+            }
+        }
+
+        dense_row_vector[row] = count > dense_count;
+
+        if (! dense_row_vector[row])
+        {
+            for (row_iter = row_slice.begin(); row_iter != row_slice.end(); ++row_iter)
+            {
+                if (row_iter.GetIndex() < n)
+                {
+                    ++column_count_vector[row_iter.GetIndex()];
+                }
+            }
+        }
+    }
+
+    std::vector<bool> dense_column_vector(n, false);
+    int number_of_live_columns = 0;
+
+    for (i = 0; i < n; ++i)
+    {
+        dense_column_vector[i] = column_count_vector[i] > dense_count;
+
+        if (! dense_column_vector[i])
+        {
+            ++number_of_live_columns;
+        }
+    }
+
+    //------------------------------------------------------------------
+    //  Make the initial elements from the rows. Element 'row' is a row
+    //  and element 'n + column' is made when the column is eliminated.
+    //------------------------------------------------------------------
+
+    int number_of_elements = 2 * n;
+    std::vector< std::vector<int> > element_member_vector(number_of_elements);
+    std::vector< std::vector<int> > column_element_vector(n);
+    std::vector<bool> element_alive_vector(number_of_elements, false);
+
+    for (row = 0; row < number_of_rows; ++row)
+    {
+        if (dense_row_vector[row])
+        {
+            continue;
+        }
+
+        SparseSlice row_slice = a_matrix.GetRow(row);
+        std::vector<int> & member_vector = element_member_vector[row];
+
+        for (SparseSlice::Iterator row_iter = row_slice.begin(); row_iter != row_slice.end(); ++row_iter)
+        {
+            int column = row_iter.GetIndex();
+
+            if ((column < n) && (! dense_column_vector[column]))
+            {
+                member_vector.push_back(column);
+                column_element_vector[column].push_back(row);
+            }
+        }
+
+        element_alive_vector[row] = ! member_vector.empty();
+    }
+
+    //------------------------------------------------------------------
+    //  The initial degree of each column is bounded by the sum of the
+    //  sizes of its elements.
+    //------------------------------------------------------------------
+
+    m_degree_head_vector.assign(n + 1, -1);
+    m_degree_next_vector.assign(n, -1);
+    m_degree_previous_vector.assign(n, -1);
+    m_degree_vector.assign(n, 0);
+    m_minimum_degree = n;
+
+    for (i = 0; i < n; ++i)
+    {
+        if (dense_column_vector[i])
+        {
+            continue;
+        }
+
+        long long degree = 0;
+
+        for (size_t k = 0; k < column_element_vector[i].size(); ++k)
+        {
+            degree += (long long)(element_member_vector[column_element_vector[i][k]].size()) - 1;
+        }
+
+        InsertInDegreeList(i, (int)(std::min(degree, (long long)(number_of_live_columns - 1))));
+    }
+
+    //------------------------------------------------------------------
+    //  Eliminate the column of minimum approximate degree until every
+    //  column that is not dense has been eliminated.
+    //------------------------------------------------------------------
+
+    std::vector<bool> eliminated_vector(n, false);
+    std::vector<int> mark_vector(n, -1);
+    std::vector<int> external_size_vector(number_of_elements, 0);
+    std::vector<int> external_mark_vector(number_of_elements, -1);
+    std::vector<int> element_size_vector(number_of_elements, 0);
+
+    for (i = 0; i < number_of_elements; ++i)
+    {
+        element_size_vector[i] = (int)(element_member_vector[i].size());
+    }
+
+    while ((int)(column_order_vector.size()) < number_of_live_columns)
+    {
+        while (m_degree_head_vector[m_minimum_degree] == -1)
+        {
+            ++m_minimum_degree;
+        }
+
+        int pivot = m_degree_head_vector[m_minimum_degree];
+        RemoveFromDegreeList(pivot);
+        eliminated_vector[pivot] = true;
+        column_order_vector.push_back(pivot);
+
+        //--------------------------------------------------------------
+        //  The new element is the union of the elements that contain
+        //  the pivot, which are absorbed into the new element.
+        //--------------------------------------------------------------
+
+        int new_element = n + pivot;
+        std::vector<int> & pivot_member_vector = element_member_vector[new_element];
+        std::vector<int> & pivot_element_vector = column_element_vector[pivot];
+        size_t k = 0;
+
+        mark_vector[pivot] = pivot;
+
+        for (k = 0; k < pivot_element_vector.size(); ++k)
+        {
+            int element = pivot_element_vector[k];
+
+            if (! element_alive_vector[element])
+            {
+                continue;
+            }
+
+            std::vector<int> & member_vector = element_member_vector[element];
+
+            for (size_t m = 0; m < member_vector.size(); ++m)
+            {
+                int column = member_vector[m];
+
+                if ((! eliminated_vector[column]) && (mark_vector[column] != pivot))
+                {
+                    mark_vector[column] = pivot;
+                    pivot_member_vector.push_back(column);
+                }
+            }
+
+            element_alive_vector[element] = false;
+            std::vector<int>().swap(member_vector);
+        }
+
+        std::vector<int>().swap(pivot_element_vector);
+
+        int pivot_size = (int)(pivot_member_vector.size());
+        element_alive_vector[new_element] = pivot_size != 0;
+        element_size_vector[new_element] = pivot_size;
+
+        //--------------------------------------------------------------
+        //  For every other element that shares a column with the new
+        //  element, find the number of its columns that are not in the
+        //  new element.
+        //--------------------------------------------------------------
+
+        for (k = 0; k < pivot_member_vector.size(); ++k)
+        {
+            std::vector<int> & element_vector = column_element_vector[pivot_member_vector[k]];
+
+            for (size_t m = 0; m < element_vector.size(); ++m)
+            {
+                int element = element_vector[m];
+
+                if (element_alive_vector[element])
+                {
+                    if (external_mark_vector[element] != pivot)
+                    {
+                        external_mark_vector[element] = pivot;
+                        external_size_vector[element] = element_size_vector[element];
+                    }
+
+                    --external_size_vector[element];
+                }
+            }
+        }
+
+        //--------------------------------------------------------------
+        //  Update the element list and the approximate degree of each
+        //  column of the new element. An element whose columns are all
+        //  in the new element is absorbed.
+        //--------------------------------------------------------------
+
+        int number_of_remaining_columns = number_of_live_columns - (int)(column_order_vector.size());
+
+        for (k = 0; k < pivot_member_vector.size(); ++k)
+        {
+            int column = pivot_member_vector[k];
+            std::vector<int> & element_vector = column_element_vector[column];
+            long long external_degree = 0;
+            size_t kept_count = 0;
+
+            RemoveFromDegreeList(column);
+
+            for (size_t m = 0; m < element_vector.size(); ++m)
+            {
+                int element = element_vector[m];
+
+                if (! element_alive_vector[element])
+                {
+                    continue;
+                }
+
+                if (external_size_vector[element] == 0)
+                {
+                    element_alive_vector[element] = false;
+                    std::vector<int>().swap(element_member_vector[element]);
+                    continue;
+                }
+
+                external_degree += external_size_vector[element];
+                element_vector[kept_count++] = element;
+            }
+
+            element_vector.resize(kept_count);
+            element_vector.push_back(new_element);
+
+            long long degree = std::min((long long)(m_degree_vector[column]) + pivot_size - 1,
+                                        (long long)(pivot_size) - 1 + external_degree);
+
+            degree = std::min(degree, (long long)(number_of_remaining_columns) - 1);
+            degree = std::max(degree, 0LL);
+
+            InsertInDegreeList(column, (int)(degree));
+        }
+    }
+
+    //------------------------------------------------------------------
+    //  Order the dense columns last.
+    //------------------------------------------------------------------
+
+    for (i = 0; i < n; ++i)
+    {
+        if (dense_column_vector[i])
+        {
+            column_order_vector.push_back(i);
+        }
+    }
+
+    return;
+}
+
+//======================================================================
+//  Member Function: ColumnOrdering::InsertInDegreeList
+//======================================================================
+
+void ColumnOrdering::InsertInDegreeList(int column, int degree)
+{
+    m_degree_vector[column] = degree;
+    m_degree_previous_vector[column] = -1;
+    m_degree_next_vector[column] = m_degree_head_vector[degree];
+
+    if (m_degree_head_vector[degree] != -1)
+    {
+        m_degree_previous_vector[m_degree_head_vector[degree]] = column;
+    }
+
+    m_degree_head_vector[degree] = column;
+
+    if (degree < m_minimum_degree)
+    {
+        m_minimum_degree = degree;
+    }
+
+    return;
+}
+
+//======================================================================
+//  Member Function: ColumnOrdering::RemoveFromDegreeList
+//======================================================================
+
+void ColumnOrdering::RemoveFromDegreeList(int column)
+{
+    int previous_column = m_degree_previous_vector[column];
+    int next_column = m_degree_next_vector[column];
+
+    if (previous_column != -1)
+    {
+        m_degree_next_vector[previous_column] = next_column;
+    }
+    else if (m_degree_head_vector[m_degree_vector[column]] == column)
+    {
+        m_degree_head_vector[m_degree_vector[column]] = next_column;
+    }
+
+    if (next_column != -1)
+    {
+        m_degree_previous_vector[next_column] = previous_column;
+    }
+
+    m_degree_previous_vector[column] = -1;
+    m_degree_next_vector[column] = -1;
+
+    return;
+}
@@ -0,0 +1,54 @@
+#ifndef COLUMNORDERING_H
+#define COLUMNORDERING_H
+
+#include <vector>
+#include "FrozenSparseMatrix.h"
+
+//======================================================================
+//  Class Definition
+//
+//  This class computes a fill-reducing column ordering for the LU
+//  factorization of a sparse square matrix. It uses approximate
+//  minimum degree on the pattern of transpose(A) A, in the same way
+//  as COLAMD, without forming transpose(A) A. Each row of A is a
+//  clique of the columns that it contains, so the rows are used as
+//  the initial elements of a quotient graph. Eliminating a column
+//  merges every element that contains the column into a new element.
+//
+//  The degree of each column is the approximate external degree of
+//  Amestoy, Davis and Duff. Elements that become subsets of the new
+//  element are absorbed.
+//
+//  Rows with many elements would make almost every column adjacent,
+//  so they are ignored, and columns with many elements are ordered
+//  last.
+//======================================================================
+
+class ColumnOrdering
+{
+public:
+
+    ColumnOrdering();
+
+    virtual ~ColumnOrdering();
+
+    void Compute(const FrozenSparseMatrix & a_matrix,
+                 int n,
+                 std::vector<int> & column_order_vector);
+
+protected:
+
+    void InsertInDegreeList(int column, int degree);
+
+    void RemoveFromDegreeList(int column);
+
+protected:
+
+    std::vector<int> m_degree_head_vector;
+    std::vector<int> m_degree_next_vector;
+    std::vector<int> m_degree_previous_vector;
+    std::vector<int> m_degree_vector;
+    int m_minimum_degree;
+};
+
+#endif
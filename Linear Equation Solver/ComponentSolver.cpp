@@ -0,0 +1,669 @@
+#include <algorithm>
+#include "ComponentSolver.h"
+
+//======================================================================
+//  Constructor: ComponentSolver::ComponentSolver
+//
+//  Input:
+//
+//    number_of_threads     The number of threads used to solve the
+//                          components. If this is zero then one
+//                          thread per hardware thread is used.
+//
+//======================================================================
+
+ComponentSolver::ComponentSolver(unsigned int number_of_threads)
+  : m_thread_pool(number_of_threads),
+    m_n(0),
+    m_sparse_density_threshold(0.0),
+    m_sparse_density_threshold_flag(false),
+    m_mixed_precision_flag(false)
+{
+}
+
+//======================================================================
+//  Destructor: ComponentSolver::~ComponentSolver
+//======================================================================
+
+ComponentSolver::~ComponentSolver()
+{
+}
+
+//======================================================================
+//  Member Function: ComponentSolver::FindComponents
+//
+//  Abstract:
+//
+//    This function finds the independent systems of equations in the
+//    A matrix.
+//
+//
+//  Input:
+//
+//    number_of_equations   The number of equations. Only the elements
+//                          in the first number_of_equations rows and
+//                          columns of A are used.
+//
+//    a_matrix              The A matrix.
+//
+//  Output:
+//
+//    This function returns a value of type 'int' that is the number
+//    of independent systems.
+//
+//======================================================================
+
+int ComponentSolver::FindComponents(unsigned int number_of_equations,
+                                    const FrozenSparseMatrix & a_matrix)
+{
+    int n = (int)(number_of_equations);
+    int number_of_rows = std::min(n, a_matrix.GetNumberOfRows());
+    int i = 0;
+    int row = 0;
+
+    m_n = n;
+
+    //------------------------------------------------------------------
+    //  Join the variables of each equation.
+    //------------------------------------------------------------------
+
+    m_parent_vector.resize(n);
+
+    for (i = 0; i < n; ++i)
+    {
+        m_parent_vector[i] = i;
+    }
+
+    for (row = 0; row < number_of_rows; ++row)
+    {
+        SparseSlice row_slice = a_matrix.GetRow(row);
+        int first_root = -1;
+
+        for (SparseSlice::Iterator row_iter = row_slice.begin(); row_iter != row_slice.end(); ++row_iter)
+        {
+            if (row_iter.GetIndex() < n)
+            {
+                int root = FindRoot(row_iter.GetIndex());
+
+                if (first_root == -1)
+                {
+                    first_root = root;
+                }
+                else if (root != first_root)
+                {
+                    //--------------------------------------------------
+                    //  Link the larger root to the smaller root, which
+                    //  stays the root of the equation's variables.
+                    //--------------------------------------------------
+
+                    if (root < first_root)
+                    {
+                        std::swap(root, first_root);
+                    }
+
+                    m_parent_vector[root] = first_root;
+                }
+            }
+        }
+    }
+
+    //------------------------------------------------------------------
+    //  Number the components in the order of their first variable. An
+    //  equation without variables is a component of its own, and these
+    //  are numbered last.
+    //------------------------------------------------------------------
+
+    std::vector<int> component_vector(n, -1);
+    std::vector<int> equation_component_vector(n, -1);
+    int number_of_components = 0;
+
+    for (i = 0; i < n; ++i)
+    {
+        int root = FindRoot(i);
+
+        if (component_vector[root] == -1)
+        {
+            component_vector[root] = number_of_components++;
+        }
+
+        component_vector[i] = component_vector[root];
+    }
+
+    for (row = 0; row < n; ++row)
+    {
+        if (row < number_of_rows)
+        {
+            SparseSlice row_slice = a_matrix.GetRow(row);
+
+            for (SparseSlice::Iterator row_iter = row_slice.begin(); row_iter != row_slice.end(); ++row_iter)
+            {
+                if (row_iter.GetIndex() < n)
+                {
+                    equation_component_vector[row] = component_vector[row_iter.GetIndex()];
+                    break;
+                }
+            }
+        }
+    }
+
+    for (row = 0; row < n; ++row)
+    {
+        if (equation_component_vector[row] == -1)
+        {
+            equation_component_vector[row] = number_of_components++;
+        }
+    }
+
+    //------------------------------------------------------------------
+    //  Store the equations and the variables of each component in
+    //  increasing order.
+    //------------------------------------------------------------------
+
+    m_equation_start_vector.assign(number_of_components + 1, 0);
+    m_variable_start_vector.assign(number_of_components + 1, 0);
+
+    for (i = 0; i < n; ++i)
+    {
+        ++m_equation_start_vector[equation_component_vector[i] + 1];
+        ++m_variable_start_vector[component_vector[i] + 1];
+    }
+
+    for (i = 0; i < number_of_components; ++i)
+    {
+        m_equation_start_vector[i + 1] += m_equation_start_vector[i];
+        m_variable_start_vector[i + 1] += m_variable_start_vector[i];
+    }
+
+    std::vector<int> equation_position_vector(m_equation_start_vector.begin(), m_equation_start_vector.end() - 1);
+    std::vector<int> variable_position_vector(m_variable_start_vector.begin(), m_variable_start_vector.end() - 1);
+
+    m_equation_vector.resize(n);
+    m_variable_vector.resize(n);
+    m_local_index_vector.resize(n);
+
+    for (i = 0; i < n; ++i)
+    {
+        m_equation_vector[equation_position_vector[equation_component_vector[i]]++] = i;
+
+        int component = component_vector[i];
+        m_local_index_vector[i] = variable_position_vector[component] - m_variable_start_vector[component];
+        m_variable_vector[variable_position_vector[component]++] = i;
+    }
+
+    //------------------------------------------------------------------
+    //  Solve the largest components first, so that a large component
+    //  is not started after the small ones are done.
+    //------------------------------------------------------------------
+
+    m_component_order_vector.resize(number_of_components);
+
+    for (i = 0; i < number_of_components; ++i)
+    {
+        m_component_order_vector[i] = i;
+    }
+
+    const std::vector<int> & equation_start_vector = m_equation_start_vector;
+
+    std::stable_sort(m_component_order_vector.begin(),
+                     m_component_order_vector.end(),
+                     [&equation_start_vector](int first_component, int second_component)
+                     {
+                         return (equation_start_vector[first_component + 1] - equation_start_vector[first_component])
+                             > (equation_start_vector[second_component + 1] - equation_start_vector[second_component]);
+                     });
+
+    return number_of_components;
+}
+
+//======================================================================
+//  Member Function: ComponentSolver::Solve
+//
+//  Abstract:
+//
+//    This function solves each independent system found by the last
+//    call to FindComponents.
+//
+//
+//  Input:
+//
+//    a_matrix                  The A matrix that was passed to
+//                              FindComponents.
+//
+//    b_vectors                 The B vectors, one after another. Each
+//                              vector has number_of_equations
+//                              elements.
+//
+//    number_of_right_hand_sides    The number of B vectors.
+//
+//    x_vectors                 The solutions, stored in the same way.
+//
+//  Output:
+//
+//    This function returns a value of type 'LinearSystemSolver::Status_T'.
+//    The status is MATRIX_SINGULAR if any independent system is
+//    singular.
+//
+//======================================================================
+
+LinearSystemSolver::Status_T ComponentSolver::Solve(const FrozenSparseMatrix & a_matrix,
+                                                    const std::vector<double> & b_vectors,
+                                                    int number_of_right_hand_sides,
+                                                    std::vector<double> & x_vectors)
+{
+    int number_of_components = GetNumberOfComponents();
+
+    x_vectors.assign((size_t)(m_n) * number_of_right_hand_sides, 0.0);
+    m_result_vector.resize(number_of_components);
+
+    m_thread_pool.Run(number_of_components,
+                      [this, &a_matrix, &b_vectors, number_of_right_hand_sides, &x_vectors](size_t task_index)
+                      {
+                          SolveComponent(m_component_order_vector[task_index],
+                                         a_matrix,
+                                         b_vectors,
+                                         number_of_right_hand_sides,
+                                         x_vectors);
+                      });
+
+    for (int c = 0; c < number_of_components; ++c)
+    {
+        if (m_result_vector[c].m_status != LinearSystemSolver::SUCCESS)
+        {
+            return m_result_vector[c].m_status;
+        }
+    }
+
+    return LinearSystemSolver::SUCCESS;
+}
+
+//======================================================================
+//  Member Function: ComponentSolver::SetSparseDensityThreshold
+//
+//  Abstract:
+//
+//    This function sets the sparse density threshold of the solver of
+//    each component. The density is that of the component.
+//
+//======================================================================
+
+void ComponentSolver::SetSparseDensityThreshold(double sparse_density_threshold)
+{
+    m_sparse_density_threshold = sparse_density_threshold;
+    m_sparse_density_threshold_flag = true;
+    return;
+}
+
+//======================================================================
+//  Member Function: ComponentSolver::SetMixedPrecision
+//======================================================================
+
+void ComponentSolver::SetMixedPrecision(bool mixed_precision_flag)
+{
+    m_mixed_precision_flag = mixed_precision_flag;
+    return;
+}
+
+//======================================================================
+//  Member Function: ComponentSolver::GetNumberOfComponents
+//======================================================================
+
+int ComponentSolver::GetNumberOfComponents() const
+{
+    return (int)(m_component_order_vector.size());
+}
+
+//======================================================================
+//  Member Function: ComponentSolver::GetLargestComponentSize
+//
+//  Abstract:
+//
+//    This function returns the number of equations of the largest
+//    independent system.
+//
+//======================================================================
+
+int ComponentSolver::GetLargestComponentSize() const
+{
+    if (m_component_order_vector.empty())
+    {
+        return 0;
+    }
+
+    int component = m_component_order_vector[0];
+
+    return m_equation_start_vector[component + 1] - m_equation_start_vector[component];
+}
+
+//======================================================================
+//  Member Function: ComponentSolver::GetNumberOfMatrixNonzeros
+//
+//  Abstract:
+//
+//    This function and the following functions return the sum, or for
+//    the refinement the largest value, over the independent systems
+//    solved by the last call to Solve.
+//
+//======================================================================
+
+size_t ComponentSolver::GetNumberOfMatrixNonzeros() const
+{
+    size_t number_of_nonzeros = 0;
+
+    for (size_t c = 0; c < m_result_vector.size(); ++c)
+    {
+        number_of_nonzeros += m_result_vector[c].m_matrix_nonzeros;
+    }
+
+    return number_of_nonzeros;
+}
+
+//======================================================================
+//  Member Function: ComponentSolver::GetNumberOfLowerNonzeros
+//======================================================================
+
+size_t ComponentSolver::GetNumberOfLowerNonzeros() const
+{
+    size_t number_of_nonzeros = 0;
+
+    for (size_t c = 0; c < m_result_vector.size(); ++c)
+    {
+        number_of_nonzeros += m_result_vector[c].m_lower_nonzeros;
+    }
+
+    return number_of_nonzeros;
+}
+
+//======================================================================
+//  Member Function: ComponentSolver::GetNumberOfUpperNonzeros
+//======================================================================
+
+size_t ComponentSolver::GetNumberOfUpperNonzeros() const
+{
+    size_t number_of_nonzeros = 0;
+
+    for (size_t c = 0; c < m_result_vector.size(); ++c)
+    {
+        number_of_nonzeros += m_result_vector[c].m_upper_nonzeros;
+    }
+
+    return number_of_nonzeros;
+}
+
+//======================================================================
+//  Member Function: ComponentSolver::GetFillIn
+//======================================================================
+
+size_t ComponentSolver::GetFillIn() const
+{
+    size_t fill_in = 0;
+
+    for (size_t c = 0; c < m_result_vector.size(); ++c)
+    {
+        fill_in += m_result_vector[c].m_fill_in;
+    }
+
+    return fill_in;
+}
+
+//======================================================================
+//  Member Function: ComponentSolver::GetFlopCount
+//======================================================================
+
+double ComponentSolver::GetFlopCount() const
+{
+    double flop_count = 0.0;
+
+    for (size_t c = 0; c < m_result_vector.size(); ++c)
+    {
+        flop_count += m_result_vector[c].m_flop_count;
+    }
+
+    return flop_count;
+}
+
+//======================================================================
+//  Member Function: ComponentSolver::GetRefinementIterations
+//======================================================================
+
+int ComponentSolver::GetRefinementIterations() const
+{
+    int refinement_iterations = 0;
+
+    for (size_t c = 0; c < m_result_vector.size(); ++c)
+    {
+        refinement_iterations = std::max(refinement_iterations, m_result_vector[c].m_refinement_iterations);
+    }
+
+    return refinement_iterations;
+}
+
+//======================================================================
+//  Member Function: ComponentSolver::GetBackwardError
+//======================================================================
+
+double ComponentSolver::GetBackwardError() const
+{
+    double backward_error = 0.0;
+
+    for (size_t c = 0; c < m_result_vector.size(); ++c)
+    {
+        if (! (m_result_vector[c].m_backward_error <= backward_error))
+        {
+            backward_error = m_result_vector[c].m_backward_error;
+        }
+    }
+
+    return backward_error;
+}
+
+//======================================================================
+//  Member Function: ComponentSolver::WasDoublePrecisionFallback
+//======================================================================
+
+bool ComponentSolver::WasDoublePrecisionFallback() const
+{
+    for (size_t c = 0; c < m_result_vector.size(); ++c)
+    {
+        if (m_result_vector[c].m_double_precision_fallback_flag)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//======================================================================
+//  Member Function: ComponentSolver::FindRoot
+//
+//  Abstract:
+//
+//    This function returns the root of the tree that holds a
+//    variable. Each variable on the path is made to point to its
+//    grandparent, which halves the length of the path.
+//
+//======================================================================
+
+int ComponentSolver::FindRoot(int variable)
+{
+    while (m_parent_vector[variable] != variable)
+    {
+        m_parent_vector[variable] = m_parent_vector[m_parent_vector[variable]];
+        variable = m_parent_vector[variable];
+    }
+
+    return variable;
+}
+
+//======================================================================
+//  Member Function: ComponentSolver::SolveComponent
+//
+//  Abstract:
+//
+//    This function copies one independent system to a small matrix,
+//    solves it, and stores the solutions in the x vectors. This
+//    function is called from several threads at once. Each call only
+//    writes the elements of the x vectors for the variables of its
+//    component and its own result.
+//
+//
+//  Input:
+//
+//    component                 The component number.
+//
+//    a_matrix                  The A matrix.
+//
+//    b_vectors                 The B vectors.
+//
+//    number_of_right_hand_sides    The number of B vectors.
+//
+//    x_vectors                 The solutions.
+//
+//  Output:
+//
+//    This function has no return value.
+//
+//======================================================================
+
+void ComponentSolver::SolveComponent(int component,
+                                     const FrozenSparseMatrix & a_matrix,
+                                     const std::vector<double> & b_vectors,
+                                     int number_of_right_hand_sides,
+                                     std::vector<double> & x_vectors)
+{
+    Result_T & result = m_result_vector[component];
+    const int * equation_ptr = &m_equation_vector[0] + m_equation_start_vector[component];
+    const int * variable_ptr = &m_variable_vector[0] + m_variable_start_vector[component];
+    int number_of_equations = m_equation_start_vector[component + 1] - m_equation_start_vector[component];
+    int number_of_variables = m_variable_start_vector[component + 1] - m_variable_start_vector[component];
+    size_t n = (size_t)(m_n);
+    size_t m = (size_t)(number_of_equations);
+    int i = 0;
+    int r = 0;
+
+    result.m_status = LinearSystemSolver::MATRIX_SINGULAR;
+    result.m_matrix_nonzeros = 0;
+    result.m_lower_nonzeros = 0;
+    result.m_upper_nonzeros = 0;
+    result.m_fill_in = 0;
+    result.m_flop_count = 0.0;
+    result.m_refinement_iterations = 0;
+    result.m_backward_error = 0.0;
+    result.m_double_precision_fallback_flag = false;
+
+    if (number_of_equations != number_of_variables)
+    {
+        return;
+    }
+
+    //------------------------------------------------------------------
+    //  Copy the equations of the component with local variable
+    //  numbers. The variables keep their order, so the columns of
+    //  each row stay in increasing order.
+    //------------------------------------------------------------------
+
+    std::vector<size_t> row_start_vector(1, 0);
+    std::vector<int> column_index_vector;
+    std::vector<double> value_vector;
+
+    row_start_vector.reserve(m + 1);
+
+    for (i = 0; i < number_of_equations; ++i)
+    {
+        int row = equation_ptr[i];
+
+        if (row < a_matrix.GetNumberOfRows())
+        {
+            SparseSlice row_slice = a_matrix.GetRow(row);
+
+            for (SparseSlice::Iterator row_iter = row_slice.begin(); row_iter != row_slice.end(); ++row_iter)
+            {
+                if (row_iter.GetIndex() < m_n)
+                {
+                    column_index_vector.push_back(m_local_index_vector[row_iter.GetIndex()]);
+                    value_vector.push_back(row_iter.GetValue());
+                }
+            }
+        }
+
+        row_start_vector.push_back(column_index_vector.size());
+    }
+
+    CompressedSparseMatrix row_matrix;
+    row_matrix.Assign(number_of_equations,
+                      number_of_equations,
+                      row_start_vector,
+                      column_index_vector,
+                      value_vector);
+
+    FrozenSparseMatrix component_matrix;
+    component_matrix.Freeze(row_matrix);
+
+    std::vector<double> b_component_vectors(m * number_of_right_hand_sides);
+    std::vector<double> x_component_vectors;
+
+    for (r = 0; r < number_of_right_hand_sides; ++r)
+    {
+        for (i = 0; i < number_of_equations; ++i)
+        {
+            b_component_vectors[m * r + i] = b_vectors[n * r + equation_ptr[i]];
+        }
+    }
+
+    //------------------------------------------------------------------
+    //  Solve the component.
+    //------------------------------------------------------------------
+
+    LinearSystemSolver system_solver;
+
+    if (m_sparse_density_threshold_flag)
+    {
+        system_solver.SetSparseDensityThreshold(m_sparse_density_threshold);
+    }
+
+    system_solver.SetMixedPrecision(m_mixed_precision_flag);
+    system_solver.Analyze(number_of_equations, component_matrix, 0);
+
+    result.m_status = system_solver.Factor(component_matrix);
+
+    if (result.m_status == LinearSystemSolver::SUCCESS)
+    {
+        if (m_mixed_precision_flag)
+        {
+            result.m_status = system_solver.SolveWithRefinement(component_matrix,
+                                                                b_component_vectors,
+                                                                number_of_right_hand_sides,
+                                                                x_component_vectors);
+        }
+        else
+        {
+            system_solver.Solve(b_component_vectors, number_of_right_hand_sides, x_component_vectors);
+        }
+    }
+
+    result.m_matrix_nonzeros = system_solver.GetNumberOfMatrixNonzeros();
+    result.m_lower_nonzeros = system_solver.GetNumberOfLowerNonzeros();
+    result.m_upper_nonzeros = system_solver.GetNumberOfUpperNonzeros();
+    result.m_fill_in = system_solver.GetFillIn();
+    result.m_flop_count = system_solver.GetFlopCount();
+    result.m_refinement_iterations = system_solver.GetRefinementIterations();
+    result.m_backward_error = system_solver.GetBackwardError();
+    result.m_double_precision_fallback_flag = system_solver.WasDoublePrecisionFallback();
+
+    //------------------------------------------------------------------
+    //  Store the solutions for the variables of the component.
+    //------------------------------------------------------------------
+
+    if (result.m_status == LinearSystemSolver::SUCCESS)
+    {
+        for (r = 0; r < number_of_right_hand_sides; ++r)
+        {
+            for (i = 0; i < number_of_equations; ++i)
+            {
+                x_vectors[n * r + variable_ptr[i]] = x_component_vectors[m * r + i];
+            }
+        }
+    }
+
+    return;
+}
@@ -0,0 +1,135 @@
+#ifndef COMPONENTSOLVER_H
+#define COMPONENTSOLVER_H
+
+#include <stddef.h>
+#include <vector>
+#include "FrozenSparseMatrix.h"
+#include "LinearSystemSolver.h"
+#include "ThreadPool.h"
+
+//======================================================================
+//  Class Definition
+//
+//  This class splits the simultaneous linear equations A x = B into
+//  independent systems and solves the independent systems in
+//  parallel.
+//
+//  Two variables are connected if they occur in the same equation.
+//  The connected components of the variables are found with a
+//  union-find structure, and each equation belongs to the component
+//  of its variables. No equation has variables from two components,
+//  so the equations of each component can be solved for its
+//  variables without the rest of the system. This is the same as
+//  permuting A to block diagonal form.
+//
+//  Each component is copied to a small FrozenSparseMatrix, where the
+//  equations and the variables keep their relative order, and is
+//  solved by its own LinearSystemSolver on a thread pool. The largest
+//  components are solved first. The solutions are stored in the
+//  elements of the x vectors for the variables of the component, so
+//  the x vectors are in the same order as for the whole system.
+//
+//  A component with a different number of equations and variables
+//  makes A singular. An equation without variables is a component
+//  with no variables.
+//======================================================================
+
+class ComponentSolver
+{
+public:
+
+    ComponentSolver(unsigned int number_of_threads);
+
+    virtual ~ComponentSolver();
+
+    int FindComponents(unsigned int number_of_equations,
+                       const FrozenSparseMatrix & a_matrix);
+
+    LinearSystemSolver::Status_T Solve(const FrozenSparseMatrix & a_matrix,
+                                       const std::vector<double> & b_vectors,
+                                       int number_of_right_hand_sides,
+                                       std::vector<double> & x_vectors);
+
+    void SetSparseDensityThreshold(double sparse_density_threshold);
+
+    void SetMixedPrecision(bool mixed_precision_flag);
+
+    int GetNumberOfComponents() const;
+
+    int GetLargestComponentSize() const;
+
+    size_t GetNumberOfMatrixNonzeros() const;
+
+    size_t GetNumberOfLowerNonzeros() const;
+
+    size_t GetNumberOfUpperNonzeros() const;
+
+    size_t GetFillIn() const;
+
+    double GetFlopCount() const;
+
+    int GetRefinementIterations() const;
+
+    double GetBackwardError() const;
+
+    bool WasDoublePrecisionFallback() const;
+
+protected:
+
+    //------------------------------------------------------------------
+    //  The results of solving one component.
+    //------------------------------------------------------------------
+
+    struct Result_T
+    {
+        LinearSystemSolver::Status_T m_status;
+        size_t m_matrix_nonzeros;
+        size_t m_lower_nonzeros;
+        size_t m_upper_nonzeros;
+        size_t m_fill_in;
+        double m_flop_count;
+        int m_refinement_iterations;
+        double m_backward_error;
+        bool m_double_precision_fallback_flag;
+    };
+
+    int FindRoot(int variable);
+
+    void SolveComponent(int component,
+                        const FrozenSparseMatrix & a_matrix,
+                        const std::vector<double> & b_vectors,
+                        int number_of_right_hand_sides,
+                        std::vector<double> & x_vectors);
+
+protected:
+
+    ThreadPool m_thread_pool;
+    int m_n;
+    double m_sparse_density_threshold;
+    bool m_sparse_density_threshold_flag;
+    bool m_mixed_precision_flag;
+
+    //------------------------------------------------------------------
+    //  The union-find parent of each variable.
+    //------------------------------------------------------------------
+
+    std::vector<int> m_parent_vector;
+
+    //------------------------------------------------------------------
+    //  The equations of component c are m_equation_vector elements
+    //  m_equation_start_vector[c] up to m_equation_start_vector[c + 1],
+    //  in increasing order, and the variables are stored in the same
+    //  way. The local index of each variable is its position in the
+    //  variables of its component.
+    //------------------------------------------------------------------
+
+    std::vector<int> m_equation_start_vector;
+    std::vector<int> m_equation_vector;
+    std::vector<int> m_variable_start_vector;
+    std::vector<int> m_variable_vector;
+    std::vector<int> m_local_index_vector;
+    std::vector<int> m_component_order_vector;
+    std::vector<Result_T> m_result_vector;
+};
+
+#endif
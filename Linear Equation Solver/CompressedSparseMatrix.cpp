@@ -0,0 +1,315 @@
+#include <algorithm>
+#include "CompressedSparseMatrix.h"
+
+//======================================================================
+//  Constructor: CompressedSparseMatrix::CompressedSparseMatrix
+//======================================================================
+
+CompressedSparseMatrix::CompressedSparseMatrix()
+{
+    Clear();
+}
+
+//======================================================================
+//  Destructor: CompressedSparseMatrix::~CompressedSparseMatrix
+//======================================================================
+
+CompressedSparseMatrix::~CompressedSparseMatrix()
+{
+}
+
+//======================================================================
+//  Member Function: CompressedSparseMatrix::Assign
+//
+//  Abstract:
+//
+//    This function sets the contents of the matrix. The passed vectors
+//    are swapped into the matrix, so they are empty on return.
+//
+//
+//  Input:
+//
+//    number_of_rows        The number of rows.
+//
+//    number_of_columns     The number of columns.
+//
+//    row_start_vector      The start of each row. This vector has
+//                          number_of_rows + 1 elements.
+//
+//    column_index_vector   The column index of each stored element.
+//
+//    value_vector          The value of each stored element.
+//
+//  Output:
+//
+//    This function has no return value.
+//
+//======================================================================
+
+void CompressedSparseMatrix::Assign(int number_of_rows,
+                                    int number_of_columns,
+                                    std::vector<size_t> & row_start_vector,
+                                    std::vector<int> & column_index_vector,
+                                    std::vector<double> & value_vector)
+{
+    m_number_of_rows = number_of_rows;
+    m_number_of_columns = number_of_columns;
+    m_row_start_vector.swap(row_start_vector);
+    m_column_index_vector.swap(column_index_vector);
+    m_value_vector.swap(value_vector);
+
+    row_start_vector.clear();
+    column_index_vector.clear();
+    value_vector.clear();
+
+    return;
+}
+
+//======================================================================
+//  Member Function: CompressedSparseMatrix::Clear
+//======================================================================
+
+void CompressedSparseMatrix::Clear()
+{
+    m_number_of_rows = 0;
+    m_number_of_columns = 0;
+    m_row_start_vector.assign(1, 0);
+    m_column_index_vector.clear();
+    m_value_vector.clear();
+    return;
+}
+
+//======================================================================
+//  Member Function: CompressedSparseMatrix::Swap
+//======================================================================
+
+void CompressedSparseMatrix::Swap(CompressedSparseMatrix & other_matrix)
+{
+    std::swap(m_number_of_rows, other_matrix.m_number_of_rows);
+    std::swap(m_number_of_columns, other_matrix.m_number_of_columns);
+    m_row_start_vector.swap(other_matrix.m_row_start_vector);
+    m_column_index_vector.swap(other_matrix.m_column_index_vector);
+    m_value_vector.swap(other_matrix.m_value_vector);
+    return;
+}
+
+//======================================================================
+//  Member Function: CompressedSparseMatrix::GetNumberOfRows
+//======================================================================
+
+int CompressedSparseMatrix::GetNumberOfRows() const
+{
+    return m_number_of_rows;
+}
+
+//======================================================================
+//  Member Function: CompressedSparseMatrix::GetNumberOfColumns
+//======================================================================
+
+int CompressedSparseMatrix::GetNumberOfColumns() const
+{
+    return m_number_of_columns;
+}
+
+//======================================================================
+//  Member Function: CompressedSparseMatrix::GetNumberOfNonzeros
+//
+//  Abstract:
+//
+//    This function returns the number of stored elements. A stored
+//    element can have the value zero if terms cancelled.
+//
+//======================================================================
+
+size_t CompressedSparseMatrix::GetNumberOfNonzeros() const
+{
+    return m_value_vector.size();
+}
+
+//======================================================================
+//  Member Function: CompressedSparseMatrix::GetRowStartArray
+//======================================================================
+
+const size_t * CompressedSparseMatrix::GetRowStartArray() const
+{
+    return m_row_start_vector.data();
+}
+
+//======================================================================
+//  Member Function: CompressedSparseMatrix::GetColumnIndexArray
+//======================================================================
+
+const int * CompressedSparseMatrix::GetColumnIndexArray() const
+{
+    return m_column_index_vector.data();
+}
+
+//======================================================================
+//  Member Function: CompressedSparseMatrix::GetValueArray
+//======================================================================
+
+const double * CompressedSparseMatrix::GetValueArray() const
+{
+    return m_value_vector.data();
+}
+
+double * CompressedSparseMatrix::GetValueArray()
+{
+    return m_value_vector.data();
+}
+
+//======================================================================
+//  Member Function: CompressedSparseMatrix::GetValue
+//
+//  Abstract:
+//
+//    This function returns the value of an element of the matrix.
+//    The value zero is returned for an element that is not stored.
+//
+//======================================================================
+
+double CompressedSparseMatrix::GetValue(int row, int column) const
+{
+    if ((row < 0) || (row >= m_number_of_rows))
+    {
+        return 0.0;
+    }
+
+    const int * start_ptr = m_column_index_vector.data() + m_row_start_vector[row];
+    const int * end_ptr = m_column_index_vector.data() + m_row_start_vector[row + 1];
+    const int * found_ptr = std::lower_bound(start_ptr, end_ptr, column);
+
+    if ((found_ptr != end_ptr) && (*found_ptr == column))
+    {
+        return m_value_vector[found_ptr - m_column_index_vector.data()];
+    }
+
+    return 0.0;
+}
+
+//======================================================================
+//  Member Function: CompressedSparseMatrix::Transpose
+//
+//  Abstract:
+//
+//    This function calculates the transpose of the matrix. Because
+//    the rows are visited in order, the column indices of the
+//    transpose are in increasing order.
+//
+//
+//  Input:
+//
+//    transpose_matrix      The matrix that is set to the transpose.
+//
+//  Output:
+//
+//    This function has no return value.
+//
+//======================================================================
+
+void CompressedSparseMatrix::Transpose(CompressedSparseMatrix & transpose_matrix) const
+{
+    size_t number_of_nonzeros = GetNumberOfNonzeros();
+
+    std::vector<size_t> row_start_vector(m_number_of_columns + 1, 0);
+    std::vector<int> column_index_vector(number_of_nonzeros);
+    std::vector<double> value_vector(number_of_nonzeros);
+
+    size_t k = 0;
+
+    for (k = 0; k < number_of_nonzeros; ++k)
+    {
+        ++row_start_vector[m_column_index_vector[k] + 1];
+    }
+
+    int column = 0;
+
+    for (column = 0; column < m_number_of_columns; ++column)
+    {
+        row_start_vector[column + 1] += row_start_vector[column];
+    }
+
+    std::vector<size_t> next_vector(row_start_vector.begin(), row_start_vector.end() - 1);
+
+    for (int row = 0; row < m_number_of_rows; ++row)
+    {
+        for (k = m_row_start_vector[row]; k < m_row_start_vector[row + 1]; ++k)
+        {
+            size_t destination = next_vector[m_column_index_vector[k]]++;
+            column_index_vector[destination] = row;
+            value_vector[destination] = m_value_vector[k];
+        }
+    }
+
+    transpose_matrix.Assign(m_number_of_columns,
+                            m_number_of_rows,
+                            row_start_vector,
+                            column_index_vector,
+                            value_vector);
+
+    return;
+}
+
+//======================================================================
+//  Member Function: CompressedSparseMatrix::Multiply
+//
+//  Abstract:
+//
+//    This function calculates y = A x.
+//
+//======================================================================
+
+void CompressedSparseMatrix::Multiply(const double * x_array, double * y_array) const
+{
+    for (int row = 0; row < m_number_of_rows; ++row)
+    {
+        double sum = 0.0;
+
+        for (size_t k = m_row_start_vector[row]; k < m_row_start_vector[row + 1]; ++k)
+        {
+            sum += m_value_vector[k] * x_array[m_column_index_vector[k]];
+        }
+
+        y_array[row] = sum;
+    }
+
+    return;
+}
+
+//======================================================================
+//  Member Function: CompressedSparseMatrix::CopyToSparseMatrix
+//
+//  Abstract:
+//
+//    This function stores every element of this matrix in a
+//    SparseMatrix. The elements are inserted in key order with a
+//    position hint, so no tree search is needed for each element.
+//
+//
+//  Input:
+//
+//    a_matrix          The sparse matrix. Any existing elements
+//                      are removed.
+//
+//  Output:
+//
+//    This function has no return value.
+//
+//======================================================================
+
+void CompressedSparseMatrix::CopyToSparseMatrix(MatrixPackage::SparseMatrix & a_matrix) const
+{
+    a_matrix.clear();
+
+    for (int row = 0; row < m_number_of_rows; ++row)
+    {
+        for (size_t k = m_row_start_vector[row]; k < m_row_start_vector[row + 1]; ++k)
+        {
+            a_matrix.insert(a_matrix.end(),
+                            MatrixPackage::SparseMatrix::value_type(DoubleIndex(row, m_column_index_vector[k]),
+                                                                     m_value_vector[k]));
+        }
+    }
+
+    return;
+}
@@ -0,0 +1,71 @@
+#ifndef COMPRESSEDSPARSEMATRIX_H
+#define COMPRESSEDSPARSEMATRIX_H
+
+#include <stddef.h>
+#include <vector>
+#include "MatrixPackage.h"
+
+//======================================================================
+//  Class Definition
+//
+//  This class stores a sparse matrix in compressed sparse row form.
+//  The column indices and the values of row 'i' are stored in the
+//  elements from GetRowStartArray()[i] up to, but not including,
+//  GetRowStartArray()[i + 1] of the column index and value arrays.
+//  The column indices within each row are in increasing order and
+//  are unique.
+//
+//  The same class stores a matrix in compressed sparse column form by
+//  storing the transpose of the matrix.
+//======================================================================
+
+class CompressedSparseMatrix
+{
+public:
+
+    CompressedSparseMatrix();
+
+    virtual ~CompressedSparseMatrix();
+
+    void Assign(int number_of_rows,
+                int number_of_columns,
+                std::vector<size_t> & row_start_vector,
+                std::vector<int> & column_index_vector,
+                std::vector<double> & value_vector);
+
+    void Clear();
+
+    void Swap(CompressedSparseMatrix & other_matrix);
+
+    int GetNumberOfRows() const;
+
+    int GetNumberOfColumns() const;
+
+    size_t GetNumberOfNonzeros() const;
+
+    const size_t * GetRowStartArray() const;
+
+    const int * GetColumnIndexArray() const;
+
+    const double * GetValueArray() const;
+
+    double * GetValueArray();
+
+    double GetValue(int row, int column) const;
+
+    void Transpose(CompressedSparseMatrix & transpose_matrix) const;
+
+    void Multiply(const double * x_array, double * y_array) const;
+
+    void CopyToSparseMatrix(MatrixPackage::SparseMatrix & a_matrix) const;
+
+protected:
+
+    int m_number_of_rows;
+    int m_number_of_columns;
+    std::vector<size_t> m_row_start_vector;
+    std::vector<int> m_column_index_vector;
+    std::vector<double> m_value_vector;
+};
+
+#endif
@@ -0,0 +1,307 @@
+#include <stdlib.h>
+#include "DecimalNumber.h"
+
+namespace
+{
+    //------------------------------------------------------------------
+    //  The powers of ten that are exactly representable as a double.
+    //------------------------------------------------------------------
+
+    const double f_EXACT_POWER_OF_TEN_ARRAY[] =
+    {
+        1.0e0,  1.0e1,  1.0e2,  1.0e3,  1.0e4,  1.0e5,  1.0e6,  1.0e7,
+        1.0e8,  1.0e9,  1.0e10, 1.0e11, 1.0e12, 1.0e13, 1.0e14, 1.0e15,
+        1.0e16, 1.0e17, 1.0e18, 1.0e19, 1.0e20, 1.0e21, 1.0e22
+    };
+
+    const int f_MAXIMUM_EXACT_POWER_OF_TEN = 22;
+
+    //------------------------------------------------------------------
+    //  A significand at or below 2^53 is exactly representable.
+    //------------------------------------------------------------------
+
+    const unsigned long long f_MAXIMUM_EXACT_SIGNIFICAND = 9007199254740992ULL;
+
+    const unsigned long long f_MAXIMUM_SIGNIFICAND_BEFORE_MULTIPLY =
+        (18446744073709551615ULL - 9ULL) / 10ULL;
+}
+
+//======================================================================
+//  Constructor: DecimalNumber::DecimalNumber
+//======================================================================
+
+DecimalNumber::DecimalNumber()
+{
+    Clear();
+}
+
+//======================================================================
+//  Member Function: DecimalNumber::Clear
+//======================================================================
+
+void DecimalNumber::Clear()
+{
+    m_significand = 0;
+    m_digit_count = 0;
+    m_fraction_digit_count = 0;
+    m_dropped_integer_digit_count = 0;
+    m_stored_digit_count = 0;
+    m_has_decimal_point_flag = false;
+    m_significand_overflow_flag = false;
+    m_nonzero_digit_dropped_flag = false;
+    m_exponent = 0;
+    return;
+}
+
+//======================================================================
+//  Member Function: DecimalNumber::AppendDigit
+//
+//  Abstract:
+//
+//    This function appends the next digit of the number. Leading
+//    zeros are counted but are not stored.
+//
+//
+//  Input:
+//
+//    digit             A character from '0' to '9'.
+//
+//  Output:
+//
+//    This function has no return value.
+//
+//======================================================================
+
+void DecimalNumber::AppendDigit(char digit)
+{
+    ++m_digit_count;
+
+    if (m_has_decimal_point_flag)
+    {
+        ++m_fraction_digit_count;
+    }
+
+    if ((m_stored_digit_count == 0) && (digit == '0'))
+    {
+        return;
+    }
+
+    if (m_stored_digit_count < MAXIMUM_STORED_DIGITS)
+    {
+        m_digit_array[m_stored_digit_count++] = digit;
+
+        if (m_significand > f_MAXIMUM_SIGNIFICAND_BEFORE_MULTIPLY)
+        {
+            m_significand_overflow_flag = true;
+        }
+        else
+        {
+            m_significand = m_significand * 10ULL + (unsigned long long)(digit - '0');
+        }
+    }
+    else
+    {
+        //--------------------------------------------------------------
+        //  The digit does not fit. Treat the number as if the digit was
+        //  still there by scaling the exponent, and remember whether
+        //  the dropped digits were all zero for rounding.
+        //--------------------------------------------------------------
+
+        if (m_has_decimal_point_flag)
+        {
+            --m_fraction_digit_count;
+        }
+        else
+        {
+            ++m_dropped_integer_digit_count;
+        }
+
+        if (digit != '0')
+        {
+            m_nonzero_digit_dropped_flag = true;
+        }
+    }
+
+    return;
+}
+
+//======================================================================
+//  Member Function: DecimalNumber::AppendDecimalPoint
+//======================================================================
+
+void DecimalNumber::AppendDecimalPoint()
+{
+    m_has_decimal_point_flag = true;
+    return;
+}
+
+//======================================================================
+//  Member Function: DecimalNumber::SetExponent
+//
+//  Abstract:
+//
+//    This function sets the power of ten that the number is scaled
+//    by. This is the exponent following the '^' character.
+//
+//======================================================================
+
+void DecimalNumber::SetExponent(int exponent)
+{
+    m_exponent = exponent;
+    return;
+}
+
+//======================================================================
+//  Member Function: DecimalNumber::GetDigitCount
+//======================================================================
+
+unsigned int DecimalNumber::GetDigitCount() const
+{
+    return m_digit_count;
+}
+
+//======================================================================
+//  Member Function: DecimalNumber::GetLength
+//
+//  Abstract:
+//
+//    This function returns the number of characters that were
+//    scanned, which is the number of digits plus one if there is a
+//    decimal point.
+//
+//======================================================================
+
+unsigned int DecimalNumber::GetLength() const
+{
+    return m_digit_count + (m_has_decimal_point_flag ? 1 : 0);
+}
+
+//======================================================================
+//  Member Function: DecimalNumber::HasDecimalPoint
+//======================================================================
+
+bool DecimalNumber::HasDecimalPoint() const
+{
+    return m_has_decimal_point_flag;
+}
+
+//======================================================================
+//  Member Function: DecimalNumber::GetIntegerValue
+//
+//  Abstract:
+//
+//    This function returns the digits as an integer. This is only
+//    meaningful for short numbers without a decimal point such as
+//    exponents.
+//
+//======================================================================
+
+int DecimalNumber::GetIntegerValue() const
+{
+    return (int)(m_significand);
+}
+
+//======================================================================
+//  Member Function: DecimalNumber::ToDouble
+//
+//  Abstract:
+//
+//    This function returns the double precision value nearest to
+//    the number.
+//
+//
+//  Input:
+//
+//    None.
+//
+//  Output:
+//
+//    This function returns a value of type 'double' that is the
+//    correctly rounded value of the number.
+//
+//======================================================================
+
+double DecimalNumber::ToDouble() const
+{
+    if (m_stored_digit_count == 0)
+    {
+        return 0.0;
+    }
+
+    int decimal_exponent = m_exponent
+        + (int)(m_dropped_integer_digit_count)
+        - (int)(m_fraction_digit_count);
+
+    //------------------------------------------------------------------
+    //  If both the significand and the power of ten are exact then a
+    //  single floating-point operation gives the correctly rounded
+    //  result.
+    //------------------------------------------------------------------
+
+    if ((! m_significand_overflow_flag)
+        && (! m_nonzero_digit_dropped_flag)
+        && (m_significand <= f_MAXIMUM_EXACT_SIGNIFICAND)
+        && (decimal_exponent >= - f_MAXIMUM_EXACT_POWER_OF_TEN)
+        && (decimal_exponent <= f_MAXIMUM_EXACT_POWER_OF_TEN))
+    {
+        double value = (double)(m_significand);
+
+        if (decimal_exponent < 0)
+        {
+            value /= f_EXACT_POWER_OF_TEN_ARRAY[- decimal_exponent];
+        }
+        else
+        {
+            value *= f_EXACT_POWER_OF_TEN_ARRAY[decimal_exponent];
+        }
+
+        return value;
+    }
+
+    //------------------------------------------------------------------
+    //  Otherwise build the string "<digits>e<exponent>" on the stack.
+    //  If any nonzero digit was dropped then a trailing '1' is added
+    //  so that the value rounds the same way as the full number.
+    //------------------------------------------------------------------
+
+    char buffer[MAXIMUM_STORED_DIGITS + 16];
+    unsigned int length = 0;
+
+    for (unsigned int i = 0; i < m_stored_digit_count; ++i)
+    {
+        buffer[length++] = m_digit_array[i];
+    }
+
+    if (m_nonzero_digit_dropped_flag)
+    {
+        buffer[length++] = '1';
+        --decimal_exponent;
+    }
+
+    buffer[length++] = 'e';
+
+    if (decimal_exponent < 0)
+    {
+        buffer[length++] = '-';
+        decimal_exponent = - decimal_exponent;
+    }
+
+    char exponent_digit_array[12];
+    unsigned int exponent_length = 0;
+
+    do
+    {
+        exponent_digit_array[exponent_length++] = (char)('0' + decimal_exponent % 10);
+        decimal_exponent /= 10;
+    }
+    while (decimal_exponent != 0);
+
+    while (exponent_length != 0)
+    {
+        buffer[length++] = exponent_digit_array[--exponent_length];
+    }
+
+    buffer[length] = '\0';
+
+    return strtod(buffer, 0);
+}
@@ -0,0 +1,62 @@
+#ifndef DECIMALNUMBER_H
+#define DECIMALNUMBER_H
+
+//======================================================================
+//  Class Definition
+//
+//  This class accumulates the digits of a decimal number one at a
+//  time while the number is scanned, and then converts the number to
+//  the nearest double precision value.
+//
+//  No heap memory is used. When the significant digits fit in 53 bits
+//  and the power of ten is exactly representable the conversion is a
+//  single multiply or divide, which is correctly rounded. Otherwise
+//  the digits are converted by strtod from a small buffer on the
+//  stack. The buffer never contains a decimal point, so the result
+//  does not depend on the current locale.
+//======================================================================
+
+class DecimalNumber
+{
+public:
+
+    enum
+    {
+        MAXIMUM_STORED_DIGITS = 40
+    };
+
+    DecimalNumber();
+
+    void Clear();
+
+    void AppendDigit(char digit);
+
+    void AppendDecimalPoint();
+
+    void SetExponent(int exponent);
+
+    unsigned int GetDigitCount() const;
+
+    unsigned int GetLength() const;
+
+    bool HasDecimalPoint() const;
+
+    int GetIntegerValue() const;
+
+    double ToDouble() const;
+
+private:
+
+    unsigned long long m_significand;
+    unsigned int m_digit_count;
+    unsigned int m_fraction_digit_count;
+    unsigned int m_dropped_integer_digit_count;
+    unsigned int m_stored_digit_count;
+    bool m_has_decimal_point_flag;
+    bool m_significand_overflow_flag;
+    bool m_nonzero_digit_dropped_flag;
+    int m_exponent;
+    char m_digit_array[MAXIMUM_STORED_DIGITS];
+};
+
+#endif
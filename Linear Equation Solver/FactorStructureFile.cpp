@@ -0,0 +1,386 @@
+#include <stdio.h>
+#include <string.h>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "FactorStructureFile.h"
+#include "CacheFileSection.h"
+#include "SystemCacheFile.h"
+#include "MappedFile.h"
+
+namespace
+{
+    //------------------------------------------------------------------
+    //  The file identification and format version. Change the version
+    //  whenever the layout of the file or the factor structure changes.
+    //------------------------------------------------------------------
+
+    const char f_STRUCTURE_MAGIC[8] = { 'L', 'E', 'S', 'L', 'U', 'S', 'T', 'R' };
+    const uint32_t f_STRUCTURE_VERSION = 1;
+
+    //------------------------------------------------------------------
+    //  Test that an array holds a permutation of 0 to n - 1.
+    //------------------------------------------------------------------
+
+    bool IsPermutation(const int32_t * index_array, uint32_t n)
+    {
+        std::vector<bool> found_vector(n, false);
+
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            if ((index_array[i] < 0) || ((uint32_t)(index_array[i]) >= n) || found_vector[index_array[i]])
+            {
+                return false;
+            }
+
+            found_vector[index_array[i]] = true;
+        }
+
+        return true;
+    }
+
+    //------------------------------------------------------------------
+    //  Test the column starts of a factor. The diagonal is the first
+    //  element of each column of L and the last element of each column
+    //  of U, and the other rows must be below or above the diagonal.
+    //------------------------------------------------------------------
+
+    bool IsFactorPattern(const uint64_t * start_array,
+                         const int32_t * index_array,
+                         uint32_t n,
+                         uint64_t number_of_nonzeros,
+                         bool lower_flag)
+    {
+        if ((start_array[0] != 0) || (start_array[n] != number_of_nonzeros))
+        {
+            return false;
+        }
+
+        for (uint32_t k = 0; k < n; ++k)
+        {
+            uint64_t column_start = start_array[k];
+            uint64_t column_end = start_array[k + 1];
+
+            if (column_end <= column_start)
+            {
+                return false;
+            }
+
+            uint64_t diagonal = lower_flag ? column_start : column_end - 1;
+
+            if (index_array[diagonal] != (int32_t)(k))
+            {
+                return false;
+            }
+
+            for (uint64_t p = column_start; p < column_end; ++p)
+            {
+                if (p == diagonal)
+                {
+                    continue;
+                }
+
+                int32_t row = index_array[p];
+
+                if (lower_flag
+                    ? ((row <= (int32_t)(k)) || ((uint32_t)(row) >= n))
+                    : ((row < 0) || (row >= (int32_t)(k))))
+                {
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+}
+
+//======================================================================
+//  Member Function: FactorStructureFile::GetPatternKey
+//
+//  Abstract:
+//
+//    This function calculates the pattern key of a system of
+//    equations from the size, the column indices of the stored
+//    elements of each row, and the variable names in index order.
+//
+//
+//  Input:
+//
+//    a_matrix          The A matrix.
+//
+//    n                 The number of equations and variables. Only
+//                      the elements in the first n rows and the first
+//                      n columns are used.
+//
+//    symbol_table      The variable names.
+//
+//  Output:
+//
+//    This function returns the pattern key.
+//
+//======================================================================
+
+uint64_t FactorStructureFile::GetPatternKey(const FrozenSparseMatrix & a_matrix,
+                                            int n,
+                                            const VariableSymbolTable & symbol_table)
+{
+    //------------------------------------------------------------------
+    //  Each row is its number of elements followed by its columns.
+    //------------------------------------------------------------------
+
+    std::vector<int32_t> pattern_vector;
+    pattern_vector.reserve(a_matrix.GetNumberOfNonzeros() + n + 1);
+    pattern_vector.push_back(n);
+
+    int number_of_rows = (n < a_matrix.GetNumberOfRows()) ? n : a_matrix.GetNumberOfRows();
+    int row = 0;
+
+    for (row = 0; row < number_of_rows; ++row)
+    {
+        SparseSlice row_slice = a_matrix.GetRow(row);
+        size_t count_position = pattern_vector.size();
+        pattern_vector.push_back(0);
+
+        for (SparseSlice::Iterator row_iter = row_slice.begin(); row_iter != row_slice.end(); ++row_iter)
+        {
+            if (row_iter.GetIndex() < n)
+            {
+                pattern_vector.push_back(row_iter.GetIndex());
+            }
+        }
+
+        pattern_vector[count_position] = (int32_t)(pattern_vector.size() - count_position - 1);
+    }
+
+    //------------------------------------------------------------------
+    //  Each name is preceded by its length.
+    //------------------------------------------------------------------
+
+    std::vector<char> name_vector;
+
+    for (unsigned int i = 0; i < symbol_table.GetSize(); ++i)
+    {
+        CharSpan name_span = symbol_table.GetName((int)(i));
+        uint32_t length = name_span.Length();
+        const char * length_ptr = (const char *)(&length);
+
+        name_vector.insert(name_vector.end(), length_ptr, length_ptr + sizeof(length));
+        name_vector.insert(name_vector.end(), name_span.Data(), name_span.Data() + length);
+    }
+
+    uint64_t hash_array[2];
+
+    hash_array[0] = SystemCacheFile::HashContent((const char *)(pattern_vector.data()),
+                                                 pattern_vector.size() * sizeof(int32_t));
+
+    hash_array[1] = SystemCacheFile::HashContent(name_vector.data(), name_vector.size());
+
+    return SystemCacheFile::HashContent((const char *)(hash_array), sizeof(hash_array));
+}
+
+//======================================================================
+//  Member Function: FactorStructureFile::Write
+//
+//  Abstract:
+//
+//    This function writes a factor structure to a file. The factor
+//    structure must include the row pivots and the patterns of L and
+//    U.
+//
+//
+//  Input:
+//
+//    file_name_ptr     A pointer to the name of the file.
+//
+//    pattern_key       The pattern key of the equations.
+//
+//    structure         The factor structure.
+//
+//
+//  Output:
+//
+//    This function returns a value of type 'bool' that is the value
+//    true if and only if the file was written.
+//
+//======================================================================
+
+bool FactorStructureFile::Write(const char * file_name_ptr,
+                                uint64_t pattern_key,
+                                const SparseLU::Structure_T & structure)
+{
+    uint64_t n = (uint64_t)(structure.m_n);
+    uint64_t number_of_lower_nonzeros = structure.m_lower_index_vector.size();
+    uint64_t number_of_upper_nonzeros = structure.m_upper_index_vector.size();
+
+    if ((structure.m_lower_start_vector.size() != n + 1)
+        || (structure.m_upper_start_vector.size() != n + 1))
+    {
+        return false;
+    }
+
+    //------------------------------------------------------------------
+    //  Lay out the file.
+    //------------------------------------------------------------------
+
+    Header_T header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.m_magic, f_STRUCTURE_MAGIC, sizeof(header.m_magic));
+    header.m_version = f_STRUCTURE_VERSION;
+    header.m_header_size = (uint32_t)(sizeof(Header_T));
+    header.m_pattern_key = pattern_key;
+    header.m_n = (uint32_t)(n);
+    header.m_number_of_lower_nonzeros = number_of_lower_nonzeros;
+    header.m_number_of_upper_nonzeros = number_of_upper_nonzeros;
+
+    header.m_column_order_offset = CacheFileSection::AlignOffset(sizeof(Header_T));
+    header.m_row_pivot_offset = CacheFileSection::AlignOffset(header.m_column_order_offset + n * sizeof(int32_t));
+    header.m_lower_start_offset = CacheFileSection::AlignOffset(header.m_row_pivot_offset + n * sizeof(int32_t));
+    header.m_lower_index_offset = CacheFileSection::AlignOffset(header.m_lower_start_offset + (n + 1) * sizeof(uint64_t));
+    header.m_upper_start_offset = CacheFileSection::AlignOffset(header.m_lower_index_offset + number_of_lower_nonzeros * sizeof(int32_t));
+    header.m_upper_index_offset = CacheFileSection::AlignOffset(header.m_upper_start_offset + (n + 1) * sizeof(uint64_t));
+    header.m_file_size = CacheFileSection::AlignOffset(header.m_upper_index_offset + number_of_upper_nonzeros * sizeof(int32_t));
+
+    //------------------------------------------------------------------
+    //  Write the file under a temporary name. The arrays are stored
+    //  with fixed widths that do not depend on the platform.
+    //------------------------------------------------------------------
+
+    std::string temporary_file_name = std::string(file_name_ptr) + ".tmp";
+    std::ofstream structure_file(temporary_file_name.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+
+    if (structure_file.fail())
+    {
+        return false;
+    }
+
+    std::vector<int32_t> column_order_vector(structure.m_column_order_vector.begin(), structure.m_column_order_vector.end());
+    std::vector<int32_t> row_pivot_vector(structure.m_row_pivot_vector.begin(), structure.m_row_pivot_vector.end());
+    std::vector<uint64_t> lower_start_vector(structure.m_lower_start_vector.begin(), structure.m_lower_start_vector.end());
+    std::vector<int32_t> lower_index_vector(structure.m_lower_index_vector.begin(), structure.m_lower_index_vector.end());
+    std::vector<uint64_t> upper_start_vector(structure.m_upper_start_vector.begin(), structure.m_upper_start_vector.end());
+    std::vector<int32_t> upper_index_vector(structure.m_upper_index_vector.begin(), structure.m_upper_index_vector.end());
+
+    uint64_t position = 0;
+
+    CacheFileSection::Write(structure_file, &header, sizeof(header), position);
+    CacheFileSection::Write(structure_file, column_order_vector.data(), n * sizeof(int32_t), position);
+    CacheFileSection::Write(structure_file, row_pivot_vector.data(), n * sizeof(int32_t), position);
+    CacheFileSection::Write(structure_file, lower_start_vector.data(), (n + 1) * sizeof(uint64_t), position);
+    CacheFileSection::Write(structure_file, lower_index_vector.data(), number_of_lower_nonzeros * sizeof(int32_t), position);
+    CacheFileSection::Write(structure_file, upper_start_vector.data(), (n + 1) * sizeof(uint64_t), position);
+    CacheFileSection::Write(structure_file, upper_index_vector.data(), number_of_upper_nonzeros * sizeof(int32_t), position);
+
+    structure_file.close();
+
+    if (structure_file.fail() || (position != header.m_file_size))
+    {
+        remove(temporary_file_name.c_str());
+        return false;
+    }
+
+    return CacheFileSection::ReplaceFile(temporary_file_name.c_str(), file_name_ptr);
+}
+
+//======================================================================
+//  Member Function: FactorStructureFile::Read
+//
+//  Abstract:
+//
+//    This function reads a factor structure from a file. The file is
+//    memory-mapped and checked before the factor structure is changed.
+//    The file is not used if it has a different format version or
+//    pattern key, or if it is damaged.
+//
+//
+//  Input:
+//
+//    file_name_ptr     A pointer to the name of the file.
+//
+//    pattern_key       The pattern key of the equations.
+//
+//    structure         The factor structure.
+//
+//
+//  Output:
+//
+//    This function returns a value of type 'bool' that is the value
+//    true if and only if the factor structure was read.
+//
+//======================================================================
+
+bool FactorStructureFile::Read(const char * file_name_ptr,
+                               uint64_t pattern_key,
+                               SparseLU::Structure_T & structure)
+{
+    MappedFile structure_file;
+
+    if ((! structure_file.Open(file_name_ptr)) || (structure_file.GetSize() < sizeof(Header_T)))
+    {
+        return false;
+    }
+
+    //------------------------------------------------------------------
+    //  Check the header.
+    //------------------------------------------------------------------
+
+    const char * data_ptr = structure_file.GetData();
+    uint64_t file_size = structure_file.GetSize();
+
+    Header_T header;
+    memcpy(&header, data_ptr, sizeof(header));
+
+    if ((memcmp(header.m_magic, f_STRUCTURE_MAGIC, sizeof(header.m_magic)) != 0)
+        || (header.m_version != f_STRUCTURE_VERSION)
+        || (header.m_header_size != sizeof(Header_T))
+        || (header.m_file_size != file_size)
+        || (header.m_pattern_key != pattern_key))
+    {
+        return false;
+    }
+
+    uint64_t n = header.m_n;
+
+    if ((! CacheFileSection::IsInFile(header.m_column_order_offset, n, sizeof(int32_t), file_size))
+        || (! CacheFileSection::IsInFile(header.m_row_pivot_offset, n, sizeof(int32_t), file_size))
+        || (! CacheFileSection::IsInFile(header.m_lower_start_offset, n + 1, sizeof(uint64_t), file_size))
+        || (! CacheFileSection::IsInFile(header.m_lower_index_offset, header.m_number_of_lower_nonzeros, sizeof(int32_t), file_size))
+        || (! CacheFileSection::IsInFile(header.m_upper_start_offset, n + 1, sizeof(uint64_t), file_size))
+        || (! CacheFileSection::IsInFile(header.m_upper_index_offset, header.m_number_of_upper_nonzeros, sizeof(int32_t), file_size)))
+    {
+        return false;
+    }
+
+    //------------------------------------------------------------------
+    //  Check the permutations and the patterns.
+    //------------------------------------------------------------------
+
+    const int32_t * column_order_array = (const int32_t *)(data_ptr + header.m_column_order_offset);
+    const int32_t * row_pivot_array = (const int32_t *)(data_ptr + header.m_row_pivot_offset);
+    const uint64_t * lower_start_array = (const uint64_t *)(data_ptr + header.m_lower_start_offset);
+    const int32_t * lower_index_array = (const int32_t *)(data_ptr + header.m_lower_index_offset);
+    const uint64_t * upper_start_array = (const uint64_t *)(data_ptr + header.m_upper_start_offset);
+    const int32_t * upper_index_array = (const int32_t *)(data_ptr + header.m_upper_index_offset);
+
+    if ((! IsPermutation(column_order_array, header.m_n))
+        || (! IsPermutation(row_pivot_array, header.m_n))
+        || (! IsFactorPattern(lower_start_array, lower_index_array, header.m_n, header.m_number_of_lower_nonzeros, true))
+        || (! IsFactorPattern(upper_start_array, upper_index_array, header.m_n, header.m_number_of_upper_nonzeros, false)))
+    {
+        return false;
+    }
+
+    //------------------------------------------------------------------
+    //  Copy the factor structure.
+    //------------------------------------------------------------------
+
+    structure.m_n = (int)(n);
+    structure.m_column_order_vector.assign(column_order_array, column_order_array + n);
+    structure.m_row_pivot_vector.assign(row_pivot_array, row_pivot_array + n);
+    structure.m_lower_start_vector.assign(lower_start_array, lower_start_array + n + 1);
+    structure.m_lower_index_vector.assign(lower_index_array, lower_index_array + header.m_number_of_lower_nonzeros);
+    structure.m_upper_start_vector.assign(upper_start_array, upper_start_array + n + 1);
+    structure.m_upper_index_vector.assign(upper_index_array, upper_index_array + header.m_number_of_upper_nonzeros);
+
+    return true;
+}
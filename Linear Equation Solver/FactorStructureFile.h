@@ -0,0 +1,69 @@
+#ifndef FACTORSTRUCTUREFILE_H
+#define FACTORSTRUCTUREFILE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "VariableSymbolTable.h"
+#include "FrozenSparseMatrix.h"
+#include "SparseLU.h"
+
+//======================================================================
+//  Class Definition
+//
+//  This class writes the factor structure of a sparse LU
+//  factorization to a binary file and reads it back, so that a later
+//  run on equations with the same variables and the same nonzero
+//  pattern can skip the analysis.
+//
+//  Each file is stored with a pattern key, which is a hash of the
+//  nonzero pattern of the A matrix and of the variable names in index
+//  order. The variable order is part of the key because the columns
+//  of the A matrix are numbered by the variable indices. A file is
+//  only read if the key and the format version match.
+//
+//  The file is laid out as described for the CacheFileSection class.
+//======================================================================
+
+class FactorStructureFile
+{
+public:
+
+    static uint64_t GetPatternKey(const FrozenSparseMatrix & a_matrix,
+                                  int n,
+                                  const VariableSymbolTable & symbol_table);
+
+    static bool Write(const char * file_name_ptr,
+                      uint64_t pattern_key,
+                      const SparseLU::Structure_T & structure);
+
+    static bool Read(const char * file_name_ptr,
+                     uint64_t pattern_key,
+                     SparseLU::Structure_T & structure);
+
+protected:
+
+    //------------------------------------------------------------------
+    //  The file header. Every offset is from the start of the file.
+    //------------------------------------------------------------------
+
+    struct Header_T
+    {
+        char m_magic[8];
+        uint32_t m_version;
+        uint32_t m_header_size;
+        uint64_t m_pattern_key;
+        uint32_t m_n;
+        uint32_t m_reserved;
+        uint64_t m_number_of_lower_nonzeros;
+        uint64_t m_number_of_upper_nonzeros;
+        uint64_t m_column_order_offset;
+        uint64_t m_row_pivot_offset;
+        uint64_t m_lower_start_offset;
+        uint64_t m_lower_index_offset;
+        uint64_t m_upper_start_offset;
+        uint64_t m_upper_index_offset;
+        uint64_t m_file_size;
+    };
+};
+
+#endif
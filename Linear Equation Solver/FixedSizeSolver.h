@@ -0,0 +1,262 @@
+#ifndef FIXEDSIZESOLVER_H
+#define FIXEDSIZESOLVER_H
+
+#include <math.h>
+#include <array>
+
+//------------------------------------------------------------------
+//  Class definition for class FixedSizeEliminationStep.
+//
+//  This class eliminates one column of a fixed size matrix. The
+//  column is a template parameter and each step runs the next step,
+//  so the elimination of every column is a separate function with
+//  constant loop bounds, which the compiler unrolls completely.
+//------------------------------------------------------------------
+
+template <int T_SIZE, int T_COLUMN>
+
+class FixedSizeEliminationStep
+{
+public:
+
+    static void Run(std::array<double, T_SIZE * T_SIZE> & lu_array,
+                    std::array<int, T_SIZE> & row_order_array,
+                    bool & singular_flag);
+};
+
+//------------------------------------------------------------------
+//  The step after the last column does nothing.
+//------------------------------------------------------------------
+
+template <int T_SIZE>
+
+class FixedSizeEliminationStep<T_SIZE, T_SIZE>
+{
+public:
+
+    static void Run(std::array<double, T_SIZE * T_SIZE> &,
+                    std::array<int, T_SIZE> &,
+                    bool &)
+    {
+    }
+};
+
+//------------------------------------------------------------------
+//  Class definition for class FixedSizeSolver.
+//
+//  This class solves the simultaneous linear equations A x = B where
+//  the number of equations is a template parameter, for the small
+//  systems that are solved many times. The A matrix is stored by rows
+//  in a std::array, so nothing is allocated.
+//
+//  Factor does Gaussian elimination with partial pivoting in place,
+//  with the same pivots and the same operations, in the same order,
+//  as the dense elimination of class LinearSystemSolver, so the
+//  solutions are the same. Rows are exchanged by moving the elements
+//  of the rows. The pivot is chosen by selecting values rather than
+//  by branching, a row is exchanged even with itself, and a zero
+//  multiplier is not skipped, so the only branches are the loops,
+//  which have constant bounds. A zero pivot is recorded and the
+//  elimination continues, and Factor returns false at the end.
+//
+//  Row i of the factors is row row_order_array[i] of A, and the
+//  multipliers of L are stored below the diagonal.
+//------------------------------------------------------------------
+
+template <int T_SIZE>
+
+class FixedSizeSolver
+{
+public:
+
+    typedef std::array<double, T_SIZE * T_SIZE> Matrix_T;
+    typedef std::array<double, T_SIZE> Vector_T;
+    typedef std::array<int, T_SIZE> RowOrder_T;
+
+    static bool Factor(Matrix_T & lu_array,
+                       RowOrder_T & row_order_array);
+
+    static void Solve(const Matrix_T & lu_array,
+                      const RowOrder_T & row_order_array,
+                      const Vector_T & b_array,
+                      Vector_T & x_array);
+
+    static bool Solve(Matrix_T a_array,
+                      const Vector_T & b_array,
+                      Vector_T & x_array);
+};
+
+//----------------------------------------------------------------------
+//  Implementation for methods of class FixedSizeEliminationStep.
+//
+//  static void Run(std::array<double, T_SIZE * T_SIZE> & lu_array,
+//                  std::array<int, T_SIZE> & row_order_array,
+//                  bool & singular_flag);
+//----------------------------------------------------------------------
+
+template <int T_SIZE, int T_COLUMN>
+
+void FixedSizeEliminationStep<T_SIZE, T_COLUMN>::Run(std::array<double, T_SIZE * T_SIZE> & lu_array,
+                                                     std::array<int, T_SIZE> & row_order_array,
+                                                     bool & singular_flag)
+{
+    const int pivot_index = T_COLUMN * T_SIZE + T_COLUMN;
+    int i = 0;
+    int j = 0;
+
+    //------------------------------------------------------------------
+    //  Find the first row with the largest element in the column.
+    //------------------------------------------------------------------
+
+    int pivot_row = T_COLUMN;
+    double pivot_magnitude = fabs(lu_array[pivot_index]);
+
+    for (i = T_COLUMN + 1; i < T_SIZE; ++i)
+    {
+        double magnitude = fabs(lu_array[i * T_SIZE + T_COLUMN]);
+        bool larger_flag = magnitude > pivot_magnitude;
+        pivot_row = larger_flag ? i : pivot_row;
+        pivot_magnitude = larger_flag ? magnitude : pivot_magnitude;
+    }
+
+    singular_flag = singular_flag | (pivot_magnitude == 0.0);
+
+    //------------------------------------------------------------------
+    //  Exchange the pivot row with the row of the column.
+    //------------------------------------------------------------------
+
+    for (j = 0; j < T_SIZE; ++j)
+    {
+        double element = lu_array[T_COLUMN * T_SIZE + j];
+        lu_array[T_COLUMN * T_SIZE + j] = lu_array[pivot_row * T_SIZE + j];
+        lu_array[pivot_row * T_SIZE + j] = element;
+    }
+
+    int row_number = row_order_array[T_COLUMN];
+    row_order_array[T_COLUMN] = row_order_array[pivot_row];
+    row_order_array[pivot_row] = row_number;
+
+    //------------------------------------------------------------------
+    //  Eliminate the column from the rows below the pivot row.
+    //------------------------------------------------------------------
+
+    for (i = T_COLUMN + 1; i < T_SIZE; ++i)
+    {
+        double multiplier = lu_array[i * T_SIZE + T_COLUMN] / lu_array[pivot_index];
+
+        for (j = T_COLUMN + 1; j < T_SIZE; ++j)
+        {
+            lu_array[i * T_SIZE + j] -= multiplier * lu_array[T_COLUMN * T_SIZE + j];
+        }
+
+        lu_array[i * T_SIZE + T_COLUMN] = multiplier;
+    }
+
+    FixedSizeEliminationStep<T_SIZE, T_COLUMN + 1>::Run(lu_array, row_order_array, singular_flag);
+
+    return;
+}
+
+//----------------------------------------------------------------------
+//  Implementation for methods of class FixedSizeSolver.
+//
+//  static bool Factor(Matrix_T & lu_array,
+//                     RowOrder_T & row_order_array);
+//
+//  The A matrix is passed in lu_array and is replaced by the factors.
+//  Returns false if a pivot is zero.
+//----------------------------------------------------------------------
+
+template <int T_SIZE>
+
+bool FixedSizeSolver<T_SIZE>::Factor(Matrix_T & lu_array,
+                                     RowOrder_T & row_order_array)
+{
+    bool singular_flag = false;
+
+    for (int i = 0; i < T_SIZE; ++i)
+    {
+        row_order_array[i] = i;
+    }
+
+    FixedSizeEliminationStep<T_SIZE, 0>::Run(lu_array, row_order_array, singular_flag);
+
+    return ! singular_flag;
+}
+
+//----------------------------------------------------------------------
+//  static void Solve(const Matrix_T & lu_array,
+//                    const RowOrder_T & row_order_array,
+//                    const Vector_T & b_array,
+//                    Vector_T & x_array);
+//
+//  Solve with the factors. The B vector and the solution can be the
+//  same array.
+//----------------------------------------------------------------------
+
+template <int T_SIZE>
+
+void FixedSizeSolver<T_SIZE>::Solve(const Matrix_T & lu_array,
+                                    const RowOrder_T & row_order_array,
+                                    const Vector_T & b_array,
+                                    Vector_T & x_array)
+{
+    Vector_T y_array;
+    int i = 0;
+    int j = 0;
+
+    for (i = 0; i < T_SIZE; ++i)
+    {
+        double y_value = b_array[row_order_array[i]];
+
+        for (j = 0; j < i; ++j)
+        {
+            y_value -= lu_array[i * T_SIZE + j] * y_array[j];
+        }
+
+        y_array[i] = y_value;
+    }
+
+    for (i = T_SIZE - 1; i >= 0; --i)
+    {
+        double sum = y_array[i];
+
+        for (j = i + 1; j < T_SIZE; ++j)
+        {
+            sum -= lu_array[i * T_SIZE + j] * x_array[j];
+        }
+
+        x_array[i] = sum / lu_array[i * T_SIZE + i];
+    }
+
+    return;
+}
+
+//----------------------------------------------------------------------
+//  static bool Solve(Matrix_T a_array,
+//                    const Vector_T & b_array,
+//                    Vector_T & x_array);
+//
+//  Factor a copy of the A matrix and solve. Returns false, and leaves
+//  the solution unchanged, if a pivot is zero.
+//----------------------------------------------------------------------
+
+template <int T_SIZE>
+
+bool FixedSizeSolver<T_SIZE>::Solve(Matrix_T a_array,
+                                    const Vector_T & b_array,
+                                    Vector_T & x_array)
+{
+    RowOrder_T row_order_array;
+
+    if (! Factor(a_array, row_order_array))
+    {
+        return false;
+    }
+
+    Solve(a_array, row_order_array, b_array, x_array);
+
+    return true;
+}
+
+#endif
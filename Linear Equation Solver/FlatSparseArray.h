@@ -0,0 +1,643 @@
+#ifndef FLATSPARSEARRAY_H
+#define FLATSPARSEARRAY_H
+
+#include <stddef.h>
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+//------------------------------------------------------------------
+//  Forward declarations.
+//------------------------------------------------------------------
+
+template <typename T_KEY, typename T_ITEM>
+
+class FlatSparseArray;
+
+//------------------------------------------------------------------
+//  Class definition for class FlatSparseArrayProxy.
+//
+//  This is the proxy class for class FlatSparseArray below. It has
+//  the same semantics as class SparseArrayProxy. Reading an element
+//  that is not stored gives the value T_ITEM(). Assigning another
+//  proxy whose value is T_ITEM() removes the element, and assigning
+//  an item stores the item even if it is T_ITEM().
+//------------------------------------------------------------------
+
+template <typename T_KEY, typename T_ITEM>
+
+class FlatSparseArrayProxy
+{
+public:
+
+    FlatSparseArrayProxy(FlatSparseArray<T_KEY, T_ITEM> & sparse_array, T_KEY key);
+
+    FlatSparseArrayProxy & operator =(const FlatSparseArrayProxy<T_KEY, T_ITEM> & right_hand_side);
+
+    FlatSparseArrayProxy & operator =(T_ITEM item);
+
+    operator T_ITEM() const;
+
+private:
+
+    FlatSparseArray<T_KEY, T_ITEM> & m_sparse_array;
+    T_KEY m_key;
+};
+
+//------------------------------------------------------------------
+//  Class definition for the flat sparse array.
+//
+//  This class is an alternative to class SparseArray that does not
+//  allocate a tree node for each element. The elements are stored
+//  in a vector sorted by key, so a lookup is a binary search over
+//  contiguous memory.
+//
+//  A new key that is larger than every stored key is appended. Any
+//  other new key is inserted into a small sorted staging vector,
+//  which is merged into the main vector when it grows past about
+//  the square root of the number of elements. Lookups search both
+//  vectors.
+//
+//  The class provides the subset of the std::map interface that is
+//  used with SparseArray. Iterating, or calling any method that
+//  returns an iterator, first merges the staging vector, so the
+//  elements are always visited in key order. Unlike std::map, any
+//  insertion or removal can invalidate iterators.
+//------------------------------------------------------------------
+
+template <typename T_KEY, typename T_ITEM>
+
+class FlatSparseArray
+{
+public:
+
+    typedef T_KEY key_type;
+    typedef T_ITEM mapped_type;
+    typedef std::pair<T_KEY, T_ITEM> value_type;
+    typedef typename std::vector<value_type>::iterator iterator;
+    typedef typename std::vector<value_type>::const_iterator const_iterator;
+    typedef size_t size_type;
+
+    FlatSparseArray();
+
+    const FlatSparseArrayProxy<T_KEY, T_ITEM> operator [](T_KEY key) const;
+
+    FlatSparseArrayProxy<T_KEY, T_ITEM> operator [](T_KEY key);
+
+    iterator begin();
+
+    const_iterator begin() const;
+
+    iterator end();
+
+    const_iterator end() const;
+
+    iterator find(const T_KEY & key);
+
+    const_iterator find(const T_KEY & key) const;
+
+    size_type count(const T_KEY & key) const;
+
+    size_type size() const;
+
+    bool empty() const;
+
+    void clear();
+
+    void reserve(size_type number_of_elements);
+
+    std::pair<iterator, bool> insert(const value_type & value);
+
+    iterator insert(iterator hint, const value_type & value);
+
+    void erase(iterator position);
+
+    size_type erase(const T_KEY & key);
+
+    const T_ITEM * FindItem(const T_KEY & key) const;
+
+    void SetItem(const T_KEY & key, const T_ITEM & item);
+
+    void EraseItem(const T_KEY & key);
+
+protected:
+
+    static bool IsKeyLess(const value_type & value, const T_KEY & key);
+
+    static typename std::vector<value_type>::const_iterator SearchVector(const std::vector<value_type> & value_vector,
+                                                                         const T_KEY & key);
+
+    void MergeStaging() const;
+
+protected:
+
+    mutable std::vector<value_type> m_element_vector;
+    mutable std::vector<value_type> m_staging_vector;
+    mutable size_t m_staging_limit;
+};
+
+//----------------------------------------------------------------------
+//  Implementation for methods of class FlatSparseArrayProxy.
+//
+//  Constructor:
+//
+//    FlatSparseArrayProxy(FlatSparseArray & sparse_array, T_KEY key);
+//----------------------------------------------------------------------
+
+template <typename T_KEY, typename T_ITEM>
+
+FlatSparseArrayProxy<T_KEY, T_ITEM>::FlatSparseArrayProxy(FlatSparseArray<T_KEY, T_ITEM> & sparse_array,
+                                                          T_KEY key)
+  : m_sparse_array(sparse_array),
+    m_key(key)
+{
+}
+
+//----------------------------------------------------------------------
+//  FlatSparseArrayProxy & operator =(const FlatSparseArrayProxy & right_hand_side);
+//----------------------------------------------------------------------
+
+template <typename T_KEY, typename T_ITEM>
+
+FlatSparseArrayProxy<T_KEY, T_ITEM> &
+    FlatSparseArrayProxy<T_KEY, T_ITEM>::operator =(const FlatSparseArrayProxy<T_KEY, T_ITEM> & right_hand_side)
+{
+    //------------------------------------------------------------------
+    //  If the item is the default item then clear the existing item
+    //  at this key from the array.
+    //------------------------------------------------------------------
+
+    T_ITEM item = right_hand_side;
+
+    if (item == T_ITEM())
+    {
+        m_sparse_array.EraseItem(m_key);
+    }
+    else
+    {
+        m_sparse_array.SetItem(m_key, item);
+    }
+
+    return *this;
+}
+
+//----------------------------------------------------------------------
+//  FlatSparseArrayProxy & operator =(T_ITEM item);
+//----------------------------------------------------------------------
+
+template <typename T_KEY, typename T_ITEM>
+
+FlatSparseArrayProxy<T_KEY, T_ITEM> &
+    FlatSparseArrayProxy<T_KEY, T_ITEM>::operator =(T_ITEM item)
+{
+    m_sparse_array.SetItem(m_key, item);
+    return *this;
+}
+
+//----------------------------------------------------------------------
+//  operator T_ITEM() const;
+//----------------------------------------------------------------------
+
+template <typename T_KEY, typename T_ITEM>
+
+FlatSparseArrayProxy<T_KEY, T_ITEM>::operator T_ITEM() const
+{
+    const T_ITEM * item_ptr = m_sparse_array.FindItem(m_key);
+
+    if (item_ptr != 0)
+    {
+        return *item_ptr;
+    }
+    else
+    {
+        return T_ITEM();
+    }
+}
+
+//----------------------------------------------------------------------
+//  Implementation for methods of class FlatSparseArray.
+//
+//  Constructor:
+//
+//    FlatSparseArray();
+//----------------------------------------------------------------------
+
+template <typename T_KEY, typename T_ITEM>
+
+FlatSparseArray<T_KEY, T_ITEM>::FlatSparseArray()
+  : m_staging_limit(64)
+{
+}
+
+//----------------------------------------------------------------------
+//  const FlatSparseArrayProxy operator [](T_KEY key) const;
+//----------------------------------------------------------------------
+
+template <typename T_KEY, typename T_ITEM>
+
+const FlatSparseArrayProxy<T_KEY, T_ITEM> FlatSparseArray<T_KEY, T_ITEM>::operator [](T_KEY key) const
+{
+    return FlatSparseArrayProxy<T_KEY, T_ITEM>(const_cast< FlatSparseArray<T_KEY, T_ITEM> & >(*this), key);
+}
+
+//----------------------------------------------------------------------
+//  FlatSparseArrayProxy<T_KEY, T_ITEM> operator [](T_KEY key);
+//----------------------------------------------------------------------
+
+template <typename T_KEY, typename T_ITEM>
+
+FlatSparseArrayProxy<T_KEY, T_ITEM> FlatSparseArray<T_KEY, T_ITEM>::operator [](T_KEY key)
+{
+    return FlatSparseArrayProxy<T_KEY, T_ITEM>(*this, key);
+}
+
+//----------------------------------------------------------------------
+//  Iterator access. The staging vector is merged first so that the
+//  elements are visited in key order.
+//----------------------------------------------------------------------
+
+template <typename T_KEY, typename T_ITEM>
+
+typename FlatSparseArray<T_KEY, T_ITEM>::iterator FlatSparseArray<T_KEY, T_ITEM>::begin()
+{
+    MergeStaging();
+    return m_element_vector.begin();
+}
+
+template <typename T_KEY, typename T_ITEM>
+
+typename FlatSparseArray<T_KEY, T_ITEM>::const_iterator FlatSparseArray<T_KEY, T_ITEM>::begin() const
+{
+    MergeStaging();
+    return m_element_vector.begin();
+}
+
+template <typename T_KEY, typename T_ITEM>
+
+typename FlatSparseArray<T_KEY, T_ITEM>::iterator FlatSparseArray<T_KEY, T_ITEM>::end()
+{
+    MergeStaging();
+    return m_element_vector.end();
+}
+
+template <typename T_KEY, typename T_ITEM>
+
+typename FlatSparseArray<T_KEY, T_ITEM>::const_iterator FlatSparseArray<T_KEY, T_ITEM>::end() const
+{
+    MergeStaging();
+    return m_element_vector.end();
+}
+
+//----------------------------------------------------------------------
+//  iterator find(const T_KEY & key);
+//----------------------------------------------------------------------
+
+template <typename T_KEY, typename T_ITEM>
+
+typename FlatSparseArray<T_KEY, T_ITEM>::iterator FlatSparseArray<T_KEY, T_ITEM>::find(const T_KEY & key)
+{
+    MergeStaging();
+
+    iterator it = std::lower_bound(m_element_vector.begin(), m_element_vector.end(), key, IsKeyLess);
+
+    if ((it != m_element_vector.end()) && (! (key < (*it).first)))
+    {
+        return it;
+    }
+
+    return m_element_vector.end();
+}
+
+template <typename T_KEY, typename T_ITEM>
+
+typename FlatSparseArray<T_KEY, T_ITEM>::const_iterator FlatSparseArray<T_KEY, T_ITEM>::find(const T_KEY & key) const
+{
+    MergeStaging();
+    return SearchVector(m_element_vector, key);
+}
+
+//----------------------------------------------------------------------
+//  size_type count(const T_KEY & key) const;
+//----------------------------------------------------------------------
+
+template <typename T_KEY, typename T_ITEM>
+
+typename FlatSparseArray<T_KEY, T_ITEM>::size_type FlatSparseArray<T_KEY, T_ITEM>::count(const T_KEY & key) const
+{
+    return (FindItem(key) != 0) ? 1 : 0;
+}
+
+//----------------------------------------------------------------------
+//  size_type size() const;
+//----------------------------------------------------------------------
+
+template <typename T_KEY, typename T_ITEM>
+
+typename FlatSparseArray<T_KEY, T_ITEM>::size_type FlatSparseArray<T_KEY, T_ITEM>::size() const
+{
+    return m_element_vector.size() + m_staging_vector.size();
+}
+
+//----------------------------------------------------------------------
+//  bool empty() const;
+//----------------------------------------------------------------------
+
+template <typename T_KEY, typename T_ITEM>
+
+bool FlatSparseArray<T_KEY, T_ITEM>::empty() const
+{
+    return m_element_vector.empty() && m_staging_vector.empty();
+}
+
+//----------------------------------------------------------------------
+//  void clear();
+//----------------------------------------------------------------------
+
+template <typename T_KEY, typename T_ITEM>
+
+void FlatSparseArray<T_KEY, T_ITEM>::clear()
+{
+    m_element_vector.clear();
+    m_staging_vector.clear();
+    m_staging_limit = 64;
+    return;
+}
+
+//----------------------------------------------------------------------
+//  void reserve(size_type number_of_elements);
+//----------------------------------------------------------------------
+
+template <typename T_KEY, typename T_ITEM>
+
+void FlatSparseArray<T_KEY, T_ITEM>::reserve(size_type number_of_elements)
+{
+    m_element_vector.reserve(number_of_elements);
+    return;
+}
+
+//----------------------------------------------------------------------
+//  std::pair<iterator, bool> insert(const value_type & value);
+//
+//  As with std::map, an existing element is not changed.
+//----------------------------------------------------------------------
+
+template <typename T_KEY, typename T_ITEM>
+
+std::pair<typename FlatSparseArray<T_KEY, T_ITEM>::iterator, bool>
+    FlatSparseArray<T_KEY, T_ITEM>::insert(const value_type & value)
+{
+    MergeStaging();
+
+    iterator it = std::lower_bound(m_element_vector.begin(), m_element_vector.end(), value.first, IsKeyLess);
+
+    if ((it != m_element_vector.end()) && (! (value.first < (*it).first)))
+    {
+        return std::make_pair(it, false);
+    }
+
+    it = m_element_vector.insert(it, value);
+    return std::make_pair(it, true);
+}
+
+//----------------------------------------------------------------------
+//  iterator insert(iterator hint, const value_type & value);
+//
+//  Inserting elements in increasing key order at the end is a
+//  constant time operation.
+//----------------------------------------------------------------------
+
+template <typename T_KEY, typename T_ITEM>
+
+typename FlatSparseArray<T_KEY, T_ITEM>::iterator
+    FlatSparseArray<T_KEY, T_ITEM>::insert(iterator hint, const value_type & value)
+{
+    if ((hint == m_element_vector.end())
+        && m_staging_vector.empty()
+        && (m_element_vector.empty() || (m_element_vector.back().first < value.first)))
+    {
+        m_element_vector.push_back(value);
+        return m_element_vector.end() - 1;
+    }
+
+    return insert(value).first;
+}
+
+//----------------------------------------------------------------------
+//  void erase(iterator position);
+//----------------------------------------------------------------------
+
+template <typename T_KEY, typename T_ITEM>
+
+void FlatSparseArray<T_KEY, T_ITEM>::erase(iterator position)
+{
+    m_element_vector.erase(position);
+    return;
+}
+
+//----------------------------------------------------------------------
+//  size_type erase(const T_KEY & key);
+//----------------------------------------------------------------------
+
+template <typename T_KEY, typename T_ITEM>
+
+typename FlatSparseArray<T_KEY, T_ITEM>::size_type FlatSparseArray<T_KEY, T_ITEM>::erase(const T_KEY & key)
+{
+    size_type old_size = size();
+    EraseItem(key);
+    return old_size - size();
+}
+
+//----------------------------------------------------------------------
+//  const T_ITEM * FindItem(const T_KEY & key) const;
+//
+//  Return a pointer to the item stored at a key or zero if there is
+//  no item at the key.
+//----------------------------------------------------------------------
+
+template <typename T_KEY, typename T_ITEM>
+
+const T_ITEM * FlatSparseArray<T_KEY, T_ITEM>::FindItem(const T_KEY & key) const
+{
+    const_iterator it = SearchVector(m_element_vector, key);
+
+    if (it != m_element_vector.end())
+    {
+        return &(*it).second;
+    }
+
+    it = SearchVector(m_staging_vector, key);
+
+    if (it != m_staging_vector.end())
+    {
+        return &(*it).second;
+    }
+
+    return 0;
+}
+
+//----------------------------------------------------------------------
+//  void SetItem(const T_KEY & key, const T_ITEM & item);
+//
+//  Store an item at a key, replacing any existing item.
+//----------------------------------------------------------------------
+
+template <typename T_KEY, typename T_ITEM>
+
+void FlatSparseArray<T_KEY, T_ITEM>::SetItem(const T_KEY & key, const T_ITEM & item)
+{
+    //------------------------------------------------------------------
+    //  Append a key that is larger than every stored key.
+    //------------------------------------------------------------------
+
+    if (m_staging_vector.empty()
+        && (m_element_vector.empty() || (m_element_vector.back().first < key)))
+    {
+        m_element_vector.push_back(value_type(key, item));
+        return;
+    }
+
+    //------------------------------------------------------------------
+    //  Replace an existing item.
+    //------------------------------------------------------------------
+
+    iterator it = std::lower_bound(m_element_vector.begin(), m_element_vector.end(), key, IsKeyLess);
+
+    if ((it != m_element_vector.end()) && (! (key < (*it).first)))
+    {
+        (*it).second = item;
+        return;
+    }
+
+    it = std::lower_bound(m_staging_vector.begin(), m_staging_vector.end(), key, IsKeyLess);
+
+    if ((it != m_staging_vector.end()) && (! (key < (*it).first)))
+    {
+        (*it).second = item;
+        return;
+    }
+
+    //------------------------------------------------------------------
+    //  Insert a new key into the staging vector.
+    //------------------------------------------------------------------
+
+    m_staging_vector.insert(it, value_type(key, item));
+
+    if (m_staging_vector.size() > m_staging_limit)
+    {
+        MergeStaging();
+    }
+
+    return;
+}
+
+//----------------------------------------------------------------------
+//  void EraseItem(const T_KEY & key);
+//----------------------------------------------------------------------
+
+template <typename T_KEY, typename T_ITEM>
+
+void FlatSparseArray<T_KEY, T_ITEM>::EraseItem(const T_KEY & key)
+{
+    iterator it = std::lower_bound(m_element_vector.begin(), m_element_vector.end(), key, IsKeyLess);
+
+    if ((it != m_element_vector.end()) && (! (key < (*it).first)))
+    {
+        m_element_vector.erase(it);
+        return;
+    }
+
+    it = std::lower_bound(m_staging_vector.begin(), m_staging_vector.end(), key, IsKeyLess);
+
+    if ((it != m_staging_vector.end()) && (! (key < (*it).first)))
+    {
+        m_staging_vector.erase(it);
+    }
+
+    return;
+}
+
+//----------------------------------------------------------------------
+//  static bool IsKeyLess(const value_type & value, const T_KEY & key);
+//----------------------------------------------------------------------
+
+template <typename T_KEY, typename T_ITEM>
+
+bool FlatSparseArray<T_KEY, T_ITEM>::IsKeyLess(const value_type & value, const T_KEY & key)
+{
+    return value.first < key;
+}
+
+//----------------------------------------------------------------------
+//  static const_iterator SearchVector(const std::vector<value_type> & value_vector,
+//                                     const T_KEY & key);
+//
+//  Return the position of a key in a sorted vector or the end of the
+//  vector if the key is not found.
+//----------------------------------------------------------------------
+
+template <typename T_KEY, typename T_ITEM>
+
+typename std::vector<typename FlatSparseArray<T_KEY, T_ITEM>::value_type>::const_iterator
+    FlatSparseArray<T_KEY, T_ITEM>::SearchVector(const std::vector<value_type> & value_vector,
+                                                 const T_KEY & key)
+{
+    const_iterator it = std::lower_bound(value_vector.begin(), value_vector.end(), key, IsKeyLess);
+
+    if ((it != value_vector.end()) && (! (key < (*it).first)))
+    {
+        return it;
+    }
+
+    return value_vector.end();
+}
+
+//----------------------------------------------------------------------
+//  void MergeStaging() const;
+//
+//  Merge the staging vector into the main vector in place, starting
+//  from the largest keys, and set the staging limit to about the
+//  square root of the number of elements.
+//----------------------------------------------------------------------
+
+template <typename T_KEY, typename T_ITEM>
+
+void FlatSparseArray<T_KEY, T_ITEM>::MergeStaging() const
+{
+    if (m_staging_vector.empty())
+    {
+        return;
+    }
+
+    size_t element_count = m_element_vector.size();
+    size_t staging_count = m_staging_vector.size();
+
+    m_element_vector.resize(element_count + staging_count);
+
+    size_t destination = element_count + staging_count;
+
+    while (staging_count != 0)
+    {
+        --destination;
+
+        if ((element_count != 0)
+            && (m_staging_vector[staging_count - 1].first < m_element_vector[element_count - 1].first))
+        {
+            m_element_vector[destination] = m_element_vector[--element_count];
+        }
+        else
+        {
+            m_element_vector[destination] = m_staging_vector[--staging_count];
+        }
+    }
+
+    m_staging_vector.clear();
+
+    while (m_staging_limit * m_staging_limit < m_element_vector.size())
+    {
+        m_staging_limit *= 2;
+    }
+
+    return;
+}
+
+#endif
@@ -0,0 +1,276 @@
+#include <algorithm>
+#include <utility>
+#include <vector>
+#include "FrozenSparseMatrix.h"
+
+//======================================================================
+//  Constructor: FrozenSparseMatrix::FrozenSparseMatrix
+//======================================================================
+
+FrozenSparseMatrix::FrozenSparseMatrix()
+{
+}
+
+//======================================================================
+//  Destructor: FrozenSparseMatrix::~FrozenSparseMatrix
+//======================================================================
+
+FrozenSparseMatrix::~FrozenSparseMatrix()
+{
+}
+
+//======================================================================
+//  Member Function: FrozenSparseMatrix::Freeze
+//
+//  Abstract:
+//
+//    This function makes the frozen matrix from a SparseMatrix. The
+//    elements of the SparseMatrix are visited once. No order of the
+//    DoubleIndex keys is assumed.
+//
+//
+//  Input:
+//
+//    a_matrix                      The sparse matrix.
+//
+//    minimum_number_of_rows        The minimum number of rows. The
+//                                  frozen matrix has more rows if an
+//                                  element has a larger row index.
+//
+//    minimum_number_of_columns     The minimum number of columns.
+//
+//  Output:
+//
+//    This function has no return value.
+//
+//======================================================================
+
+void FrozenSparseMatrix::Freeze(const MatrixPackage::SparseMatrix & a_matrix,
+                                int minimum_number_of_rows,
+                                int minimum_number_of_columns)
+{
+    MatrixPackage::SparseMatrix::const_iterator a_iter;
+
+    //------------------------------------------------------------------
+    //  Find the size of the matrix and count the elements in each row.
+    //------------------------------------------------------------------
+
+    int number_of_rows = minimum_number_of_rows;
+    int number_of_columns = minimum_number_of_columns;
+
+    for (a_iter = a_matrix.begin(); a_iter != a_matrix.end(); ++a_iter)
+    {
+        number_of_rows = std::max(number_of_rows, (*a_iter).first.GetRowIndex() + 1);
+        number_of_columns = std::max(number_of_columns, (*a_iter).first.GetColumnIndex() + 1);
+    }
+
+    std::vector<size_t> row_start_vector(number_of_rows + 1, 0);
+
+    for (a_iter = a_matrix.begin(); a_iter != a_matrix.end(); ++a_iter)
+    {
+        ++row_start_vector[(*a_iter).first.GetRowIndex() + 1];
+    }
+
+    int row = 0;
+
+    for (row = 0; row < number_of_rows; ++row)
+    {
+        row_start_vector[row + 1] += row_start_vector[row];
+    }
+
+    //------------------------------------------------------------------
+    //  Place each element in its row.
+    //------------------------------------------------------------------
+
+    size_t number_of_nonzeros = row_start_vector[number_of_rows];
+    std::vector<int> column_index_vector(number_of_nonzeros);
+    std::vector<double> value_vector(number_of_nonzeros);
+    std::vector<size_t> next_vector(row_start_vector.begin(), row_start_vector.end() - 1);
+
+    for (a_iter = a_matrix.begin(); a_iter != a_matrix.end(); ++a_iter)
+    {
+        size_t destination = next_vector[(*a_iter).first.GetRowIndex()]++;
+        column_index_vector[destination] = (*a_iter).first.GetColumnIndex();
+        value_vector[destination] = (*a_iter).second;
+    }
+
+    //------------------------------------------------------------------
+    //  Sort any row that is not in column order.
+    //------------------------------------------------------------------
+
+    std::vector<std::pair<int, double> > row_element_vector;
+
+    for (row = 0; row < number_of_rows; ++row)
+    {
+        size_t row_start = row_start_vector[row];
+        size_t row_end = row_start_vector[row + 1];
+
+        if (std::is_sorted(column_index_vector.begin() + row_start,
+                           column_index_vector.begin() + row_end))
+        {
+            continue;
+        }
+
+        row_element_vector.clear();
+
+        size_t k = 0;
+
+        for (k = row_start; k < row_end; ++k)
+        {
+            row_element_vector.push_back(std::make_pair(column_index_vector[k], value_vector[k]));
+        }
+
+        std::sort(row_element_vector.begin(), row_element_vector.end());
+
+        for (k = row_start; k < row_end; ++k)
+        {
+            column_index_vector[k] = row_element_vector[k - row_start].first;
+            value_vector[k] = row_element_vector[k - row_start].second;
+        }
+    }
+
+    CompressedSparseMatrix row_matrix;
+
+    row_matrix.Assign(number_of_rows,
+                      number_of_columns,
+                      row_start_vector,
+                      column_index_vector,
+                      value_vector);
+
+    Freeze(row_matrix);
+
+    return;
+}
+
+//======================================================================
+//  Member Function: FrozenSparseMatrix::Freeze
+//
+//  Abstract:
+//
+//    This function makes the frozen matrix from a compressed sparse
+//    row matrix. The contents of the passed matrix are moved into the
+//    frozen matrix, so the passed matrix is empty on return.
+//
+//
+//  Input:
+//
+//    a_matrix          The compressed sparse row matrix.
+//
+//  Output:
+//
+//    This function has no return value.
+//
+//======================================================================
+
+void FrozenSparseMatrix::Freeze(CompressedSparseMatrix & a_matrix)
+{
+    m_row_matrix.Clear();
+    m_row_matrix.Swap(a_matrix);
+    m_row_matrix.Transpose(m_column_matrix);
+    return;
+}
+
+//======================================================================
+//  Member Function: FrozenSparseMatrix::GetNumberOfRows
+//======================================================================
+
+int FrozenSparseMatrix::GetNumberOfRows() const
+{
+    return m_row_matrix.GetNumberOfRows();
+}
+
+//======================================================================
+//  Member Function: FrozenSparseMatrix::GetNumberOfColumns
+//======================================================================
+
+int FrozenSparseMatrix::GetNumberOfColumns() const
+{
+    return m_row_matrix.GetNumberOfColumns();
+}
+
+//======================================================================
+//  Member Function: FrozenSparseMatrix::GetNumberOfNonzeros
+//======================================================================
+
+size_t FrozenSparseMatrix::GetNumberOfNonzeros() const
+{
+    return m_row_matrix.GetNumberOfNonzeros();
+}
+
+//======================================================================
+//  Member Function: FrozenSparseMatrix::GetRow
+//
+//  Abstract:
+//
+//    This function returns the stored elements of a row.
+//
+//======================================================================
+
+SparseSlice FrozenSparseMatrix::GetRow(int row) const
+{
+    const size_t * row_start_array = m_row_matrix.GetRowStartArray();
+    size_t row_start = row_start_array[row];
+
+    return SparseSlice(m_row_matrix.GetColumnIndexArray() + row_start,
+                       m_row_matrix.GetValueArray() + row_start,
+                       row_start_array[row + 1] - row_start);
+}
+
+//======================================================================
+//  Member Function: FrozenSparseMatrix::GetColumn
+//
+//  Abstract:
+//
+//    This function returns the stored elements of a column.
+//
+//======================================================================
+
+SparseSlice FrozenSparseMatrix::GetColumn(int column) const
+{
+    const size_t * column_start_array = m_column_matrix.GetRowStartArray();
+    size_t column_start = column_start_array[column];
+
+    return SparseSlice(m_column_matrix.GetColumnIndexArray() + column_start,
+                       m_column_matrix.GetValueArray() + column_start,
+                       column_start_array[column + 1] - column_start);
+}
+
+//======================================================================
+//  Member Function: FrozenSparseMatrix::GetValue
+//
+//  Abstract:
+//
+//    This function returns the value of an element, or zero if the
+//    element is not stored.
+//
+//======================================================================
+
+double FrozenSparseMatrix::GetValue(int row, int column) const
+{
+    return m_row_matrix.GetValue(row, column);
+}
+
+//======================================================================
+//  Member Function: FrozenSparseMatrix::GetRowMatrix
+//======================================================================
+
+const CompressedSparseMatrix & FrozenSparseMatrix::GetRowMatrix() const
+{
+    return m_row_matrix;
+}
+
+//======================================================================
+//  Member Function: FrozenSparseMatrix::GetColumnMatrix
+//
+//  Abstract:
+//
+//    This function returns the transpose of the matrix in compressed
+//    sparse row form, which is the matrix in compressed sparse column
+//    form.
+//
+//======================================================================
+
+const CompressedSparseMatrix & FrozenSparseMatrix::GetColumnMatrix() const
+{
+    return m_column_matrix;
+}
@@ -0,0 +1,149 @@
+#ifndef FROZENSPARSEMATRIX_H
+#define FROZENSPARSEMATRIX_H
+
+#include <stddef.h>
+#include "MatrixPackage.h"
+#include "CompressedSparseMatrix.h"
+
+//======================================================================
+//  Class Definition
+//
+//  This class is a read-only view of the stored elements of one row
+//  or one column of a FrozenSparseMatrix. The indices are in
+//  increasing order. For a row slice the indices are column indices
+//  and for a column slice the indices are row indices.
+//======================================================================
+
+class SparseSlice
+{
+public:
+
+    class Iterator
+    {
+    public:
+
+        Iterator(const int * index_ptr, const double * value_ptr)
+          : m_index_ptr(index_ptr),
+            m_value_ptr(value_ptr)
+        {
+        }
+
+        int GetIndex() const
+        {
+            return *m_index_ptr;
+        }
+
+        double GetValue() const
+        {
+            return *m_value_ptr;
+        }
+
+        Iterator & operator ++()
+        {
+            ++m_index_ptr;
+            ++m_value_ptr;
+            return *this;
+        }
+
+        bool operator ==(const Iterator & other_iterator) const
+        {
+            return m_index_ptr == other_iterator.m_index_ptr;
+        }
+
+        bool operator !=(const Iterator & other_iterator) const
+        {
+            return m_index_ptr != other_iterator.m_index_ptr;
+        }
+
+    private:
+
+        const int * m_index_ptr;
+        const double * m_value_ptr;
+    };
+
+    SparseSlice(const int * index_ptr, const double * value_ptr, size_t size)
+      : m_index_ptr(index_ptr),
+        m_value_ptr(value_ptr),
+        m_size(size)
+    {
+    }
+
+    Iterator begin() const
+    {
+        return Iterator(m_index_ptr, m_value_ptr);
+    }
+
+    Iterator end() const
+    {
+        return Iterator(m_index_ptr + m_size, m_value_ptr + m_size);
+    }
+
+    size_t GetSize() const
+    {
+        return m_size;
+    }
+
+    int GetIndex(size_t position) const
+    {
+        return m_index_ptr[position];
+    }
+
+    double GetValue(size_t position) const
+    {
+        return m_value_ptr[position];
+    }
+
+private:
+
+    const int * m_index_ptr;
+    const double * m_value_ptr;
+    size_t m_size;
+};
+
+//======================================================================
+//  Class Definition
+//
+//  This class holds an immutable copy of a sparse matrix in both
+//  compressed sparse row and compressed sparse column form. It is
+//  made once, by freezing either a SparseMatrix or a compressed
+//  sparse row matrix, after which any row or any column of stored
+//  elements is available in constant time without searching.
+//======================================================================
+
+class FrozenSparseMatrix
+{
+public:
+
+    FrozenSparseMatrix();
+
+    virtual ~FrozenSparseMatrix();
+
+    void Freeze(const MatrixPackage::SparseMatrix & a_matrix,
+                int minimum_number_of_rows,
+                int minimum_number_of_columns);
+
+    void Freeze(CompressedSparseMatrix & a_matrix);
+
+    int GetNumberOfRows() const;
+
+    int GetNumberOfColumns() const;
+
+    size_t GetNumberOfNonzeros() const;
+
+    SparseSlice GetRow(int row) const;
+
+    SparseSlice GetColumn(int column) const;
+
+    double GetValue(int row, int column) const;
+
+    const CompressedSparseMatrix & GetRowMatrix() const;
+
+    const CompressedSparseMatrix & GetColumnMatrix() const;
+
+protected:
+
+    CompressedSparseMatrix m_row_matrix;
+    CompressedSparseMatrix m_column_matrix;
+};
+
+#endif
@@ -1,6 +1,5 @@
 #pragma warning (disable : 4786)
 
-#include <map>
 #include "LinearEquationParser.h"
 
 namespace
@@ -8,7 +7,8 @@ namespace
     enum ParserState_T
     {
         PARSE_TERM,
-        PARSE_OPERATOR
+        PARSE_OPERATOR,
+        PARSE_RIGHT_HAND_SIDE
     };
 
     unsigned int f_MAX_NUMBER_LENGTH = 20;
@@ -26,6 +26,9 @@ namespace
     const char * f_ERROR_TOO_MANY_DIGITS = "A number contains more than 15 digits.";
     const char * f_ERROR_MISSING_EXPONENT = "A number contains the '^' character and is missing an exponent.";
     const char * f_ERROR_ILLEGAL_EXPONENT = "A number contains an illegal exponent.";
+    const char * f_ERROR_ILLEGAL_RIGHT_HAND_SIDE = "The right-hand side syntax is illegal.";
+
+    const char * f_RIGHT_HAND_SIDE_KEYWORD = "rhs";
 };
 if a==c but b==d,
     aX = cX
@@ -54,17 +57,16 @@ LinearEquationParser::~LinearEquationParser()
 //
 //  Abstract:
 //
-//    This function parses line that contains all or part of a simple
-//    linear equation. The equation contains terms separated by
-//    operators. The term can be a number, a variable, or a number and
-//    a variable. A term cannot be split between lines input to the
-//    parser method. The operators are either the plus character '+',
-//    the minus character '-', or the equal sign character '='.
+//    This function parses a line that contains all or part of a
+//    simple linear equation and adds the terms directly to the
+//    A matrix and the B vector. See the overload of this function
+//    that takes a LinearSystemBuilder for a description of the
+//    equation syntax.
 //
 //
 //  Input:
 //
-//    input_line_string          The input line to be parsed
+//    input_line_string          The input line to be parsed.
 //
 //    a_matrix                 The A matrix for the simultaneous
 //                             equations This is updated as each line
@@ -76,9 +78,9 @@ LinearEquationParser::~LinearEquationParser()
 //                             line of input is parsed. See file
 //                             MatricPackage.h for more information.
 //
-//    variable_name_index_map  A map that stores the integer index
-//                             for a variable using the variable name
-//                             string as a key.
+//    variable_name_index_map  A symbol table that stores the integer
+//                             index for a variable using the variable
+//                             name string as a key.
 //
 //    number_of_equations      A reference to an unsigned integer that
 //                             is used to return the current number
@@ -93,11 +95,66 @@ LinearEquationParser::~LinearEquationParser()
 //======================================================================
 
 LinearEquationParser::Status_T LinearEquationParser::Parse(
-                                   const CharString & input_line_string,
+                                   const CharSpan & input_line_string,
                                    MatrixPackage::SparseMatrix & a_matrix,
                                    MatrixPackage::SparseVector & b_vector,
                                    VariableNameIndexMap & variable_name_index_map,
                                    unsigned int & number_of_equations)
+{
+    SparseMatrixBuilder builder(a_matrix, b_vector);
+
+    return Parse(input_line_string,
+                 builder,
+                 variable_name_index_map,
+                 number_of_equations);
+}
+
+//======================================================================
+//  Member Function: LinearEquationParser::Parse
+//
+//  Abstract:
+//
+//    This function parses line that contains all or part of a simple
+//    linear equation. The equation contains terms separated by
+//    operators. The term can be a number, a variable, or a number and
+//    a variable. A term cannot be split between lines input to the
+//    parser method. The operators are either the plus character '+',
+//    the minus character '-', or the equal sign character '='.
+//
+//
+//  Input:
+//
+//    input_line_string          The input line to be parsed. This is
+//                             a non-owning view of the characters so
+//                             the line can be a CharString or a line
+//                             inside of a memory-mapped file.
+//
+//    builder                  The builder that each term of the
+//                             equations is added to. See file
+//                             LinearSystemBuilder.h for more
+//                             information.
+//
+//    variable_name_index_map  A symbol table that stores the integer
+//                             index for a variable using the variable
+//                             name string as a key.
+//
+//    number_of_equations      A reference to an unsigned integer that
+//                             is used to return the current number
+//                             of equations.
+//
+//
+//  Output:
+//
+//    This function returns a value of type 'Status_T' that is
+//    an enum value.
+//
+//======================================================================
+
+LinearEquationParser::Status_T LinearEquationParser::Parse(
+                                   const CharSpan & input_line_string,
+                                   LinearSystemBuilder & builder,
+                                   VariableNameIndexMap & variable_name_index_map,
+                                   unsigned int & number_of_equations)
 {
     //------------------------------------------------------------------
     //  Assume success status.
@@ -129,6 +186,18 @@ LinearEquationParser::Status_T LinearEquationParser::Parse(
 
     if (position >= (int)(input_line_string.Length()))
     {
+        if (m_parser_state == PARSE_RIGHT_HAND_SIDE)
+        {
+            if (m_right_hand_side_value_expected_flag)
+            {
+                SetLastStatusValue(ERROR_ILLEGAL_RIGHT_HAND_SIDE, position);
+                return GetLastStatusValue();
+            }
+
+            m_parser_state = PARSE_TERM;
+            return SUCCESS;
+        }
+
         Status_T status = GetEquationStatus();
 
         if (status == SUCCESS)
@@ -143,6 +212,26 @@ LinearEquationParser::Status_T LinearEquationParser::Parse(
         return status;
     }
 
+    //------------------------------------------------------------------
+    //  If the line starts or continues a right-hand side directive
+    //  then parse the values of the directive.
+    //------------------------------------------------------------------
+
+    if ((m_parser_state == PARSE_RIGHT_HAND_SIDE)
+        || ((input_line_string[position] == '$') && IsAtEquationBoundary()))
+    {
+        Status_T status = GetRightHandSide(input_line_string,
+                                           position,
+                                           builder);
+
+        if (status == SUCCESS)
+        {
+            number_of_equations = m_equation_index;
+        }
+
+        return status;
+    }
+
     //------------------------------------------------------------------
     //  If the next character is a semicolon then start a new equation.
     //------------------------------------------------------------------
@@ -210,8 +299,7 @@ LinearEquationParser::Status_T LinearEquationParser::Parse(
                 {
                     if (GetTerm(input_line_string,
                                   position,
-                                  a_matrix,
-                                  b_vector,
+                                  builder,
                                   variable_name_index_map))
                     {
                         m_parser_state = PARSE_OPERATOR;
@@ -307,6 +395,9 @@ void LinearEquationParser::Reset()
     m_term_after_equal_sign_exists_flag = false;
     m_parser_state = PARSE_TERM;
     m_equation_index = 0;
+    m_number_of_right_hand_sides = 0;
+    m_right_hand_side_value_index = 0;
+    m_right_hand_side_value_expected_flag = false;
     
     return;
 }
@@ -363,6 +454,93 @@ int LinearEquationParser::GetErrorPosition() const
     return m_error_position;
 }
 
+//======================================================================
+//  Member Function: LinearEquationParser::GetEquationIndex
+//
+//  Abstract:
+//
+//    This function returns the index of the equation that is
+//    currently being parsed, which is also the number of equations
+//    that have been completed.
+//
+//
+//  Input:
+//
+//    None.
+//
+//
+//  Output:
+//
+//    This function returns a value of type 'int' that is the index
+//    of the current equation.
+//
+//======================================================================
+
+int LinearEquationParser::GetEquationIndex() const
+{
+    return m_equation_index;
+}
+
+//======================================================================
+//  Member Function: LinearEquationParser::IsAtEquationBoundary
+//
+//  Abstract:
+//
+//    This function returns true if no part of an equation has been
+//    parsed since the last equation was completed. In that state the
+//    parser behaves exactly like a parser that was just reset, except
+//    for the equation index.
+//
+//
+//  Input:
+//
+//    None.
+//
+//
+//  Output:
+//
+//    This function returns a value of type 'bool' that is the value
+//    true if and only if the parser is between equations.
+//
+//======================================================================
+
+bool LinearEquationParser::IsAtEquationBoundary() const
+{
+    return (m_parser_state == PARSE_TERM)
+        && (! m_negative_operator_flag)
+        && (! m_equal_sign_in_equation_flag)
+        && (! m_at_least_one_var_in_equation_flag)
+        && (! m_term_before_equal_sign_exists_flag)
+        && (! m_term_after_equal_sign_exists_flag);
+}
+
+//======================================================================
+//  Member Function: LinearEquationParser::GetNumberOfRightHandSides
+//
+//  Abstract:
+//
+//    This function returns the number of right-hand side directives
+//    that have been started since the parser was reset. The constants
+//    in the equations are not counted.
+//
+//
+//  Input:
+//
+//    None.
+//
+//
+//  Output:
+//
+//    This function returns a value of type 'int' that is the number
+//    of right-hand side directives.
+//
+//======================================================================
+
+int LinearEquationParser::GetNumberOfRightHandSides() const
+{
+    return m_number_of_right_hand_sides;
+}
+
 //======================================================================
 //  Member Function: LinearEquationParser::GetStatusString
 //
@@ -430,6 +608,9 @@ const char * LinearEquationParser::GetStatusString(Status_T status)
     case ERROR_ILLEGAL_EXPONENT:
         status_ptr = f_ERROR_ILLEGAL_EXPONENT;
         break;
+    case ERROR_ILLEGAL_RIGHT_HAND_SIDE:
+        status_ptr = f_ERROR_ILLEGAL_RIGHT_HAND_SIDE;
+        break;
     default:
         status_ptr = f_ERROR_ILLEGAL_EQUATION;
         break;
@@ -544,19 +725,13 @@ void LinearEquationParser::ResetForNewEquation()
 //    position                 The current parse position in the input
 //                             string.
 //
-//    a_matrix                 The A matrix for the simultaneous
-//                             of input is equations This is updated as
-//                             each line parsed. See file
-//                             MatricPackage.h for more information.
-//
-//    b_vector                 The B vector for the simultaneous
-//                             equations. This is updated as each line
-//                             of input is parsed. See file
-//                             MatricPackage.h for more information.
+//    builder                  The builder that the term is added to.
+//                             See file LinearSystemBuilder.h for more
+//                             information.
 //
-//    variable_name_index_map  A map that stores the integer index
-//                             for a variable using the variable name
-//                             string as a key.
+//    variable_name_index_map  A symbol table that stores the integer
+//                             index for a variable using the variable
+//                             name string as a key.
 //
 //  Output:
 //
@@ -565,10 +740,9 @@ void LinearEquationParser::ResetForNewEquation()
 //
 //======================================================================
 
-bool LinearEquationParser::GetTerm(const CharString & input_line_string,
+bool LinearEquationParser::GetTerm(const CharSpan & input_line_string,
                                    int & position,
-                                   MatrixPackage::SparseMatrix & a_matrix,
-                                   MatrixPackage::SparseVector & b_vector,
+                                   LinearSystemBuilder & builder,
                                    VariableNameIndexMap & variable_name_index_map)
 {
     //------------------------------------------------------------------
@@ -597,11 +771,11 @@ bool LinearEquationParser::GetTerm(const CharString & input_line_string,
     //  Check to see if this is a number or a variable.
     //------------------------------------------------------------------
 
-    CharString number_string;
+    DecimalNumber number;
 
     bool have_number_flag = GetNumber(input_line_string,
                                       position,
-                                      number_string);
+                                      number);
 
     //------------------------------------------------------------------
     //  If an error occurred then abort.
@@ -619,86 +793,11 @@ bool LinearEquationParser::GetTerm(const CharString & input_line_string,
 
     if (have_number_flag)
     {
-        if (position < (int)(input_line_string.Length()))
+        if (! GetExponent(input_line_string,
+                          position,
+                          number))
         {
-            //----------------------------------------------------------
-            //  Does the number have an exponent?
-            //----------------------------------------------------------
-
-            if (input_line_string[position] == '^')
-            {
-                ++position;
-
-                //------------------------------------------------------
-                //  Does the exponent have a sign.
-                //------------------------------------------------------
-
-                bool negative_exponent_flag;
-
-                GetSign(input_line_string,
-                        position,
-                        negative_exponent_flag);
-
-                //------------------------------------------------------
-                //  Get the exponent digits.
-                //------------------------------------------------------
-
-                CharString exponent_string;
-
-                if (GetNumber(input_line_string,
-                              position,
-                              exponent_string))
-                {
-                    //--------------------------------------------------
-                    //  Is the exponent a valid exponent.
-                    //--------------------------------------------------
-
-                    int exponent_length = exponent_string.Length();
-
-                    if (exponent_length <= 2)
-                    {
-                        bool exponent_error_flag = false;
-
-                        for (int i = 0; i < exponent_length; ++i)
-                        {
-                            if (! isdigit(exponent_string[i]))
-                            {
-                                exponent_error_flag = true;
-                            }
-                        }
-
-                        if (! exponent_error_flag)
-                        {
-                            number_string += 'E';
-
-                            if (negative_exponent_flag)
-                            {
-                                number_string += '-';
-                            }
-
-                            number_string += exponent_string;
-                        }
-                        else
-                        {
-                            SetLastStatusValue(ERROR_ILLEGAL_EXPONENT,
-                                                position);
-                            return false;
-                        }
-                    }
-                    else
-                    {
-                        SetLastStatusValue(ERROR_ILLEGAL_EXPONENT,
-                                            position);
-                        return false;
-                    }
-                }
-                else
-                {
-                    SetLastStatusValue(ERROR_MISSING_EXPONENT,
-                                        position);
-                    return false;
-                }
-            }
+            return false;
         }
     }
 
@@ -708,12 +807,12 @@ bool LinearEquationParser::GetTerm(const CharString & input_line_string,
 
     SkipSpaces(input_line_string, position);
 
-    CharString variable_name_string;
+    CharSpan variable_name_span;
 
     bool have_variable_name_flag =
         GetVariableName(input_line_string,
                         position,
-                        variable_name_string);
+                        variable_name_span);
 
     //------------------------------------------------------------------
     //  Calculate the sign of the value. The sign is negated
@@ -727,7 +826,7 @@ bool LinearEquationParser::GetTerm(const CharString & input_line_string,
 
     if (have_number_flag)
     {
-        value = atof(number_string.CString());
+        value = number.ToDouble();
 
         if (negative_flag)
         {
@@ -767,37 +866,15 @@ bool LinearEquationParser::GetTerm(const CharString & input_line_string,
         m_at_least_one_var_in_equation_flag = true;
 
         //--------------------------------------------------------------
-        //  If this variable has not been encountered before then add
-        //  the variable to the variable_name_index_map.
+        //  Get the variable index for the a_matrix. If this variable
+        //  has not been encountered before then the variable is added
+        //  to the variable_name_index_map and is given the next index.
         //--------------------------------------------------------------
 
-        int variable_index = 0;
-
-        VariableNameIndexMap::iterator it =
-            variable_name_index_map.find(variable_name_string);
-
-        if (it != variable_name_index_map.end())
-        {
-            //----------------------------------------------------------
-            //  The variable name has already been encountered. Get
-            //  the variable index for the a_matrix.
-            //----------------------------------------------------------
-
-            variable_index = (*it).second;
-        }
-        else
-        {
-            //----------------------------------------------------------
-            //  This is a new variable.  Add the variable to the
-            //  variable name index map.
-            //----------------------------------------------------------
-
-            variable_index = variable_name_index_map.size();
-            variable_name_index_map[variable_name_string] = variable_index;
-        }
+        int variable_index =
+            variable_name_index_map.FindOrInsert(variable_name_span);
 
-        a_matrix[DoubleIndex(m_equation_index, variable_index)] =
-            a_matrix[DoubleIndex(m_equation_index, variable_index)] + value;
+        builder.AddToAMatrix(m_equation_index, variable_index, value);
     }
     else if (have_number_flag)
     {
@@ -812,7 +889,7 @@ bool LinearEquationParser::GetTerm(const CharString & input_line_string,
         //  Put the value in the B vector.
         //--------------------------------------------------------------
 
-        b_vector[m_equation_index] = b_vector[m_equation_index] - value;
+        builder.AddToBVector(m_equation_index, - value);
     }
     else
     {
@@ -846,6 +923,295 @@ bool LinearEquationParser::GetTerm(const CharString & input_line_string,
     return have_term_flag;
 }
 
+//======================================================================
+//  Member Function: LinearEquationParser::GetRightHandSide
+//
+//  Abstract:
+//
+//    This function parses all or part of a right-hand side directive.
+//    A directive gives another set of constants for the equations so
+//    that the equations can be solved for several right-hand sides.
+//    The directive is the keyword '$rhs' followed by one number for
+//    each equation, in the order of the equations. The numbers are
+//    separated by spaces or commas and can continue on the following
+//    lines. The directive ends with a semicolon or a blank line. A
+//    comma must follow a value, so an empty value such as the one in
+//    '$rhs 5,,6;' is an error.
+//
+//      $rhs 3, -1.5, 2^-3 ;
+//
+//    A directive can only start between equations. Each value is
+//    passed to the builder as the constant on the right side of the
+//    equal sign.
+//
+//
+//  Input:
+//
+//    input_line_string        The input line to be parsed.
+//
+//    position                 The current parse position in the input
+//                             string. This is either the position of
+//                             the '$' character or the position of
+//                             the first character in a line that
+//                             continues a directive.
+//
+//    builder                  The builder that the values are added
+//                             to. See file LinearSystemBuilder.h for
+//                             more information.
+//
+//  Output:
+//
+//    This function returns a value of type 'Status_T' that is
+//    an enum value.
+//
+//======================================================================
+
+LinearEquationParser::Status_T LinearEquationParser::GetRightHandSide(
+                                   const CharSpan & input_line_string,
+                                   int & position,
+                                   LinearSystemBuilder & builder)
+{
+    int length = (int)(input_line_string.Length());
+
+    //------------------------------------------------------------------
+    //  If this is the start of a directive then check the keyword.
+    //------------------------------------------------------------------
+
+    if (m_parser_state != PARSE_RIGHT_HAND_SIDE)
+    {
+        ++position;
+
+        CharSpan keyword_span;
+        unsigned int keyword_length = (unsigned int)(strlen(f_RIGHT_HAND_SIDE_KEYWORD));
+
+        if ((! GetVariableName(input_line_string, position, keyword_span))
+            || (keyword_span.Length() != keyword_length)
+            || (strncmp(keyword_span.Data(), f_RIGHT_HAND_SIDE_KEYWORD, keyword_length) != 0))
+        {
+            SetLastStatusValue(ERROR_ILLEGAL_RIGHT_HAND_SIDE, position);
+            return GetLastStatusValue();
+        }
+
+        m_parser_state = PARSE_RIGHT_HAND_SIDE;
+        m_right_hand_side_value_index = 0;
+        m_right_hand_side_value_expected_flag = false;
+        ++m_number_of_right_hand_sides;
+    }
+
+    //------------------------------------------------------------------
+    //  Get each value until the end of the line or the semicolon that
+    //  ends the directive.
+    //------------------------------------------------------------------
+
+    SkipSpaces(input_line_string, position);
+
+    while (position < length)
+    {
+        char c = input_line_string[position];
+
+        //--------------------------------------------------------------
+        //  A comma or the semicolon cannot follow a comma, and a comma
+        //  cannot come before the first value. Either would leave a
+        //  value empty.
+        //--------------------------------------------------------------
+
+        if (((c == ',') || (c == ';'))
+            && (m_right_hand_side_value_expected_flag
+                || ((c == ',') && (m_right_hand_side_value_index == 0))))
+        {
+            SetLastStatusValue(ERROR_ILLEGAL_RIGHT_HAND_SIDE, position);
+            return GetLastStatusValue();
+        }
+
+        if (c == ';')
+        {
+            ++position;
+            m_parser_state = PARSE_TERM;
+
+            //----------------------------------------------------------
+            //  Nothing can follow the directive on the same line.
+            //----------------------------------------------------------
+
+            SkipSpaces(input_line_string, position);
+
+            if (position < length)
+            {
+                SetLastStatusValue(ERROR_ILLEGAL_RIGHT_HAND_SIDE, position);
+                return GetLastStatusValue();
+            }
+
+            break;
+        }
+
+        if (c == ',')
+        {
+            ++position;
+            m_right_hand_side_value_expected_flag = true;
+        }
+        else
+        {
+            bool negative_flag;
+
+            GetSign(input_line_string,
+                    position,
+                    negative_flag);
+
+            DecimalNumber number;
+
+            bool have_number_flag = GetNumber(input_line_string,
+                                              position,
+                                              number);
+
+            if (GetLastStatusValue() != SUCCESS)
+            {
+                return GetLastStatusValue();
+            }
+
+            if (! have_number_flag)
+            {
+                SetLastStatusValue(ERROR_ILLEGAL_RIGHT_HAND_SIDE, position);
+                return GetLastStatusValue();
+            }
+
+            if (! GetExponent(input_line_string,
+                              position,
+                              number))
+            {
+                return GetLastStatusValue();
+            }
+
+            //----------------------------------------------------------
+            //  A value must be followed by a separator.
+            //----------------------------------------------------------
+
+            if ((position < length)
+                && (! iswspace((int)(input_line_string[position])))
+                && (input_line_string[position] != ',')
+                && (input_line_string[position] != ';'))
+            {
+                SetLastStatusValue(ERROR_ILLEGAL_RIGHT_HAND_SIDE, position);
+                return GetLastStatusValue();
+            }
+
+            double value = number.ToDouble();
+
+            if (negative_flag)
+            {
+                value = - value;
+            }
+
+            builder.AddToRightHandSide(m_number_of_right_hand_sides - 1,
+                                       m_right_hand_side_value_index,
+                                       value);
+
+            ++m_right_hand_side_value_index;
+            m_right_hand_side_value_expected_flag = false;
+        }
+
+        SkipSpaces(input_line_string, position);
+    }
+
+    return SUCCESS;
+}
+
+//======================================================================
+//  Member Function: LinearEquationParser::GetExponent
+//
+//  Abstract:
+//
+//    This function parses the optional exponent that follows a
+//    number. The exponent is the '^' character followed by an
+//    optional sign and at most two digits. If there is an exponent
+//    then it is set in the number.
+//
+//
+//  Input:
+//
+//    input_line_string  The input line to be parsed.
+//
+//    position           The current parse position in the input
+//                       string, which is just after the number.
+//
+//    number             The number that the exponent applies to.
+//
+//  Output:
+//
+//    This function returns a value of type 'bool' that is the value
+//    false if and only if the exponent is missing or illegal.
+//
+//======================================================================
+
+bool LinearEquationParser::GetExponent(const CharSpan & input_line_string,
+                                       int & position,
+                                       DecimalNumber & number)
+{
+    if (position < (int)(input_line_string.Length()))
+    {
+        //--------------------------------------------------------------
+        //  Does the number have an exponent?
+        //--------------------------------------------------------------
+
+        if (input_line_string[position] == '^')
+        {
+            ++position;
+
+            //----------------------------------------------------------
+            //  Does the exponent have a sign.
+            //----------------------------------------------------------
+
+            bool negative_exponent_flag;
+
+            GetSign(input_line_string,
+                    position,
+                    negative_exponent_flag);
+
+            //----------------------------------------------------------
+            //  Get the exponent digits.
+            //----------------------------------------------------------
+
+            DecimalNumber exponent;
+
+            if (GetNumber(input_line_string,
+                          position,
+                          exponent))
+            {
+                //------------------------------------------------------
+                //  Is the exponent a valid exponent. The exponent is
+                //  at most two characters, all of which must be
+                //  digits.
+                //------------------------------------------------------
+
+                if ((exponent.GetLength() <= 2)
+                    && (! exponent.HasDecimalPoint()))
+                {
+                    int exponent_value = exponent.GetIntegerValue();
+
+                    if (negative_exponent_flag)
+                    {
+                        exponent_value = - exponent_value;
+                    }
+
+                    number.SetExponent(exponent_value);
+                }
+                else
+                {
+                    SetLastStatusValue(ERROR_ILLEGAL_EXPONENT,
+                                        position);
+                    return false;
+                }
+            }
+            else
+            {
+                SetLastStatusValue(ERROR_MISSING_EXPONENT,
+                                    position);
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
 //======================================================================
 //  Member Function: LinearEquationParser::GetSign
 //
@@ -876,7 +1242,7 @@ bool LinearEquationParser::GetTerm(const CharString & input_line_string,
 //
 //======================================================================
 
-bool LinearEquationParser::GetSign(const CharString & input_line_string,
+bool LinearEquationParser::GetSign(const CharSpan & input_line_string,
                                    int & position,
                                    bool & negative_flag)
 {
@@ -912,7 +1278,9 @@ bool LinearEquationParser::GetSign(const CharString & input_line_string,
 //
 //  Abstract:
 //
-//    This function parses a number string.
+//    This function parses a number string. The digits are
+//    accumulated into a DecimalNumber as they are scanned, so that
+//    the value can be computed without copying the characters.
 //
 //  Input:
 //
@@ -921,9 +1289,9 @@ bool LinearEquationParser::GetSign(const CharString & input_line_string,
 //    position           The current parse position in the input
 //                       string.
 //
-//    number_string      A reference to a string object that will
-//                       contain the number string if a number
-//                       is found by this method.
+//    number             A reference to a DecimalNumber object that
+//                       will contain the number if a number is found
+//                       by this method.
 //
 //  Output:
 //
@@ -932,55 +1300,50 @@ bool LinearEquationParser::GetSign(const CharString & input_line_string,
 //
 //======================================================================
 
-bool LinearEquationParser::GetNumber(const CharString & input_line_string,
+bool LinearEquationParser::GetNumber(const CharSpan & input_line_string,
                                      int & position,
-                                     CharString & number_string)
+                                     DecimalNumber & number)
 {
-    unsigned int decimal_point = 0;
-    unsigned int digit_length = 0;
+    number.Clear();
+
     bool have_number_flag = false;
-    bool continue_flag = position < (int)(input_line_string.Length());
+    int length = (int)(input_line_string.Length());
 
-    while (continue_flag)
+    while (position < length)
     {
         char c = input_line_string[position];
 
-        continue_flag = (c == _TXT('.'));
-
-        if (isdigit(c))
+        if ((c >= '0') && (c <= '9'))
         {
-            if (++digit_length > f_MAX_NUMBER_LENGTH)
+            if (number.GetDigitCount() + 1 > f_MAX_NUMBER_LENGTH)
             {
                 SetLastStatusValue(ERROR_TOO_MANY_DIGITS, position);
                 return false;
             }
 
             have_number_flag = true;
-            number_string += c;
+            number.AppendDigit(c);
             ++position;
-            continue_flag = position < (int)(input_line_string.Length());
         }
-        else
+        else if (c == _TXT('.'))
         {
-            bool continue_flag = c == _TXT('.');
-
-            if (continue_flag)
+            if (number.HasDecimalPoint())
             {
-                if (++decimal_point > 1)
-                {
-                    SetLastStatusValue(ERROR_MULTIPLE_DECIMAL_POINTS,
-                                       position);
-                    return false;
-                }
-
-                number_string += c;
-                ++position;
-                continue_flag = position < (int)(input_line_string.Length());
+                SetLastStatusValue(ERROR_MULTIPLE_DECIMAL_POINTS,
+                                   position);
+                return false;
             }
+
+            number.AppendDecimalPoint();
+            ++position;
+        }
+        else
+        {
+            break;
         }
     }
 
-    if (number_string.Length() > f_MAX_NUMBER_LENGTH)
+    if (number.GetLength() > f_MAX_NUMBER_LENGTH)
     {
         SetLastStatusValue(ERROR_TOO_MANY_DIGITS, position);
         return false;
@@ -1003,9 +1366,9 @@ bool LinearEquationParser::GetNumber(const CharString & input_line_string,
 //    position              The current parse position in the input
 //                          string.
 //
-//    variable_name_string  A reference to a string object that will
-//                          contain the variable name string if a
-//                          variable name is found by this method.
+//    variable_name_span    A reference to a span that is set to view
+//                          the variable name inside of the input line
+//                          if a variable name is found by this method.
 //
 //  Output:
 //
@@ -1014,10 +1377,11 @@ bool LinearEquationParser::GetNumber(const CharString & input_line_string,
 //
 //======================================================================
 
-bool LinearEquationParser::GetVariableName(const CharString & input_line_string,
+bool LinearEquationParser::GetVariableName(const CharSpan & input_line_string,
                                            int & position,
-                                           CharString & variable_name_string)
+                                           CharSpan & variable_name_span)
 {
+    int start_position = position;
     bool have_variable_name_flag = false;
     bool continue_flag = position < (int)(input_line_string.Length());
 
@@ -1030,12 +1394,17 @@ bool LinearEquationParser::GetVariableName(const CharString & input_line_string,
         if (continue_flag)
         {
             have_variable_name_flag = true;
-            variable_name_string += c;
             ++position;
             continue_flag = position < (int)(input_line_string.Length());
         }
     }
-    
+
+    if (have_variable_name_flag)
+    {
+        variable_name_span = CharSpan(input_line_string.Data() + start_position,
+                                      (unsigned int)(position - start_position));
+    }
+
     return have_variable_name_flag;
 }
 
@@ -1060,7 +1429,7 @@ bool LinearEquationParser::GetVariableName(const CharString & input_line_string,
 //
 //======================================================================
 
-bool LinearEquationParser::GetOperator(const CharString & input_line_string,
+bool LinearEquationParser::GetOperator(const CharSpan & input_line_string,
                                        int & position)
 {
     //------------------------------------------------------------------
@@ -1151,7 +1520,7 @@ bool LinearEquationParser::GetOperator(const CharString & input_line_string,
 //
 //======================================================================
 
-void LinearEquationParser::SkipSpaces(const CharString & input_line_string,
+void LinearEquationParser::SkipSpaces(const CharSpan & input_line_string,
                                        int & position)
 {
     bool continue_flag = position < (int)(input_line_string.Length());
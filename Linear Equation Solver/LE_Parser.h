@@ -5,6 +5,10 @@
 
 #include "MatrixPackage.h"
 #include "CharString.h"
+#include "CharSpan.h"
+#include "VariableSymbolTable.h"
+#include "DecimalNumber.h"
+#include "LinearSystemBuilder.h"
 
 //======================================================================
 //  Class Definition
@@ -29,7 +33,8 @@ public:
         ERROR_MULTIPLE_DECIMAL_POINTS,
         ERROR_TOO_MANY_DIGITS,
         ERROR_MISSING_EXPONENT,
-        ERROR_ILLEGAL_EXPONENT
+        ERROR_ILLEGAL_EXPONENT,
+        ERROR_ILLEGAL_RIGHT_HAND_SIDE
     };
 
 protected:
@@ -39,6 +44,9 @@ protected:
     Status_T m_last_error;
     int m_equation_index;
     int m_parser_state;
+    int m_number_of_right_hand_sides;
+    int m_right_hand_side_value_index;
+    bool m_right_hand_side_value_expected_flag;
     bool m_negative_operator_flag;
     bool m_equal_sign_in_equation_flag;
     bool m_at_least_one_var_in_equation_flag;
@@ -47,24 +55,35 @@ protected:
 
 public:
 
-    typedef std::map<CharString, int> VariableNameIndexMap;
+    typedef VariableSymbolTable VariableNameIndexMap;
 
     LinearEquationParser();
 
     virtual ~LinearEquationParser();
 
-    Status_T Parse(const CharString & input_line_string,
+    Status_T Parse(const CharSpan & input_line_string,
                    MatrixPackage::SparseMatrix & a_matrix,
                    MatrixPackage::SparseVector & b_vector,
                    VariableNameIndexMap & variable_name_index_map,
                    unsigned int & number_of_equations);
 
+    Status_T Parse(const CharSpan & input_line_string,
+                   LinearSystemBuilder & builder,
+                   VariableNameIndexMap & variable_name_index_map,
+                   unsigned int & number_of_equations);
+
     void Reset();
 
     Status_T GetLastStatusValue() const;
 
     int GetErrorPosition() const;
 
+    int GetEquationIndex() const;
+
+    bool IsAtEquationBoundary() const;
+
+    int GetNumberOfRightHandSides() const;
+
     const char * GetStatusString(Status_T status);
 
 protected:
@@ -73,28 +92,35 @@ protected:
 
     void ResetForNewEquation();
 
-    bool GetTerm(const CharString & input_line_string,
+    bool GetTerm(const CharSpan & input_line_string,
                  int & position,
-                 MatrixPackage::SparseMatrix & a_matrix,
-                 MatrixPackage::SparseVector & b_vector,
+                 LinearSystemBuilder & builder,
                  VariableNameIndexMap & variable_name_index_map);
 
-    bool GetSign(const CharString & input_line_string,
+    Status_T GetRightHandSide(const CharSpan & input_line_string,
+                              int & position,
+                              LinearSystemBuilder & builder);
+
+    bool GetExponent(const CharSpan & input_line_string,
+                     int & position,
+                     DecimalNumber & number);
+
+    bool GetSign(const CharSpan & input_line_string,
                  int & position,
                  bool & negative_flag);
 
-    bool GetNumber(const CharString & input_line_string,
+    bool GetNumber(const CharSpan & input_line_string,
                    int & position,
-                   CharString & number_string);
+                   DecimalNumber & number);
 
-    bool GetVariableName(const CharString & input_line_string,
+    bool GetVariableName(const CharSpan & input_line_string,
                          int & position,
-                         CharString & variable_name_string);
+                         CharSpan & variable_name_span);
 
-    bool GetOperator(const CharString & input_line_string,
+    bool GetOperator(const CharSpan & input_line_string,
                      int & position);
 
-    void SkipSpaces(const CharString & input_line_string,
+    void SkipSpaces(const CharSpan & input_line_string,
                     int & position);
 
     void SetLastStatusValue(Status_T last_error,
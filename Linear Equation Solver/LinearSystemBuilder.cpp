@@ -0,0 +1,544 @@
+#include <algorithm>
+#include <utility>
+#include "LinearSystemBuilder.h"
+
+//======================================================================
+//  Destructor: LinearSystemBuilder::~LinearSystemBuilder
+//======================================================================
+
+LinearSystemBuilder::~LinearSystemBuilder()
+{
+}
+
+//======================================================================
+//  Member Function: LinearSystemBuilder::AddToRightHandSide
+//
+//  Abstract:
+//
+//    This function adds a value to an element of an extra right-hand
+//    side. The default implementation ignores the value.
+//
+//
+//  Input:
+//
+//    right_hand_side_index     The index of the extra right-hand side.
+//
+//    equation_index            The index of the equation.
+//
+//    value                     The value that is added.
+//
+//  Output:
+//
+//    This function has no return value.
+//
+//======================================================================
+
+void LinearSystemBuilder::AddToRightHandSide(int /* right_hand_side_index */,
+                                             int /* equation_index */,
+                                             double /* value */)
+{
+    return;
+}
+
+//======================================================================
+//  Constructor: SparseMatrixBuilder::SparseMatrixBuilder
+//======================================================================
+
+SparseMatrixBuilder::SparseMatrixBuilder(MatrixPackage::SparseMatrix & a_matrix,
+                                         MatrixPackage::SparseVector & b_vector)
+  : m_a_matrix(a_matrix),
+    m_b_vector(b_vector)
+{
+}
+
+//======================================================================
+//  Destructor: SparseMatrixBuilder::~SparseMatrixBuilder
+//======================================================================
+
+SparseMatrixBuilder::~SparseMatrixBuilder()
+{
+}
+
+//======================================================================
+//  Member Function: SparseMatrixBuilder::AddToAMatrix
+//======================================================================
+
+void SparseMatrixBuilder::AddToAMatrix(int equation_index,
+                                       int variable_index,
+                                       double value)
+{
+    m_a_matrix[DoubleIndex(equation_index, variable_index)] =
+        m_a_matrix[DoubleIndex(equation_index, variable_index)] + value;
+    return;
+}
+
+//======================================================================
+//  Member Function: SparseMatrixBuilder::AddToBVector
+//======================================================================
+
+void SparseMatrixBuilder::AddToBVector(int equation_index,
+                                       double value)
+{
+    m_b_vector[equation_index] = m_b_vector[equation_index] + value;
+    return;
+}
+
+//======================================================================
+//  Constructor: TripletBuilder::TripletBuilder
+//======================================================================
+
+TripletBuilder::TripletBuilder()
+{
+}
+
+//======================================================================
+//  Destructor: TripletBuilder::~TripletBuilder
+//======================================================================
+
+TripletBuilder::~TripletBuilder()
+{
+}
+
+//======================================================================
+//  Member Function: TripletBuilder::AddToAMatrix
+//======================================================================
+
+void TripletBuilder::AddToAMatrix(int equation_index,
+                                  int variable_index,
+                                  double value)
+{
+    Triplet_T triplet;
+    triplet.m_row = equation_index;
+    triplet.m_column = variable_index;
+    triplet.m_value = value;
+    m_a_triplet_vector.push_back(triplet);
+    return;
+}
+
+//======================================================================
+//  Member Function: TripletBuilder::AddToBVector
+//======================================================================
+
+void TripletBuilder::AddToBVector(int equation_index,
+                                  double value)
+{
+    Triplet_T triplet;
+    triplet.m_row = equation_index;
+    triplet.m_column = 0;
+    triplet.m_value = value;
+    m_b_triplet_vector.push_back(triplet);
+    return;
+}
+
+//======================================================================
+//  Member Function: TripletBuilder::AddToRightHandSide
+//======================================================================
+
+void TripletBuilder::AddToRightHandSide(int right_hand_side_index,
+                                        int equation_index,
+                                        double value)
+{
+    Triplet_T triplet;
+    triplet.m_row = right_hand_side_index;
+    triplet.m_column = equation_index;
+    triplet.m_value = value;
+    m_rhs_triplet_vector.push_back(triplet);
+    return;
+}
+
+//======================================================================
+//  Member Function: TripletBuilder::Replay
+//
+//  Abstract:
+//
+//    This function adds every stored term to another builder in the
+//    order that the terms were stored.
+//
+//
+//  Input:
+//
+//    builder               The builder that receives the terms.
+//
+//    equation_offset       This value is added to each equation index.
+//
+//    right_hand_side_offset    This value is added to each extra
+//                              right-hand side index.
+//
+//    variable_index_map    Maps each stored variable index to the
+//                          variable index passed to the builder.
+//
+//  Output:
+//
+//    This function has no return value.
+//
+//======================================================================
+
+void TripletBuilder::Replay(LinearSystemBuilder & builder,
+                            int equation_offset,
+                            int right_hand_side_offset,
+                            const std::vector<int> & variable_index_map) const
+{
+    size_t i = 0;
+
+    for (i = 0; i < m_a_triplet_vector.size(); ++i)
+    {
+        const Triplet_T & triplet = m_a_triplet_vector[i];
+
+        builder.AddToAMatrix(triplet.m_row + equation_offset,
+                             variable_index_map[triplet.m_column],
+                             triplet.m_value);
+    }
+
+    for (i = 0; i < m_b_triplet_vector.size(); ++i)
+    {
+        const Triplet_T & triplet = m_b_triplet_vector[i];
+
+        builder.AddToBVector(triplet.m_row + equation_offset,
+                             triplet.m_value);
+    }
+
+    for (i = 0; i < m_rhs_triplet_vector.size(); ++i)
+    {
+        const Triplet_T & triplet = m_rhs_triplet_vector[i];
+
+        builder.AddToRightHandSide(triplet.m_row + right_hand_side_offset,
+                                   triplet.m_column,
+                                   triplet.m_value);
+    }
+
+    return;
+}
+
+//======================================================================
+//  Member Function: TripletBuilder::Assemble
+//
+//  Abstract:
+//
+//    This function sums the A matrix terms into a compressed sparse
+//    row matrix. See the AssembleTriplets method.
+//
+//
+//  Input:
+//
+//    minimum_number_of_rows        The minimum number of rows. The
+//                                  matrix has more rows if a term has
+//                                  a larger equation index.
+//
+//    minimum_number_of_columns     The minimum number of columns.
+//
+//    a_matrix                      The assembled matrix.
+//
+//  Output:
+//
+//    This function has no return value.
+//
+//======================================================================
+
+void TripletBuilder::Assemble(int minimum_number_of_rows,
+                              int minimum_number_of_columns,
+                              CompressedSparseMatrix & a_matrix) const
+{
+    AssembleTriplets(m_a_triplet_vector,
+                     minimum_number_of_rows,
+                     minimum_number_of_columns,
+                     a_matrix);
+    return;
+}
+
+//======================================================================
+//  Member Function: TripletBuilder::AssembleRightHandSides
+//
+//  Abstract:
+//
+//    This function sums the terms of the extra right-hand sides into
+//    a compressed sparse row matrix. Row r of the matrix is extra
+//    right-hand side r and the column index is the equation index.
+//    The terms are summed in the same way as the A matrix terms.
+//
+//
+//  Input:
+//
+//    right_hand_side_matrix    The assembled matrix.
+//
+//  Output:
+//
+//    This function has no return value.
+//
+//======================================================================
+
+void TripletBuilder::AssembleRightHandSides(CompressedSparseMatrix & right_hand_side_matrix) const
+{
+    AssembleTriplets(m_rhs_triplet_vector,
+                     0,
+                     0,
+                     right_hand_side_matrix);
+    return;
+}
+
+//======================================================================
+//  Member Function: TripletBuilder::AssembleTriplets
+//
+//  Abstract:
+//
+//    This function sums a vector of terms into a compressed sparse
+//    row matrix.
+//
+//    The terms are first distributed into rows with a stable counting
+//    sort. Terms for the same element are then summed, in the order
+//    that they were added, starting with the value zero. This gives
+//    exactly the same sums as adding each term to a SparseMatrix.
+//    An element whose terms cancel is kept with the value zero, as it
+//    is in a SparseMatrix. Finally, the elements of each row that is
+//    not already in column order are sorted.
+//
+//
+//  Input:
+//
+//    triplet_vector                The terms.
+//
+//    minimum_number_of_rows        The minimum number of rows. The
+//                                  matrix has more rows if a term has
+//                                  a larger row index.
+//
+//    minimum_number_of_columns     The minimum number of columns.
+//
+//    matrix                        The assembled matrix.
+//
+//  Output:
+//
+//    This function has no return value.
+//
+//======================================================================
+
+void TripletBuilder::AssembleTriplets(const std::vector<Triplet_T> & triplet_vector,
+                                      int minimum_number_of_rows,
+                                      int minimum_number_of_columns,
+                                      CompressedSparseMatrix & matrix)
+{
+    //------------------------------------------------------------------
+    //  Find the size of the matrix.
+    //------------------------------------------------------------------
+
+    int number_of_rows = minimum_number_of_rows;
+    int number_of_columns = minimum_number_of_columns;
+    size_t number_of_terms = triplet_vector.size();
+    size_t i = 0;
+
+    for (i = 0; i < number_of_terms; ++i)
+    {
+        const Triplet_T & triplet = triplet_vector[i];
+
+        if (triplet.m_row >= number_of_rows)
+        {
+            number_of_rows = triplet.m_row + 1;
+        }
+
+        if (triplet.m_column >= number_of_columns)
+        {
+            number_of_columns = triplet.m_column + 1;
+        }
+    }
+
+    //------------------------------------------------------------------
+    //  Count the terms in each row and distribute the terms into rows
+    //  keeping the order that they were added.
+    //------------------------------------------------------------------
+
+    std::vector<size_t> row_start_vector(number_of_rows + 1, 0);
+
+    for (i = 0; i < number_of_terms; ++i)
+    {
+        ++row_start_vector[triplet_vector[i].m_row + 1];
+    }
+
+    int row = 0;
+
+    for (row = 0; row < number_of_rows; ++row)
+    {
+        row_start_vector[row + 1] += row_start_vector[row];
+    }
+
+    std::vector<int> column_index_vector(number_of_terms);
+    std::vector<double> value_vector(number_of_terms);
+    std::vector<size_t> next_vector(row_start_vector.begin(), row_start_vector.end() - 1);
+
+    for (i = 0; i < number_of_terms; ++i)
+    {
+        const Triplet_T & triplet = triplet_vector[i];
+        size_t destination = next_vector[triplet.m_row]++;
+        column_index_vector[destination] = triplet.m_column;
+        value_vector[destination] = triplet.m_value;
+    }
+
+    //------------------------------------------------------------------
+    //  Sum the terms for the same element in place and then sort the
+    //  elements of the row by column index. The position vector holds
+    //  the position of each column in the current row.
+    //------------------------------------------------------------------
+
+    std::vector<size_t> position_vector(number_of_columns, number_of_terms);
+    std::vector<std::pair<int, double> > row_element_vector;
+    size_t number_of_elements = 0;
+    size_t term_start = 0;
+
+    for (row = 0; row < number_of_rows; ++row)
+    {
+        size_t row_start = number_of_elements;
+        size_t term_end = row_start_vector[row + 1];
+        bool sorted_flag = true;
+
+        for (i = term_start; i < term_end; ++i)
+        {
+            int column = column_index_vector[i];
+            size_t position = position_vector[column];
+
+            if ((position != number_of_terms) && (position >= row_start))
+            {
+                value_vector[position] = value_vector[position] + value_vector[i];
+            }
+            else
+            {
+                if ((number_of_elements > row_start)
+                    && (column < column_index_vector[number_of_elements - 1]))
+                {
+                    sorted_flag = false;
+                }
+
+                position_vector[column] = number_of_elements;
+                column_index_vector[number_of_elements] = column;
+                value_vector[number_of_elements] = 0.0 + value_vector[i];
+                ++number_of_elements;
+            }
+        }
+
+        if (! sorted_flag)
+        {
+            row_element_vector.clear();
+
+            for (i = row_start; i < number_of_elements; ++i)
+            {
+                row_element_vector.push_back(std::make_pair(column_index_vector[i], value_vector[i]));
+            }
+
+            std::sort(row_element_vector.begin(), row_element_vector.end());
+
+            for (i = row_start; i < number_of_elements; ++i)
+            {
+                column_index_vector[i] = row_element_vector[i - row_start].first;
+                value_vector[i] = row_element_vector[i - row_start].second;
+            }
+        }
+
+        term_start = term_end;
+        row_start_vector[row] = row_start;
+    }
+
+    row_start_vector[number_of_rows] = number_of_elements;
+    column_index_vector.resize(number_of_elements);
+    value_vector.resize(number_of_elements);
+
+    matrix.Assign(number_of_rows,
+                number_of_columns,
+                row_start_vector,
+                column_index_vector,
+                value_vector);
+
+    return;
+}
+
+//======================================================================
+//  Member Function: TripletBuilder::AssembleBVector
+//
+//  Abstract:
+//
+//    This function sums the B vector terms into a sparse vector. The
+//    elements are inserted in index order with a position hint.
+//
+//
+//  Input:
+//
+//    b_vector          The sparse vector. Any existing elements are
+//                      removed.
+//
+//  Output:
+//
+//    This function has no return value.
+//
+//======================================================================
+
+void TripletBuilder::AssembleBVector(MatrixPackage::SparseVector & b_vector) const
+{
+    b_vector.clear();
+
+    int number_of_rows = 0;
+    size_t i = 0;
+
+    for (i = 0; i < m_b_triplet_vector.size(); ++i)
+    {
+        if (m_b_triplet_vector[i].m_row >= number_of_rows)
+        {
+            number_of_rows = m_b_triplet_vector[i].m_row + 1;
+        }
+    }
+
+    std::vector<double> sum_vector(number_of_rows, 0.0);
+    std::vector<bool> present_vector(number_of_rows, false);
+
+    for (i = 0; i < m_b_triplet_vector.size(); ++i)
+    {
+        const Triplet_T & triplet = m_b_triplet_vector[i];
+        sum_vector[triplet.m_row] = sum_vector[triplet.m_row] + triplet.m_value;
+        present_vector[triplet.m_row] = true;
+    }
+
+    for (int row = 0; row < number_of_rows; ++row)
+    {
+        if (present_vector[row])
+        {
+            b_vector.insert(b_vector.end(),
+                            MatrixPackage::SparseVector::value_type(row, sum_vector[row]));
+        }
+    }
+
+    return;
+}
+
+//======================================================================
+//  Member Function: TripletBuilder::Reserve
+//======================================================================
+
+void TripletBuilder::Reserve(size_t number_of_a_terms)
+{
+    m_a_triplet_vector.reserve(number_of_a_terms);
+    return;
+}
+
+//======================================================================
+//  Member Function: TripletBuilder::Clear
+//======================================================================
+
+void TripletBuilder::Clear()
+{
+    m_a_triplet_vector.clear();
+    m_b_triplet_vector.clear();
+    m_rhs_triplet_vector.clear();
+    return;
+}
+
+//======================================================================
+//  Member Function: TripletBuilder::GetATriplets
+//======================================================================
+
+const std::vector<TripletBuilder::Triplet_T> & TripletBuilder::GetATriplets() const
+{
+    return m_a_triplet_vector;
+}
+
+//======================================================================
+//  Member Function: TripletBuilder::GetBTriplets
+//======================================================================
+
+const std::vector<TripletBuilder::Triplet_T> & TripletBuilder::GetBTriplets() const
+{
+    return m_b_triplet_vector;
+}
@@ -0,0 +1,150 @@
+#ifndef LINEARSYSTEMBUILDER_H
+#define LINEARSYSTEMBUILDER_H
+
+#include <vector>
+#include "MatrixPackage.h"
+#include "CompressedSparseMatrix.h"
+
+//======================================================================
+//  Class Definition
+//
+//  This is the interface that the LinearEquationParser uses to store
+//  the terms of the equations. For each term the parser adds a value
+//  either to an element of the A matrix or to an element of the B
+//  vector.
+//
+//  The input can also contain extra right-hand sides, which are other
+//  B vectors for the same A matrix. The first extra right-hand side
+//  has index zero. A builder that does not override the
+//  AddToRightHandSide method ignores the extra right-hand sides.
+//======================================================================
+
+class LinearSystemBuilder
+{
+public:
+
+    virtual ~LinearSystemBuilder();
+
+    virtual void AddToAMatrix(int equation_index,
+                              int variable_index,
+                              double value) = 0;
+
+    virtual void AddToBVector(int equation_index,
+                              double value) = 0;
+
+    virtual void AddToRightHandSide(int right_hand_side_index,
+                                    int equation_index,
+                                    double value);
+};
+
+//======================================================================
+//  Class Definition
+//
+//  This builder adds each term directly to a sparse A matrix and a
+//  sparse B vector.
+//======================================================================
+
+class SparseMatrixBuilder : public LinearSystemBuilder
+{
+public:
+
+    SparseMatrixBuilder(MatrixPackage::SparseMatrix & a_matrix,
+                        MatrixPackage::SparseVector & b_vector);
+
+    virtual ~SparseMatrixBuilder();
+
+    virtual void AddToAMatrix(int equation_index,
+                              int variable_index,
+                              double value);
+
+    virtual void AddToBVector(int equation_index,
+                              double value);
+
+private:
+
+    MatrixPackage::SparseMatrix & m_a_matrix;
+    MatrixPackage::SparseVector & m_b_vector;
+};
+
+//======================================================================
+//  Class Definition
+//
+//  This builder appends each term to a contiguous buffer of
+//  (row, column, value) triplets. The terms are kept in the order
+//  that they were parsed so that they can later be replayed into
+//  another builder, with the indices renumbered, and give exactly the
+//  same sums as if the terms had been added directly.
+//
+//  The terms can also be assembled directly into a compressed sparse
+//  row matrix with one sort-and-sum pass, which avoids a tree search
+//  and a node allocation for each term.
+//======================================================================
+
+class TripletBuilder : public LinearSystemBuilder
+{
+public:
+
+    struct Triplet_T
+    {
+        int m_row;
+        int m_column;
+        double m_value;
+    };
+
+    TripletBuilder();
+
+    virtual ~TripletBuilder();
+
+    virtual void AddToAMatrix(int equation_index,
+                              int variable_index,
+                              double value);
+
+    virtual void AddToBVector(int equation_index,
+                              double value);
+
+    virtual void AddToRightHandSide(int right_hand_side_index,
+                                    int equation_index,
+                                    double value);
+
+    void Replay(LinearSystemBuilder & builder,
+                int equation_offset,
+                int right_hand_side_offset,
+                const std::vector<int> & variable_index_map) const;
+
+    void Assemble(int minimum_number_of_rows,
+                  int minimum_number_of_columns,
+                  CompressedSparseMatrix & a_matrix) const;
+
+    void AssembleBVector(MatrixPackage::SparseVector & b_vector) const;
+
+    void AssembleRightHandSides(CompressedSparseMatrix & right_hand_side_matrix) const;
+
+    void Reserve(size_t number_of_a_terms);
+
+    void Clear();
+
+    const std::vector<Triplet_T> & GetATriplets() const;
+
+    const std::vector<Triplet_T> & GetBTriplets() const;
+
+protected:
+
+    static void AssembleTriplets(const std::vector<Triplet_T> & triplet_vector,
+                                 int minimum_number_of_rows,
+                                 int minimum_number_of_columns,
+                                 CompressedSparseMatrix & matrix);
+
+protected:
+
+    std::vector<Triplet_T> m_a_triplet_vector;
+    std::vector<Triplet_T> m_b_triplet_vector;
+
+    //------------------------------------------------------------------
+    //  The row of an extra right-hand side term is the right-hand side
+    //  index and the column is the equation index.
+    //------------------------------------------------------------------
+
+    std::vector<Triplet_T> m_rhs_triplet_vector;
+};
+
+#endif
@@ -0,0 +1,2266 @@
+#include <float.h>
+#include <math.h>
+#include <algorithm>
+#include <utility>
+#include "FixedSizeSolver.h"
+#include "LinearSystemSolver.h"
+
+namespace
+{
+    //------------------------------------------------------------------
+    //  The sparse LU factorization is used when fewer than this
+    //  fraction of the elements of the A matrix are stored.
+    //------------------------------------------------------------------
+
+    const double f_DEFAULT_SPARSE_DENSITY_THRESHOLD = 0.1;
+
+    //------------------------------------------------------------------
+    //  The largest number of B vectors that are solved together. The
+    //  elements of a block for one row fill two cache lines.
+    //------------------------------------------------------------------
+
+    const int f_RIGHT_HAND_SIDE_BLOCK_SIZE = 16;
+
+    //------------------------------------------------------------------
+    //  The largest system that is solved with a fixed size solver.
+    //------------------------------------------------------------------
+
+    const int f_MAXIMUM_FIXED_SIZE = 8;
+
+    //------------------------------------------------------------------
+    //  Iterative refinement stops when the backward error is at most
+    //  the square root of the number of equations times the double
+    //  precision epsilon. The refinement has stalled if an iteration
+    //  does not at least halve the backward error, or if the error is
+    //  still too large after the maximum number of iterations.
+    //------------------------------------------------------------------
+
+    const int f_MAXIMUM_REFINEMENT_ITERATIONS = 30;
+    const double f_REFINEMENT_STALL_RATIO = 0.5;
+
+    //------------------------------------------------------------------
+    //  Copy the stored elements of the first n rows and columns of the
+    //  A matrix into a dense matrix, and return the number of elements
+    //  that were copied.
+    //------------------------------------------------------------------
+
+    template <class T_ELEMENT>
+    size_t CopyToDense(const FrozenSparseMatrix & a_matrix,
+                       int n,
+                       std::vector<T_ELEMENT> & dense_vector,
+                       std::vector<T_ELEMENT *> & row_ptr_vector,
+                       std::vector<int> & dense_row_vector)
+    {
+        size_t row_length = (size_t)(n);
+        size_t number_of_elements = 0;
+
+        dense_vector.assign(row_length * n, T_ELEMENT(0));
+        dense_row_vector.resize(n);
+        row_ptr_vector.resize(n);
+
+        for (int i = 0; i < n; ++i)
+        {
+            T_ELEMENT * row_ptr = &dense_vector[row_length * i];
+            row_ptr_vector[i] = row_ptr;
+            dense_row_vector[i] = i;
+
+            if (i < a_matrix.GetNumberOfRows())
+            {
+                SparseSlice row_slice = a_matrix.GetRow(i);
+
+                for (SparseSlice::Iterator row_iter = row_slice.begin(); row_iter != row_slice.end(); ++row_iter)
+                {
+                    if (row_iter.GetIndex() < n)
+                    {
+                        row_ptr[row_iter.GetIndex()] = (T_ELEMENT)(row_iter.GetValue());
+                        ++number_of_elements;
+                    }
+                }
+            }
+        }
+
+        return number_of_elements;
+    }
+
+    //------------------------------------------------------------------
+    //  Reduce a dense matrix to upper triangular form with partial
+    //  pivoting, storing each multiplier in place of the element that
+    //  it eliminates. Rows are exchanged by exchanging row pointers and
+    //  row numbers, and rows whose multiplier is zero are skipped. The
+    //  inner loop has unit stride, so it is compiled to vector
+    //  instructions, which hold twice as many single precision
+    //  elements as double precision elements. Returns false if a
+    //  pivot is zero.
+    //------------------------------------------------------------------
+
+    template <class T_ELEMENT>
+    bool EliminateDense(int n,
+                        std::vector<T_ELEMENT *> & row_ptr_vector,
+                        std::vector<int> & dense_row_vector,
+                        double & flop_count)
+    {
+        int i = 0;
+        int j = 0;
+        int k = 0;
+
+        for (k = 0; k < n; ++k)
+        {
+            int pivot_row = k;
+
+            for (i = k + 1; i < n; ++i)
+            {
+                if (fabs(row_ptr_vector[i][k]) > fabs(row_ptr_vector[pivot_row][k]))
+                {
+                    pivot_row = i;
+                }
+            }
+
+            if (row_ptr_vector[pivot_row][k] == T_ELEMENT(0))
+            {
+                return false;
+            }
+
+            std::swap(row_ptr_vector[pivot_row], row_ptr_vector[k]);
+            std::swap(dense_row_vector[pivot_row], dense_row_vector[k]);
+
+            const T_ELEMENT * pivot_row_ptr = row_ptr_vector[k];
+
+            for (i = k + 1; i < n; ++i)
+            {
+                T_ELEMENT * row_ptr = row_ptr_vector[i];
+
+                if (row_ptr[k] != T_ELEMENT(0))
+                {
+                    T_ELEMENT multiplier = row_ptr[k] / pivot_row_ptr[k];
+
+                    for (j = k + 1; j < n; ++j)
+                    {
+                        row_ptr[j] -= multiplier * pivot_row_ptr[j];
+                    }
+
+                    row_ptr[k] = multiplier;
+                    flop_count += 2.0 * (double)(n - k - 1) + 1.0;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    //------------------------------------------------------------------
+    //  Solve with dense factors. The B vector is rounded to the
+    //  precision of the factors and the solution is returned in
+    //  double precision.
+    //------------------------------------------------------------------
+
+    template <class T_ELEMENT>
+    void SolveDenseFactors(int n,
+                           const std::vector<T_ELEMENT> & dense_vector,
+                           const std::vector<int> & dense_row_vector,
+                           const std::vector<double> & b_vector,
+                           std::vector<double> & x_vector)
+    {
+        size_t row_length = (size_t)(n);
+        std::vector<T_ELEMENT> y_vector(n);
+        int i = 0;
+        int j = 0;
+
+        //--------------------------------------------------------------
+        //  Reduce the B vector. Each element is reduced by the
+        //  multipliers in its row in column order, which is the order
+        //  in which the elimination would have reduced it.
+        //--------------------------------------------------------------
+
+        for (i = 0; i < n; ++i)
+        {
+            const T_ELEMENT * row_ptr = &dense_vector[row_length * dense_row_vector[i]];
+            T_ELEMENT y_value = (T_ELEMENT)(b_vector[dense_row_vector[i]]);
+
+            for (j = 0; j < i; ++j)
+            {
+                if (row_ptr[j] != T_ELEMENT(0))
+                {
+                    y_value -= row_ptr[j] * y_vector[j];
+                }
+            }
+
+            y_vector[i] = y_value;
+        }
+
+        //--------------------------------------------------------------
+        //  Back substitute in place.
+        //--------------------------------------------------------------
+
+        for (i = n - 1; i >= 0; --i)
+        {
+            const T_ELEMENT * row_ptr = &dense_vector[row_length * dense_row_vector[i]];
+            T_ELEMENT sum = y_vector[i];
+
+            for (j = i + 1; j < n; ++j)
+            {
+                sum -= row_ptr[j] * y_vector[j];
+            }
+
+            y_vector[i] = sum / row_ptr[i];
+        }
+
+        x_vector.assign(y_vector.begin(), y_vector.end());
+
+        return;
+    }
+
+    //------------------------------------------------------------------
+    //  Factor a dense matrix with T_SIZE rows in place with the fixed
+    //  size solver, and store the row order of the factors.
+    //------------------------------------------------------------------
+
+    template <int T_SIZE>
+    bool FactorFixedSizeArray(std::vector<double> & dense_vector,
+                              std::vector<int> & dense_row_vector)
+    {
+        typename FixedSizeSolver<T_SIZE>::Matrix_T lu_array;
+        typename FixedSizeSolver<T_SIZE>::RowOrder_T row_order_array;
+
+        std::copy(dense_vector.begin(), dense_vector.begin() + T_SIZE * T_SIZE, lu_array.begin());
+
+        bool factored_flag = FixedSizeSolver<T_SIZE>::Factor(lu_array, row_order_array);
+
+        std::copy(lu_array.begin(), lu_array.end(), dense_vector.begin());
+        std::copy(row_order_array.begin(), row_order_array.end(), dense_row_vector.begin());
+
+        return factored_flag;
+    }
+
+    //------------------------------------------------------------------
+    //  Solve for B vectors of T_SIZE elements, stored one after
+    //  another, with the fixed size factors.
+    //------------------------------------------------------------------
+
+    template <int T_SIZE>
+    void SolveFixedSizeArray(const std::vector<double> & dense_vector,
+                             const std::vector<int> & dense_row_vector,
+                             const double * b_ptr,
+                             int number_of_right_hand_sides,
+                             double * x_ptr)
+    {
+        typename FixedSizeSolver<T_SIZE>::Matrix_T lu_array;
+        typename FixedSizeSolver<T_SIZE>::RowOrder_T row_order_array;
+        typename FixedSizeSolver<T_SIZE>::Vector_T b_array;
+        typename FixedSizeSolver<T_SIZE>::Vector_T x_array;
+
+        std::copy(dense_vector.begin(), dense_vector.begin() + T_SIZE * T_SIZE, lu_array.begin());
+        std::copy(dense_row_vector.begin(), dense_row_vector.begin() + T_SIZE, row_order_array.begin());
+
+        for (int r = 0; r < number_of_right_hand_sides; ++r)
+        {
+            std::copy(b_ptr + T_SIZE * r, b_ptr + T_SIZE * (r + 1), b_array.begin());
+            FixedSizeSolver<T_SIZE>::Solve(lu_array, row_order_array, b_array, x_array);
+            std::copy(x_array.begin(), x_array.end(), x_ptr + T_SIZE * r);
+        }
+
+        return;
+    }
+}
+
+//======================================================================
+//  Constructor: LinearSystemSolver::LinearSystemSolver
+//======================================================================
+
+LinearSystemSolver::LinearSystemSolver()
+  : m_n(0)
+  , m_sparse_density_threshold(f_DEFAULT_SPARSE_DENSITY_THRESHOLD)
+  , m_method(DENSE_ELIMINATION)
+  , m_pattern_key(0)
+  , m_analysis_reused_flag(false)
+  , m_matrix_nonzeros(0)
+  , m_lower_nonzeros(0)
+  , m_upper_nonzeros(0)
+  , m_fill_in(0)
+  , m_flop_count(0.0)
+  , m_mixed_precision_flag(false)
+  , m_single_precision_flag(false)
+  , m_double_precision_fallback_flag(false)
+  , m_refinement_iterations(0)
+  , m_backward_error(0.0)
+  , m_block_triangular_flag(true)
+{
+}
+
+//======================================================================
+//  Destructor: LinearSystemSolver::~LinearSystemSolver
+//======================================================================
+
+LinearSystemSolver::~LinearSystemSolver()
+{
+}
+
+//======================================================================
+//  Member Function: LinearSystemSolver::Analyze
+//
+//  Abstract:
+//
+//    This function computes the block triangular form of the A
+//    matrix. If there is more than one diagonal block then each
+//    diagonal block with more than one element is analyzed by its own
+//    solver. Otherwise this function chooses the method from the
+//    fraction of the elements of the A matrix that are stored. For the
+//    sparse LU factorization the factor structure is computed unless
+//    the solver holds a factor structure with the same pattern key.
+//    The solvers of the diagonal blocks are analyzed with a pattern
+//    key of zero, so to keep a factor structure for the whole A
+//    matrix the block triangular form must be turned off.
+//
+//
+//  Input:
+//
+//    number_of_equations   The number of equations and variables.
+//
+//    a_matrix              The A matrix.
+//
+//    pattern_key           The pattern key of the equations, or zero
+//                          if the factor structure is not to be kept.
+//
+//  Output:
+//
+//    This function has no return value.
+//
+//======================================================================
+
+void LinearSystemSolver::Analyze(unsigned int number_of_equations,
+                                 const FrozenSparseMatrix & a_matrix,
+                                 uint64_t pattern_key)
+{
+    int n = (int)(number_of_equations);
+    double density = 1.0;
+
+    m_n = n;
+    m_block_solver_vector.clear();
+    m_off_diagonal_start_vector.clear();
+    m_off_diagonal_column_vector.clear();
+    m_off_diagonal_value_vector.clear();
+
+    //------------------------------------------------------------------
+    //  A small system is not split into blocks.
+    //------------------------------------------------------------------
+
+    if ((n > 0) && (n <= f_MAXIMUM_FIXED_SIZE))
+    {
+        m_method = FIXED_SIZE_ELIMINATION;
+        m_analysis_reused_flag = false;
+        m_pattern_key = pattern_key;
+        return;
+    }
+
+    //------------------------------------------------------------------
+    //  Use the block triangular form if it has more than one block. A
+    //  structurally singular matrix has no block triangular form.
+    //------------------------------------------------------------------
+
+    if (m_block_triangular_flag
+        && (n > 1)
+        && m_block_form.Compute(a_matrix, n)
+        && (m_block_form.GetNumberOfBlocks() > 1))
+    {
+        const std::vector<int> & column_order_vector = m_block_form.GetColumnOrder();
+        const std::vector<int> & block_start_vector = m_block_form.GetBlockStart();
+        int number_of_blocks = m_block_form.GetNumberOfBlocks();
+
+        m_method = BLOCK_TRIANGULAR;
+        m_analysis_reused_flag = false;
+        m_pattern_key = pattern_key;
+        m_column_position_vector.resize(n);
+
+        for (int k = 0; k < n; ++k)
+        {
+            m_column_position_vector[column_order_vector[k]] = k;
+        }
+
+        m_block_solver_vector.resize(number_of_blocks);
+        m_block_diagonal_vector.assign(number_of_blocks, 0.0);
+        m_off_diagonal_start_vector.assign(1, 0);
+
+        for (int block = 0; block < number_of_blocks; ++block)
+        {
+            int block_size = block_start_vector[block + 1] - block_start_vector[block];
+            FrozenSparseMatrix block_matrix;
+
+            SplitBlock(a_matrix, block, block_matrix);
+
+            if (block_size > 1)
+            {
+                m_block_solver_vector[block].reset(new LinearSystemSolver());
+
+                LinearSystemSolver & block_solver = *m_block_solver_vector[block];
+                block_solver.SetSparseDensityThreshold(m_sparse_density_threshold);
+                block_solver.SetBlockTriangularForm(false);
+                block_solver.Analyze(block_size, block_matrix, 0);
+            }
+        }
+
+        return;
+    }
+
+    if (n > 0)
+    {
+        density = (double)(a_matrix.GetNumberOfNonzeros()) / ((double)(n) * (double)(n));
+    }
+
+    m_method = (density < m_sparse_density_threshold) ? SPARSE_LU : DENSE_ELIMINATION;
+
+    m_analysis_reused_flag = (m_method == SPARSE_LU)
+        && (pattern_key != 0)
+        && (pattern_key == m_pattern_key)
+        && m_sparse_lu.IsAnalyzed()
+        && (m_sparse_lu.GetSize() == n);
+
+    if ((m_method == SPARSE_LU) && (! m_analysis_reused_flag))
+    {
+        m_sparse_lu.Analyze(a_matrix, n);
+    }
+
+    m_pattern_key = pattern_key;
+
+    return;
+}
+
+//======================================================================
+//  Member Function: LinearSystemSolver::Factor
+//
+//  Abstract:
+//
+//    This function factors the A matrix using the method chosen by
+//    the analysis. The A matrix must have the nonzero pattern that was
+//    analyzed, but the values of its elements can differ. In mixed
+//    precision mode, dense elimination is done in single precision.
+//
+//
+//  Input:
+//
+//    a_matrix              The A matrix.
+//
+//  Output:
+//
+//    This function returns a value of type 'Status_T'.
+//
+//======================================================================
+
+LinearSystemSolver::Status_T LinearSystemSolver::Factor(const FrozenSparseMatrix & a_matrix)
+{
+    m_double_precision_fallback_flag = false;
+    m_single_precision_flag = false;
+
+    if (m_method == FIXED_SIZE_ELIMINATION)
+    {
+        return FactorFixedSize(a_matrix);
+    }
+
+    if (m_method == BLOCK_TRIANGULAR)
+    {
+        return FactorBlocks(a_matrix, m_mixed_precision_flag);
+    }
+
+    if (m_method == DENSE_ELIMINATION)
+    {
+        //--------------------------------------------------------------
+        //  In mixed precision mode, factor in single precision unless
+        //  a single precision pivot is zero.
+        //--------------------------------------------------------------
+
+        if (m_mixed_precision_flag)
+        {
+            if (FactorDenseSingle(a_matrix) == SUCCESS)
+            {
+                return SUCCESS;
+            }
+
+            m_double_precision_fallback_flag = true;
+        }
+
+        return FactorDense(a_matrix);
+    }
+
+    SparseLU::Status_T lu_status = m_sparse_lu.Factor(a_matrix);
+
+    m_matrix_nonzeros = m_sparse_lu.GetNumberOfMatrixNonzeros();
+    m_lower_nonzeros = m_sparse_lu.GetNumberOfLowerNonzeros();
+    m_upper_nonzeros = m_sparse_lu.GetNumberOfUpperNonzeros();
+    m_fill_in = m_sparse_lu.GetFillIn();
+    m_flop_count = m_sparse_lu.GetFlopCount();
+
+    return (lu_status == SparseLU::SUCCESS) ? SUCCESS : MATRIX_SINGULAR;
+}
+
+//======================================================================
+//  Member Function: LinearSystemSolver::Solve
+//
+//  Abstract:
+//
+//    This function solves the equations A x = B using the factors.
+//
+//
+//  Input:
+//
+//    b_vector              The B vector.
+//
+//    x_vector              The solution. Any existing elements are
+//                          removed, and then every element of the
+//                          solution is stored.
+//
+//  Output:
+//
+//    This function has no return value.
+//
+//======================================================================
+
+void LinearSystemSolver::Solve(const MatrixPackage::SparseVector & b_vector,
+                               MatrixPackage::SparseVector & x_vector) const
+{
+    std::vector<double> b_dense_vector(m_n, 0.0);
+
+    for (MatrixPackage::SparseVector::const_iterator b_iter = b_vector.begin();
+         b_iter != b_vector.end();
+         ++b_iter)
+    {
+        if (((*b_iter).first >= 0) && ((*b_iter).first < m_n))
+        {
+            b_dense_vector[(*b_iter).first] = (*b_iter).second;
+        }
+    }
+
+    std::vector<double> x_dense_vector;
+    Solve(b_dense_vector, x_dense_vector);
+
+    x_vector.clear();
+
+    for (int i = 0; i < (int)(x_dense_vector.size()); ++i)
+    {
+        x_vector.insert(x_vector.end(),
+                        MatrixPackage::SparseVector::value_type(i, x_dense_vector[i]));
+    }
+
+    return;
+}
+
+//======================================================================
+//  Member Function: LinearSystemSolver::Solve
+//
+//  Abstract:
+//
+//    This function solves the equations A x = B for a dense B vector
+//    using the factors.
+//
+//
+//  Input:
+//
+//    b_vector              The B vector, which must have
+//                          number_of_equations elements.
+//
+//    x_vector              The solution.
+//
+//  Output:
+//
+//    This function has no return value.
+//
+//======================================================================
+
+void LinearSystemSolver::Solve(const std::vector<double> & b_vector,
+                               std::vector<double> & x_vector) const
+{
+    if (m_method == BLOCK_TRIANGULAR)
+    {
+        SolveBlockTriangular(b_vector, 1, x_vector);
+    }
+    else if (m_method == FIXED_SIZE_ELIMINATION)
+    {
+        x_vector.resize(m_n);
+        SolveFixedSize(&b_vector[0], 1, &x_vector[0]);
+    }
+    else if (m_single_precision_flag)
+    {
+        SolveDenseFactors(m_n, m_single_dense_vector, m_dense_row_vector, b_vector, x_vector);
+    }
+    else if (m_method == DENSE_ELIMINATION)
+    {
+        SolveDense(b_vector, x_vector);
+    }
+    else
+    {
+        m_sparse_lu.Solve(b_vector, x_vector);
+    }
+
+    return;
+}
+
+//======================================================================
+//  Member Function: LinearSystemSolver::Solve
+//
+//  Abstract:
+//
+//    This function solves the equations A x = B for several dense B
+//    vectors using the factors. The vectors are copied into blocks of
+//    up to f_RIGHT_HAND_SIDE_BLOCK_SIZE vectors, where the elements of
+//    the vectors are interleaved, and each block is solved with one
+//    pass over the factors. The solution of each vector is the same as
+//    the solution when the vector is solved by itself.
+//
+//
+//  Input:
+//
+//    b_vectors                 The B vectors, one after another. Each
+//                              vector has number_of_equations
+//                              elements.
+//
+//    number_of_right_hand_sides    The number of B vectors.
+//
+//    x_vectors                 The solutions, stored in the same way.
+//
+//  Output:
+//
+//    This function has no return value.
+//
+//======================================================================
+
+void LinearSystemSolver::Solve(const std::vector<double> & b_vectors,
+                               int number_of_right_hand_sides,
+                               std::vector<double> & x_vectors) const
+{
+    size_t n = (size_t)(m_n);
+    std::vector<double> b_block_vector;
+    std::vector<double> x_block_vector;
+
+    x_vectors.resize(n * number_of_right_hand_sides);
+
+    //------------------------------------------------------------------
+    //  The solver of each diagonal block solves the block's part of
+    //  every vector together.
+    //------------------------------------------------------------------
+
+    if (m_method == BLOCK_TRIANGULAR)
+    {
+        SolveBlockTriangular(b_vectors, number_of_right_hand_sides, x_vectors);
+        return;
+    }
+
+    if (m_method == FIXED_SIZE_ELIMINATION)
+    {
+        SolveFixedSize(&b_vectors[0], number_of_right_hand_sides, &x_vectors[0]);
+        return;
+    }
+
+    //------------------------------------------------------------------
+    //  Single precision factors are only used for refinement, so each
+    //  vector is solved by itself.
+    //------------------------------------------------------------------
+
+    if (m_single_precision_flag)
+    {
+        std::vector<double> b_vector(n);
+        std::vector<double> x_vector;
+
+        for (int r = 0; r < number_of_right_hand_sides; ++r)
+        {
+            b_vector.assign(b_vectors.begin() + n * r, b_vectors.begin() + n * (r + 1));
+            Solve(b_vector, x_vector);
+            std::copy(x_vector.begin(), x_vector.end(), x_vectors.begin() + n * r);
+        }
+
+        return;
+    }
+
+    for (int first = 0; first < number_of_right_hand_sides; first += f_RIGHT_HAND_SIDE_BLOCK_SIZE)
+    {
+        int block_width = std::min(f_RIGHT_HAND_SIDE_BLOCK_SIZE, number_of_right_hand_sides - first);
+        size_t i = 0;
+        int r = 0;
+
+        b_block_vector.resize(n * block_width);
+
+        for (r = 0; r < block_width; ++r)
+        {
+            const double * b_ptr = &b_vectors[n * (first + r)];
+
+            for (i = 0; i < n; ++i)
+            {
+                b_block_vector[i * block_width + r] = b_ptr[i];
+            }
+        }
+
+        if (m_method == DENSE_ELIMINATION)
+        {
+            SolveDenseBlock(b_block_vector, block_width, x_block_vector);
+        }
+        else
+        {
+            m_sparse_lu.SolveBlock(b_block_vector, block_width, x_block_vector);
+        }
+
+        for (r = 0; r < block_width; ++r)
+        {
+            double * x_ptr = &x_vectors[n * (first + r)];
+
+            for (i = 0; i < n; ++i)
+            {
+                x_ptr[i] = x_block_vector[i * block_width + r];
+            }
+        }
+    }
+
+    return;
+}
+
+//======================================================================
+//  Member Function: LinearSystemSolver::SolveWithRefinement
+//
+//  Abstract:
+//
+//    This function solves the equations A x = B for several dense B
+//    vectors and computes the backward error of the solutions, which
+//    is the largest value of
+//
+//      max | B - A x | / (max row sum | A | * max | x | + max | B |)
+//
+//    over the vectors. If the factors are in single precision then the
+//    solutions are refined. Each iteration computes the residuals
+//    B - A x in double precision, solves for the corrections with the
+//    single precision factors, and adds the corrections to the
+//    solutions. If the refinement stalls then the A matrix, or each
+//    diagonal block of the block triangular form, is factored in
+//    double precision and the equations are solved again.
+//
+//
+//  Input:
+//
+//    a_matrix                  The A matrix that was factored.
+//
+//    b_vectors                 The B vectors, one after another. Each
+//                              vector has number_of_equations
+//                              elements.
+//
+//    number_of_right_hand_sides    The number of B vectors.
+//
+//    x_vectors                 The solutions, stored in the same way.
+//
+//  Output:
+//
+//    This function returns a value of type 'Status_T'. The status is
+//    MATRIX_SINGULAR only if the double precision factorization that
+//    follows a stalled refinement finds that A is singular.
+//
+//======================================================================
+
+LinearSystemSolver::Status_T LinearSystemSolver::SolveWithRefinement(
+                                 const FrozenSparseMatrix & a_matrix,
+                                 const std::vector<double> & b_vectors,
+                                 int number_of_right_hand_sides,
+                                 std::vector<double> & x_vectors)
+{
+    std::vector<double> r_vectors;
+    std::vector<double> d_vectors;
+
+    m_refinement_iterations = 0;
+
+    Solve(b_vectors, number_of_right_hand_sides, x_vectors);
+
+    m_backward_error = ComputeResiduals(a_matrix,
+                                        b_vectors,
+                                        number_of_right_hand_sides,
+                                        x_vectors,
+                                        r_vectors);
+
+    if (! m_single_precision_flag)
+    {
+        return SUCCESS;
+    }
+
+    //------------------------------------------------------------------
+    //  Refine the solutions. The tests are written so that a backward
+    //  error that is not a number is treated as too large.
+    //------------------------------------------------------------------
+
+    double tolerance = sqrt((double)(m_n)) * DBL_EPSILON;
+    bool stalled_flag = false;
+
+    while (! (m_backward_error <= tolerance))
+    {
+        if (m_refinement_iterations == f_MAXIMUM_REFINEMENT_ITERATIONS)
+        {
+            stalled_flag = true;
+            break;
+        }
+
+        Solve(r_vectors, number_of_right_hand_sides, d_vectors);
+
+        for (size_t i = 0; i < x_vectors.size(); ++i)
+        {
+            x_vectors[i] += d_vectors[i];
+        }
+
+        ++m_refinement_iterations;
+
+        double previous_backward_error = m_backward_error;
+
+        m_backward_error = ComputeResiduals(a_matrix,
+                                            b_vectors,
+                                            number_of_right_hand_sides,
+                                            x_vectors,
+                                            r_vectors);
+
+        if (! (m_backward_error <= f_REFINEMENT_STALL_RATIO * previous_backward_error))
+        {
+            stalled_flag = true;
+            break;
+        }
+    }
+
+    //------------------------------------------------------------------
+    //  If the refinement stalled then solve in double precision.
+    //------------------------------------------------------------------
+
+    if (stalled_flag)
+    {
+        m_double_precision_fallback_flag = true;
+
+        Status_T status = (m_method == BLOCK_TRIANGULAR)
+            ? FactorBlocks(a_matrix, false)
+            : FactorDense(a_matrix);
+
+        if (status != SUCCESS)
+        {
+            return status;
+        }
+
+        Solve(b_vectors, number_of_right_hand_sides, x_vectors);
+
+        m_backward_error = ComputeResiduals(a_matrix,
+                                            b_vectors,
+                                            number_of_right_hand_sides,
+                                            x_vectors,
+                                            r_vectors);
+    }
+
+    return SUCCESS;
+}
+
+//======================================================================
+//  Member Function: LinearSystemSolver::Solve
+//
+//  Abstract:
+//
+//    This function analyzes and factors the A matrix and solves the
+//    equations A x = B. No factor structure is kept. In mixed
+//    precision mode the solution is refined.
+//
+//
+//  Input:
+//
+//    number_of_equations   The number of equations and variables.
+//
+//    a_matrix              The A matrix.
+//
+//    b_vector              The B vector.
+//
+//    x_vector              The solution. Any existing elements are
+//                          removed, and then every element of the
+//                          solution is stored.
+//
+//  Output:
+//
+//    This function returns a value of type 'Status_T'.
+//
+//======================================================================
+
+LinearSystemSolver::Status_T LinearSystemSolver::Solve(unsigned int number_of_equations,
+                                                       const FrozenSparseMatrix & a_matrix,
+                                                       const MatrixPackage::SparseVector & b_vector,
+                                                       MatrixPackage::SparseVector & x_vector)
+{
+    std::vector<double> b_dense_vector(number_of_equations, 0.0);
+
+    for (MatrixPackage::SparseVector::const_iterator b_iter = b_vector.begin();
+         b_iter != b_vector.end();
+         ++b_iter)
+    {
+        if (((*b_iter).first >= 0) && ((*b_iter).first < (int)(number_of_equations)))
+        {
+            b_dense_vector[(*b_iter).first] = (*b_iter).second;
+        }
+    }
+
+    std::vector<double> x_dense_vector;
+
+    Status_T status = Solve(number_of_equations, a_matrix, b_dense_vector, x_dense_vector);
+
+    x_vector.clear();
+
+    if (status == SUCCESS)
+    {
+        for (int i = 0; i < (int)(x_dense_vector.size()); ++i)
+        {
+            x_vector.insert(x_vector.end(),
+                            MatrixPackage::SparseVector::value_type(i, x_dense_vector[i]));
+        }
+    }
+
+    return status;
+}
+
+//======================================================================
+//  Member Function: LinearSystemSolver::Solve
+//
+//  Abstract:
+//
+//    This function analyzes and factors the A matrix and solves the
+//    equations A x = B for a dense B vector. No factor structure is
+//    kept. In mixed precision mode the solution is refined.
+//
+//
+//  Input:
+//
+//    number_of_equations   The number of equations and variables.
+//
+//    a_matrix              The A matrix.
+//
+//    b_vector              The B vector.
+//
+//    x_vector              The solution.
+//
+//  Output:
+//
+//    This function returns a value of type 'Status_T'.
+//
+//======================================================================
+
+LinearSystemSolver::Status_T LinearSystemSolver::Solve(unsigned int number_of_equations,
+                                                       const FrozenSparseMatrix & a_matrix,
+                                                       const std::vector<double> & b_vector,
+                                                       std::vector<double> & x_vector)
+{
+    Analyze(number_of_equations, a_matrix, 0);
+
+    Status_T status = Factor(a_matrix);
+
+    if (status == SUCCESS)
+    {
+        status = SolveWithRefinement(a_matrix, b_vector, 1, x_vector);
+    }
+
+    return status;
+}
+
+//======================================================================
+//  Member Function: LinearSystemSolver::SetFactorStructure
+//
+//  Abstract:
+//
+//    This function gives the solver a factor structure that was
+//    saved, for example by the FactorStructureFile class. The next
+//    analysis with the same pattern key uses this factor structure.
+//    The passed factor structure is exchanged with the previous factor
+//    structure.
+//
+//
+//  Input:
+//
+//    pattern_key           The pattern key of the factor structure.
+//
+//    structure             The factor structure.
+//
+//  Output:
+//
+//    This function has no return value.
+//
+//======================================================================
+
+void LinearSystemSolver::SetFactorStructure(uint64_t pattern_key,
+                                            SparseLU::Structure_T & structure)
+{
+    m_sparse_lu.SwapStructure(structure);
+    m_pattern_key = pattern_key;
+    return;
+}
+
+//======================================================================
+//  Member Function: LinearSystemSolver::GetFactorStructure
+//======================================================================
+
+const SparseLU::Structure_T & LinearSystemSolver::GetFactorStructure() const
+{
+    return m_sparse_lu.GetStructure();
+}
+
+//======================================================================
+//  Member Function: LinearSystemSolver::WasFactorStructureReused
+//
+//  Abstract:
+//
+//    This function returns true if the last analysis was skipped and
+//    the last factorization reused the whole factor structure, which
+//    means that the factor structure did not change.
+//
+//======================================================================
+
+bool LinearSystemSolver::WasFactorStructureReused() const
+{
+    return (m_method == SPARSE_LU)
+        && m_analysis_reused_flag
+        && m_sparse_lu.WasPatternReused();
+}
+
+//======================================================================
+//  Member Function: LinearSystemSolver::SetSparseDensityThreshold
+//
+//  Abstract:
+//
+//    This function sets the density below which the sparse LU
+//    factorization is used. A value of zero always uses dense
+//    elimination and a value greater than one always uses the sparse
+//    LU factorization.
+//
+//======================================================================
+
+void LinearSystemSolver::SetSparseDensityThreshold(double sparse_density_threshold)
+{
+    m_sparse_density_threshold = sparse_density_threshold;
+    return;
+}
+
+//======================================================================
+//  Member Function: LinearSystemSolver::GetSparseDensityThreshold
+//======================================================================
+
+double LinearSystemSolver::GetSparseDensityThreshold() const
+{
+    return m_sparse_density_threshold;
+}
+
+//======================================================================
+//  Member Function: LinearSystemSolver::SetMixedPrecision
+//
+//  Abstract:
+//
+//    This function selects mixed precision mode, where the dense
+//    elimination is done in single precision and the solutions from
+//    SolveWithRefinement are refined to double precision accuracy.
+//    The mode does not change the sparse LU factorization.
+//
+//======================================================================
+
+void LinearSystemSolver::SetMixedPrecision(bool mixed_precision_flag)
+{
+    m_mixed_precision_flag = mixed_precision_flag;
+    return;
+}
+
+//======================================================================
+//  Member Function: LinearSystemSolver::GetMixedPrecision
+//======================================================================
+
+bool LinearSystemSolver::GetMixedPrecision() const
+{
+    return m_mixed_precision_flag;
+}
+
+//======================================================================
+//  Member Function: LinearSystemSolver::IsSinglePrecisionFactor
+//
+//  Abstract:
+//
+//    This function returns true if the current factors are in single
+//    precision.
+//
+//======================================================================
+
+bool LinearSystemSolver::IsSinglePrecisionFactor() const
+{
+    return m_single_precision_flag;
+}
+
+//======================================================================
+//  Member Function: LinearSystemSolver::WasDoublePrecisionFallback
+//
+//  Abstract:
+//
+//    This function returns true if, in mixed precision mode, the last
+//    factorization had to be done in double precision, either because
+//    a single precision pivot was zero or because the refinement
+//    stalled.
+//
+//======================================================================
+
+bool LinearSystemSolver::WasDoublePrecisionFallback() const
+{
+    return m_double_precision_fallback_flag;
+}
+
+//======================================================================
+//  Member Function: LinearSystemSolver::GetRefinementIterations
+//
+//  Abstract:
+//
+//    This function returns the number of refinement iterations done by
+//    the last call to SolveWithRefinement.
+//
+//======================================================================
+
+int LinearSystemSolver::GetRefinementIterations() const
+{
+    return m_refinement_iterations;
+}
+
+//======================================================================
+//  Member Function: LinearSystemSolver::GetBackwardError
+//
+//  Abstract:
+//
+//    This function returns the backward error of the solutions from
+//    the last call to SolveWithRefinement.
+//
+//======================================================================
+
+double LinearSystemSolver::GetBackwardError() const
+{
+    return m_backward_error;
+}
+
+//======================================================================
+//  Member Function: LinearSystemSolver::SetBlockTriangularForm
+//
+//  Abstract:
+//
+//    This function selects whether the A matrix is permuted to block
+//    triangular form by the analysis. The default is true.
+//
+//======================================================================
+
+void LinearSystemSolver::SetBlockTriangularForm(bool block_triangular_flag)
+{
+    m_block_triangular_flag = block_triangular_flag;
+    return;
+}
+
+//======================================================================
+//  Member Function: LinearSystemSolver::GetBlockTriangularForm
+//======================================================================
+
+bool LinearSystemSolver::GetBlockTriangularForm() const
+{
+    return m_block_triangular_flag;
+}
+
+//======================================================================
+//  Member Function: LinearSystemSolver::GetNumberOfBlocks
+//
+//  Abstract:
+//
+//    This function returns the number of diagonal blocks of the block
+//    triangular form, which is one if the block triangular form is
+//    not used.
+//
+//======================================================================
+
+int LinearSystemSolver::GetNumberOfBlocks() const
+{
+    if (m_method != BLOCK_TRIANGULAR)
+    {
+        return 1;
+    }
+
+    return m_block_form.GetNumberOfBlocks();
+}
+
+//======================================================================
+//  Member Function: LinearSystemSolver::GetLargestBlockSize
+//======================================================================
+
+int LinearSystemSolver::GetLargestBlockSize() const
+{
+    if (m_method != BLOCK_TRIANGULAR)
+    {
+        return m_n;
+    }
+
+    const std::vector<int> & block_start_vector = m_block_form.GetBlockStart();
+    int largest_block_size = 0;
+
+    for (size_t block = 0; block + 1 < block_start_vector.size(); ++block)
+    {
+        largest_block_size = std::max(largest_block_size,
+                                      block_start_vector[block + 1] - block_start_vector[block]);
+    }
+
+    return largest_block_size;
+}
+
+//======================================================================
+//  Member Function: LinearSystemSolver::GetNumberOfSingletonBlocks
+//
+//  Abstract:
+//
+//    This function returns the number of diagonal blocks with one
+//    element, which are not factored.
+//
+//======================================================================
+
+int LinearSystemSolver::GetNumberOfSingletonBlocks() const
+{
+    if (m_method != BLOCK_TRIANGULAR)
+    {
+        return (m_n == 1) ? 1 : 0;
+    }
+
+    const std::vector<int> & block_start_vector = m_block_form.GetBlockStart();
+    int number_of_singleton_blocks = 0;
+
+    for (size_t block = 0; block + 1 < block_start_vector.size(); ++block)
+    {
+        if (block_start_vector[block + 1] - block_start_vector[block] == 1)
+        {
+            ++number_of_singleton_blocks;
+        }
+    }
+
+    return number_of_singleton_blocks;
+}
+
+//======================================================================
+//  Member Function: LinearSystemSolver::GetBlockSize
+//
+//  Abstract:
+//
+//    This function returns the number of equations in a diagonal
+//    block of the block triangular form. If the block triangular form
+//    is not used then there is one block with every equation.
+//
+//======================================================================
+
+int LinearSystemSolver::GetBlockSize(int block) const
+{
+    if (m_method != BLOCK_TRIANGULAR)
+    {
+        return m_n;
+    }
+
+    const std::vector<int> & block_start_vector = m_block_form.GetBlockStart();
+
+    return block_start_vector[block + 1] - block_start_vector[block];
+}
+
+//======================================================================
+//  Member Function: LinearSystemSolver::GetBlockFillIn
+//
+//  Abstract:
+//
+//    This function returns the fill-in of the factors of a diagonal
+//    block, which is zero for a block with one element.
+//
+//======================================================================
+
+size_t LinearSystemSolver::GetBlockFillIn(int block) const
+{
+    if (m_method != BLOCK_TRIANGULAR)
+    {
+        return m_fill_in;
+    }
+
+    if (! m_block_solver_vector[block])
+    {
+        return 0;
+    }
+
+    return m_block_solver_vector[block]->GetFillIn();
+}
+
+//======================================================================
+//  Member Function: LinearSystemSolver::GetNumberOfOffDiagonalNonzeros
+//
+//  Abstract:
+//
+//    This function returns the number of stored elements of the A
+//    matrix that are outside of the diagonal blocks.
+//
+//======================================================================
+
+size_t LinearSystemSolver::GetNumberOfOffDiagonalNonzeros() const
+{
+    return m_off_diagonal_value_vector.size();
+}
+
+//======================================================================
+//  Member Function: LinearSystemSolver::GetMethod
+//
+//  Abstract:
+//
+//    This function returns the method chosen by the last analysis.
+//
+//======================================================================
+
+LinearSystemSolver::Method_T LinearSystemSolver::GetMethod() const
+{
+    return m_method;
+}
+
+//======================================================================
+//  Member Function: LinearSystemSolver::GetNumberOfMatrixNonzeros
+//======================================================================
+
+size_t LinearSystemSolver::GetNumberOfMatrixNonzeros() const
+{
+    return m_matrix_nonzeros;
+}
+
+//======================================================================
+//  Member Function: LinearSystemSolver::GetNumberOfLowerNonzeros
+//
+//  Abstract:
+//
+//    This function returns the number of elements of the L factor,
+//    including the unit diagonal. For dense elimination this is the
+//    size of the lower triangle.
+//
+//======================================================================
+
+size_t LinearSystemSolver::GetNumberOfLowerNonzeros() const
+{
+    return m_lower_nonzeros;
+}
+
+//======================================================================
+//  Member Function: LinearSystemSolver::GetNumberOfUpperNonzeros
+//======================================================================
+
+size_t LinearSystemSolver::GetNumberOfUpperNonzeros() const
+{
+    return m_upper_nonzeros;
+}
+
+//======================================================================
+//  Member Function: LinearSystemSolver::GetFillIn
+//
+//  Abstract:
+//
+//    This function returns the number of elements of the factors that
+//    are not stored elements of the A matrix.
+//
+//======================================================================
+
+size_t LinearSystemSolver::GetFillIn() const
+{
+    return m_fill_in;
+}
+
+//======================================================================
+//  Member Function: LinearSystemSolver::GetFlopCount
+//
+//  Abstract:
+//
+//    This function returns the number of floating point operations
+//    used to factor the A matrix.
+//
+//======================================================================
+
+double LinearSystemSolver::GetFlopCount() const
+{
+    return m_flop_count;
+}
+
+//======================================================================
+//  Member Function: LinearSystemSolver::GetStatusString
+//======================================================================
+
+const char * LinearSystemSolver::GetStatusString(Status_T status)
+{
+    const char * status_ptr = "";
+
+    switch (status)
+    {
+    case SUCCESS:
+
+        status_ptr = "Success";
+        break;
+
+    case MATRIX_SINGULAR:
+
+        status_ptr = "The equations are singular and do not have a unique solution";
+        break;
+
+    default:
+
+        status_ptr = "Unknown error";
+        break;
+    }
+
+    return status_ptr;
+}
+
+//======================================================================
+//  Member Function: LinearSystemSolver::GetMethodString
+//======================================================================
+
+const char * LinearSystemSolver::GetMethodString(Method_T method)
+{
+    const char * method_ptr = "";
+
+    switch (method)
+    {
+    case DENSE_ELIMINATION:
+
+        method_ptr = "Dense Gaussian elimination";
+        break;
+
+    case SPARSE_LU:
+
+        method_ptr = "Sparse LU factorization";
+        break;
+
+    case BLOCK_TRIANGULAR:
+
+        method_ptr = "Block triangular form";
+        break;
+
+    case FIXED_SIZE_ELIMINATION:
+
+        method_ptr = "Fixed size Gaussian elimination";
+        break;
+
+    default:
+
+        method_ptr = "Unknown method";
+        break;
+    }
+
+    return method_ptr;
+}
+
+//======================================================================
+//  Member Function: LinearSystemSolver::FactorDense
+//
+//  Abstract:
+//
+//    This function factors a dense copy of the A matrix using
+//    Gaussian elimination with partial pivoting. The dense copy is
+//    filled from the stored elements of each row. Rows are exchanged
+//    by exchanging row numbers, and rows whose multiplier is zero are
+//    skipped.
+//
+//
+//  Input:
+//
+//    a_matrix              The A matrix.
+//
+//  Output:
+//
+//    This function returns a value of type 'Status_T'.
+//
+//======================================================================
+
+LinearSystemSolver::Status_T LinearSystemSolver::FactorDense(const FrozenSparseMatrix & a_matrix)
+{
+    std::vector<double *> row_ptr_vector;
+    int n = m_n;
+
+    m_single_precision_flag = false;
+    std::vector<float>().swap(m_single_dense_vector);
+
+    m_matrix_nonzeros = CopyToDense(a_matrix,
+                                    n,
+                                    m_dense_vector,
+                                    row_ptr_vector,
+                                    m_dense_row_vector);
+
+    m_lower_nonzeros = ((size_t)(n) * (n + 1)) / 2;
+    m_upper_nonzeros = m_lower_nonzeros;
+    m_fill_in = (size_t)(n) * n - m_matrix_nonzeros;
+    m_flop_count = 0.0;
+
+    if (! EliminateDense(n, row_ptr_vector, m_dense_row_vector, m_flop_count))
+    {
+        return MATRIX_SINGULAR;
+    }
+
+    return SUCCESS;
+}
+
+//======================================================================
+//  Member Function: LinearSystemSolver::FactorDenseSingle
+//
+//  Abstract:
+//
+//    This function factors a single precision copy of the A matrix in
+//    the same way as the FactorDense method. The double precision
+//    dense matrix is released.
+//
+//
+//  Input:
+//
+//    a_matrix              The A matrix.
+//
+//  Output:
+//
+//    This function returns a value of type 'Status_T'.
+//
+//======================================================================
+
+LinearSystemSolver::Status_T LinearSystemSolver::FactorDenseSingle(const FrozenSparseMatrix & a_matrix)
+{
+    std::vector<float *> row_ptr_vector;
+    int n = m_n;
+
+    std::vector<double>().swap(m_dense_vector);
+
+    m_matrix_nonzeros = CopyToDense(a_matrix,
+                                    n,
+                                    m_single_dense_vector,
+                                    row_ptr_vector,
+                                    m_dense_row_vector);
+
+    m_lower_nonzeros = ((size_t)(n) * (n + 1)) / 2;
+    m_upper_nonzeros = m_lower_nonzeros;
+    m_fill_in = (size_t)(n) * n - m_matrix_nonzeros;
+    m_flop_count = 0.0;
+
+    m_single_precision_flag = EliminateDense(n, row_ptr_vector, m_dense_row_vector, m_flop_count);
+
+    return m_single_precision_flag ? SUCCESS : MATRIX_SINGULAR;
+}
+
+//======================================================================
+//  Member Function: LinearSystemSolver::FactorFixedSize
+//
+//  Abstract:
+//
+//    This function factors a dense copy of the A matrix with the
+//    fixed size solver for the number of equations. The statistics
+//    are those of dense elimination, except that the operations on
+//    zero multipliers are counted.
+//
+//
+//  Input:
+//
+//    a_matrix              The A matrix.
+//
+//  Output:
+//
+//    This function returns a value of type 'Status_T'.
+//
+//======================================================================
+
+LinearSystemSolver::Status_T LinearSystemSolver::FactorFixedSize(const FrozenSparseMatrix & a_matrix)
+{
+    std::vector<double *> row_ptr_vector;
+    int n = m_n;
+    bool factored_flag = false;
+
+    std::vector<float>().swap(m_single_dense_vector);
+
+    m_matrix_nonzeros = CopyToDense(a_matrix,
+                                    n,
+                                    m_dense_vector,
+                                    row_ptr_vector,
+                                    m_dense_row_vector);
+
+    m_lower_nonzeros = ((size_t)(n) * (n + 1)) / 2;
+    m_upper_nonzeros = m_lower_nonzeros;
+    m_fill_in = (size_t)(n) * n - m_matrix_nonzeros;
+    m_flop_count = 0.0;
+
+    for (int k = 0; k < n; ++k)
+    {
+        m_flop_count += (double)(n - k - 1) * (2.0 * (double)(n - k - 1) + 1.0);
+    }
+
+    switch (n)
+    {
+    case 1:
+
+        factored_flag = FactorFixedSizeArray<1>(m_dense_vector, m_dense_row_vector);
+        break;
+
+    case 2:
+
+        factored_flag = FactorFixedSizeArray<2>(m_dense_vector, m_dense_row_vector);
+        break;
+
+    case 3:
+
+        factored_flag = FactorFixedSizeArray<3>(m_dense_vector, m_dense_row_vector);
+        break;
+
+    case 4:
+
+        factored_flag = FactorFixedSizeArray<4>(m_dense_vector, m_dense_row_vector);
+        break;
+
+    case 5:
+
+        factored_flag = FactorFixedSizeArray<5>(m_dense_vector, m_dense_row_vector);
+        break;
+
+    case 6:
+
+        factored_flag = FactorFixedSizeArray<6>(m_dense_vector, m_dense_row_vector);
+        break;
+
+    case 7:
+
+        factored_flag = FactorFixedSizeArray<7>(m_dense_vector, m_dense_row_vector);
+        break;
+
+    case 8:
+
+        factored_flag = FactorFixedSizeArray<8>(m_dense_vector, m_dense_row_vector);
+        break;
+
+    default:
+
+        break;
+    }
+
+    return factored_flag ? SUCCESS : MATRIX_SINGULAR;
+}
+
+//======================================================================
+//  Member Function: LinearSystemSolver::FactorBlocks
+//
+//  Abstract:
+//
+//    This function factors each diagonal block of the block
+//    triangular form with the solver of the block, keeps the diagonal
+//    element of each block with one element, and keeps the
+//    off-diagonal elements for the solution.
+//
+//
+//  Input:
+//
+//    a_matrix              The A matrix.
+//
+//    mixed_precision_flag  If true then dense blocks are factored in
+//                          single precision.
+//
+//  Output:
+//
+//    This function returns a value of type 'Status_T'.
+//
+//======================================================================
+
+LinearSystemSolver::Status_T LinearSystemSolver::FactorBlocks(const FrozenSparseMatrix & a_matrix,
+                                                              bool mixed_precision_flag)
+{
+    const std::vector<int> & block_start_vector = m_block_form.GetBlockStart();
+    int number_of_blocks = m_block_form.GetNumberOfBlocks();
+
+    m_off_diagonal_start_vector.assign(1, 0);
+    m_off_diagonal_column_vector.clear();
+    m_off_diagonal_value_vector.clear();
+
+    m_matrix_nonzeros = 0;
+    m_lower_nonzeros = 0;
+    m_upper_nonzeros = 0;
+    m_fill_in = 0;
+    m_flop_count = 0.0;
+    m_single_precision_flag = false;
+
+    for (int block = 0; block < number_of_blocks; ++block)
+    {
+        int block_size = block_start_vector[block + 1] - block_start_vector[block];
+        FrozenSparseMatrix block_matrix;
+
+        double diagonal_value = SplitBlock(a_matrix, block, block_matrix);
+
+        if (block_size == 1)
+        {
+            if (diagonal_value == 0.0)
+            {
+                return MATRIX_SINGULAR;
+            }
+
+            m_block_diagonal_vector[block] = diagonal_value;
+            ++m_matrix_nonzeros;
+            ++m_lower_nonzeros;
+            ++m_upper_nonzeros;
+        }
+        else
+        {
+            LinearSystemSolver & block_solver = *m_block_solver_vector[block];
+            block_solver.SetMixedPrecision(mixed_precision_flag);
+
+            if (block_solver.Factor(block_matrix) != SUCCESS)
+            {
+                return MATRIX_SINGULAR;
+            }
+
+            m_matrix_nonzeros += block_solver.GetNumberOfMatrixNonzeros();
+            m_lower_nonzeros += block_solver.GetNumberOfLowerNonzeros();
+            m_upper_nonzeros += block_solver.GetNumberOfUpperNonzeros();
+            m_fill_in += block_solver.GetFillIn();
+            m_flop_count += block_solver.GetFlopCount();
+
+            if (block_solver.IsSinglePrecisionFactor())
+            {
+                m_single_precision_flag = true;
+            }
+
+            if (block_solver.WasDoublePrecisionFallback())
+            {
+                m_double_precision_fallback_flag = true;
+            }
+        }
+    }
+
+    m_matrix_nonzeros += m_off_diagonal_value_vector.size();
+
+    return SUCCESS;
+}
+
+//======================================================================
+//  Member Function: LinearSystemSolver::SplitBlock
+//
+//  Abstract:
+//
+//    This function copies the elements of the rows of one diagonal
+//    block of the block triangular form. The elements in the diagonal
+//    block are copied to the block matrix, with the rows and columns
+//    numbered from the start of the block, unless the block has one
+//    element. The elements in earlier blocks are appended to the
+//    off-diagonal elements.
+//
+//
+//  Input:
+//
+//    a_matrix              The A matrix.
+//
+//    block                 The block number.
+//
+//    block_matrix          The diagonal block.
+//
+//  Output:
+//
+//    This function returns a value of type 'double' that is the
+//    diagonal element of a block with one element.
+//
+//======================================================================
+
+double LinearSystemSolver::SplitBlock(const FrozenSparseMatrix & a_matrix,
+                                      int block,
+                                      FrozenSparseMatrix & block_matrix)
+{
+    const std::vector<int> & row_order_vector = m_block_form.GetRowOrder();
+    const std::vector<int> & block_start_vector = m_block_form.GetBlockStart();
+    int start = block_start_vector[block];
+    int block_size = block_start_vector[block + 1] - start;
+    double diagonal_value = 0.0;
+
+    std::vector<size_t> row_start_vector(1, 0);
+    std::vector<int> column_index_vector;
+    std::vector<double> value_vector;
+    std::vector< std::pair<int, double> > element_vector;
+
+    for (int position = start; position < start + block_size; ++position)
+    {
+        SparseSlice row_slice = a_matrix.GetRow(row_order_vector[position]);
+
+        element_vector.clear();
+
+        for (SparseSlice::Iterator row_iter = row_slice.begin(); row_iter != row_slice.end(); ++row_iter)
+        {
+            int column = row_iter.GetIndex();
+
+            if (column >= m_n)
+            {
+                continue;
+            }
+
+            int column_position = m_column_position_vector[column];
+
+            if (column_position < start)
+            {
+                m_off_diagonal_column_vector.push_back(column);
+                m_off_diagonal_value_vector.push_back(row_iter.GetValue());
+            }
+            else if (block_size == 1)
+            {
+                diagonal_value = row_iter.GetValue();
+            }
+            else
+            {
+                element_vector.push_back(std::make_pair(column_position - start, row_iter.GetValue()));
+            }
+        }
+
+        m_off_diagonal_start_vector.push_back(m_off_diagonal_column_vector.size());
+
+        //--------------------------------------------------------------
+        //  The columns of each row of the block matrix must be in
+        //  increasing order.
+        //--------------------------------------------------------------
+
+        std::sort(element_vector.begin(), element_vector.end());
+
+        for (size_t k = 0; k < element_vector.size(); ++k)
+        {
+            column_index_vector.push_back(element_vector[k].first);
+            value_vector.push_back(element_vector[k].second);
+        }
+
+        row_start_vector.push_back(column_index_vector.size());
+    }
+
+    if (block_size > 1)
+    {
+        CompressedSparseMatrix row_matrix;
+        row_matrix.Assign(block_size,
+                          block_size,
+                          row_start_vector,
+                          column_index_vector,
+                          value_vector);
+
+        block_matrix.Freeze(row_matrix);
+    }
+
+    return diagonal_value;
+}
+
+//======================================================================
+//  Member Function: LinearSystemSolver::SolveDense
+//
+//  Abstract:
+//
+//    This function solves the equations using the dense factors. The
+//    B vector is reduced with the multipliers, and then the solution
+//    is found by back substitution.
+//
+//
+//  Input:
+//
+//    b_vector              The B vector.
+//
+//    x_vector              The solution.
+//
+//  Output:
+//
+//    This function has no return value.
+//
+//======================================================================
+
+void LinearSystemSolver::SolveDense(const std::vector<double> & b_vector,
+                                    std::vector<double> & x_vector) const
+{
+    int n = m_n;
+    size_t row_length = (size_t)(n);
+    std::vector<double> y_vector(n);
+    int i = 0;
+    int j = 0;
+
+    //------------------------------------------------------------------
+    //  Reduce the B vector. Each element is reduced by the multipliers
+    //  in its row in column order, which is the order in which the
+    //  elimination would have reduced it.
+    //------------------------------------------------------------------
+
+    for (i = 0; i < n; ++i)
+    {
+        const double * row_ptr = &m_dense_vector[row_length * m_dense_row_vector[i]];
+        double y_value = b_vector[m_dense_row_vector[i]];
+
+        for (j = 0; j < i; ++j)
+        {
+            if (row_ptr[j] != 0.0)
+            {
+                y_value -= row_ptr[j] * y_vector[j];
+            }
+        }
+
+        y_vector[i] = y_value;
+    }
+
+    //------------------------------------------------------------------
+    //  Back substitute.
+    //------------------------------------------------------------------
+
+    x_vector.assign(n, 0.0);
+
+    for (i = n - 1; i >= 0; --i)
+    {
+        const double * row_ptr = &m_dense_vector[row_length * m_dense_row_vector[i]];
+        double sum = y_vector[i];
+
+        for (j = i + 1; j < n; ++j)
+        {
+            sum -= row_ptr[j] * x_vector[j];
+        }
+
+        x_vector[i] = sum / row_ptr[i];
+    }
+
+    return;
+}
+
+//======================================================================
+//  Member Function: LinearSystemSolver::SolveDenseBlock
+//
+//  Abstract:
+//
+//    This function solves the equations for a block of B vectors with
+//    the dense factors. The operations for each vector are the same,
+//    and in the same order, as in the SolveDense method.
+//
+//
+//  Input:
+//
+//    b_block_vector    The B vectors. Element i of vector r is at
+//                      index i * block_width + r.
+//
+//    block_width       The number of vectors in the block.
+//
+//    x_block_vector    The solutions, stored in the same way.
+//
+//  Output:
+//
+//    This function has no return value.
+//
+//======================================================================
+
+void LinearSystemSolver::SolveDenseBlock(const std::vector<double> & b_block_vector,
+                                         int block_width,
+                                         std::vector<double> & x_block_vector) const
+{
+    int n = m_n;
+    size_t row_length = (size_t)(n);
+    size_t width = (size_t)(block_width);
+    std::vector<double> y_block_vector(n * width);
+    size_t r = 0;
+    int i = 0;
+    int j = 0;
+
+    //------------------------------------------------------------------
+    //  Reduce the B vectors.
+    //------------------------------------------------------------------
+
+    for (i = 0; i < n; ++i)
+    {
+        const double * row_ptr = &m_dense_vector[row_length * m_dense_row_vector[i]];
+        const double * b_ptr = &b_block_vector[m_dense_row_vector[i] * width];
+        double * y_ptr = &y_block_vector[i * width];
+
+        for (r = 0; r < width; ++r)
+        {
+            y_ptr[r] = b_ptr[r];
+        }
+
+        for (j = 0; j < i; ++j)
+        {
+            if (row_ptr[j] != 0.0)
+            {
+                double multiplier = row_ptr[j];
+                const double * y_column_ptr = &y_block_vector[j * width];
+
+                for (r = 0; r < width; ++r)
+                {
+                    y_ptr[r] -= multiplier * y_column_ptr[r];
+                }
+            }
+        }
+    }
+
+    //------------------------------------------------------------------
+    //  Back substitute.
+    //------------------------------------------------------------------
+
+    x_block_vector.assign(n * width, 0.0);
+
+    for (i = n - 1; i >= 0; --i)
+    {
+        const double * row_ptr = &m_dense_vector[row_length * m_dense_row_vector[i]];
+        double * x_ptr = &x_block_vector[i * width];
+
+        for (r = 0; r < width; ++r)
+        {
+            x_ptr[r] = y_block_vector[i * width + r];
+        }
+
+        for (j = i + 1; j < n; ++j)
+        {
+            double element = row_ptr[j];
+            const double * x_column_ptr = &x_block_vector[j * width];
+
+            for (r = 0; r < width; ++r)
+            {
+                x_ptr[r] -= element * x_column_ptr[r];
+            }
+        }
+
+        for (r = 0; r < width; ++r)
+        {
+            x_ptr[r] = x_ptr[r] / row_ptr[i];
+        }
+    }
+
+    return;
+}
+
+//======================================================================
+//  Member Function: LinearSystemSolver::SolveFixedSize
+//
+//  Abstract:
+//
+//    This function solves the equations for several B vectors with
+//    the fixed size factors.
+//
+//
+//  Input:
+//
+//    b_ptr                     The B vectors, one after another.
+//
+//    number_of_right_hand_sides    The number of B vectors.
+//
+//    x_ptr                     The solutions, stored in the same way.
+//
+//  Output:
+//
+//    This function has no return value.
+//
+//======================================================================
+
+void LinearSystemSolver::SolveFixedSize(const double * b_ptr,
+                                        int number_of_right_hand_sides,
+                                        double * x_ptr) const
+{
+    switch (m_n)
+    {
+    case 1:
+
+        SolveFixedSizeArray<1>(m_dense_vector, m_dense_row_vector, b_ptr, number_of_right_hand_sides, x_ptr);
+        break;
+
+    case 2:
+
+        SolveFixedSizeArray<2>(m_dense_vector, m_dense_row_vector, b_ptr, number_of_right_hand_sides, x_ptr);
+        break;
+
+    case 3:
+
+        SolveFixedSizeArray<3>(m_dense_vector, m_dense_row_vector, b_ptr, number_of_right_hand_sides, x_ptr);
+        break;
+
+    case 4:
+
+        SolveFixedSizeArray<4>(m_dense_vector, m_dense_row_vector, b_ptr, number_of_right_hand_sides, x_ptr);
+        break;
+
+    case 5:
+
+        SolveFixedSizeArray<5>(m_dense_vector, m_dense_row_vector, b_ptr, number_of_right_hand_sides, x_ptr);
+        break;
+
+    case 6:
+
+        SolveFixedSizeArray<6>(m_dense_vector, m_dense_row_vector, b_ptr, number_of_right_hand_sides, x_ptr);
+        break;
+
+    case 7:
+
+        SolveFixedSizeArray<7>(m_dense_vector, m_dense_row_vector, b_ptr, number_of_right_hand_sides, x_ptr);
+        break;
+
+    case 8:
+
+        SolveFixedSizeArray<8>(m_dense_vector, m_dense_row_vector, b_ptr, number_of_right_hand_sides, x_ptr);
+        break;
+
+    default:
+
+        break;
+    }
+
+    return;
+}
+
+//======================================================================
+//  Member Function: LinearSystemSolver::SolveBlockTriangular
+//
+//  Abstract:
+//
+//    This function solves the equations with the block triangular
+//    form. For each diagonal block in order, the off-diagonal elements
+//    of the rows of the block are multiplied by the solution of the
+//    earlier blocks and subtracted from B, and the diagonal block is
+//    solved for the solution of its columns.
+//
+//
+//  Input:
+//
+//    b_vectors                 The B vectors, one after another.
+//
+//    number_of_right_hand_sides    The number of B vectors.
+//
+//    x_vectors                 The solutions, stored in the same way.
+//
+//  Output:
+//
+//    This function has no return value.
+//
+//======================================================================
+
+void LinearSystemSolver::SolveBlockTriangular(const std::vector<double> & b_vectors,
+                                              int number_of_right_hand_sides,
+                                              std::vector<double> & x_vectors) const
+{
+    const std::vector<int> & row_order_vector = m_block_form.GetRowOrder();
+    const std::vector<int> & column_order_vector = m_block_form.GetColumnOrder();
+    const std::vector<int> & block_start_vector = m_block_form.GetBlockStart();
+    int number_of_blocks = m_block_form.GetNumberOfBlocks();
+    size_t n = (size_t)(m_n);
+    std::vector<double> y_vectors;
+    std::vector<double> z_vectors;
+    int r = 0;
+
+    x_vectors.assign(n * number_of_right_hand_sides, 0.0);
+
+    for (int block = 0; block < number_of_blocks; ++block)
+    {
+        int start = block_start_vector[block];
+        size_t block_size = (size_t)(block_start_vector[block + 1] - start);
+        size_t i = 0;
+
+        y_vectors.resize(block_size * number_of_right_hand_sides);
+
+        for (r = 0; r < number_of_right_hand_sides; ++r)
+        {
+            const double * b_ptr = &b_vectors[n * r];
+            const double * x_ptr = &x_vectors[n * r];
+
+            for (i = 0; i < block_size; ++i)
+            {
+                size_t position = start + i;
+                double value = b_ptr[row_order_vector[position]];
+
+                for (size_t q = m_off_diagonal_start_vector[position];
+                     q < m_off_diagonal_start_vector[position + 1];
+                     ++q)
+                {
+                    value -= m_off_diagonal_value_vector[q] * x_ptr[m_off_diagonal_column_vector[q]];
+                }
+
+                y_vectors[block_size * r + i] = value;
+            }
+        }
+
+        if (block_size == 1)
+        {
+            for (r = 0; r < number_of_right_hand_sides; ++r)
+            {
+                x_vectors[n * r + column_order_vector[start]] = y_vectors[r] / m_block_diagonal_vector[block];
+            }
+        }
+        else
+        {
+            m_block_solver_vector[block]->Solve(y_vectors, number_of_right_hand_sides, z_vectors);
+
+            for (r = 0; r < number_of_right_hand_sides; ++r)
+            {
+                for (i = 0; i < block_size; ++i)
+                {
+                    x_vectors[n * r + column_order_vector[start + i]] = z_vectors[block_size * r + i];
+                }
+            }
+        }
+    }
+
+    return;
+}
+
+//======================================================================
+//  Member Function: LinearSystemSolver::ComputeResiduals
+//
+//  Abstract:
+//
+//    This function computes the residuals B - A x in double precision
+//    from the stored elements of the A matrix, and returns the
+//    backward error, which is described with the SolveWithRefinement
+//    method.
+//
+//
+//  Input:
+//
+//    a_matrix                  The A matrix.
+//
+//    b_vectors                 The B vectors, one after another.
+//
+//    number_of_right_hand_sides    The number of B vectors.
+//
+//    x_vectors                 The solutions, stored in the same way.
+//
+//    r_vectors                 The residuals, stored in the same way.
+//
+//  Output:
+//
+//    This function returns a value of type 'double' that is the
+//    largest backward error of the solutions.
+//
+//======================================================================
+
+double LinearSystemSolver::ComputeResiduals(const FrozenSparseMatrix & a_matrix,
+                                            const std::vector<double> & b_vectors,
+                                            int number_of_right_hand_sides,
+                                            const std::vector<double> & x_vectors,
+                                            std::vector<double> & r_vectors) const
+{
+    size_t n = (size_t)(m_n);
+    int number_of_rows = std::min(m_n, a_matrix.GetNumberOfRows());
+    double backward_error = 0.0;
+    double a_norm = 0.0;
+    int i = 0;
+
+    r_vectors.assign(b_vectors.begin(), b_vectors.begin() + n * number_of_right_hand_sides);
+
+    for (i = 0; i < number_of_rows; ++i)
+    {
+        SparseSlice row_slice = a_matrix.GetRow(i);
+        double row_sum = 0.0;
+
+        for (SparseSlice::Iterator row_iter = row_slice.begin(); row_iter != row_slice.end(); ++row_iter)
+        {
+            size_t j = (size_t)(row_iter.GetIndex());
+
+            if (j < n)
+            {
+                double value = row_iter.GetValue();
+                row_sum += fabs(value);
+
+                for (int r = 0; r < number_of_right_hand_sides; ++r)
+                {
+                    r_vectors[n * r + i] -= value * x_vectors[n * r + j];
+                }
+            }
+        }
+
+        a_norm = std::max(a_norm, row_sum);
+    }
+
+    for (int r = 0; r < number_of_right_hand_sides; ++r)
+    {
+        double b_norm = 0.0;
+        double x_norm = 0.0;
+        double r_norm = 0.0;
+
+        for (size_t k = n * r; k < n * (r + 1); ++k)
+        {
+            b_norm = std::max(b_norm, fabs(b_vectors[k]));
+            x_norm = std::max(x_norm, fabs(x_vectors[k]));
+            r_norm = std::max(r_norm, fabs(r_vectors[k]));
+        }
+
+        double denominator = a_norm * x_norm + b_norm;
+        double error = (denominator > 0.0) ? r_norm / denominator : r_norm;
+
+        //--------------------------------------------------------------
+        //  Keep an error that is not a number.
+        //--------------------------------------------------------------
+
+        if (! (error <= backward_error))
+        {
+            backward_error = error;
+        }
+    }
+
+    return backward_error;
+}
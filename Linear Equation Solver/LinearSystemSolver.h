@@ -0,0 +1,266 @@
+#ifndef LINEARSYSTEMSOLVER_H
+#define LINEARSYSTEMSOLVER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <memory>
+#include <vector>
+#include "MatrixPackage.h"
+#include "BlockTriangularForm.h"
+#include "FrozenSparseMatrix.h"
+#include "SparseLU.h"
+
+//======================================================================
+//  Class Definition
+//
+//  This class solves the simultaneous linear equations A x = B where
+//  the A matrix is a FrozenSparseMatrix. The stored elements of A are
+//  read one row at a time, so absent elements are never looked up.
+//
+//  As with MatrixPackage::SolveLinearEquations, the number of
+//  equations is passed and any element of A or B outside of the
+//  first number_of_equations rows and columns is ignored.
+//
+//  When the fraction of the elements of A that are stored is less
+//  than the sparse density threshold, the equations are solved with
+//  a sparse LU factorization. Otherwise Gaussian elimination is done
+//  on a dense copy of A. The method used, the fill-in and the number
+//  of floating point operations of the last factorization are kept.
+//
+//  The solution is done in three steps. Analyze chooses the method
+//  and, for the sparse LU factorization, computes the factor
+//  structure. Factor computes the factors and Solve uses the factors
+//  for each B vector. Analyze is passed a pattern key, which is a hash
+//  of the nonzero pattern of A and the variable order. If the solver
+//  already holds a factor structure with the same key, either from an
+//  earlier analysis or from SetFactorStructure, then the analysis is
+//  skipped and the factorization reuses the factor structure. A key
+//  of zero never matches.
+//
+//  After one factorization, Solve can be passed several B vectors at
+//  once. The B vectors are solved in blocks, where each element of the
+//  factors is used for every vector in the block.
+//
+//  In mixed precision mode the dense elimination is done on a single
+//  precision copy of A, which halves the memory traffic of the
+//  factorization and doubles the number of elements in each vector
+//  instruction. SolveWithRefinement then recovers double precision
+//  accuracy by iterative refinement, where each residual is computed
+//  in double precision from the A matrix and the correction is solved
+//  with the single precision factors. If the backward error stops
+//  decreasing before it reaches the double precision level then the
+//  A matrix is factored again in double precision.
+//
+//  Before the method is chosen, the A matrix is permuted to block
+//  lower triangular form. If there is more than one diagonal block
+//  then only the diagonal blocks are factored, each by its own solver
+//  that chooses the method for that block, and a block with one
+//  element is not factored at all. The solution is found one block at
+//  a time, where the elements of the off-diagonal blocks multiply the
+//  solution of the earlier blocks and are subtracted from B. A matrix
+//  that is nearly triangular is solved with little more work than a
+//  triangular solve and without fill outside the diagonal blocks.
+//
+//  A system of at most eight equations, including a diagonal block of
+//  that size, is factored and solved by class FixedSizeSolver for its
+//  number of equations, whose loops are unrolled for that size.
+//======================================================================
+
+class LinearSystemSolver
+{
+public:
+
+    enum Status_T
+    {
+        SUCCESS,
+        MATRIX_SINGULAR
+    };
+
+    enum Method_T
+    {
+        DENSE_ELIMINATION,
+        SPARSE_LU,
+        BLOCK_TRIANGULAR,
+        FIXED_SIZE_ELIMINATION
+    };
+
+    LinearSystemSolver();
+
+    virtual ~LinearSystemSolver();
+
+    void Analyze(unsigned int number_of_equations,
+                 const FrozenSparseMatrix & a_matrix,
+                 uint64_t pattern_key);
+
+    Status_T Factor(const FrozenSparseMatrix & a_matrix);
+
+    void Solve(const MatrixPackage::SparseVector & b_vector,
+               MatrixPackage::SparseVector & x_vector) const;
+
+    void Solve(const std::vector<double> & b_vector,
+               std::vector<double> & x_vector) const;
+
+    void Solve(const std::vector<double> & b_vectors,
+               int number_of_right_hand_sides,
+               std::vector<double> & x_vectors) const;
+
+    Status_T SolveWithRefinement(const FrozenSparseMatrix & a_matrix,
+                                 const std::vector<double> & b_vectors,
+                                 int number_of_right_hand_sides,
+                                 std::vector<double> & x_vectors);
+
+    Status_T Solve(unsigned int number_of_equations,
+                   const FrozenSparseMatrix & a_matrix,
+                   const MatrixPackage::SparseVector & b_vector,
+                   MatrixPackage::SparseVector & x_vector);
+
+    Status_T Solve(unsigned int number_of_equations,
+                   const FrozenSparseMatrix & a_matrix,
+                   const std::vector<double> & b_vector,
+                   std::vector<double> & x_vector);
+
+    void SetFactorStructure(uint64_t pattern_key,
+                            SparseLU::Structure_T & structure);
+
+    const SparseLU::Structure_T & GetFactorStructure() const;
+
+    bool WasFactorStructureReused() const;
+
+    void SetSparseDensityThreshold(double sparse_density_threshold);
+
+    double GetSparseDensityThreshold() const;
+
+    void SetMixedPrecision(bool mixed_precision_flag);
+
+    bool GetMixedPrecision() const;
+
+    bool IsSinglePrecisionFactor() const;
+
+    bool WasDoublePrecisionFallback() const;
+
+    int GetRefinementIterations() const;
+
+    double GetBackwardError() const;
+
+    void SetBlockTriangularForm(bool block_triangular_flag);
+
+    bool GetBlockTriangularForm() const;
+
+    int GetNumberOfBlocks() const;
+
+    int GetLargestBlockSize() const;
+
+    int GetNumberOfSingletonBlocks() const;
+
+    int GetBlockSize(int block) const;
+
+    size_t GetBlockFillIn(int block) const;
+
+    size_t GetNumberOfOffDiagonalNonzeros() const;
+
+    Method_T GetMethod() const;
+
+    size_t GetNumberOfMatrixNonzeros() const;
+
+    size_t GetNumberOfLowerNonzeros() const;
+
+    size_t GetNumberOfUpperNonzeros() const;
+
+    size_t GetFillIn() const;
+
+    double GetFlopCount() const;
+
+    static const char * GetStatusString(Status_T status);
+
+    static const char * GetMethodString(Method_T method);
+
+protected:
+
+    Status_T FactorDense(const FrozenSparseMatrix & a_matrix);
+
+    Status_T FactorDenseSingle(const FrozenSparseMatrix & a_matrix);
+
+    Status_T FactorFixedSize(const FrozenSparseMatrix & a_matrix);
+
+    Status_T FactorBlocks(const FrozenSparseMatrix & a_matrix,
+                          bool mixed_precision_flag);
+
+    double SplitBlock(const FrozenSparseMatrix & a_matrix,
+                      int block,
+                      FrozenSparseMatrix & block_matrix);
+
+    void SolveDense(const std::vector<double> & b_vector,
+                    std::vector<double> & x_vector) const;
+
+    void SolveDenseBlock(const std::vector<double> & b_block_vector,
+                         int block_width,
+                         std::vector<double> & x_block_vector) const;
+
+    void SolveFixedSize(const double * b_ptr,
+                        int number_of_right_hand_sides,
+                        double * x_ptr) const;
+
+    void SolveBlockTriangular(const std::vector<double> & b_vectors,
+                              int number_of_right_hand_sides,
+                              std::vector<double> & x_vectors) const;
+
+    double ComputeResiduals(const FrozenSparseMatrix & a_matrix,
+                            const std::vector<double> & b_vectors,
+                            int number_of_right_hand_sides,
+                            const std::vector<double> & x_vectors,
+                            std::vector<double> & r_vectors) const;
+
+protected:
+
+    int m_n;
+    double m_sparse_density_threshold;
+    Method_T m_method;
+    uint64_t m_pattern_key;
+    bool m_analysis_reused_flag;
+    size_t m_matrix_nonzeros;
+    size_t m_lower_nonzeros;
+    size_t m_upper_nonzeros;
+    size_t m_fill_in;
+    double m_flop_count;
+    bool m_mixed_precision_flag;
+    bool m_single_precision_flag;
+    bool m_double_precision_fallback_flag;
+    int m_refinement_iterations;
+    double m_backward_error;
+    SparseLU m_sparse_lu;
+
+    //------------------------------------------------------------------
+    //  The dense factors. Row i of the factors is stored in row
+    //  m_dense_row_vector[i] of m_dense_vector, or of
+    //  m_single_dense_vector for single precision factors. The
+    //  multipliers of L are stored below the diagonal. The fixed size
+    //  factors are stored in m_dense_vector in the order of the
+    //  factors, and row i of the factors is row m_dense_row_vector[i]
+    //  of A.
+    //------------------------------------------------------------------
+
+    std::vector<double> m_dense_vector;
+    std::vector<float> m_single_dense_vector;
+    std::vector<int> m_dense_row_vector;
+
+    //------------------------------------------------------------------
+    //  The block triangular form. Each diagonal block with more than
+    //  one element has its own solver, and the diagonal element of a
+    //  block with one element is kept. The off-diagonal elements of
+    //  the row at position k of the block triangular form are
+    //  elements m_off_diagonal_start_vector[k] up to
+    //  m_off_diagonal_start_vector[k + 1] of the off-diagonal column
+    //  and value vectors, where the columns are not permuted.
+    //------------------------------------------------------------------
+
+    bool m_block_triangular_flag;
+    BlockTriangularForm m_block_form;
+    std::vector<int> m_column_position_vector;
+    std::vector< std::unique_ptr<LinearSystemSolver> > m_block_solver_vector;
+    std::vector<double> m_block_diagonal_vector;
+    std::vector<size_t> m_off_diagonal_start_vector;
+    std::vector<int> m_off_diagonal_column_vector;
+    std::vector<double> m_off_diagonal_value_vector;
+};
+
+#endif
@@ -0,0 +1,858 @@
+#include <math.h>
+#include "LowRankUpdateSolver.h"
+
+namespace
+{
+    //------------------------------------------------------------------
+    //  The largest rank of a correction. Z has one column of n elements
+    //  for each unit of rank.
+    //------------------------------------------------------------------
+
+    const int f_MAXIMUM_RANK = 64;
+
+    //------------------------------------------------------------------
+    //  A pivot of the capacitance matrix whose magnitude is less than
+    //  this fraction of the largest magnitude of its elements makes the
+    //  correction inaccurate.
+    //------------------------------------------------------------------
+
+    const double f_CAPACITANCE_PIVOT_TOLERANCE = 1.0E-8;
+
+    //------------------------------------------------------------------
+    //  The largest backward error of a corrected solution.
+    //------------------------------------------------------------------
+
+    const double f_MAXIMUM_BACKWARD_ERROR = 1.0E-12;
+}
+
+//======================================================================
+//  Constructor: LowRankUpdateSolver::LowRankUpdateSolver
+//======================================================================
+
+LowRankUpdateSolver::LowRankUpdateSolver()
+  : m_n(0),
+    m_factored_flag(false),
+    m_update_ready_flag(false),
+    m_rank(0),
+    m_break_even_rank(0),
+    m_number_of_refactorizations(0),
+    m_backward_error(0.0)
+{
+}
+
+//======================================================================
+//  Destructor: LowRankUpdateSolver::~LowRankUpdateSolver
+//======================================================================
+
+LowRankUpdateSolver::~LowRankUpdateSolver()
+{
+}
+
+//======================================================================
+//  Member Function: LowRankUpdateSolver::Factor
+//
+//  Abstract:
+//
+//    This function keeps a copy of the A matrix and factors it. Any
+//    changes made before are discarded.
+//
+//
+//  Input:
+//
+//    number_of_equations   The number of equations.
+//
+//    a_matrix              The A matrix.
+//
+//  Output:
+//
+//    This function returns a value of type
+//    'LinearSystemSolver::Status_T'.
+//
+//======================================================================
+
+LinearSystemSolver::Status_T LowRankUpdateSolver::Factor(unsigned int number_of_equations,
+                                                         const FrozenSparseMatrix & a_matrix)
+{
+    m_n = number_of_equations;
+    m_a_matrix = a_matrix;
+    m_change_map.clear();
+    m_number_of_refactorizations = 0;
+
+    return Refactor();
+}
+
+//======================================================================
+//  Member Function: LowRankUpdateSolver::ChangeCoefficient
+//
+//  Abstract:
+//
+//    This function sets a new value of one coefficient of A. The
+//    change is used by the next call to Solve.
+//
+//
+//  Input:
+//
+//    row                   The row of the coefficient.
+//
+//    column                The column of the coefficient.
+//
+//    value                 The new value.
+//
+//  Output:
+//
+//    This function returns false if the row or the column is not less
+//    than the number of equations.
+//
+//======================================================================
+
+bool LowRankUpdateSolver::ChangeCoefficient(int row,
+                                            int column,
+                                            double value)
+{
+    if ((row < 0) || (column < 0) || (row >= (int)(m_n)) || (column >= (int)(m_n)))
+    {
+        return false;
+    }
+
+    m_change_map[Position_T(row, column)] = value;
+    m_update_ready_flag = false;
+
+    return true;
+}
+
+//======================================================================
+//  Member Function: LowRankUpdateSolver::Solve
+//
+//  Abstract:
+//
+//    This function solves A' x = B for one B vector.
+//
+//
+//  Input:
+//
+//    b_vector              The B vector.
+//
+//    x_vector              The solution.
+//
+//  Output:
+//
+//    This function returns a value of type
+//    'LinearSystemSolver::Status_T'.
+//
+//======================================================================
+
+LinearSystemSolver::Status_T LowRankUpdateSolver::Solve(const std::vector<double> & b_vector,
+                                                        std::vector<double> & x_vector)
+{
+    return Solve(b_vector, 1, x_vector);
+}
+
+//======================================================================
+//  Member Function: LowRankUpdateSolver::Solve
+//
+//  Abstract:
+//
+//    This function solves A' x = B, where A' is A with the changed
+//    coefficients, for several B vectors.
+//
+//
+//  Input:
+//
+//    b_vectors                    The B vectors, stored one after
+//                                 another.
+//
+//    number_of_right_hand_sides   The number of B vectors.
+//
+//    x_vectors                    The solutions, stored in the same
+//                                 way as the B vectors.
+//
+//  Output:
+//
+//    This function returns a value of type
+//    'LinearSystemSolver::Status_T'.
+//
+//======================================================================
+
+LinearSystemSolver::Status_T LowRankUpdateSolver::Solve(const std::vector<double> & b_vectors,
+                                                        int number_of_right_hand_sides,
+                                                        std::vector<double> & x_vectors)
+{
+    LinearSystemSolver::Status_T status = LinearSystemSolver::SUCCESS;
+
+    if (! m_update_ready_flag)
+    {
+        status = PrepareUpdate();
+
+        if (status != LinearSystemSolver::SUCCESS)
+        {
+            return status;
+        }
+    }
+
+    m_solver.Solve(b_vectors, number_of_right_hand_sides, x_vectors);
+    m_backward_error = 0.0;
+
+    if (m_rank == 0)
+    {
+        return status;
+    }
+
+    //------------------------------------------------------------------
+    //  Correct the solution of each B vector. x_vectors holds y.
+    //------------------------------------------------------------------
+
+    std::vector<double> s_vector(m_rank);
+    int n = (int)(m_n);
+    int p = 0;
+
+    for (int r = 0; r < number_of_right_hand_sides; ++r)
+    {
+        double * x_ptr = &x_vectors[(size_t)(n) * r];
+
+        for (p = 0; p < m_rank; ++p)
+        {
+            const SparseColumn_T & v_column = m_v_column_vector[p];
+            double sum = 0.0;
+
+            for (size_t e = 0; e < v_column.size(); ++e)
+            {
+                sum += v_column[e].second * x_ptr[v_column[e].first];
+            }
+
+            s_vector[p] = sum;
+        }
+
+        SolveCapacitance(s_vector);
+
+        for (p = 0; p < m_rank; ++p)
+        {
+            const double * z_ptr = &m_z_vectors[(size_t)(n) * p];
+            double t = s_vector[p];
+
+            for (int i = 0; i < n; ++i)
+            {
+                x_ptr[i] -= z_ptr[i] * t;
+            }
+        }
+    }
+
+    //------------------------------------------------------------------
+    //  If the corrected solutions are not accurate then factor A' and
+    //  solve again.
+    //------------------------------------------------------------------
+
+    m_backward_error = ComputeBackwardError(b_vectors, number_of_right_hand_sides, x_vectors);
+
+    if (m_backward_error > f_MAXIMUM_BACKWARD_ERROR)
+    {
+        status = Refactor();
+
+        if (status == LinearSystemSolver::SUCCESS)
+        {
+            m_solver.Solve(b_vectors, number_of_right_hand_sides, x_vectors);
+            m_backward_error = 0.0;
+        }
+    }
+
+    return status;
+}
+
+//======================================================================
+//  Member Function: LowRankUpdateSolver::SetSparseDensityThreshold
+//======================================================================
+
+void LowRankUpdateSolver::SetSparseDensityThreshold(double sparse_density_threshold)
+{
+    m_solver.SetSparseDensityThreshold(sparse_density_threshold);
+    return;
+}
+
+//======================================================================
+//  Member Function: LowRankUpdateSolver::GetRank
+//
+//  Abstract:
+//
+//    This function returns the rank of the correction used by the last
+//    call to Solve, which is zero if A was factored again.
+//
+//======================================================================
+
+int LowRankUpdateSolver::GetRank() const
+{
+    return m_rank;
+}
+
+//======================================================================
+//  Member Function: LowRankUpdateSolver::GetBreakEvenRank
+//======================================================================
+
+int LowRankUpdateSolver::GetBreakEvenRank() const
+{
+    return m_break_even_rank;
+}
+
+//======================================================================
+//  Member Function: LowRankUpdateSolver::GetNumberOfRefactorizations
+//
+//  Abstract:
+//
+//    This function returns the number of times A was factored again
+//    since the call to Factor.
+//
+//======================================================================
+
+int LowRankUpdateSolver::GetNumberOfRefactorizations() const
+{
+    return m_number_of_refactorizations;
+}
+
+//======================================================================
+//  Member Function: LowRankUpdateSolver::GetBackwardError
+//
+//  Abstract:
+//
+//    This function returns the largest backward error of the corrected
+//    solutions of the last call to Solve, or zero if no correction was
+//    used.
+//
+//======================================================================
+
+double LowRankUpdateSolver::GetBackwardError() const
+{
+    return m_backward_error;
+}
+
+//======================================================================
+//  Member Function: LowRankUpdateSolver::GetSolver
+//
+//  Abstract:
+//
+//    This function returns the solver that holds the factors of A, for
+//    its statistics.
+//
+//======================================================================
+
+const LinearSystemSolver & LowRankUpdateSolver::GetSolver() const
+{
+    return m_solver;
+}
+
+//======================================================================
+//  Member Function: LowRankUpdateSolver::Refactor
+//
+//  Abstract:
+//
+//    This function makes the changes to the copy of A, factors it, and
+//    sets the break-even rank from the cost of the factorization and
+//    of one solve.
+//
+//
+//  Output:
+//
+//    This function returns a value of type
+//    'LinearSystemSolver::Status_T'.
+//
+//======================================================================
+
+LinearSystemSolver::Status_T LowRankUpdateSolver::Refactor()
+{
+    //------------------------------------------------------------------
+    //  Merge the changes into the rows of the copy of A. Both are in
+    //  increasing order of row and column.
+    //------------------------------------------------------------------
+
+    if (! m_change_map.empty())
+    {
+        const CompressedSparseMatrix & row_matrix = m_a_matrix.GetRowMatrix();
+        const size_t * row_start_array = row_matrix.GetRowStartArray();
+        const int * column_index_array = row_matrix.GetColumnIndexArray();
+        const double * value_array = row_matrix.GetValueArray();
+        int number_of_rows = row_matrix.GetNumberOfRows();
+        std::vector<size_t> row_start_vector(1, 0);
+        std::vector<int> column_index_vector;
+        std::vector<double> value_vector;
+        std::map<Position_T, double>::const_iterator change_iter = m_change_map.begin();
+
+        column_index_vector.reserve(row_matrix.GetNumberOfNonzeros() + m_change_map.size());
+        value_vector.reserve(row_matrix.GetNumberOfNonzeros() + m_change_map.size());
+
+        for (int row = 0; row < number_of_rows; ++row)
+        {
+            size_t position = row_start_array[row];
+            size_t row_end = row_start_array[row + 1];
+
+            while ((position < row_end)
+                   || ((change_iter != m_change_map.end()) && (change_iter->first.first == row)))
+            {
+                bool change_flag = (change_iter != m_change_map.end()) && (change_iter->first.first == row);
+                int column = 0;
+                double value = 0.0;
+
+                if (change_flag && ((position == row_end) || (change_iter->first.second <= column_index_array[position])))
+                {
+                    column = change_iter->first.second;
+                    value = change_iter->second;
+
+                    if ((position < row_end) && (column_index_array[position] == column))
+                    {
+                        ++position;
+                    }
+
+                    ++change_iter;
+                }
+                else
+                {
+                    column = column_index_array[position];
+                    value = value_array[position];
+                    ++position;
+                }
+
+                if (value != 0.0)
+                {
+                    column_index_vector.push_back(column);
+                    value_vector.push_back(value);
+                }
+            }
+
+            row_start_vector.push_back(column_index_vector.size());
+        }
+
+        CompressedSparseMatrix a_csr_matrix;
+        a_csr_matrix.Assign(number_of_rows,
+                            row_matrix.GetNumberOfColumns(),
+                            row_start_vector,
+                            column_index_vector,
+                            value_vector);
+        m_a_matrix.Freeze(a_csr_matrix);
+        m_change_map.clear();
+        ++m_number_of_refactorizations;
+    }
+
+    //------------------------------------------------------------------
+    //  Factor A.
+    //------------------------------------------------------------------
+
+    m_rank = 0;
+    m_v_column_vector.clear();
+    std::vector<double>().swap(m_z_vectors);
+
+    m_solver.Analyze(m_n, m_a_matrix, 0);
+    LinearSystemSolver::Status_T status = m_solver.Factor(m_a_matrix);
+
+    m_factored_flag = status == LinearSystemSolver::SUCCESS;
+    m_update_ready_flag = m_factored_flag;
+
+    //------------------------------------------------------------------
+    //  A correction of rank k costs k solves, and about 2 n k
+    //  operations for each column of Z, more than a solve with A'.
+    //------------------------------------------------------------------
+
+    double solve_flop_count = 2.0 * (double)(m_solver.GetNumberOfLowerNonzeros() + m_solver.GetNumberOfUpperNonzeros())
+        + 2.0 * (double)(m_n);
+    double break_even_rank = (solve_flop_count > 0.0) ? m_solver.GetFlopCount() / solve_flop_count : 0.0;
+
+    m_break_even_rank = (break_even_rank < (double)(f_MAXIMUM_RANK)) ? (int)(break_even_rank) : f_MAXIMUM_RANK;
+
+    return status;
+}
+
+//======================================================================
+//  Member Function: LowRankUpdateSolver::PrepareUpdate
+//
+//  Abstract:
+//
+//    This function computes Z and the factors of the capacitance
+//    matrix for the changes, or factors A' if that is cheaper or the
+//    correction would not be accurate.
+//
+//
+//  Output:
+//
+//    This function returns a value of type
+//    'LinearSystemSolver::Status_T'.
+//
+//======================================================================
+
+LinearSystemSolver::Status_T LowRankUpdateSolver::PrepareUpdate()
+{
+    if (! m_factored_flag)
+    {
+        return Refactor();
+    }
+
+    std::vector<double> u_vectors;
+
+    MakeUpdateVectors(u_vectors);
+
+    if (m_rank > m_break_even_rank)
+    {
+        return Refactor();
+    }
+
+    if (m_rank > 0)
+    {
+        m_solver.Solve(u_vectors, m_rank, m_z_vectors);
+
+        if (! FactorCapacitance())
+        {
+            return Refactor();
+        }
+    }
+
+    m_update_ready_flag = true;
+
+    return LinearSystemSolver::SUCCESS;
+}
+
+//======================================================================
+//  Member Function: LowRankUpdateSolver::MakeUpdateVectors
+//
+//  Abstract:
+//
+//    This function writes the changes as A' = A + U V'. If fewer rows
+//    than columns changed then each changed row i has a column e_i of
+//    U and a column of V that holds the changes of the row. Otherwise
+//    each changed column j has a column of U that holds the changes of
+//    the column and a column e_j of V. The row norms of A' are also
+//    computed.
+//
+//
+//  Input:
+//
+//    u_vectors             The columns of U, stored one after another.
+//
+//======================================================================
+
+void LowRankUpdateSolver::MakeUpdateVectors(std::vector<double> & u_vectors)
+{
+    std::map<int, int> row_map;
+    std::map<int, int> column_map;
+    std::map<Position_T, double>::const_iterator change_iter;
+    int n = (int)(m_n);
+
+    //------------------------------------------------------------------
+    //  Compute the row norms of A, and find the changed rows and
+    //  columns, skipping changes back to the value in A.
+    //------------------------------------------------------------------
+
+    m_row_norm_vector.assign(n, 0.0);
+
+    for (int row = 0; row < n; ++row)
+    {
+        SparseSlice row_slice = m_a_matrix.GetRow(row);
+
+        for (SparseSlice::Iterator iter = row_slice.begin(); iter != row_slice.end(); ++iter)
+        {
+            if (iter.GetIndex() < n)
+            {
+                m_row_norm_vector[row] += fabs(iter.GetValue());
+            }
+        }
+    }
+
+    for (change_iter = m_change_map.begin(); change_iter != m_change_map.end(); ++change_iter)
+    {
+        int row = change_iter->first.first;
+        int column = change_iter->first.second;
+        double a_value = m_a_matrix.GetValue(row, column);
+
+        if (change_iter->second != a_value)
+        {
+            m_row_norm_vector[row] += fabs(change_iter->second) - fabs(a_value);
+            row_map.insert(std::make_pair(row, (int)(row_map.size())));
+            column_map.insert(std::make_pair(column, (int)(column_map.size())));
+        }
+    }
+
+    bool row_update_flag = row_map.size() <= column_map.size();
+    std::map<int, int> & index_map = row_update_flag ? row_map : column_map;
+
+    m_rank = (int)(index_map.size());
+    m_v_column_vector.assign(m_rank, SparseColumn_T());
+
+    if ((m_rank == 0) || (m_rank > m_break_even_rank))
+    {
+        return;
+    }
+
+    //------------------------------------------------------------------
+    //  Number the changed rows or columns in increasing order and make
+    //  the columns of U and V.
+    //------------------------------------------------------------------
+
+    int p = 0;
+
+    for (std::map<int, int>::iterator iter = index_map.begin(); iter != index_map.end(); ++iter)
+    {
+        iter->second = p++;
+    }
+
+    u_vectors.assign((size_t)(n) * m_rank, 0.0);
+
+    for (std::map<int, int>::const_iterator iter = index_map.begin(); iter != index_map.end(); ++iter)
+    {
+        if (row_update_flag)
+        {
+            u_vectors[(size_t)(n) * iter->second + iter->first] = 1.0;
+        }
+        else
+        {
+            m_v_column_vector[iter->second].push_back(std::make_pair(iter->first, 1.0));
+        }
+    }
+
+    for (change_iter = m_change_map.begin(); change_iter != m_change_map.end(); ++change_iter)
+    {
+        int row = change_iter->first.first;
+        int column = change_iter->first.second;
+        double delta = change_iter->second - m_a_matrix.GetValue(row, column);
+
+        if (delta != 0.0)
+        {
+            if (row_update_flag)
+            {
+                m_v_column_vector[row_map[row]].push_back(std::make_pair(column, delta));
+            }
+            else
+            {
+                u_vectors[(size_t)(n) * column_map[column] + row] = delta;
+            }
+        }
+    }
+
+    return;
+}
+
+//======================================================================
+//  Member Function: LowRankUpdateSolver::FactorCapacitance
+//
+//  Abstract:
+//
+//    This function forms the capacitance matrix I + V' Z and factors it
+//    with Gaussian elimination with partial pivoting.
+//
+//
+//  Output:
+//
+//    This function returns false if a pivot is small compared with the
+//    largest element of the capacitance matrix.
+//
+//======================================================================
+
+bool LowRankUpdateSolver::FactorCapacitance()
+{
+    int k = m_rank;
+    int n = (int)(m_n);
+    double largest_magnitude = 0.0;
+    int i = 0;
+    int j = 0;
+
+    m_capacitance_vector.assign((size_t)(k) * k, 0.0);
+    m_capacitance_row_vector.resize(k);
+
+    for (i = 0; i < k; ++i)
+    {
+        const SparseColumn_T & v_column = m_v_column_vector[i];
+
+        for (j = 0; j < k; ++j)
+        {
+            const double * z_ptr = &m_z_vectors[(size_t)(n) * j];
+            double sum = (i == j) ? 1.0 : 0.0;
+
+            for (size_t e = 0; e < v_column.size(); ++e)
+            {
+                sum += v_column[e].second * z_ptr[v_column[e].first];
+            }
+
+            m_capacitance_vector[i * k + j] = sum;
+
+            if (fabs(sum) > largest_magnitude)
+            {
+                largest_magnitude = fabs(sum);
+            }
+        }
+
+        m_capacitance_row_vector[i] = i;
+    }
+
+    double minimum_pivot = f_CAPACITANCE_PIVOT_TOLERANCE * largest_magnitude;
+    double * c_ptr = &m_capacitance_vector[0];
+
+    for (int p = 0; p < k; ++p)
+    {
+        int pivot_row = p;
+
+        for (i = p + 1; i < k; ++i)
+        {
+            if (fabs(c_ptr[i * k + p]) > fabs(c_ptr[pivot_row * k + p]))
+            {
+                pivot_row = i;
+            }
+        }
+
+        if (! (fabs(c_ptr[pivot_row * k + p]) > minimum_pivot))
+        {
+            return false;
+        }
+
+        if (pivot_row != p)
+        {
+            for (j = 0; j < k; ++j)
+            {
+                double element = c_ptr[p * k + j];
+                c_ptr[p * k + j] = c_ptr[pivot_row * k + j];
+                c_ptr[pivot_row * k + j] = element;
+            }
+
+            int row = m_capacitance_row_vector[p];
+            m_capacitance_row_vector[p] = m_capacitance_row_vector[pivot_row];
+            m_capacitance_row_vector[pivot_row] = row;
+        }
+
+        for (i = p + 1; i < k; ++i)
+        {
+            double multiplier = c_ptr[i * k + p] / c_ptr[p * k + p];
+
+            for (j = p + 1; j < k; ++j)
+            {
+                c_ptr[i * k + j] -= multiplier * c_ptr[p * k + j];
+            }
+
+            c_ptr[i * k + p] = multiplier;
+        }
+    }
+
+    return true;
+}
+
+//======================================================================
+//  Member Function: LowRankUpdateSolver::SolveCapacitance
+//
+//  Abstract:
+//
+//    This function solves with the factors of the capacitance matrix.
+//    The solution replaces s_vector.
+//
+//======================================================================
+
+void LowRankUpdateSolver::SolveCapacitance(std::vector<double> & s_vector) const
+{
+    int k = m_rank;
+    std::vector<double> y_vector(k);
+    const double * c_ptr = &m_capacitance_vector[0];
+    int i = 0;
+    int j = 0;
+
+    for (i = 0; i < k; ++i)
+    {
+        double y_value = s_vector[m_capacitance_row_vector[i]];
+
+        for (j = 0; j < i; ++j)
+        {
+            y_value -= c_ptr[i * k + j] * y_vector[j];
+        }
+
+        y_vector[i] = y_value;
+    }
+
+    for (i = k - 1; i >= 0; --i)
+    {
+        double sum = y_vector[i];
+
+        for (j = i + 1; j < k; ++j)
+        {
+            sum -= c_ptr[i * k + j] * s_vector[j];
+        }
+
+        s_vector[i] = sum / c_ptr[i * k + i];
+    }
+
+    return;
+}
+
+//======================================================================
+//  Member Function: LowRankUpdateSolver::ComputeBackwardError
+//
+//  Abstract:
+//
+//    This function computes the largest backward error of the
+//    solutions of A' x = B, which is
+//
+//      max |B - A' x| / (||A'|| ||x|| + ||B||)
+//
+//    using the infinity norm. A' x is computed as A x plus the changes
+//    times x.
+//
+//======================================================================
+
+double LowRankUpdateSolver::ComputeBackwardError(const std::vector<double> & b_vectors,
+                                                 int number_of_right_hand_sides,
+                                                 const std::vector<double> & x_vectors) const
+{
+    int n = (int)(m_n);
+    double a_norm = 0.0;
+    double backward_error = 0.0;
+    std::vector<double> residual_vector(n);
+
+    for (int i = 0; i < n; ++i)
+    {
+        if (m_row_norm_vector[i] > a_norm)
+        {
+            a_norm = m_row_norm_vector[i];
+        }
+    }
+
+    for (int r = 0; r < number_of_right_hand_sides; ++r)
+    {
+        const double * b_ptr = &b_vectors[(size_t)(n) * r];
+        const double * x_ptr = &x_vectors[(size_t)(n) * r];
+        double x_norm = 0.0;
+        double b_norm = 0.0;
+        double residual_norm = 0.0;
+        int row = 0;
+
+        for (row = 0; row < n; ++row)
+        {
+            SparseSlice row_slice = m_a_matrix.GetRow(row);
+            double sum = b_ptr[row];
+
+            for (SparseSlice::Iterator iter = row_slice.begin(); iter != row_slice.end(); ++iter)
+            {
+                if (iter.GetIndex() < n)
+                {
+                    sum -= iter.GetValue() * x_ptr[iter.GetIndex()];
+                }
+            }
+
+            residual_vector[row] = sum;
+        }
+
+        for (std::map<Position_T, double>::const_iterator change_iter = m_change_map.begin();
+             change_iter != m_change_map.end();
+             ++change_iter)
+        {
+            int change_row = change_iter->first.first;
+            int column = change_iter->first.second;
+            double delta = change_iter->second - m_a_matrix.GetValue(change_row, column);
+
+            residual_vector[change_row] -= delta * x_ptr[column];
+        }
+
+        for (row = 0; row < n; ++row)
+        {
+            x_norm = (fabs(x_ptr[row]) > x_norm) ? fabs(x_ptr[row]) : x_norm;
+            b_norm = (fabs(b_ptr[row]) > b_norm) ? fabs(b_ptr[row]) : b_norm;
+            residual_norm = (fabs(residual_vector[row]) > residual_norm) ? fabs(residual_vector[row]) : residual_norm;
+        }
+
+        double denominator = a_norm * x_norm + b_norm;
+        double error = (denominator > 0.0) ? residual_norm / denominator : residual_norm;
+
+        if (! (error <= backward_error))
+        {
+            backward_error = error;
+        }
+    }
+
+    return backward_error;
+}
@@ -0,0 +1,137 @@
+#ifndef LOWRANKUPDATESOLVER_H
+#define LOWRANKUPDATESOLVER_H
+
+#include <stddef.h>
+#include <map>
+#include <utility>
+#include <vector>
+#include "FrozenSparseMatrix.h"
+#include "LinearSystemSolver.h"
+
+//======================================================================
+//  Class Definition
+//
+//  This class solves the simultaneous linear equations A x = B after
+//  a few coefficients of A have changed, without factoring A again.
+//
+//  Factor factors A and keeps a copy of it. ChangeCoefficient then
+//  sets new values of single coefficients. The changes are a low rank
+//  correction A' = A + U V', where each column of U and of V belongs
+//  to one changed row or one changed column of A, whichever there are
+//  fewer of, so the rank k is the smaller of the two counts. Solve
+//  uses the Sherman-Morrison-Woodbury formula
+//
+//      x = y - Z (I + V' Z)^-1 V' y
+//
+//  where y = A^-1 B and Z = A^-1 U. Z and the factors of the k by k
+//  capacitance matrix I + V' Z are computed once after the changes,
+//  with k solves with the factors of A, and each B vector then costs
+//  one solve and about 2 n k more operations.
+//
+//  A is factored again, with every change made to the copy of A,
+//  when any of these is true.
+//
+//    - The rank is above the break-even rank, which is the rank where
+//      the k solves for Z cost as much as a factorization of A, or
+//      above f_MAXIMUM_RANK.
+//
+//    - A pivot of the capacitance matrix is small compared with its
+//      largest element, so the correction is not accurate.
+//
+//    - The backward error of a corrected solution for A' is too
+//      large.
+//
+//  After that the changes are part of the factored matrix and the
+//  rank is zero again.
+//======================================================================
+
+class LowRankUpdateSolver
+{
+public:
+
+    LowRankUpdateSolver();
+
+    virtual ~LowRankUpdateSolver();
+
+    LinearSystemSolver::Status_T Factor(unsigned int number_of_equations,
+                                        const FrozenSparseMatrix & a_matrix);
+
+    bool ChangeCoefficient(int row,
+                           int column,
+                           double value);
+
+    LinearSystemSolver::Status_T Solve(const std::vector<double> & b_vector,
+                                       std::vector<double> & x_vector);
+
+    LinearSystemSolver::Status_T Solve(const std::vector<double> & b_vectors,
+                                       int number_of_right_hand_sides,
+                                       std::vector<double> & x_vectors);
+
+    void SetSparseDensityThreshold(double sparse_density_threshold);
+
+    int GetRank() const;
+
+    int GetBreakEvenRank() const;
+
+    int GetNumberOfRefactorizations() const;
+
+    double GetBackwardError() const;
+
+    const LinearSystemSolver & GetSolver() const;
+
+protected:
+
+    LinearSystemSolver::Status_T Refactor();
+
+    LinearSystemSolver::Status_T PrepareUpdate();
+
+    void MakeUpdateVectors(std::vector<double> & u_vectors);
+
+    bool FactorCapacitance();
+
+    void SolveCapacitance(std::vector<double> & s_vector) const;
+
+    double ComputeBackwardError(const std::vector<double> & b_vectors,
+                                int number_of_right_hand_sides,
+                                const std::vector<double> & x_vectors) const;
+
+protected:
+
+    typedef std::pair<int, int> Position_T;
+    typedef std::vector<std::pair<int, double> > SparseColumn_T;
+
+    unsigned int m_n;
+    FrozenSparseMatrix m_a_matrix;
+    LinearSystemSolver m_solver;
+    bool m_factored_flag;
+    bool m_update_ready_flag;
+    int m_rank;
+    int m_break_even_rank;
+    int m_number_of_refactorizations;
+    double m_backward_error;
+
+    //------------------------------------------------------------------
+    //  The new values of the changed coefficients.
+    //------------------------------------------------------------------
+
+    std::map<Position_T, double> m_change_map;
+
+    //------------------------------------------------------------------
+    //  The columns of V, Z = A^-1 U stored one column after another,
+    //  and the LU factors of the capacitance matrix, stored by rows
+    //  with the pivot rows in m_capacitance_row_vector.
+    //------------------------------------------------------------------
+
+    std::vector<SparseColumn_T> m_v_column_vector;
+    std::vector<double> m_z_vectors;
+    std::vector<double> m_capacitance_vector;
+    std::vector<int> m_capacitance_row_vector;
+
+    //------------------------------------------------------------------
+    //  The sum of the magnitudes of the elements of each row of A'.
+    //------------------------------------------------------------------
+
+    std::vector<double> m_row_norm_vector;
+};
+
+#endif
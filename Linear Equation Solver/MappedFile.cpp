@@ -0,0 +1,253 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+//======================================================================
+//  Constructor: MappedFile::MappedFile
+//======================================================================
+
+MappedFile::MappedFile()
+  : m_data_ptr(0),
+    m_size(0),
+    m_is_open_flag(false)
+#ifdef _WIN32
+    , m_file_handle(INVALID_HANDLE_VALUE),
+    m_mapping_handle(0)
+#else
+    , m_file_descriptor(-1)
+#endif
+{
+}
+
+//======================================================================
+//  Destructor: MappedFile::~MappedFile
+//======================================================================
+
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+//======================================================================
+//  Member Function: MappedFile::Open
+//
+//  Abstract:
+//
+//    This function opens a file and maps the whole file read-only
+//    into memory. Any file that is already open is closed first.
+//
+//
+//  Input:
+//
+//    file_name_ptr     A pointer to the name of the file to map.
+//
+//
+//  Output:
+//
+//    This function returns a value of type 'bool' that is the value
+//    true if and only if the file was opened and mapped.
+//
+//======================================================================
+
+bool MappedFile::Open(const char * file_name_ptr)
+{
+    Close();
+
+#ifdef _WIN32
+    HANDLE file_handle = CreateFileA(file_name_ptr,
+                                     GENERIC_READ,
+                                     FILE_SHARE_READ,
+                                     0,
+                                     OPEN_EXISTING,
+                                     FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+                                     0);
+
+    if (file_handle == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    LARGE_INTEGER file_size;
+
+    if ((! GetFileSizeEx(file_handle, &file_size))
+        || ((unsigned long long)(file_size.QuadPart) > (size_t)(-1)))
+    {
+        CloseHandle(file_handle);
+        return false;
+    }
+
+    m_file_handle = file_handle;
+    m_size = (size_t)(file_size.QuadPart);
+
+    //------------------------------------------------------------------
+    //  A zero length file cannot be mapped.
+    //------------------------------------------------------------------
+
+    if (m_size != 0)
+    {
+        HANDLE mapping_handle = CreateFileMappingA(file_handle, 0, PAGE_READONLY, 0, 0, 0);
+
+        if (mapping_handle == 0)
+        {
+            Close();
+            return false;
+        }
+
+        m_mapping_handle = mapping_handle;
+
+        void * view_ptr = MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0);
+
+        if (view_ptr == 0)
+        {
+            Close();
+            return false;
+        }
+
+        m_data_ptr = (const char *)(view_ptr);
+    }
+#else
+    int file_descriptor = open(file_name_ptr, O_RDONLY);
+
+    if (file_descriptor < 0)
+    {
+        return false;
+    }
+
+    struct stat file_status;
+
+    if (fstat(file_descriptor, &file_status) != 0)
+    {
+        close(file_descriptor);
+        return false;
+    }
+
+    m_file_descriptor = file_descriptor;
+    m_size = (size_t)(file_status.st_size);
+
+    //------------------------------------------------------------------
+    //  A zero length file cannot be mapped.
+    //------------------------------------------------------------------
+
+    if (m_size != 0)
+    {
+        void * view_ptr = mmap(0, m_size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+
+        if (view_ptr == MAP_FAILED)
+        {
+            Close();
+            return false;
+        }
+
+        //--------------------------------------------------------------
+        //  The file is read front to back exactly once.
+        //--------------------------------------------------------------
+
+        madvise(view_ptr, m_size, MADV_SEQUENTIAL);
+
+        m_data_ptr = (const char *)(view_ptr);
+    }
+#endif
+
+    m_is_open_flag = true;
+
+    return true;
+}
+
+//======================================================================
+//  Member Function: MappedFile::Close
+//
+//  Abstract:
+//
+//    This function unmaps and closes the file. It is safe to call
+//    this function if no file is open.
+//
+//
+//  Input:
+//
+//    None.
+//
+//  Output:
+//
+//    This function has no return value.
+//
+//======================================================================
+
+void MappedFile::Close()
+{
+#ifdef _WIN32
+    if (m_data_ptr != 0)
+    {
+        UnmapViewOfFile(m_data_ptr);
+    }
+
+    if (m_mapping_handle != 0)
+    {
+        CloseHandle(m_mapping_handle);
+        m_mapping_handle = 0;
+    }
+
+    if (m_file_handle != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(m_file_handle);
+        m_file_handle = INVALID_HANDLE_VALUE;
+    }
+#else
+    if (m_data_ptr != 0)
+    {
+        munmap((void *)(m_data_ptr), m_size);
+    }
+
+    if (m_file_descriptor >= 0)
+    {
+        close(m_file_descriptor);
+        m_file_descriptor = -1;
+    }
+#endif
+
+    m_data_ptr = 0;
+    m_size = 0;
+    m_is_open_flag = false;
+
+    return;
+}
+
+//======================================================================
+//  Member Function: MappedFile::IsOpen
+//======================================================================
+
+bool MappedFile::IsOpen() const
+{
+    return m_is_open_flag;
+}
+
+//======================================================================
+//  Member Function: MappedFile::GetData
+//
+//  Abstract:
+//
+//    This function returns a pointer to the first character of the
+//    mapped file. The characters are not null terminated.
+//
+//======================================================================
+
+const char * MappedFile::GetData() const
+{
+    return m_data_ptr;
+}
+
+//======================================================================
+//  Member Function: MappedFile::GetSize
+//======================================================================
+
+size_t MappedFile::GetSize() const
+{
+    return m_size;
+}
@@ -0,0 +1,59 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <stddef.h>
+
+//======================================================================
+//  Class Definition
+//
+//  This class maps an entire file read-only into the address space
+//  of the process. The file contents can then be accessed as a single
+//  array of characters without any intermediate copies.
+//
+//  An empty file opens successfully and has a null data pointer and
+//  a size of zero.
+//======================================================================
+
+class MappedFile
+{
+public:
+
+    MappedFile();
+
+    virtual ~MappedFile();
+
+    bool Open(const char * file_name_ptr);
+
+    void Close();
+
+    bool IsOpen() const;
+
+    const char * GetData() const;
+
+    size_t GetSize() const;
+
+private:
+
+    //------------------------------------------------------------------
+    //  Copying a mapped file is not allowed.
+    //------------------------------------------------------------------
+
+    MappedFile(const MappedFile &);
+
+    MappedFile & operator =(const MappedFile &);
+
+private:
+
+    const char * m_data_ptr;
+    size_t m_size;
+    bool m_is_open_flag;
+
+#ifdef _WIN32
+    void * m_file_handle;
+    void * m_mapping_handle;
+#else
+    int m_file_descriptor;
+#endif
+};
+
+#endif
@@ -0,0 +1,1172 @@
+#include <math.h>
+#include <algorithm>
+#include "OutOfCoreSolver.h"
+
+namespace
+{
+    //------------------------------------------------------------------
+    //  The default memory budget is 256 megabytes.
+    //------------------------------------------------------------------
+
+    const size_t f_DEFAULT_MEMORY_BUDGET = (size_t)(256) << 20;
+
+    //------------------------------------------------------------------
+    //  The number of tile columns in memory during the factorization
+    //  and the back substitution: the target tile column and the two
+    //  tile columns that are read from the file.
+    //------------------------------------------------------------------
+
+    const size_t f_NUMBER_OF_TILE_COLUMN_BUFFERS = 3;
+}
+
+//======================================================================
+//  Constructor: OutOfCoreSolver::OutOfCoreSolver
+//======================================================================
+
+OutOfCoreSolver::OutOfCoreSolver()
+  : m_memory_budget(f_DEFAULT_MEMORY_BUDGET),
+    m_requested_tile_size(0),
+    m_n(0),
+    m_number_of_right_hand_sides(0),
+    m_tile_size(0),
+    m_padded_n(0),
+    m_number_of_a_tile_columns(0),
+    m_number_of_tile_columns(0),
+    m_number_of_rows(0),
+    m_memory_in_use(0),
+    m_peak_memory(0),
+    m_flop_count(0.0)
+{
+}
+
+//======================================================================
+//  Destructor: OutOfCoreSolver::~OutOfCoreSolver
+//======================================================================
+
+OutOfCoreSolver::~OutOfCoreSolver()
+{
+}
+
+//======================================================================
+//  Member Function: OutOfCoreSolver::SetMemoryBudget
+//
+//  Abstract:
+//
+//    This function sets the largest number of bytes used for the
+//    tiles in memory. It is used by the next call to Create.
+//
+//
+//  Input:
+//
+//    memory_budget         The memory budget in bytes.
+//
+//  Output:
+//
+//    This function has no return value.
+//
+//======================================================================
+
+void OutOfCoreSolver::SetMemoryBudget(size_t memory_budget)
+{
+    m_memory_budget = memory_budget;
+    return;
+}
+
+//======================================================================
+//  Member Function: OutOfCoreSolver::GetMemoryBudget
+//======================================================================
+
+size_t OutOfCoreSolver::GetMemoryBudget() const
+{
+    return m_memory_budget;
+}
+
+//======================================================================
+//  Member Function: OutOfCoreSolver::SetTileSize
+//
+//  Abstract:
+//
+//    This function sets the tile size used by the next call to Create
+//    instead of the largest tile size that fits in the memory budget.
+//    The buffers for the tile size must still fit in the budget.
+//
+//
+//  Input:
+//
+//    tile_size             The number of rows and columns of a tile, or
+//                          zero to choose the tile size from the
+//                          memory budget.
+//
+//  Output:
+//
+//    This function has no return value.
+//
+//======================================================================
+
+void OutOfCoreSolver::SetTileSize(int tile_size)
+{
+    m_requested_tile_size = tile_size;
+    return;
+}
+
+//======================================================================
+//  Member Function: OutOfCoreSolver::Create
+//
+//  Abstract:
+//
+//    This function chooses the tile size and creates the tile file for
+//    a system. The rows of the augmented matrix are then passed to
+//    AppendRow.
+//
+//
+//  Input:
+//
+//    number_of_equations           The number of equations, which must
+//                                  be at least one.
+//
+//    number_of_right_hand_sides    The number of B vectors, which must
+//                                  be at least one.
+//
+//    tile_file_name_ptr            The name of the tile file. The file
+//                                  is deleted when the system is
+//                                  solved.
+//
+//  Output:
+//
+//    This function returns a value of type 'Status_T'.
+//
+//======================================================================
+
+OutOfCoreSolver::Status_T OutOfCoreSolver::Create(int number_of_equations,
+                                                  int number_of_right_hand_sides,
+                                                  const char * tile_file_name_ptr)
+{
+    m_tile_store.Close();
+    ReleaseBuffer(m_row_tiles_vector);
+
+    m_n = number_of_equations;
+    m_number_of_right_hand_sides = number_of_right_hand_sides;
+    m_number_of_rows = 0;
+    m_memory_in_use = 0;
+    m_peak_memory = 0;
+    m_flop_count = 0.0;
+
+    m_tile_size = ChooseTileSize();
+
+    if (m_tile_size < 1)
+    {
+        return ERROR_MEMORY_BUDGET_TOO_SMALL;
+    }
+
+    int t = m_tile_size;
+    int number_of_b_tile_columns = (m_number_of_right_hand_sides + t - 1) / t;
+
+    m_number_of_a_tile_columns = (m_n + t - 1) / t;
+    m_number_of_tile_columns = m_number_of_a_tile_columns + number_of_b_tile_columns;
+    m_padded_n = m_number_of_a_tile_columns * t;
+
+    if (! m_tile_store.Create(tile_file_name_ptr,
+                              m_number_of_a_tile_columns,
+                              m_number_of_tile_columns,
+                              t))
+    {
+        return ERROR_TILE_FILE;
+    }
+
+    AllocateBuffer(m_row_tiles_vector, (size_t)(m_number_of_tile_columns) * t * t);
+
+    return SUCCESS;
+}
+
+//======================================================================
+//  Member Function: OutOfCoreSolver::AppendRow
+//
+//  Abstract:
+//
+//    This function adds the next row of the augmented matrix. The
+//    rows are written to the tile file one tile row at a time.
+//
+//
+//  Input:
+//
+//    row_ptr               A pointer to the n coefficients of the row
+//                          followed by the element of the row of each
+//                          B vector.
+//
+//  Output:
+//
+//    This function returns a value of type 'Status_T'.
+//
+//======================================================================
+
+OutOfCoreSolver::Status_T OutOfCoreSolver::AppendRow(const double * row_ptr)
+{
+    if (! m_tile_store.IsOpen())
+    {
+        return ERROR_TILE_FILE;
+    }
+
+    if (m_number_of_rows >= m_n)
+    {
+        return ERROR_NUMBER_OF_ROWS;
+    }
+
+    //------------------------------------------------------------------
+    //  Column j of the augmented matrix is in tile column j / t. The
+    //  B vectors start at column m_padded_n.
+    //------------------------------------------------------------------
+
+    size_t t = m_tile_size;
+    size_t row_in_tile = (size_t)(m_number_of_rows) % t;
+    double * row_tiles_ptr = &m_row_tiles_vector[0];
+
+    for (int j = 0; j < m_n; ++j)
+    {
+        row_tiles_ptr[((j / t) * t + row_in_tile) * t + j % t] = row_ptr[j];
+    }
+
+    for (int r = 0; r < m_number_of_right_hand_sides; ++r)
+    {
+        size_t j = (size_t)(m_padded_n) + r;
+        row_tiles_ptr[((j / t) * t + row_in_tile) * t + j % t] = row_ptr[m_n + r];
+    }
+
+    ++m_number_of_rows;
+
+    if ((row_in_tile == t - 1) && (! FlushRows()))
+    {
+        return ERROR_TILE_FILE;
+    }
+
+    return SUCCESS;
+}
+
+//======================================================================
+//  Member Function: OutOfCoreSolver::Solve
+//
+//  Abstract:
+//
+//    This function factors the A matrix in the tile file, solves for
+//    every B vector and deletes the tile file.
+//
+//
+//  Input:
+//
+//    x_vectors             The solutions, one after another, each with
+//                          n elements.
+//
+//  Output:
+//
+//    This function returns a value of type 'Status_T'.
+//
+//======================================================================
+
+OutOfCoreSolver::Status_T OutOfCoreSolver::Solve(std::vector<double> & x_vectors)
+{
+    if (! m_tile_store.IsOpen())
+    {
+        return ERROR_TILE_FILE;
+    }
+
+    Status_T status = SUCCESS;
+
+    if (m_number_of_rows != m_n)
+    {
+        status = ERROR_NUMBER_OF_ROWS;
+    }
+
+    //------------------------------------------------------------------
+    //  Write the last tile row, with the rows of the identity matrix
+    //  that fill it.
+    //------------------------------------------------------------------
+
+    if ((status == SUCCESS) && (m_n < m_padded_n))
+    {
+        size_t t = m_tile_size;
+
+        for (size_t i = m_n; i < (size_t)(m_padded_n); ++i)
+        {
+            m_row_tiles_vector[((i / t) * t + i % t) * t + i % t] = 1.0;
+        }
+
+        m_number_of_rows = m_padded_n;
+
+        if (! FlushRows())
+        {
+            status = ERROR_TILE_FILE;
+        }
+    }
+
+    ReleaseBuffer(m_row_tiles_vector);
+
+    if (status == SUCCESS)
+    {
+        status = Factor();
+    }
+
+    if (status == SUCCESS)
+    {
+        status = BackSubstitute(x_vectors);
+    }
+
+    //------------------------------------------------------------------
+    //  Wait for any read that is in progress before the buffers are
+    //  released.
+    //------------------------------------------------------------------
+
+    m_tile_store.FinishRead();
+    m_tile_store.Close();
+
+    ReleaseBuffer(m_target_vector);
+    ReleaseBuffer(m_read_vector_array[0]);
+    ReleaseBuffer(m_read_vector_array[1]);
+    std::vector<int>().swap(m_pivot_row_vector);
+    m_memory_in_use = 0;
+
+    return status;
+}
+
+//======================================================================
+//  Member Function: OutOfCoreSolver::GetTileSize
+//======================================================================
+
+int OutOfCoreSolver::GetTileSize() const
+{
+    return m_tile_size;
+}
+
+//======================================================================
+//  Member Function: OutOfCoreSolver::GetNumberOfTileRows
+//======================================================================
+
+int OutOfCoreSolver::GetNumberOfTileRows() const
+{
+    return m_number_of_a_tile_columns;
+}
+
+//======================================================================
+//  Member Function: OutOfCoreSolver::GetNumberOfTileColumns
+//======================================================================
+
+int OutOfCoreSolver::GetNumberOfTileColumns() const
+{
+    return m_number_of_tile_columns;
+}
+
+//======================================================================
+//  Member Function: OutOfCoreSolver::GetPeakMemory
+//
+//  Abstract:
+//
+//    This function returns the largest number of bytes used at once
+//    for the tiles in memory and the pivot rows.
+//
+//======================================================================
+
+size_t OutOfCoreSolver::GetPeakMemory() const
+{
+    return m_peak_memory;
+}
+
+//======================================================================
+//  Member Function: OutOfCoreSolver::GetBytesRead
+//======================================================================
+
+uint64_t OutOfCoreSolver::GetBytesRead() const
+{
+    return m_tile_store.GetBytesRead();
+}
+
+//======================================================================
+//  Member Function: OutOfCoreSolver::GetBytesWritten
+//======================================================================
+
+uint64_t OutOfCoreSolver::GetBytesWritten() const
+{
+    return m_tile_store.GetBytesWritten();
+}
+
+//======================================================================
+//  Member Function: OutOfCoreSolver::GetFlopCount
+//======================================================================
+
+double OutOfCoreSolver::GetFlopCount() const
+{
+    return m_flop_count;
+}
+
+//======================================================================
+//  Member Function: OutOfCoreSolver::GetStatusString
+//======================================================================
+
+const char * OutOfCoreSolver::GetStatusString(Status_T status)
+{
+    const char * status_ptr = "";
+
+    switch (status)
+    {
+    case SUCCESS:
+
+        status_ptr = "Success";
+        break;
+
+    case MATRIX_SINGULAR:
+
+        status_ptr = "The equations are singular and do not have a unique solution";
+        break;
+
+    case ERROR_MEMORY_BUDGET_TOO_SMALL:
+
+        status_ptr = "The memory budget is too small for one column of tiles";
+        break;
+
+    case ERROR_TILE_FILE:
+
+        status_ptr = "The tile file could not be created, read or written";
+        break;
+
+    case ERROR_NUMBER_OF_ROWS:
+
+        status_ptr = "The number of rows is not the number of equations";
+        break;
+
+    default:
+
+        status_ptr = "Unknown error";
+        break;
+    }
+
+    return status_ptr;
+}
+
+//======================================================================
+//  Member Function: OutOfCoreSolver::ChooseTileSize
+//
+//  Abstract:
+//
+//    This function returns the requested tile size, or the largest
+//    tile size whose buffers fit in the memory budget, but not more
+//    than the number of equations. Zero is returned if the buffers
+//    do not fit in the memory budget.
+//
+//======================================================================
+
+int OutOfCoreSolver::ChooseTileSize() const
+{
+    int tile_size = m_requested_tile_size;
+
+    if (tile_size <= 0)
+    {
+        //--------------------------------------------------------------
+        //  Start from the tile size of three tile columns of n rows.
+        //--------------------------------------------------------------
+
+        size_t estimate = m_memory_budget
+            / (f_NUMBER_OF_TILE_COLUMN_BUFFERS * sizeof(double) * (size_t)(m_n));
+
+        tile_size = (estimate < (size_t)(m_n)) ? (int)(estimate) : m_n;
+
+        while ((tile_size > 0) && (GetRequiredMemory(tile_size) > m_memory_budget))
+        {
+            --tile_size;
+        }
+    }
+    else
+    {
+        tile_size = std::min(tile_size, m_n);
+
+        if (GetRequiredMemory(tile_size) > m_memory_budget)
+        {
+            tile_size = 0;
+        }
+    }
+
+    return tile_size;
+}
+
+//======================================================================
+//  Member Function: OutOfCoreSolver::GetRequiredMemory
+//
+//  Abstract:
+//
+//    This function returns the number of bytes used for a tile size.
+//    While the rows are appended one tile row is in memory. During the
+//    factorization and the back substitution three tile columns and
+//    the pivot rows are in memory.
+//
+//======================================================================
+
+size_t OutOfCoreSolver::GetRequiredMemory(int tile_size) const
+{
+    size_t t = tile_size;
+    size_t padded_n = ((m_n + t - 1) / t) * t;
+    size_t padded_b = ((m_number_of_right_hand_sides + t - 1) / t) * t;
+    size_t row_tiles_bytes = t * (padded_n + padded_b) * sizeof(double);
+    size_t tile_columns_bytes = f_NUMBER_OF_TILE_COLUMN_BUFFERS * padded_n * t * sizeof(double)
+        + padded_n * sizeof(int);
+
+    return std::max(row_tiles_bytes, tile_columns_bytes);
+}
+
+//======================================================================
+//  Member Function: OutOfCoreSolver::AllocateBuffer
+//
+//  Abstract:
+//
+//    This function allocates a buffer of zeros and counts its memory.
+//
+//======================================================================
+
+void OutOfCoreSolver::AllocateBuffer(std::vector<double> & buffer_vector,
+                                     size_t number_of_elements)
+{
+    ReleaseBuffer(buffer_vector);
+
+    buffer_vector.assign(number_of_elements, 0.0);
+    m_memory_in_use += number_of_elements * sizeof(double);
+    m_peak_memory = std::max(m_peak_memory, m_memory_in_use);
+
+    return;
+}
+
+//======================================================================
+//  Member Function: OutOfCoreSolver::ReleaseBuffer
+//======================================================================
+
+void OutOfCoreSolver::ReleaseBuffer(std::vector<double> & buffer_vector)
+{
+    size_t buffer_bytes = buffer_vector.size() * sizeof(double);
+
+    m_memory_in_use -= std::min(m_memory_in_use, buffer_bytes);
+    std::vector<double>().swap(buffer_vector);
+
+    return;
+}
+
+//======================================================================
+//  Member Function: OutOfCoreSolver::FlushRows
+//
+//  Abstract:
+//
+//    This function writes the tile row that holds the last appended
+//    row, one tile to each tile column, and clears it for the next
+//    tile row.
+//
+//======================================================================
+
+bool OutOfCoreSolver::FlushRows()
+{
+    size_t tile_elements = (size_t)(m_tile_size) * m_tile_size;
+    int tile_row = (m_number_of_rows - 1) / m_tile_size;
+
+    for (int tile_column = 0; tile_column < m_number_of_tile_columns; ++tile_column)
+    {
+        if (! m_tile_store.WriteTiles(tile_column,
+                                      tile_row,
+                                      1,
+                                      &m_row_tiles_vector[tile_column * tile_elements]))
+        {
+            return false;
+        }
+    }
+
+    std::fill(m_row_tiles_vector.begin(), m_row_tiles_vector.end(), 0.0);
+
+    return true;
+}
+
+//======================================================================
+//  Member Function: OutOfCoreSolver::Factor
+//
+//  Abstract:
+//
+//    This function factors A and does the forward substitution of the
+//    B vectors. Each tile column is read whole, then updated by each
+//    factored tile column to its left from the diagonal tile down,
+//    then factored if it is a tile column of A, and written. The reads
+//    are done in that order, and each read is started before the work
+//    on the tiles of the read before it.
+//
+//
+//  Input:
+//
+//    None.
+//
+//  Output:
+//
+//    This function returns a value of type 'Status_T'.
+//
+//======================================================================
+
+OutOfCoreSolver::Status_T OutOfCoreSolver::Factor()
+{
+    int number_of_tile_rows = m_number_of_a_tile_columns;
+    size_t tile_column_elements = (size_t)(m_padded_n) * m_tile_size;
+
+    AllocateBuffer(m_target_vector, tile_column_elements);
+    AllocateBuffer(m_read_vector_array[0], tile_column_elements);
+    AllocateBuffer(m_read_vector_array[1], tile_column_elements);
+
+    m_pivot_row_vector.assign(m_padded_n, 0);
+    m_memory_in_use += m_pivot_row_vector.size() * sizeof(int);
+    m_peak_memory = std::max(m_peak_memory, m_memory_in_use);
+
+    //------------------------------------------------------------------
+    //  List the reads.
+    //------------------------------------------------------------------
+
+    std::vector<ReadRequest_T> request_vector;
+
+    for (int target = 0; target < m_number_of_tile_columns; ++target)
+    {
+        ReadRequest_T request = { target, 0, number_of_tile_rows, target };
+        request_vector.push_back(request);
+
+        int end_factored = std::min(target, m_number_of_a_tile_columns);
+
+        for (int factored = 0; factored < end_factored; ++factored)
+        {
+            ReadRequest_T factored_request = { factored,
+                                               factored,
+                                               number_of_tile_rows - factored,
+                                               target };
+            request_vector.push_back(factored_request);
+        }
+    }
+
+    //------------------------------------------------------------------
+    //  Do the reads and the work on each tile column.
+    //------------------------------------------------------------------
+
+    m_tile_store.StartRead(request_vector[0].m_tile_column,
+                           request_vector[0].m_first_tile_row,
+                           request_vector[0].m_number_of_tile_rows,
+                           &m_read_vector_array[0][0]);
+
+    for (size_t r = 0; r < request_vector.size(); ++r)
+    {
+        const ReadRequest_T & request = request_vector[r];
+        std::vector<double> & read_vector = m_read_vector_array[r % 2];
+        int target = request.m_target_tile_column;
+
+        if (! m_tile_store.FinishRead())
+        {
+            return ERROR_TILE_FILE;
+        }
+
+        if (r + 1 < request_vector.size())
+        {
+            const ReadRequest_T & next_request = request_vector[r + 1];
+
+            m_tile_store.StartRead(next_request.m_tile_column,
+                                   next_request.m_first_tile_row,
+                                   next_request.m_number_of_tile_rows,
+                                   &m_read_vector_array[(r + 1) % 2][0]);
+        }
+
+        if (request.m_tile_column == target)
+        {
+            m_target_vector.swap(read_vector);
+        }
+        else
+        {
+            UpdateTileColumn(request.m_tile_column,
+                             &read_vector[0],
+                             &m_target_vector[0],
+                             GetNumberOfColumns(target));
+        }
+
+        //--------------------------------------------------------------
+        //  After the last update, factor and write the tile column.
+        //--------------------------------------------------------------
+
+        if ((r + 1 == request_vector.size()) || (request_vector[r + 1].m_target_tile_column != target))
+        {
+            if ((target < m_number_of_a_tile_columns) && (! FactorTileColumn(target, &m_target_vector[0])))
+            {
+                return MATRIX_SINGULAR;
+            }
+
+            if (! m_tile_store.WriteTiles(target, 0, number_of_tile_rows, &m_target_vector[0]))
+            {
+                return ERROR_TILE_FILE;
+            }
+        }
+    }
+
+    return SUCCESS;
+}
+
+//======================================================================
+//  Member Function: OutOfCoreSolver::BackSubstitute
+//
+//  Abstract:
+//
+//    This function solves U X = Y, where Y is the B vectors after the
+//    forward substitution. For each tile column of Y, the tile columns
+//    of U are read from right to left, down to their diagonal tiles.
+//
+//
+//  Input:
+//
+//    x_vectors             The solutions, one after another, each with
+//                          n elements.
+//
+//  Output:
+//
+//    This function returns a value of type 'Status_T'.
+//
+//======================================================================
+
+OutOfCoreSolver::Status_T OutOfCoreSolver::BackSubstitute(std::vector<double> & x_vectors)
+{
+    int number_of_tile_rows = m_number_of_a_tile_columns;
+    size_t t = m_tile_size;
+
+    x_vectors.assign((size_t)(m_n) * m_number_of_right_hand_sides, 0.0);
+
+    //------------------------------------------------------------------
+    //  List the reads.
+    //------------------------------------------------------------------
+
+    std::vector<ReadRequest_T> request_vector;
+
+    for (int target = m_number_of_a_tile_columns; target < m_number_of_tile_columns; ++target)
+    {
+        ReadRequest_T request = { target, 0, number_of_tile_rows, target };
+        request_vector.push_back(request);
+
+        for (int factored = m_number_of_a_tile_columns - 1; factored >= 0; --factored)
+        {
+            ReadRequest_T factored_request = { factored, 0, factored + 1, target };
+            request_vector.push_back(factored_request);
+        }
+    }
+
+    //------------------------------------------------------------------
+    //  Do the reads and the work on each tile column.
+    //------------------------------------------------------------------
+
+    m_tile_store.StartRead(request_vector[0].m_tile_column,
+                           request_vector[0].m_first_tile_row,
+                           request_vector[0].m_number_of_tile_rows,
+                           &m_read_vector_array[0][0]);
+
+    for (size_t r = 0; r < request_vector.size(); ++r)
+    {
+        const ReadRequest_T & request = request_vector[r];
+        std::vector<double> & read_vector = m_read_vector_array[r % 2];
+        int target = request.m_target_tile_column;
+        int number_of_columns = GetNumberOfColumns(target);
+
+        if (! m_tile_store.FinishRead())
+        {
+            return ERROR_TILE_FILE;
+        }
+
+        if (r + 1 < request_vector.size())
+        {
+            const ReadRequest_T & next_request = request_vector[r + 1];
+
+            m_tile_store.StartRead(next_request.m_tile_column,
+                                   next_request.m_first_tile_row,
+                                   next_request.m_number_of_tile_rows,
+                                   &m_read_vector_array[(r + 1) % 2][0]);
+        }
+
+        if (request.m_tile_column == target)
+        {
+            m_target_vector.swap(read_vector);
+        }
+        else
+        {
+            SolveTileColumn(request.m_tile_column,
+                            &read_vector[0],
+                            &m_target_vector[0],
+                            number_of_columns);
+        }
+
+        //--------------------------------------------------------------
+        //  After the last tile column of U, copy the solutions.
+        //--------------------------------------------------------------
+
+        if ((r + 1 == request_vector.size()) || (request_vector[r + 1].m_target_tile_column != target))
+        {
+            int first_vector = (target - m_number_of_a_tile_columns) * m_tile_size;
+
+            for (int c = 0; c < number_of_columns; ++c)
+            {
+                double * x_ptr = &x_vectors[(size_t)(first_vector + c) * m_n];
+
+                for (int i = 0; i < m_n; ++i)
+                {
+                    x_ptr[i] = m_target_vector[i * t + c];
+                }
+            }
+        }
+    }
+
+    return SUCCESS;
+}
+
+//======================================================================
+//  Member Function: OutOfCoreSolver::GetNumberOfColumns
+//
+//  Abstract:
+//
+//    This function returns the number of columns of a tile column that
+//    are used. Every column of a tile column of A is used, including
+//    the columns of the identity matrix, but only the columns of the
+//    last tile column of B that hold B vectors are used.
+//
+//======================================================================
+
+int OutOfCoreSolver::GetNumberOfColumns(int tile_column) const
+{
+    if (tile_column < m_number_of_a_tile_columns)
+    {
+        return m_tile_size;
+    }
+
+    int first_vector = (tile_column - m_number_of_a_tile_columns) * m_tile_size;
+
+    return std::min(m_tile_size, m_number_of_right_hand_sides - first_vector);
+}
+
+//======================================================================
+//  Member Function: OutOfCoreSolver::ExchangeRows
+//
+//  Abstract:
+//
+//    This function exchanges the rows of a tile column that were
+//    exchanged when a tile column to its left was factored.
+//
+//
+//  Input:
+//
+//    factored_tile_column  The factored tile column.
+//
+//    a_ptr                 A pointer to the whole tile column that is
+//                          updated.
+//
+//    number_of_columns     The number of columns that are used.
+//
+//  Output:
+//
+//    This function has no return value.
+//
+//======================================================================
+
+void OutOfCoreSolver::ExchangeRows(int factored_tile_column,
+                                   double * a_ptr,
+                                   int number_of_columns) const
+{
+    size_t t = m_tile_size;
+    size_t first_step = factored_tile_column * t;
+
+    for (size_t step = first_step; step < first_step + t; ++step)
+    {
+        size_t pivot_row = m_pivot_row_vector[step];
+
+        if (pivot_row != step)
+        {
+            std::swap_ranges(a_ptr + step * t,
+                             a_ptr + step * t + number_of_columns,
+                             a_ptr + pivot_row * t);
+        }
+    }
+
+    return;
+}
+
+//======================================================================
+//  Member Function: OutOfCoreSolver::UpdateTileColumn
+//
+//  Abstract:
+//
+//    This function updates a tile column with a factored tile column
+//    to its left. With K the factored tile column, the tile in tile
+//    row K becomes the U tile L(K,K)^-1 A(K), and each tile below it
+//    has L(I,K) times that U tile subtracted.
+//
+//
+//  Input:
+//
+//    factored_tile_column  The factored tile column.
+//
+//    l_ptr                 A pointer to the factored tile column from
+//                          its diagonal tile down.
+//
+//    a_ptr                 A pointer to the whole tile column that is
+//                          updated.
+//
+//    number_of_columns     The number of columns that are used.
+//
+//  Output:
+//
+//    This function has no return value.
+//
+//======================================================================
+
+void OutOfCoreSolver::UpdateTileColumn(int factored_tile_column,
+                                       const double * l_ptr,
+                                       double * a_ptr,
+                                       int number_of_columns)
+{
+    size_t t = m_tile_size;
+    size_t first_row = factored_tile_column * t;
+    size_t number_of_rows_below = m_padded_n - first_row - t;
+    double * u_ptr = a_ptr + first_row * t;
+
+    ExchangeRows(factored_tile_column, a_ptr, number_of_columns);
+
+    //------------------------------------------------------------------
+    //  Solve with the unit lower triangle of the diagonal tile.
+    //------------------------------------------------------------------
+
+    for (size_t i = 1; i < t; ++i)
+    {
+        double * u_row_ptr = u_ptr + i * t;
+        const double * l_row_ptr = l_ptr + i * t;
+
+        for (size_t p = 0; p < i; ++p)
+        {
+            double multiplier = l_row_ptr[p];
+
+            if (multiplier != 0.0)
+            {
+                const double * u_pivot_row_ptr = u_ptr + p * t;
+
+                for (int c = 0; c < number_of_columns; ++c)
+                {
+                    u_row_ptr[c] -= multiplier * u_pivot_row_ptr[c];
+                }
+            }
+        }
+    }
+
+    //------------------------------------------------------------------
+    //  Update the tiles below the diagonal tile.
+    //------------------------------------------------------------------
+
+    for (size_t i = 0; i < number_of_rows_below; ++i)
+    {
+        double * a_row_ptr = u_ptr + (t + i) * t;
+        const double * l_row_ptr = l_ptr + (t + i) * t;
+
+        for (size_t p = 0; p < t; ++p)
+        {
+            double multiplier = l_row_ptr[p];
+
+            if (multiplier != 0.0)
+            {
+                const double * u_pivot_row_ptr = u_ptr + p * t;
+
+                for (int c = 0; c < number_of_columns; ++c)
+                {
+                    a_row_ptr[c] -= multiplier * u_pivot_row_ptr[c];
+                }
+            }
+        }
+    }
+
+    m_flop_count += 2.0 * number_of_columns * ((double)(t) * (t - 1) / 2.0 + (double)(number_of_rows_below) * t);
+
+    return;
+}
+
+//======================================================================
+//  Member Function: OutOfCoreSolver::FactorTileColumn
+//
+//  Abstract:
+//
+//    This function factors the part of a tile column of A from its
+//    diagonal tile down, after it is updated by every tile column to
+//    its left, using Gaussian elimination with partial pivoting. The
+//    multipliers are stored in place of the eliminated elements, and
+//    the pivot rows are stored in m_pivot_row_vector.
+//
+//
+//  Input:
+//
+//    tile_column           The tile column.
+//
+//    a_ptr                 A pointer to the whole tile column.
+//
+//  Output:
+//
+//    This function returns a value of type 'bool' that is the value
+//    false if and only if a column has no nonzero pivot, so the matrix
+//    is singular.
+//
+//======================================================================
+
+bool OutOfCoreSolver::FactorTileColumn(int tile_column,
+                                       double * a_ptr)
+{
+    size_t t = m_tile_size;
+    size_t padded_n = m_padded_n;
+    size_t first_row = tile_column * t;
+
+    for (size_t c = 0; c < t; ++c)
+    {
+        size_t row = first_row + c;
+
+        //--------------------------------------------------------------
+        //  Find the pivot row and exchange it with this row.
+        //--------------------------------------------------------------
+
+        size_t pivot_row = row;
+        double maximum_magnitude = fabs(a_ptr[row * t + c]);
+
+        for (size_t i = row + 1; i < padded_n; ++i)
+        {
+            double magnitude = fabs(a_ptr[i * t + c]);
+
+            if (magnitude > maximum_magnitude)
+            {
+                maximum_magnitude = magnitude;
+                pivot_row = i;
+            }
+        }
+
+        if (maximum_magnitude == 0.0)
+        {
+            return false;
+        }
+
+        m_pivot_row_vector[row] = (int)(pivot_row);
+
+        if (pivot_row != row)
+        {
+            std::swap_ranges(a_ptr + row * t, a_ptr + row * t + t, a_ptr + pivot_row * t);
+        }
+
+        //--------------------------------------------------------------
+        //  Eliminate the column from the rows below.
+        //--------------------------------------------------------------
+
+        const double * pivot_row_ptr = a_ptr + row * t;
+        double pivot = pivot_row_ptr[c];
+
+        for (size_t i = row + 1; i < padded_n; ++i)
+        {
+            double * a_row_ptr = a_ptr + i * t;
+            double multiplier = a_row_ptr[c] / pivot;
+
+            a_row_ptr[c] = multiplier;
+
+            if (multiplier != 0.0)
+            {
+                for (size_t j = c + 1; j < t; ++j)
+                {
+                    a_row_ptr[j] -= multiplier * pivot_row_ptr[j];
+                }
+            }
+        }
+
+        m_flop_count += (double)(padded_n - row - 1) * (1.0 + 2.0 * (t - c - 1));
+    }
+
+    return true;
+}
+
+//======================================================================
+//  Member Function: OutOfCoreSolver::SolveTileColumn
+//
+//  Abstract:
+//
+//    This function does the back substitution with one tile column of
+//    U. With K the tile column, the tile in tile row K of Y becomes the
+//    solution U(K,K)^-1 Y(K), and each tile above it has U(I,K) times
+//    that solution subtracted.
+//
+//
+//  Input:
+//
+//    factored_tile_column  The tile column of U.
+//
+//    u_ptr                 A pointer to the tile column of U, from the
+//                          first tile row down to its diagonal tile.
+//
+//    y_ptr                 A pointer to the whole tile column of Y.
+//
+//    number_of_columns     The number of columns that are used.
+//
+//  Output:
+//
+//    This function has no return value.
+//
+//======================================================================
+
+void OutOfCoreSolver::SolveTileColumn(int factored_tile_column,
+                                      const double * u_ptr,
+                                      double * y_ptr,
+                                      int number_of_columns)
+{
+    size_t t = m_tile_size;
+    size_t first_row = factored_tile_column * t;
+    double * x_ptr = y_ptr + first_row * t;
+    const double * u_diagonal_ptr = u_ptr + first_row * t;
+
+    //------------------------------------------------------------------
+    //  Solve with the upper triangle of the diagonal tile.
+    //------------------------------------------------------------------
+
+    for (size_t i = t; i-- > 0;)
+    {
+        double * x_row_ptr = x_ptr + i * t;
+        const double * u_row_ptr = u_diagonal_ptr + i * t;
+
+        for (size_t p = i + 1; p < t; ++p)
+        {
+            double multiplier = u_row_ptr[p];
+
+            if (multiplier != 0.0)
+            {
+                const double * x_solved_row_ptr = x_ptr + p * t;
+
+                for (int c = 0; c < number_of_columns; ++c)
+                {
+                    x_row_ptr[c] -= multiplier * x_solved_row_ptr[c];
+                }
+            }
+        }
+
+        double pivot = u_row_ptr[i];
+
+        for (int c = 0; c < number_of_columns; ++c)
+        {
+            x_row_ptr[c] /= pivot;
+        }
+    }
+
+    //------------------------------------------------------------------
+    //  Update the tiles above the diagonal tile.
+    //------------------------------------------------------------------
+
+    for (size_t i = 0; i < first_row; ++i)
+    {
+        double * y_row_ptr = y_ptr + i * t;
+        const double * u_row_ptr = u_ptr + i * t;
+
+        for (size_t p = 0; p < t; ++p)
+        {
+            double multiplier = u_row_ptr[p];
+
+            if (multiplier != 0.0)
+            {
+                const double * x_solved_row_ptr = x_ptr + p * t;
+
+                for (int c = 0; c < number_of_columns; ++c)
+                {
+                    y_row_ptr[c] -= multiplier * x_solved_row_ptr[c];
+                }
+            }
+        }
+    }
+
+    m_flop_count += 2.0 * number_of_columns * ((double)(t) * (t + 1) / 2.0 + (double)(first_row) * t);
+
+    return;
+}
@@ -0,0 +1,179 @@
+#ifndef OUTOFCORESOLVER_H
+#define OUTOFCORESOLVER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+#include "TileStore.h"
+
+//======================================================================
+//  Class Definition
+//
+//  This class solves a dense system of simultaneous linear equations
+//  A x = B that is too large to be stored in memory. The augmented
+//  matrix [A B] is stored in square tiles in a TileStore file, and
+//  only a few tile columns are in memory at any time. The memory
+//  budget sets the tile size, so that the buffers never use more
+//  memory than the budget.
+//
+//  Create is passed the number of equations, the number of B vectors
+//  and the name of the tile file. AppendRow is then called once for
+//  each row of the augmented matrix, in order, and Solve factors A
+//  and finds the solution for each B vector.
+//
+//  The size of A is rounded up to a whole number of tiles by adding
+//  rows and columns of the identity matrix, and the B vectors start
+//  at the next tile column. A is factored by Gaussian elimination
+//  with partial pivoting, one tile column at a time. Before a tile
+//  column is factored, it is updated by every factored tile column
+//  to its left, which is read from the file while the previous one
+//  is used. The tile columns of B are updated in the same way, which
+//  is the forward substitution. The back substitution reads the tile
+//  columns of U from right to left.
+//
+//  A factored tile column is written once and is not changed when
+//  rows are exchanged by the tile columns factored after it. Before a
+//  tile column is updated by a factored tile column, the rows that
+//  were exchanged when that tile column was factored are exchanged,
+//  so each tile column sees the factored tile columns in the row order
+//  in which they were factored, as in right-looking elimination.
+//
+//  The peak memory used and the number of bytes read from and written
+//  to the file are kept.
+//======================================================================
+
+class OutOfCoreSolver
+{
+public:
+
+    enum Status_T
+    {
+        SUCCESS,
+        MATRIX_SINGULAR,
+        ERROR_MEMORY_BUDGET_TOO_SMALL,
+        ERROR_TILE_FILE,
+        ERROR_NUMBER_OF_ROWS
+    };
+
+    OutOfCoreSolver();
+
+    virtual ~OutOfCoreSolver();
+
+    void SetMemoryBudget(size_t memory_budget);
+
+    size_t GetMemoryBudget() const;
+
+    void SetTileSize(int tile_size);
+
+    Status_T Create(int number_of_equations,
+                    int number_of_right_hand_sides,
+                    const char * tile_file_name_ptr);
+
+    Status_T AppendRow(const double * row_ptr);
+
+    Status_T Solve(std::vector<double> & x_vectors);
+
+    int GetTileSize() const;
+
+    int GetNumberOfTileRows() const;
+
+    int GetNumberOfTileColumns() const;
+
+    size_t GetPeakMemory() const;
+
+    uint64_t GetBytesRead() const;
+
+    uint64_t GetBytesWritten() const;
+
+    double GetFlopCount() const;
+
+    static const char * GetStatusString(Status_T status);
+
+protected:
+
+    //------------------------------------------------------------------
+    //  A read of a range of tile rows of a tile column, done for the
+    //  work on a target tile column.
+    //------------------------------------------------------------------
+
+    struct ReadRequest_T
+    {
+        int m_tile_column;
+        int m_first_tile_row;
+        int m_number_of_tile_rows;
+        int m_target_tile_column;
+    };
+
+    int ChooseTileSize() const;
+
+    size_t GetRequiredMemory(int tile_size) const;
+
+    void AllocateBuffer(std::vector<double> & buffer_vector,
+                        size_t number_of_elements);
+
+    void ReleaseBuffer(std::vector<double> & buffer_vector);
+
+    bool FlushRows();
+
+    Status_T Factor();
+
+    Status_T BackSubstitute(std::vector<double> & x_vectors);
+
+    int GetNumberOfColumns(int tile_column) const;
+
+    void ExchangeRows(int factored_tile_column,
+                      double * a_ptr,
+                      int number_of_columns) const;
+
+    void UpdateTileColumn(int factored_tile_column,
+                          const double * l_ptr,
+                          double * a_ptr,
+                          int number_of_columns);
+
+    bool FactorTileColumn(int tile_column,
+                          double * a_ptr);
+
+    void SolveTileColumn(int factored_tile_column,
+                         const double * u_ptr,
+                         double * y_ptr,
+                         int number_of_columns);
+
+protected:
+
+    TileStore m_tile_store;
+    size_t m_memory_budget;
+    int m_requested_tile_size;
+    int m_n;
+    int m_number_of_right_hand_sides;
+    int m_tile_size;
+    int m_padded_n;
+    int m_number_of_a_tile_columns;
+    int m_number_of_tile_columns;
+    int m_number_of_rows;
+    size_t m_memory_in_use;
+    size_t m_peak_memory;
+    double m_flop_count;
+
+    //------------------------------------------------------------------
+    //  The tile column that is being factored or solved, and two tile
+    //  columns that are read from the file one after the other.
+    //------------------------------------------------------------------
+
+    std::vector<double> m_target_vector;
+    std::vector<double> m_read_vector_array[2];
+
+    //------------------------------------------------------------------
+    //  The rows of the augmented matrix that have been appended but
+    //  not written, stored as one tile row of tiles.
+    //------------------------------------------------------------------
+
+    std::vector<double> m_row_tiles_vector;
+
+    //------------------------------------------------------------------
+    //  The row exchanged with row i in step i of the factorization.
+    //------------------------------------------------------------------
+
+    std::vector<int> m_pivot_row_vector;
+};
+
+#endif
@@ -0,0 +1,105 @@
+#include "OutOfCoreSystemFile.h"
+
+//======================================================================
+//  Constructor: OutOfCoreSystemFile::OutOfCoreSystemFile
+//
+//  Input:
+//
+//    solver                The solver that is passed the rows.
+//
+//    tile_file_name_ptr    The name of the tile file of the solver.
+//
+//======================================================================
+
+OutOfCoreSystemFile::OutOfCoreSystemFile(OutOfCoreSolver & solver,
+                                         const char * tile_file_name_ptr)
+  : m_solver(solver),
+    m_tile_file_name_string(tile_file_name_ptr),
+    m_solver_status(OutOfCoreSolver::SUCCESS)
+{
+}
+
+//======================================================================
+//  Destructor: OutOfCoreSystemFile::~OutOfCoreSystemFile
+//======================================================================
+
+OutOfCoreSystemFile::~OutOfCoreSystemFile()
+{
+}
+
+//======================================================================
+//  Member Function: OutOfCoreSystemFile::GetSolverStatus
+//
+//  Abstract:
+//
+//    This function returns the status of the solver when the tile
+//    file was created and the rows were appended.
+//
+//======================================================================
+
+OutOfCoreSolver::Status_T OutOfCoreSystemFile::GetSolverStatus() const
+{
+    return m_solver_status;
+}
+
+//======================================================================
+//  Member Function: OutOfCoreSystemFile::AddValue
+//
+//  Abstract:
+//
+//    This function collects the values of one row and passes the row
+//    to the solver. The tile file is created for the first value.
+//
+//
+//  Input:
+//
+//    value                 The value.
+//
+//  Output:
+//
+//    This function has no return value.
+//
+//======================================================================
+
+void OutOfCoreSystemFile::AddValue(double value)
+{
+    size_t row_size = (size_t)(m_n) + 1;
+
+    if (m_number_of_values == 0)
+    {
+        m_row_vector.clear();
+        m_row_vector.reserve(row_size);
+        m_solver_status = m_solver.Create(m_n, 1, m_tile_file_name_string.c_str());
+    }
+
+    if ((m_solver_status != OutOfCoreSolver::SUCCESS)
+        || (m_number_of_values >= (size_t)(m_n) * row_size))
+    {
+        return;
+    }
+
+    m_row_vector.push_back(value);
+
+    if (m_row_vector.size() == row_size)
+    {
+        m_solver_status = m_solver.AppendRow(&m_row_vector[0]);
+        m_row_vector.clear();
+    }
+
+    return;
+}
+
+//======================================================================
+//  Member Function: OutOfCoreSystemFile::MakeBatch
+//
+//  Abstract:
+//
+//    The rows are already in the tile file of the solver, so there is
+//    nothing to store.
+//
+//======================================================================
+
+void OutOfCoreSystemFile::MakeBatch()
+{
+    return;
+}
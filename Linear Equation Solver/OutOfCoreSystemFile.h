@@ -0,0 +1,47 @@
+#ifndef OUTOFCORESYSTEMFILE_H
+#define OUTOFCORESYSTEMFILE_H
+
+#include <stddef.h>
+#include <string>
+#include <vector>
+#include "BatchSystemFile.h"
+#include "OutOfCoreSolver.h"
+
+//======================================================================
+//  Class Definition
+//
+//  This class reads a dense system that is too large to be stored in
+//  memory from a file with the format of a batch file that holds one
+//  system. Each row of the augmented matrix is passed to an
+//  OutOfCoreSolver as soon as it is read, so only one row is kept.
+//  The values of any system after the first are read and counted, so
+//  GetNumberOfSystems returns the number of systems in the file, but
+//  they are not used.
+//======================================================================
+
+class OutOfCoreSystemFile : public BatchSystemFile
+{
+public:
+
+    OutOfCoreSystemFile(OutOfCoreSolver & solver,
+                        const char * tile_file_name_ptr);
+
+    virtual ~OutOfCoreSystemFile();
+
+    OutOfCoreSolver::Status_T GetSolverStatus() const;
+
+protected:
+
+    virtual void AddValue(double value);
+
+    virtual void MakeBatch();
+
+protected:
+
+    OutOfCoreSolver & m_solver;
+    std::string m_tile_file_name_string;
+    OutOfCoreSolver::Status_T m_solver_status;
+    std::vector<double> m_row_vector;
+};
+
+#endif
@@ -0,0 +1,487 @@
+#include <limits.h>
+#include <string.h>
+#include <wctype.h>
+#include <atomic>
+#include <thread>
+#include "ParallelEquationParser.h"
+
+namespace
+{
+    //------------------------------------------------------------------
+    //  Chunks smaller than this are not worth a thread.
+    //------------------------------------------------------------------
+
+    const size_t f_MINIMUM_CHUNK_SIZE = 256 * 1024;
+
+    //------------------------------------------------------------------
+    //  Make several chunks per thread so that the threads stay busy
+    //  when the chunks take different amounts of time to parse.
+    //------------------------------------------------------------------
+
+    const size_t f_CHUNKS_PER_THREAD = 4;
+
+    const unsigned int f_NUMBER_OF_EQUATIONS_NOT_SET = UINT_MAX;
+}
+
+//======================================================================
+//  Constructor: ParallelEquationParser::ParallelEquationParser
+//
+//  Input:
+//
+//    number_of_threads     The number of threads used for parsing.
+//                          If this is zero then one thread per
+//                          hardware thread is used.
+//
+//======================================================================
+
+ParallelEquationParser::ParallelEquationParser(unsigned int number_of_threads)
+  : m_number_of_threads(number_of_threads),
+    m_error_line(0),
+    m_error_position(0)
+{
+    if (m_number_of_threads == 0)
+    {
+        m_number_of_threads = std::thread::hardware_concurrency();
+    }
+
+    if (m_number_of_threads == 0)
+    {
+        m_number_of_threads = 1;
+    }
+}
+
+//======================================================================
+//  Destructor: ParallelEquationParser::~ParallelEquationParser
+//======================================================================
+
+ParallelEquationParser::~ParallelEquationParser()
+{
+}
+
+//======================================================================
+//  Member Function: ParallelEquationParser::Parse
+//
+//  Abstract:
+//
+//    This function parses every line in a block of characters,
+//    followed by the blank line that terminates the final equation.
+//    The results are the same as passing each line, and then a blank
+//    line, to the LinearEquationParser::Parse method.
+//
+//
+//  Input:
+//
+//    data_ptr                 A pointer to the characters to parse.
+//                             The characters do not have to be null
+//                             terminated.
+//
+//    data_size                The number of characters to parse.
+//
+//    builder                  The builder that receives the terms of
+//                             the equations, in the same order as
+//                             when the lines are parsed one at a time.
+//
+//    variable_name_index_map  A symbol table that stores the integer
+//                             index for a variable using the variable
+//                             name string as a key.
+//
+//    number_of_equations      A reference to an unsigned integer that
+//                             is used to return the number of
+//                             equations.
+//
+//
+//  Output:
+//
+//    This function returns a value of type 'Status_T' that is the
+//    status of the first line that failed to parse, or the value
+//    SUCCESS. If an error occurs then the line and the column of the
+//    error are returned by the GetErrorLine() and GetErrorPosition()
+//    methods.
+//
+//======================================================================
+
+LinearEquationParser::Status_T ParallelEquationParser::Parse(
+                                   const char * data_ptr,
+                                   size_t data_size,
+                                   LinearSystemBuilder & builder,
+                                   LinearEquationParser::VariableNameIndexMap & variable_name_index_map,
+                                   unsigned int & number_of_equations)
+{
+    m_error_line = 0;
+    m_error_position = 0;
+
+    SplitInput(data_ptr, data_size);
+
+    //------------------------------------------------------------------
+    //  Parse the chunks on the worker threads. Each thread takes the
+    //  next unparsed chunk until there are no chunks left.
+    //------------------------------------------------------------------
+
+    std::atomic<size_t> next_chunk_index(0);
+    std::vector<Chunk_T> & chunk_vector = m_chunk_vector;
+
+    unsigned int number_of_threads = m_number_of_threads;
+
+    if (number_of_threads > chunk_vector.size())
+    {
+        number_of_threads = (unsigned int)(chunk_vector.size());
+    }
+
+    std::vector<std::thread> thread_vector;
+
+    for (unsigned int t = 0; t < number_of_threads; ++t)
+    {
+        thread_vector.push_back(std::thread([&next_chunk_index, &chunk_vector]()
+        {
+            size_t chunk_index;
+
+            while ((chunk_index = next_chunk_index++) < chunk_vector.size())
+            {
+                Chunk_T & chunk = chunk_vector[chunk_index];
+                ParseChunkLines(chunk, chunk.m_start_ptr, chunk.m_end_ptr);
+            }
+        }));
+    }
+
+    for (size_t t = 0; t < thread_vector.size(); ++t)
+    {
+        thread_vector[t].join();
+    }
+
+    //------------------------------------------------------------------
+    //  If a chunk ended in the middle of an equation then the next
+    //  chunk was parsed with the wrong starting state. Parse that
+    //  chunk again as a continuation of the previous chunk.
+    //------------------------------------------------------------------
+
+    size_t previous_index = 0;
+    size_t chunk_index = 0;
+
+    for (chunk_index = 1; chunk_index < chunk_vector.size(); ++chunk_index)
+    {
+        Chunk_T & previous_chunk = chunk_vector[previous_index];
+
+        if (previous_chunk.m_status != LinearEquationParser::SUCCESS)
+        {
+            break;
+        }
+
+        if (previous_chunk.m_parser.IsAtEquationBoundary())
+        {
+            previous_index = chunk_index;
+        }
+        else
+        {
+            Chunk_T & chunk = chunk_vector[chunk_index];
+
+            ParseChunkLines(previous_chunk, chunk.m_start_ptr, chunk.m_end_ptr);
+
+            chunk.m_absorbed_flag = true;
+        }
+    }
+
+    //------------------------------------------------------------------
+    //  Merge the chunks in order.
+    //------------------------------------------------------------------
+
+    std::vector<int> variable_index_map;
+    int equation_offset = 0;
+    int right_hand_side_offset = 0;
+    int last_equation_offset = 0;
+    int line_offset = 0;
+    Chunk_T * last_chunk_ptr = 0;
+
+    for (chunk_index = 0; chunk_index < chunk_vector.size(); ++chunk_index)
+    {
+        Chunk_T & chunk = chunk_vector[chunk_index];
+
+        if (chunk.m_absorbed_flag)
+        {
+            continue;
+        }
+
+        //--------------------------------------------------------------
+        //  Renumber the chunk's variables. New variables are given
+        //  the next global index in the order they occur in the chunk.
+        //--------------------------------------------------------------
+
+        unsigned int number_of_local_variables = chunk.m_symbol_table.GetSize();
+
+        variable_index_map.resize(number_of_local_variables);
+
+        for (unsigned int i = 0; i < number_of_local_variables; ++i)
+        {
+            variable_index_map[i] =
+                variable_name_index_map.FindOrInsert(chunk.m_symbol_table.GetName((int)(i)));
+        }
+
+        chunk.m_builder.Replay(builder,
+                               equation_offset,
+                               right_hand_side_offset,
+                               variable_index_map);
+
+        if (chunk.m_number_of_equations_set_flag)
+        {
+            number_of_equations = equation_offset + chunk.m_number_of_equations;
+        }
+
+        if (chunk.m_status != LinearEquationParser::SUCCESS)
+        {
+            m_error_line = line_offset + chunk.m_error_line;
+            m_error_position = chunk.m_parser.GetErrorPosition();
+            return chunk.m_status;
+        }
+
+        last_equation_offset = equation_offset;
+        equation_offset += chunk.m_parser.GetEquationIndex();
+        right_hand_side_offset += chunk.m_parser.GetNumberOfRightHandSides();
+        line_offset += chunk.m_number_of_lines;
+        last_chunk_ptr = &chunk;
+    }
+
+    //------------------------------------------------------------------
+    //  Send a blank line to the parser that holds the state at the end
+    //  of the input to terminate the final equation.
+    //------------------------------------------------------------------
+
+    LinearEquationParser final_parser;
+    LinearEquationParser * parser_ptr = &final_parser;
+
+    if (last_chunk_ptr != 0)
+    {
+        parser_ptr = &(last_chunk_ptr->m_parser);
+    }
+
+    TripletBuilder final_builder;
+    VariableSymbolTable final_symbol_table;
+    unsigned int final_number_of_equations = f_NUMBER_OF_EQUATIONS_NOT_SET;
+
+    LinearEquationParser::Status_T status = parser_ptr->Parse(CharSpan("\n", 1),
+                                                              final_builder,
+                                                              final_symbol_table,
+                                                              final_number_of_equations);
+
+    if (final_number_of_equations != f_NUMBER_OF_EQUATIONS_NOT_SET)
+    {
+        number_of_equations = last_equation_offset + final_number_of_equations;
+    }
+
+    if (status != LinearEquationParser::SUCCESS)
+    {
+        m_error_line = line_offset;
+        m_error_position = parser_ptr->GetErrorPosition();
+    }
+
+    return status;
+}
+
+//======================================================================
+//  Member Function: ParallelEquationParser::GetErrorLine
+//
+//  Abstract:
+//
+//    This function returns the one-based line number where the last
+//    error occurred.
+//
+//======================================================================
+
+int ParallelEquationParser::GetErrorLine() const
+{
+    return m_error_line;
+}
+
+//======================================================================
+//  Member Function: ParallelEquationParser::GetErrorPosition
+//
+//  Abstract:
+//
+//    This function returns the position in the line where the last
+//    error occurred.
+//
+//======================================================================
+
+int ParallelEquationParser::GetErrorPosition() const
+{
+    return m_error_position;
+}
+
+//======================================================================
+//  Member Function: ParallelEquationParser::GetNumberOfChunks
+//======================================================================
+
+unsigned int ParallelEquationParser::GetNumberOfChunks() const
+{
+    return (unsigned int)(m_chunk_vector.size());
+}
+
+//======================================================================
+//  Member Function: ParallelEquationParser::SplitInput
+//
+//  Abstract:
+//
+//    This function splits the input into chunks. Each chunk except
+//    the last ends just after a line that ends an equation.
+//
+//
+//  Input:
+//
+//    data_ptr          A pointer to the characters to parse.
+//
+//    data_size         The number of characters to parse.
+//
+//  Output:
+//
+//    This function has no return value.
+//
+//======================================================================
+
+void ParallelEquationParser::SplitInput(const char * data_ptr,
+                                        size_t data_size)
+{
+    size_t target_chunk_size = data_size / (m_number_of_threads * f_CHUNKS_PER_THREAD);
+
+    if (target_chunk_size < f_MINIMUM_CHUNK_SIZE)
+    {
+        target_chunk_size = f_MINIMUM_CHUNK_SIZE;
+    }
+
+    std::vector<const char *> chunk_start_vector;
+    const char * end_ptr = data_ptr + data_size;
+    const char * start_ptr = data_ptr;
+
+    while (start_ptr < end_ptr)
+    {
+        chunk_start_vector.push_back(start_ptr);
+
+        //--------------------------------------------------------------
+        //  Skip ahead by the target size and then move forward to the
+        //  start of a line.
+        //--------------------------------------------------------------
+
+        const char * line_ptr = end_ptr;
+
+        if ((size_t)(end_ptr - start_ptr) > target_chunk_size)
+        {
+            line_ptr = start_ptr + target_chunk_size;
+
+            const char * newline_ptr = (const char *)(memchr(line_ptr,
+                                                             '\n',
+                                                             end_ptr - line_ptr));
+
+            line_ptr = (newline_ptr != 0) ? newline_ptr + 1 : end_ptr;
+        }
+
+        //--------------------------------------------------------------
+        //  End the chunk after the next line that ends an equation.
+        //--------------------------------------------------------------
+
+        CharSpan input_line_span;
+
+        while (GetNextInputLine(line_ptr, end_ptr, input_line_span))
+        {
+            if (IsEquationTerminatorLine(input_line_span))
+            {
+                break;
+            }
+        }
+
+        start_ptr = line_ptr;
+    }
+
+    m_chunk_vector.clear();
+    m_chunk_vector.resize(chunk_start_vector.size());
+
+    for (size_t i = 0; i < chunk_start_vector.size(); ++i)
+    {
+        Chunk_T & chunk = m_chunk_vector[i];
+
+        chunk.m_start_ptr = chunk_start_vector[i];
+        chunk.m_end_ptr = (i + 1 < chunk_start_vector.size()) ? chunk_start_vector[i + 1] : end_ptr;
+        chunk.m_status = LinearEquationParser::SUCCESS;
+        chunk.m_number_of_lines = 0;
+        chunk.m_error_line = 0;
+        chunk.m_number_of_equations = 0;
+        chunk.m_number_of_equations_set_flag = false;
+        chunk.m_absorbed_flag = false;
+    }
+
+    return;
+}
+
+//======================================================================
+//  Member Function: ParallelEquationParser::ParseChunkLines
+//
+//  Abstract:
+//
+//    This function parses lines using the parser, the builder, and
+//    the symbol table of a chunk. Parsing stops at the first error.
+//
+//
+//  Input:
+//
+//    chunk             The chunk that holds the parser state.
+//
+//    start_ptr         A pointer to the first line to parse.
+//
+//    end_ptr           A pointer just past the last line to parse.
+//
+//  Output:
+//
+//    This function has no return value.
+//
+//======================================================================
+
+void ParallelEquationParser::ParseChunkLines(Chunk_T & chunk,
+                                             const char * start_ptr,
+                                             const char * end_ptr)
+{
+    CharSpan input_line_span;
+
+    while ((chunk.m_status == LinearEquationParser::SUCCESS)
+           && GetNextInputLine(start_ptr, end_ptr, input_line_span))
+    {
+        ++chunk.m_number_of_lines;
+
+        unsigned int number_of_equations = f_NUMBER_OF_EQUATIONS_NOT_SET;
+
+        chunk.m_status = chunk.m_parser.Parse(input_line_span,
+                                              chunk.m_builder,
+                                              chunk.m_symbol_table,
+                                              number_of_equations);
+
+        if (number_of_equations != f_NUMBER_OF_EQUATIONS_NOT_SET)
+        {
+            chunk.m_number_of_equations = number_of_equations;
+            chunk.m_number_of_equations_set_flag = true;
+        }
+
+        if (chunk.m_status != LinearEquationParser::SUCCESS)
+        {
+            chunk.m_error_line = chunk.m_number_of_lines;
+        }
+    }
+
+    return;
+}
+
+//======================================================================
+//  Member Function: ParallelEquationParser::IsEquationTerminatorLine
+//
+//  Abstract:
+//
+//    This function returns true if a line, with any comment already
+//    removed, is blank or ends with a semicolon.
+//
+//======================================================================
+
+bool ParallelEquationParser::IsEquationTerminatorLine(const CharSpan & input_line_span)
+{
+    int position = (int)(input_line_span.Length()) - 1;
+
+    while ((position >= 0) && (iswspace((int)(input_line_span[position])) != 0))
+    {
+        --position;
+    }
+
+    return (position < 0) || (input_line_span[position] == ';');
+}
@@ -0,0 +1,86 @@
+#ifndef PARALLELEQUATIONPARSER_H
+#define PARALLELEQUATIONPARSER_H
+
+#include <stddef.h>
+#include <vector>
+#include "LinearEquationParser.h"
+#include "LinearSystemBuilder.h"
+#include "VariableSymbolTable.h"
+
+//======================================================================
+//  Class Definition
+//
+//  This class parses a whole block of equations, such as a
+//  memory-mapped file, using several threads.
+//
+//  The input is split into chunks at lines that end an equation,
+//  which are blank lines and lines whose last character before any
+//  comment is a semicolon. Each chunk is parsed by its own
+//  LinearEquationParser into a thread-local TripletBuilder and a
+//  local symbol table. The chunks are then merged in order. The
+//  variables are renumbered in the order they first occur and the
+//  equations and the extra right-hand sides are offset by the number
+//  of each in the previous chunks, so the A matrix, the B vector, the
+//  symbol table and the number of equations are exactly the same as
+//  when the lines are parsed one at a time by a single parser.
+//
+//  A blank line does not always end an equation. If a chunk ends in
+//  the middle of an equation then the following chunk is parsed
+//  again, continuing with the parser state of the previous chunk.
+//======================================================================
+
+class ParallelEquationParser
+{
+public:
+
+    ParallelEquationParser(unsigned int number_of_threads);
+
+    virtual ~ParallelEquationParser();
+
+    LinearEquationParser::Status_T Parse(const char * data_ptr,
+                                         size_t data_size,
+                                         LinearSystemBuilder & builder,
+                                         LinearEquationParser::VariableNameIndexMap & variable_name_index_map,
+                                         unsigned int & number_of_equations);
+
+    int GetErrorLine() const;
+
+    int GetErrorPosition() const;
+
+    unsigned int GetNumberOfChunks() const;
+
+protected:
+
+    struct Chunk_T
+    {
+        const char * m_start_ptr;
+        const char * m_end_ptr;
+        LinearEquationParser m_parser;
+        TripletBuilder m_builder;
+        VariableSymbolTable m_symbol_table;
+        LinearEquationParser::Status_T m_status;
+        int m_number_of_lines;
+        int m_error_line;
+        unsigned int m_number_of_equations;
+        bool m_number_of_equations_set_flag;
+        bool m_absorbed_flag;
+    };
+
+    void SplitInput(const char * data_ptr,
+                    size_t data_size);
+
+    static void ParseChunkLines(Chunk_T & chunk,
+                                const char * start_ptr,
+                                const char * end_ptr);
+
+    static bool IsEquationTerminatorLine(const CharSpan & input_line_span);
+
+protected:
+
+    unsigned int m_number_of_threads;
+    std::vector<Chunk_T> m_chunk_vector;
+    int m_error_line;
+    int m_error_position;
+};
+
+#endif
@@ -1,14 +1,40 @@
 #include <iostream>
 #include <fstream>
+#include <chrono>
 #include <map>
+#include <vector>
+#include <string.h>
+#include <stdlib.h>
 #include "MatrixPackage.h"
 #include "CharString.h"
+#include "CharSpan.h"
+#include "MappedFile.h"
 #include "LinearEquationParser.h"
+#include "LinearSystemBuilder.h"
+#include "CompressedSparseMatrix.h"
+#include "FrozenSparseMatrix.h"
+#include "LinearSystemSolver.h"
+#include "ComponentSolver.h"
+#include "SubstitutionPresolve.h"
+#include "BatchSolver.h"
+#include "BatchSystemFile.h"
+#include "OutOfCoreSolver.h"
+#include "OutOfCoreSystemFile.h"
+#include "ParallelEquationParser.h"
+#include "SystemCacheFile.h"
+#include "FactorStructureFile.h"
 
 //======================================================================
 //  Function Prototypes.
 //======================================================================
 
+void SolveBatchFile(const CharString & input_file_name_string,
+                    bool solver_statistics_flag);
+
+void SolveOutOfCoreFile(const CharString & input_file_name_string,
+                        unsigned int memory_budget_megabytes,
+                        bool solver_statistics_flag);
+
 void DisplayHelp();
 
 #define MAXIMUM_INPUT_LINE_LENGTH (1024)
@@ -44,6 +70,18 @@ int main(int argc, char * argv[], char * envp[])
 
     CharString input_file_name_string;
     bool display_program_name_flag = true;
+    bool memory_mapped_input_flag = false;
+    bool parallel_parse_flag = false;
+    bool system_cache_flag = false;
+    bool factor_structure_flag = false;
+    bool solver_statistics_flag = false;
+    bool sparse_density_threshold_flag = false;
+    bool mixed_precision_flag = false;
+    bool batch_file_flag = false;
+    bool out_of_core_flag = false;
+    double sparse_density_threshold = 0.0;
+    unsigned int memory_budget_megabytes = 0;
+    unsigned int number_of_parser_threads = 0;
     unsigned int input_file_name_count = 0;
 
     for (int i = 1; i < argc; i++)
@@ -71,6 +109,115 @@ int main(int argc, char * argv[], char * envp[])
                 display_program_name_flag = false;
                 break;
 
+            //----------------------------------------------------------
+            //  Memory-map the input file and parse the lines in place.
+            //----------------------------------------------------------
+
+            case 'm':
+            case 'M':
+
+                memory_mapped_input_flag = true;
+                break;
+
+            //----------------------------------------------------------
+            //  Parse the memory-mapped input file using several
+            //  threads. The number of threads can follow the switch,
+            //  for example -p8.
+            //----------------------------------------------------------
+
+            case 'p':
+            case 'P':
+
+                memory_mapped_input_flag = true;
+                parallel_parse_flag = true;
+                number_of_parser_threads = (unsigned int)(atoi(&argv[i][2]));
+                break;
+
+            //----------------------------------------------------------
+            //  Read the parsed system from a cache file when the cache
+            //  file matches the input file, otherwise parse the input
+            //  file and write the cache file.
+            //----------------------------------------------------------
+
+            case 'c':
+            case 'C':
+
+                system_cache_flag = true;
+                break;
+
+            //----------------------------------------------------------
+            //  Reuse the factor structure of the sparse LU
+            //  factorization from a file when the equations have the
+            //  same variables and nonzero pattern, otherwise analyze
+            //  the equations and write the file.
+            //----------------------------------------------------------
+
+            case 's':
+            case 'S':
+
+                factor_structure_flag = true;
+                break;
+
+            //----------------------------------------------------------
+            //  Set the density of the A matrix below which the sparse
+            //  LU factorization is used, for example -d0.05. The
+            //  switch -d0 always uses dense elimination.
+            //----------------------------------------------------------
+
+            case 'd':
+            case 'D':
+
+                sparse_density_threshold_flag = true;
+                sparse_density_threshold = atof(&argv[i][2]);
+                break;
+
+            //----------------------------------------------------------
+            //  Do dense elimination in single precision and refine the
+            //  solution to double precision accuracy.
+            //----------------------------------------------------------
+
+            case 'r':
+            case 'R':
+
+                mixed_precision_flag = true;
+                break;
+
+            //----------------------------------------------------------
+            //  The input file is a batch file of many systems with the
+            //  same number of equations.
+            //----------------------------------------------------------
+
+            case 'b':
+            case 'B':
+
+                batch_file_flag = true;
+                break;
+
+            //----------------------------------------------------------
+            //  The input file holds one dense system, in the format of
+            //  a batch file, that is solved out of core. The memory
+            //  budget in megabytes can follow the switch, for example
+            //  -o1024.
+            //----------------------------------------------------------
+
+            case 'o':
+            case 'O':
+
+                out_of_core_flag = true;
+                memory_budget_megabytes = (unsigned int)(atoi(&argv[i][2]));
+                break;
+
+            //----------------------------------------------------------
+            //  Display the solution method, the fill-in and the number
+            //  of floating point operations.
+            //----------------------------------------------------------
+
+            case 'v':
+            case 'V':
+
+                solver_statistics_flag = true;
+                break;
+
             default:
 
                 std::cout << "Illegal switch " << std::endl << argv[i] << std::endl;
@@ -116,6 +263,26 @@ int main(int argc, char * argv[], char * envp[])
     {
         std::cout << "No input file specified." << std::endl;
     }      
+    else if (batch_file_flag)
+    {
+        if (input_file_name_string.Find('.') == -1)
+        {
+            input_file_name_string += ".txt";
+        }
+
+        SolveBatchFile(input_file_name_string, solver_statistics_flag);
+    }
+    else if (out_of_core_flag)
+    {
+        if (input_file_name_string.Find('.') == -1)
+        {
+            input_file_name_string += ".txt";
+        }
+
+        SolveOutOfCoreFile(input_file_name_string,
+                           memory_budget_megabytes,
+                           solver_statistics_flag);
+    }
     else
     {
         //--------------------------------------------------------------
@@ -133,29 +300,112 @@ int main(int argc, char * argv[], char * envp[])
         //--------------------------------------------------------------
 
         bool valid_system_of_equations_flag = true;
+        bool input_file_open_flag = false;
 
         std::ifstream input_file;
-        input_file.open(input_file_name_string.CString(), std::ios::in);
+        MappedFile mapped_input_file;
 
-        if (input_file.fail())
+        if (memory_mapped_input_flag)
         {
-            std::cout << "File " << input_file_name_string << " not found." << std::endl;
+            input_file_open_flag = mapped_input_file.Open(input_file_name_string.CString());
         }
         else
         {
-            //----------------------------------------------------------
-            //  Loop and read all lines from the input file.
-            //----------------------------------------------------------
+            input_file.open(input_file_name_string.CString(), std::ios::in);
+            input_file_open_flag = ! input_file.fail();
+        }
 
+        if (! input_file_open_flag)
+        {
+            std::cout << "File " << input_file_name_string << " not found." << std::endl;
+        }
+        else
+        {
             LinearEquationParser equation_parser;
             LinearEquationParser::Status_T parser_status = LinearEquationParser::SUCCESS;
-            MatrixPackage::SparseMatrix a_matrix;
+            TripletBuilder system_builder;
+            CompressedSparseMatrix a_csr_matrix;
+            FrozenSparseMatrix a_matrix;
             MatrixPackage::SparseVector b_vector;
+            CompressedSparseMatrix right_hand_side_matrix;
             LinearEquationParser::VariableNameIndexMap variable_name_index_map;
             unsigned int number_of_equations = 0;
             int file_line = 0;
 
-            while (!input_file.eof())
+            //----------------------------------------------------------
+            //  If a cache file was made from this exact input file then
+            //  load the parsed system from the cache file and do not
+            //  parse the input file.
+            //----------------------------------------------------------
+
+            SystemCacheFile::SourceStamp_T source_stamp;
+            bool source_stamp_valid_flag = false;
+            bool cache_loaded_flag = false;
+            CharString cache_file_name_string = input_file_name_string;
+            cache_file_name_string += ".cache";
+
+            if (system_cache_flag)
+            {
+                source_stamp_valid_flag =
+                    SystemCacheFile::GetSourceStamp(input_file_name_string.CString(), source_stamp);
+
+                cache_loaded_flag = source_stamp_valid_flag
+                    && SystemCacheFile::Read(cache_file_name_string.CString(),
+                                             source_stamp,
+                                             variable_name_index_map,
+                                             a_csr_matrix,
+                                             b_vector,
+                                             right_hand_side_matrix,
+                                             number_of_equations);
+            }
+
+            //----------------------------------------------------------
+            //  Loop over all lines in the memory-mapped file. Each
+            //  line is passed to the parser as a view into the mapped
+            //  file, so no line is copied and there is no limit on the
+            //  length of a line.
+            //----------------------------------------------------------
+
+            const char * input_data_ptr = mapped_input_file.GetData();
+            const char * input_end_ptr = input_data_ptr + mapped_input_file.GetSize();
+
+            CharSpan input_line_span;
+
+            while (memory_mapped_input_flag
+                   && (! parallel_parse_flag)
+                   && (! cache_loaded_flag)
+                   && GetNextInputLine(input_data_ptr, input_end_ptr, input_line_span))
+            {
+                ++file_line;
+
+                //------------------------------------------------------
+                //  Parse the line.
+                //------------------------------------------------------
+
+                parser_status =
+                    equation_parser.Parse(input_line_span,
+                                          system_builder,
+                                          variable_name_index_map,
+                                          number_of_equations);
+
+                valid_system_of_equations_flag =
+                    parser_status == LinearEquationParser::SUCCESS;
+
+                if (! valid_system_of_equations_flag)
+                {
+                    ReportParserError(input_file_name_string,
+                                      file_line,
+                                      equation_parser.GetErrorPosition(),
+                                      equation_parser.GetStatusString(parser_status));
+                    break;
+                }
+            }
+
+            //----------------------------------------------------------
+            //  Loop and read all lines from the input file.
+            //----------------------------------------------------------
+
+            while ((! memory_mapped_input_flag) && (! cache_loaded_flag) && (!input_file.eof()))
             {
                 //------------------------------------------------------
                 //  Read a line from the input file.
@@ -168,6 +418,23 @@ int main(int argc, char * argv[], char * envp[])
                                    maximum_line_length);
                 ++file_line;
 
+                //------------------------------------------------------
+                //  The fail bit without the end of file means that the
+                //  line did not fit in the array. Nothing more can be
+                //  read from the stream, so report the error and stop.
+                //------------------------------------------------------
+
+                if (input_file.fail() && (! input_file.eof()))
+                {
+                    valid_system_of_equations_flag = false;
+
+                    ReportParserError(input_file_name_string,
+                                      file_line,
+                                      maximum_line_length - 1,
+                                      "The line is too long. Use the -m switch to read longer lines.");
+                    break;
+                }
+
                 CharString input_line_string = input_data_array;
 
                 //------------------------------------------------------
@@ -190,8 +457,7 @@ int main(int argc, char * argv[], char * envp[])
 
                 parser_status =
                     equation_parser.Parse(input_line_string,
-                                          a_matrix,
-                                          b_vector,
+                                          system_builder,
                                           variable_name_index_map,
                                           number_of_equations);
 
@@ -213,47 +479,109 @@ int main(int argc, char * argv[], char * envp[])
             }
 
             //----------------------------------------------------------
-            //  Close the input file.
+            //  Parse all lines of the memory-mapped file, including the
+            //  blank line that terminates the final equation, using
+            //  several threads.
+            //----------------------------------------------------------
+
+            if (parallel_parse_flag && (! cache_loaded_flag))
+            {
+                ParallelEquationParser parallel_parser(number_of_parser_threads);
+
+                parser_status = parallel_parser.Parse(mapped_input_file.GetData(),
+                                                      mapped_input_file.GetSize(),
+                                                      system_builder,
+                                                      variable_name_index_map,
+                                                      number_of_equations);
+
+                valid_system_of_equations_flag =
+                    parser_status == LinearEquationParser::SUCCESS;
+
+                if (! valid_system_of_equations_flag)
+                {
+                    ReportParserError(input_file_name_string,
+                                      parallel_parser.GetErrorLine(),
+                                      parallel_parser.GetErrorPosition(),
+                                      equation_parser.GetStatusString(parser_status));
+                }
+            }
+
+            if (memory_mapped_input_flag)
+            {
+                mapped_input_file.Close();
+            }
+            else
+            {
+                input_file.close();
+            }
+
+            //----------------------------------------------------------
+            //  Sum the terms into a compressed sparse row matrix with
+            //  one sort-and-sum pass, then freeze the matrix so that
+            //  the rows and the columns can be read without searching.
+            //  A system that was loaded from the cache file is already
+            //  assembled.
             //----------------------------------------------------------
 
-            input_file.close();
+            if (valid_system_of_equations_flag)
+            {
+                if (! cache_loaded_flag)
+                {
+                    system_builder.Assemble((int)(number_of_equations),
+                                            (int)(variable_name_index_map.GetSize()),
+                                            a_csr_matrix);
+
+                    system_builder.AssembleBVector(b_vector);
+                    system_builder.AssembleRightHandSides(right_hand_side_matrix);
+                    system_builder.Clear();
+                }
+
+                a_matrix.Freeze(a_csr_matrix);
+            }
 
 #ifdef DUMP_A_MATRIX_AND_B_VECTOR
             //----------------------------------------------------------
-            //  Dump the a_matrix and the b_vector.
+            //  Dump the stored elements of the a_matrix and the
+            //  b_vector.
             //----------------------------------------------------------
 
             int i = 0;
-            for (i = 0; i < (int)(number_of_equations); ++i)
+            for (i = 0; i < a_matrix.GetNumberOfRows(); ++i)
             {
-                int j = 0;
-                for (j = 0; j < (int)(number_of_equations); ++j)
+                SparseSlice row_slice = a_matrix.GetRow(i);
+
+                for (SparseSlice::Iterator row_iter = row_slice.begin(); row_iter != row_slice.end(); ++row_iter)
                 {
-                    double value = a_matrix[DoubleIndex(i, j)];
-                    std::cout << "a_matrix[" << i << ", " << j << "] = " << value << std::endl;
+                    std::cout << "a_matrix[" << i << ", " << row_iter.GetIndex() << "] = "
+                        << row_iter.GetValue() << std::endl;
                 }
             }
 
-            for (i = 0; i < (int)(number_of_equations); ++i)
+            for (MatrixPackage::SparseVector::const_iterator b_iter = b_vector.begin();
+                 b_iter != b_vector.end();
+                 ++b_iter)
             {
-                double value = b_vector[i];
-                std::cout << "b_vector[" << i << "] = " << value << std::endl;
+                std::cout << "b_vector[" << (*b_iter).first << "] = " << (*b_iter).second << std::endl;
             }
 #endif
             //----------------------------------------------------------
             //  Send a blank line to the parser to terminate the final
             //  equation and update the variable 'number_of_equations'.
+            //  The parallel parser has already done this, and a system
+            //  that was loaded from the cache file is complete.
             //----------------------------------------------------------
 
             if (valid_system_of_equations_flag)
             {
-                CharString carriage_return_string = "\n";
+                if ((! parallel_parse_flag) && (! cache_loaded_flag))
+                {
+                    CharString carriage_return_string = "\n";
 
-                parser_status = equation_parser.Parse(carriage_return_string,
-                                                       a_matrix,
-                                                       b_vector,
-                                                       variable_name_index_map,
-                                                       number_of_equations);
+                    parser_status = equation_parser.Parse(carriage_return_string,
+                                                           system_builder,
+                                                           variable_name_index_map,
+                                                           number_of_equations);
+                }
 
                 //------------------------------------------------------
                 //  If a parser error occurs then report the error.
@@ -264,14 +592,61 @@ int main(int argc, char * argv[], char * envp[])
 
                 if (valid_system_of_equations_flag)
                 {
+                    //--------------------------------------------------
+                    //  Save the parsed system so that later runs do not
+                    //  have to parse the input file.
+                    //--------------------------------------------------
+
+                    if (source_stamp_valid_flag && (! cache_loaded_flag))
+                    {
+                        if (! SystemCacheFile::Write(cache_file_name_string.CString(),
+                                                     source_stamp,
+                                                     variable_name_index_map,
+                                                     a_matrix.GetRowMatrix(),
+                                                     b_vector,
+                                                     right_hand_side_matrix,
+                                                     number_of_equations))
+                        {
+                            std::cout << "Unable to write the cache file "
+                                << cache_file_name_string << "." << std::endl;
+                        }
+                    }
+
                     //--------------------------------------------------
                     //  Test to make sure there are the same number of
                     //  equations as the number of variables.
                     //--------------------------------------------------
 
-                    unsigned int number_of_variables = variable_name_index_map.size();
+                    unsigned int number_of_variables = variable_name_index_map.GetSize();
+
+                    //--------------------------------------------------
+                    //  Each extra right-hand side must have one value
+                    //  for each equation.
+                    //--------------------------------------------------
 
-                    if (number_of_variables > number_of_equations)
+                    int number_of_right_hand_sides = 1 + right_hand_side_matrix.GetNumberOfRows();
+                    int bad_right_hand_side = 0;
+                    size_t bad_right_hand_side_length = 0;
+
+                    for (int r = 1; (r < number_of_right_hand_sides) && (bad_right_hand_side == 0); ++r)
+                    {
+                        const size_t * row_start_array = right_hand_side_matrix.GetRowStartArray();
+                        size_t row_length = row_start_array[r] - row_start_array[r - 1];
+
+                        if (row_length != number_of_equations)
+                        {
+                            bad_right_hand_side = r + 1;
+                            bad_right_hand_side_length = row_length;
+                        }
+                    }
+
+                    if (bad_right_hand_side != 0)
+                    {
+                        std::cout << "Right-hand side " << bad_right_hand_side
+                            << " has " << bad_right_hand_side_length << " values and there are "
+                            << number_of_equations << " equations." << std::endl;
+                    }
+                    else if (number_of_variables > number_of_equations)
                     {
                         std::cout << "There are " << number_of_variables
                             << " variables and only " << number_of_equations << " equations." << std::endl;
@@ -283,31 +658,369 @@ int main(int argc, char * argv[], char * envp[])
                     }
                     else
                     {
-                        MatrixPackage::SparseVector x_vector;
+                        std::vector<double> x_vectors;
+                        LinearSystemSolver system_solver;
+                        ComponentSolver component_solver(0);
+
+                        if (sparse_density_threshold_flag)
+                        {
+                            system_solver.SetSparseDensityThreshold(sparse_density_threshold);
+                            component_solver.SetSparseDensityThreshold(sparse_density_threshold);
+                        }
+
+                        system_solver.SetMixedPrecision(mixed_precision_flag);
+                        component_solver.SetMixedPrecision(mixed_precision_flag);
+
+                        //----------------------------------------------
+                        //  A saved factor structure is for the whole
+                        //  system, so the system is not put in block
+                        //  triangular form when the -s switch is used.
+                        //----------------------------------------------
+
+                        system_solver.SetBlockTriangularForm(! factor_structure_flag);
+
+                        //----------------------------------------------
+                        //  Make the B vector and every extra right-hand
+                        //  side.
+                        //----------------------------------------------
+
+                        std::vector<double> b_vectors(number_of_equations * number_of_right_hand_sides, 0.0);
+
+                        for (MatrixPackage::SparseVector::const_iterator b_iter = b_vector.begin();
+                             b_iter != b_vector.end();
+                             ++b_iter)
+                        {
+                            if ((*b_iter).first < (int)(number_of_equations))
+                            {
+                                b_vectors[(*b_iter).first] = (*b_iter).second;
+                            }
+                        }
+
+                        const size_t * row_start_array = right_hand_side_matrix.GetRowStartArray();
+                        const int * column_index_array = right_hand_side_matrix.GetColumnIndexArray();
+                        const double * value_array = right_hand_side_matrix.GetValueArray();
+
+                        for (int r = 1; r < number_of_right_hand_sides; ++r)
+                        {
+                            for (size_t q = row_start_array[r - 1]; q < row_start_array[r]; ++q)
+                            {
+                                b_vectors[number_of_equations * r + column_index_array[q]] = value_array[q];
+                            }
+                        }
 
-                        MatrixPackage::Status_T system_status =
-                            MatrixPackage::SolveLinearEquations(number_of_equations,
-                                                                 a_matrix,
-                                                                 b_vector,
-                                                                 x_vector);
+                        //----------------------------------------------
+                        //  Eliminate the variables of the equations
+                        //  with one or two variables. The rest of the
+                        //  equations are the system that is solved.
+                        //  A saved factor structure is for the whole
+                        //  system, so the equations are not reduced
+                        //  when the -s switch is used.
+                        //----------------------------------------------
 
-                        if (system_status == MatrixPackage::SUCCESS)
+                        SubstitutionPresolve presolve;
+                        int number_of_eliminated_variables = 0;
+
+                        if (! factor_structure_flag)
+                        {
+                            number_of_eliminated_variables = presolve.Reduce(number_of_equations,
+                                                                             a_matrix,
+                                                                             b_vectors,
+                                                                             number_of_right_hand_sides);
+                        }
+
+                        bool reduced_flag = number_of_eliminated_variables > 0;
+                        unsigned int system_number_of_equations =
+                            reduced_flag ? presolve.GetReducedNumberOfEquations() : number_of_equations;
+                        const FrozenSparseMatrix & system_matrix =
+                            reduced_flag ? presolve.GetReducedMatrix() : a_matrix;
+                        const std::vector<double> & system_b_vectors =
+                            reduced_flag ? presolve.GetReducedRightHandSides() : b_vectors;
+
+                        //----------------------------------------------
+                        //  Find the independent systems of equations,
+                        //  which share no variables. A saved factor
+                        //  structure is for the whole system, so the
+                        //  system is not split when the -s switch is
+                        //  used.
+                        //----------------------------------------------
+
+                        int number_of_components = 1;
+
+                        if (! factor_structure_flag)
+                        {
+                            number_of_components = component_solver.FindComponents(system_number_of_equations, system_matrix);
+                        }
+
+                        LinearSystemSolver::Status_T system_status = LinearSystemSolver::SUCCESS;
+                        double factor_seconds = 0.0;
+
+                        if (system_number_of_equations == 0)
                         {
                             //------------------------------------------
-                            //  Display the solution of the equations.
+                            //  Every variable was eliminated.
                             //------------------------------------------
 
-                            for (LinearEquationParser::VariableNameIndexMap::iterator it =
-                                 variable_name_index_map.begin();
-                                 it != variable_name_index_map.end();
-                                 ++it)
+                            x_vectors.clear();
+                        }
+                        else if (number_of_components > 1)
+                        {
+                            //------------------------------------------
+                            //  Solve the independent systems in
+                            //  parallel.
+                            //------------------------------------------
+
+                            system_status = component_solver.Solve(system_matrix,
+                                                                   system_b_vectors,
+                                                                   number_of_right_hand_sides,
+                                                                   x_vectors);
+                        }
+                        else
+                        {
+                            //------------------------------------------
+                            //  Load a saved factor structure for
+                            //  equations with the same variables and
+                            //  nonzero pattern.
+                            //------------------------------------------
+
+                            uint64_t pattern_key = 0;
+                            CharString structure_file_name_string = input_file_name_string;
+                            structure_file_name_string += ".lu";
+
+                            if (factor_structure_flag)
+                            {
+                                pattern_key = FactorStructureFile::GetPatternKey(a_matrix,
+                                                                                 number_of_equations,
+                                                                                 variable_name_index_map);
+
+                                SparseLU::Structure_T factor_structure;
+
+                                if (FactorStructureFile::Read(structure_file_name_string.CString(),
+                                                              pattern_key,
+                                                              factor_structure))
+                                {
+                                    system_solver.SetFactorStructure(pattern_key, factor_structure);
+                                }
+                            }
+
+                            std::chrono::steady_clock::time_point factor_start_time = std::chrono::steady_clock::now();
+
+                            system_solver.Analyze(system_number_of_equations, system_matrix, pattern_key);
+
+                            system_status = system_solver.Factor(system_matrix);
+
+                            factor_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now()
+                                                                           - factor_start_time).count();
+
+                            if (system_status == LinearSystemSolver::SUCCESS)
                             {
-                                std::cout << (*it).first << " = " << x_vector[(*it).second] << std::endl;
+                                //--------------------------------------
+                                //  Solve for every right-hand side with
+                                //  one factorization.
+                                //--------------------------------------
+
+                                if (mixed_precision_flag)
+                                {
+                                    system_status = system_solver.SolveWithRefinement(system_matrix,
+                                                                                      system_b_vectors,
+                                                                                      number_of_right_hand_sides,
+                                                                                      x_vectors);
+                                }
+                                else
+                                {
+                                    system_solver.Solve(system_b_vectors, number_of_right_hand_sides, x_vectors);
+                                }
+
+                                //--------------------------------------
+                                //  Save a new or changed factor
+                                //  structure. Only the sparse LU
+                                //  factorization has a factor
+                                //  structure.
+                                //--------------------------------------
+
+                                if (factor_structure_flag
+                                    && (system_solver.GetMethod() != LinearSystemSolver::SPARSE_LU))
+                                {
+                                    std::cout << "The factor structure was not saved. "
+                                        << LinearSystemSolver::GetMethodString(system_solver.GetMethod())
+                                        << " has no factor structure." << std::endl;
+                                }
+                                else if (factor_structure_flag
+                                         && (! system_solver.WasFactorStructureReused()))
+                                {
+                                    if (! FactorStructureFile::Write(structure_file_name_string.CString(),
+                                                                     pattern_key,
+                                                                     system_solver.GetFactorStructure()))
+                                    {
+                                        std::cout << "Unable to write the factor structure file "
+                                            << structure_file_name_string << "." << std::endl;
+                                    }
+                                }
+                            }
+                        }
+
+                        if (solver_statistics_flag && reduced_flag)
+                        {
+                            std::cout << "Presolve eliminated " << number_of_eliminated_variables
+                                << " variables with " << presolve.GetNumberOfSingletons()
+                                << " equations of one variable and " << presolve.GetNumberOfSubstitutions()
+                                << " equations of two variables. The reduced system has "
+                                << system_number_of_equations << " equations." << std::endl;
+                        }
+
+                        if (solver_statistics_flag && (number_of_components > 1))
+                        {
+                            std::cout << "The equations were split into " << number_of_components
+                                << " independent systems. The largest system has "
+                                << component_solver.GetLargestComponentSize() << " equations." << std::endl;
+                            std::cout << "Nonzeros in A = " << component_solver.GetNumberOfMatrixNonzeros()
+                                << ", L = " << component_solver.GetNumberOfLowerNonzeros()
+                                << ", U = " << component_solver.GetNumberOfUpperNonzeros()
+                                << ", fill-in = " << component_solver.GetFillIn() << std::endl;
+                            std::cout << "Floating point operations = "
+                                << component_solver.GetFlopCount() << std::endl;
+
+                            if (mixed_precision_flag)
+                            {
+                                std::cout << "Refinement iterations = "
+                                    << component_solver.GetRefinementIterations()
+                                    << ", backward error = "
+                                    << component_solver.GetBackwardError() << std::endl;
+
+                                if (component_solver.WasDoublePrecisionFallback())
+                                {
+                                    std::cout << "Some of the systems were factored again in double precision."
+                                        << std::endl;
+                                }
+                            }
+                        }
+                        else if (solver_statistics_flag && (system_number_of_equations > 0))
+                        {
+                            std::cout << LinearSystemSolver::GetMethodString(system_solver.GetMethod())
+                                << std::endl;
+                            std::cout << "Nonzeros in A = " << system_solver.GetNumberOfMatrixNonzeros()
+                                << ", L = " << system_solver.GetNumberOfLowerNonzeros()
+                                << ", U = " << system_solver.GetNumberOfUpperNonzeros()
+                                << ", fill-in = " << system_solver.GetFillIn() << std::endl;
+                            std::cout << "Floating point operations = "
+                                << system_solver.GetFlopCount() << std::endl;
+
+                            if (system_solver.WasFactorStructureReused())
+                            {
+                                std::cout << "The factor structure was reused." << std::endl;
+                            }
+
+                            //------------------------------------------
+                            //  For the block triangular form, display
+                            //  the number of blocks and the fill-in of
+                            //  their factors for each range of block
+                            //  sizes. Range r holds the blocks with
+                            //  2^r up to 2^(r + 1) - 1 equations.
+                            //------------------------------------------
+
+                            if (system_solver.GetMethod() == LinearSystemSolver::BLOCK_TRIANGULAR)
+                            {
+                                std::cout << "Diagonal blocks = " << system_solver.GetNumberOfBlocks()
+                                    << ", largest block = " << system_solver.GetLargestBlockSize()
+                                    << ", blocks of one equation = " << system_solver.GetNumberOfSingletonBlocks()
+                                    << ", off-diagonal nonzeros = " << system_solver.GetNumberOfOffDiagonalNonzeros()
+                                    << std::endl;
+
+                                std::vector<int> range_block_count_vector;
+                                std::vector<size_t> range_fill_in_vector;
+
+                                for (int block = 0; block < system_solver.GetNumberOfBlocks(); ++block)
+                                {
+                                    int block_size = system_solver.GetBlockSize(block);
+                                    size_t range = 0;
+
+                                    while ((2 << range) <= block_size)
+                                    {
+                                        ++range;
+                                    }
+
+                                    if (range >= range_block_count_vector.size())
+                                    {
+                                        range_block_count_vector.resize(range + 1, 0);
+                                        range_fill_in_vector.resize(range + 1, 0);
+                                    }
+
+                                    ++range_block_count_vector[range];
+                                    range_fill_in_vector[range] += system_solver.GetBlockFillIn(block);
+                                }
+
+                                for (size_t range = 1; range < range_block_count_vector.size(); ++range)
+                                {
+                                    if (range_block_count_vector[range] > 0)
+                                    {
+                                        std::cout << "Blocks of " << (1 << range) << " to " << (2 << range) - 1
+                                            << " equations = " << range_block_count_vector[range]
+                                            << ", fill-in = " << range_fill_in_vector[range] << std::endl;
+                                    }
+                                }
+                            }
+
+                            std::cout << "Factorization time = " << factor_seconds << " seconds." << std::endl;
+
+                            if (mixed_precision_flag)
+                            {
+                                std::cout << "Refinement iterations = "
+                                    << system_solver.GetRefinementIterations()
+                                    << ", backward error = "
+                                    << system_solver.GetBackwardError() << std::endl;
+
+                                if (system_solver.WasDoublePrecisionFallback())
+                                {
+                                    std::cout << "The equations were factored again in double precision."
+                                        << std::endl;
+                                }
+                            }
+                        }
+
+                        if (system_status == LinearSystemSolver::SUCCESS)
+                        {
+                            //------------------------------------------
+                            //  Find the eliminated variables.
+                            //------------------------------------------
+
+                            if (reduced_flag)
+                            {
+                                std::vector<double> reduced_x_vectors;
+                                reduced_x_vectors.swap(x_vectors);
+                                presolve.Restore(reduced_x_vectors, x_vectors);
+                            }
+
+                            //------------------------------------------
+                            //  Display the solution of the equations
+                            //  sorted by the variable name. If there
+                            //  are extra right-hand sides then each
+                            //  solution follows the number of its
+                            //  right-hand side.
+                            //------------------------------------------
+
+                            std::vector<int> sorted_index_vector;
+                            variable_name_index_map.GetIndicesSortedByName(sorted_index_vector);
+
+                            for (int r = 0; r < number_of_right_hand_sides; ++r)
+                            {
+                                const double * x_ptr = &x_vectors[number_of_equations * r];
+
+                                if (number_of_right_hand_sides > 1)
+                                {
+                                    std::cout << "Right-hand side " << r + 1 << ":" << std::endl;
+                                }
+
+                                for (unsigned int k = 0; k < sorted_index_vector.size(); ++k)
+                                {
+                                    int variable_index = sorted_index_vector[k];
+
+                                    std::cout << variable_name_index_map.GetName(variable_index)
+                                        << " = " << x_ptr[variable_index] << std::endl;
+                                }
                             }
                         }
                         else
                         {
-                            std::cout << MatrixPackage::GetStatusString(system_status) << std::endl;
+                            std::cout << LinearSystemSolver::GetStatusString(system_status) << std::endl;
                         }
                     }
                 }
@@ -325,6 +1038,196 @@ int main(int argc, char * argv[], char * envp[])
     return 0;
 }
 
+//======================================================================
+//  Routine to solve the systems in a batch file.
+//======================================================================
+
+void SolveBatchFile(const CharString & input_file_name_string,
+                    bool solver_statistics_flag)
+{
+    MappedFile mapped_input_file;
+
+    if (! mapped_input_file.Open(input_file_name_string.CString()))
+    {
+        std::cout << "File " << input_file_name_string << " not found." << std::endl;
+        return;
+    }
+
+    BatchSystemFile batch_file;
+    BatchSystemFile::Status_T parser_status = batch_file.Parse(mapped_input_file.GetData(),
+                                                               mapped_input_file.GetSize());
+    mapped_input_file.Close();
+
+    if (parser_status != BatchSystemFile::SUCCESS)
+    {
+        ReportParserError(input_file_name_string,
+                          batch_file.GetErrorLine(),
+                          batch_file.GetErrorPosition(),
+                          BatchSystemFile::GetStatusString(parser_status));
+        return;
+    }
+
+    //------------------------------------------------------------------
+    //  Solve the systems.
+    //------------------------------------------------------------------
+
+    int n = batch_file.GetNumberOfEquations();
+    int number_of_systems = batch_file.GetNumberOfSystems();
+    BatchSolver batch_solver;
+    std::vector<double> x_batch_vector;
+    std::vector<char> singular_vector;
+
+    std::chrono::steady_clock::time_point solve_start_time = std::chrono::steady_clock::now();
+
+    int number_of_singular_systems = batch_solver.Solve(n,
+                                                        number_of_systems,
+                                                        batch_file.GetAMatrices(),
+                                                        batch_file.GetBVectors(),
+                                                        x_batch_vector,
+                                                        singular_vector);
+
+    double solve_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now()
+                                                         - solve_start_time).count();
+
+    if (solver_statistics_flag)
+    {
+        std::cout << "Systems = " << number_of_systems
+            << ", equations per system = " << n
+            << ", singular systems = " << number_of_singular_systems << std::endl;
+        std::cout << "Solution time = " << solve_seconds << " seconds";
+
+        if (solve_seconds > 0.0)
+        {
+            std::cout << ", systems per second = " << number_of_systems / solve_seconds;
+        }
+
+        std::cout << std::endl;
+    }
+
+    //------------------------------------------------------------------
+    //  Display the solution of each system.
+    //------------------------------------------------------------------
+
+    for (int s = 0; s < number_of_systems; ++s)
+    {
+        std::cout << "System " << s + 1 << ":" << std::endl;
+
+        if (singular_vector[s] != 0)
+        {
+            std::cout << LinearSystemSolver::GetStatusString(LinearSystemSolver::MATRIX_SINGULAR) << std::endl;
+        }
+        else
+        {
+            for (int i = 0; i < n; ++i)
+            {
+                std::cout << "x" << i + 1 << " = "
+                    << x_batch_vector[(size_t)(i) * number_of_systems + s] << std::endl;
+            }
+        }
+    }
+
+    return;
+}
+
+//======================================================================
+//  Routine to solve a dense system that does not fit in memory.
+//======================================================================
+
+void SolveOutOfCoreFile(const CharString & input_file_name_string,
+                        unsigned int memory_budget_megabytes,
+                        bool solver_statistics_flag)
+{
+    MappedFile mapped_input_file;
+
+    if (! mapped_input_file.Open(input_file_name_string.CString()))
+    {
+        std::cout << "File " << input_file_name_string << " not found." << std::endl;
+        return;
+    }
+
+    //------------------------------------------------------------------
+    //  The rows are written to the tile file while the input file is
+    //  parsed.
+    //------------------------------------------------------------------
+
+    CharString tile_file_name_string = input_file_name_string;
+    tile_file_name_string += ".tiles";
+
+    OutOfCoreSolver solver;
+
+    if (memory_budget_megabytes > 0)
+    {
+        solver.SetMemoryBudget((size_t)(memory_budget_megabytes) << 20);
+    }
+
+    std::chrono::steady_clock::time_point solve_start_time = std::chrono::steady_clock::now();
+
+    OutOfCoreSystemFile system_file(solver, tile_file_name_string.CString());
+    BatchSystemFile::Status_T parser_status = system_file.Parse(mapped_input_file.GetData(),
+                                                                mapped_input_file.GetSize());
+    mapped_input_file.Close();
+
+    if (parser_status != BatchSystemFile::SUCCESS)
+    {
+        ReportParserError(input_file_name_string,
+                          system_file.GetErrorLine(),
+                          system_file.GetErrorPosition(),
+                          BatchSystemFile::GetStatusString(parser_status));
+        return;
+    }
+
+    if (system_file.GetNumberOfSystems() != 1)
+    {
+        std::cout << "The file " << input_file_name_string
+            << " must hold one system to be solved out of core." << std::endl;
+        return;
+    }
+
+    OutOfCoreSolver::Status_T status = system_file.GetSolverStatus();
+    std::vector<double> x_vector;
+
+    if (status == OutOfCoreSolver::SUCCESS)
+    {
+        status = solver.Solve(x_vector);
+    }
+
+    double solve_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now()
+                                                         - solve_start_time).count();
+
+    if (solver_statistics_flag)
+    {
+        std::cout << "Out of core dense Gaussian elimination: equations = "
+            << system_file.GetNumberOfEquations()
+            << ", tile size = " << solver.GetTileSize()
+            << ", tiles = " << solver.GetNumberOfTileRows()
+            << " x " << solver.GetNumberOfTileColumns() << std::endl;
+        std::cout << "Memory budget = " << solver.GetMemoryBudget()
+            << " bytes, peak memory = " << solver.GetPeakMemory() << " bytes" << std::endl;
+        std::cout << "Bytes read = " << solver.GetBytesRead()
+            << ", bytes written = " << solver.GetBytesWritten() << std::endl;
+        std::cout << "Floating point operations = " << solver.GetFlopCount()
+            << ", solution time = " << solve_seconds << " seconds" << std::endl;
+    }
+
+    //------------------------------------------------------------------
+    //  Display the solution.
+    //------------------------------------------------------------------
+
+    if (status != OutOfCoreSolver::SUCCESS)
+    {
+        std::cout << OutOfCoreSolver::GetStatusString(status) << std::endl;
+    }
+    else
+    {
+        for (size_t i = 0; i < x_vector.size(); ++i)
+        {
+            std::cout << "x" << i + 1 << " = " << x_vector[i] << std::endl;
+        }
+    }
+
+    return;
+}
+
 //======================================================================
 //  Routine to report parser errors.
 //======================================================================
@@ -366,7 +1269,7 @@ void DisplayHelp()
     std::cout << std::endl;
     std::cout << std::endl << "Usage:";
     std::cout << std::endl;
-    std::cout << std::endl << "        SolveLinearEquations -q Equations.txt";
+    std::cout << std::endl << "        SolveLinearEquations [-q] [-m] [-p[N]] [-c] [-s] [-d[D]] [-r] [-b] [-o[M]] [-v] Equations.txt";
     std::cout << std::endl;
     std::cout << std::endl;
     std::cout << std::endl << "The program takes a single file name as an argument. The file";
@@ -376,6 +1279,81 @@ void DisplayHelp()
     std::cout << std::endl;
     std::cout << std::endl << "The -q switch suppresses program and version information.";
     std::cout << std::endl;
+    std::cout << std::endl << "The -m switch memory-maps the input file and parses each line in";
+    std::cout << std::endl << "place. Use this for very large files. There is no limit on the";
+    std::cout << std::endl << "length of a line when this switch is used.";
+    std::cout << std::endl;
+    std::cout << std::endl << "The -p switch memory-maps the input file and parses it using";
+    std::cout << std::endl << "several threads. The number of threads can follow the switch,";
+    std::cout << std::endl << "for example -p8. By default one thread per processor is used.";
+    std::cout << std::endl;
+    std::cout << std::endl << "The -c switch saves the parsed equations in a binary cache file";
+    std::cout << std::endl << "named by adding \".cache\" to the input file name. If the input";
+    std::cout << std::endl << "file has not changed then later runs with the -c switch load the";
+    std::cout << std::endl << "cache file instead of parsing the input file.";
+    std::cout << std::endl;
+    std::cout << std::endl << "The equations are solved using a sparse LU factorization when the";
+    std::cout << std::endl << "fraction of the coefficients that are not zero is less than a";
+    std::cout << std::endl << "threshold, otherwise dense Gaussian elimination is used. The -d";
+    std::cout << std::endl << "switch sets the threshold, for example -d0.05. The default is 0.1.";
+    std::cout << std::endl << "The switch -d0 always uses dense Gaussian elimination.";
+    std::cout << std::endl;
+    std::cout << std::endl << "Equations that share no variables with the other equations are";
+    std::cout << std::endl << "solved as independent systems, in parallel. This is not done when";
+    std::cout << std::endl << "the -s switch is used.";
+    std::cout << std::endl;
+    std::cout << std::endl << "Before the equations are factored, each equation with only one";
+    std::cout << std::endl << "variable gives the value of that variable, and each equation with";
+    std::cout << std::endl << "two variables is used to replace one of them in the other equations.";
+    std::cout << std::endl << "This is repeated until no equation with one or two variables is";
+    std::cout << std::endl << "left, and the eliminated variables are found after the rest of the";
+    std::cout << std::endl << "equations are solved. This is not done when the -s switch is used.";
+    std::cout << std::endl;
+    std::cout << std::endl << "Before the equations are factored they are put in block triangular";
+    std::cout << std::endl << "form, and only the blocks on the diagonal are factored. With the";
+    std::cout << std::endl << "-v switch the number of blocks and the fill-in of their factors are";
+    std::cout << std::endl << "displayed for each range of block sizes.";
+    std::cout << std::endl;
+    std::cout << std::endl << "The -s switch saves the structure of the sparse LU factorization";
+    std::cout << std::endl << "in a file named by adding \".lu\" to the input file name. Later";
+    std::cout << std::endl << "runs with the -s switch on equations with the same variables, in";
+    std::cout << std::endl << "the same order, and the same nonzero coefficients reuse the saved";
+    std::cout << std::endl << "structure, so only the values of the factors are computed. The";
+    std::cout << std::endl << "equations are not put in block triangular form when the -s switch";
+    std::cout << std::endl << "is used. A message is displayed if the equations are not solved by";
+    std::cout << std::endl << "the sparse LU factorization, which is the only method with a saved";
+    std::cout << std::endl << "structure.";
+    std::cout << std::endl;
+    std::cout << std::endl << "The -r switch does dense Gaussian elimination in single precision,";
+    std::cout << std::endl << "which is faster for large systems, and then refines the solution";
+    std::cout << std::endl << "until it is as accurate as a double precision solution. If the";
+    std::cout << std::endl << "refinement stops improving the solution then the equations are";
+    std::cout << std::endl << "factored again in double precision. With the -v switch, the number";
+    std::cout << std::endl << "of refinement iterations and the backward error are displayed.";
+    std::cout << std::endl;
+    std::cout << std::endl << "The -b switch reads a batch file of many systems that all have the";
+    std::cout << std::endl << "same number of equations, and solves several systems at once with";
+    std::cout << std::endl << "vector instructions. The first number in the file is the number of";
+    std::cout << std::endl << "equations N. Each system follows as N rows of N coefficients, each";
+    std::cout << std::endl << "row followed by its constant. The numbers are separated by spaces,";
+    std::cout << std::endl << "commas or line breaks, and the exponent of a number is preceded by";
+    std::cout << std::endl << "the '^' or 'e' character. The solution of each system is displayed";
+    std::cout << std::endl << "as x1 to xN. With the -v switch the number of systems solved per";
+    std::cout << std::endl << "second is displayed.";
+    std::cout << std::endl;
+    std::cout << std::endl << "The -o switch solves one dense system that is too large for memory.";
+    std::cout << std::endl << "The file has the format of a batch file that holds one system. The";
+    std::cout << std::endl << "matrix is stored in square tiles in a file named by adding \".tiles\"";
+    std::cout << std::endl << "to the input file name, which is deleted when the system is solved.";
+    std::cout << std::endl << "The memory budget in megabytes can follow the switch, for example";
+    std::cout << std::endl << "-o1024, and sets the tile size. The default is 256 megabytes. With";
+    std::cout << std::endl << "the -v switch the tile size, the peak memory and the number of bytes";
+    std::cout << std::endl << "read from and written to the tile file are displayed.";
+    std::cout << std::endl;
+    std::cout << std::endl << "The -v switch displays the solution method, the number of nonzero";
+    std::cout << std::endl << "elements in the matrix and its factors, and the number of floating";
+    std::cout << std::endl << "point operations.";
+    std::cout << std::endl;
     std::cout << std::endl << "Comments can be included on any line in the file. The comments";
     std::cout << std::endl << "are started by the characters \"//\". All characters on the same";
     std::cout << std::endl << "line that occur after the comment characters are ignored.";
@@ -390,7 +1368,8 @@ void DisplayHelp()
     std::cout << std::endl;
     std::cout << std::endl << "Equations can take a many lines as necessary. The only restriction";
     std::cout << std::endl << "is that a term cannot be split between lines. Equations are delimited";
-    std::cout << std::endl << "by a semicolon. There is a " << MAXIMUM_INPUT_LINE_LENGTH << "character limit per line";
+    std::cout << std::endl << "by a semicolon. There is a " << MAXIMUM_INPUT_LINE_LENGTH << " character limit per line";
+    std::cout << std::endl << "unless the -m switch is used.";
     std::cout << std::endl;
     std::cout << std::endl;
     std::cout << std::endl << "An example of a legal equation file is:";
@@ -405,18 +1384,74 @@ void DisplayHelp()
     std::cout << std::endl;
     std::cout << std::endl << "  A = 1 ; B = 2 A; C = 2 B  // You can have more than one equation per line.";
     std::cout << std::endl;
+    std::cout << std::endl;
+    std::cout << std::endl << "The equations can be solved for more than one set of constants.";
+    std::cout << std::endl << "Each extra set of constants is given between equations by the";
+    std::cout << std::endl << "keyword \"$rhs\" followed by one number for each equation, in the";
+    std::cout << std::endl << "order of the equations. The numbers are separated by spaces or";
+    std::cout << std::endl << "commas and the list is ended by a semicolon or a blank line. The";
+    std::cout << std::endl << "list can continue on as many lines as necessary, but a number cannot";
+    std::cout << std::endl << "be split between lines and each comma must follow a number. The";
+    std::cout << std::endl << "equations are factored once and the solution for each set of";
+    std::cout << std::endl << "constants is displayed. For the second example above:";
+    std::cout << std::endl;
+    std::cout << std::endl << "  $rhs 2, 0, 0;         // Solve again with A = 2, B = 2 A, C = 2 B";
+    std::cout << std::endl;
     return;
 }
 #ifndef SPARSEARRAY_H
 #define SPARSEARRAY_H
 
+//------------------------------------------------------------------
+//  Define SPARSE_ARRAY_FLAT_STORAGE to store the elements of each
+//  SparseArray in a sorted vector instead of in a std::map. See
+//  file FlatSparseArray.h. Both have the same proxy semantics.
+//------------------------------------------------------------------
+
+#ifdef SPARSE_ARRAY_FLAT_STORAGE
+
+#include "FlatSparseArray.h"
+
+//------------------------------------------------------------------
+//  The allocator parameter is accepted for compatibility with the
+//  std::map storage, but it is not used.
+//------------------------------------------------------------------
+
+template <typename T_KEY, typename T_ITEM, typename T_ALLOCATOR = void>
+
+using SparseArray = FlatSparseArray<T_KEY, T_ITEM>;
+
+template <typename T_KEY, typename T_ITEM, typename T_ALLOCATOR = void>
+
+using SparseArrayProxy = FlatSparseArrayProxy<T_KEY, T_ITEM>;
+
+#else
+
 #include <map>
+#include <memory>
+#include "ArenaAllocator.h"
+
+//------------------------------------------------------------------
+//  By default the tree nodes of each SparseArray are allocated from
+//  an arena that belongs to that SparseArray. The arena is freed all
+//  at once when the SparseArray is destroyed. Define the symbol
+//  SPARSE_ARRAY_STANDARD_ALLOCATOR to allocate each node separately
+//  with std::allocator instead.
+//------------------------------------------------------------------
+
+#ifdef SPARSE_ARRAY_STANDARD_ALLOCATOR
+#define SPARSE_ARRAY_DEFAULT_ALLOCATOR std::allocator
+#else
+#define SPARSE_ARRAY_DEFAULT_ALLOCATOR ArenaAllocator
+#endif
 
 //------------------------------------------------------------------
 //  Forward declarations.
 //------------------------------------------------------------------
 
-template <typename T_KEY, typename T_ITEM>
+template <typename T_KEY,
+          typename T_ITEM,
+          typename T_ALLOCATOR = SPARSE_ARRAY_DEFAULT_ALLOCATOR< std::pair<const T_KEY, T_ITEM> > >
 
 class SparseArray;
 
@@ -436,15 +1471,17 @@ class SparseArray;
 //  or the right side of an equals sign in an expression.
 //------------------------------------------------------------------
 
-template <typename T_KEY, typename T_ITEM>
+template <typename T_KEY,
+          typename T_ITEM,
+          typename T_ALLOCATOR = SPARSE_ARRAY_DEFAULT_ALLOCATOR< std::pair<const T_KEY, T_ITEM> > >
 
 class SparseArrayProxy
 {
 public:
 
-    SparseArrayProxy(SparseArray<T_KEY, T_ITEM> & sparse_array, T_KEY key);
+    SparseArrayProxy(SparseArray<T_KEY, T_ITEM, T_ALLOCATOR> & sparse_array, T_KEY key);
 
-    SparseArrayProxy & operator =(const SparseArrayProxy<T_KEY, T_ITEM> & right_hand_side);
+    SparseArrayProxy & operator =(const SparseArrayProxy<T_KEY, T_ITEM, T_ALLOCATOR> & right_hand_side);
 
     SparseArrayProxy & operator =(T_ITEM item);
 
@@ -452,7 +1489,7 @@ public:
 
 private:
 
-    SparseArray<T_KEY, T_ITEM> & m_sparse_array;
+    SparseArray<T_KEY, T_ITEM, T_ALLOCATOR> & m_sparse_array;
     T_KEY m_key;
 };
 
@@ -463,17 +1500,19 @@ private:
 //  cleaner to use containment for the STL map container and
 //  to create methods to allow accessing the map from the
 //  proxy class.
+//
+//  The T_ALLOCATOR parameter is the allocator for the map nodes.
 //------------------------------------------------------------------
 
-template <typename T_KEY, typename T_ITEM>
+template <typename T_KEY, typename T_ITEM, typename T_ALLOCATOR>
 
-class SparseArray : public std::map< T_KEY, T_ITEM, std::less<T_KEY> >
+class SparseArray : public std::map< T_KEY, T_ITEM, std::less<T_KEY>, T_ALLOCATOR >
 {
 public:
 
-    const SparseArrayProxy<T_KEY, T_ITEM> operator [](T_KEY key) const;
+    const SparseArrayProxy<T_KEY, T_ITEM, T_ALLOCATOR> operator [](T_KEY key) const;
 
-    SparseArrayProxy<T_KEY, T_ITEM> operator [](T_KEY key);
+    SparseArrayProxy<T_KEY, T_ITEM, T_ALLOCATOR> operator [](T_KEY key);
 };
 
 //----------------------------------------------------------------------
@@ -484,10 +1523,10 @@ public:
 //    SparseArrayProxy(SparseArray & sparse_array, T_KEY key);
 //----------------------------------------------------------------------
 
-template <typename T_KEY, typename T_ITEM>
+template <typename T_KEY, typename T_ITEM, typename T_ALLOCATOR>
 
-SparseArrayProxy<T_KEY, T_ITEM>::SparseArrayProxy(SparseArray<T_KEY, T_ITEM> & sparse_array,
-                                                  T_KEY key)
+SparseArrayProxy<T_KEY, T_ITEM, T_ALLOCATOR>::SparseArrayProxy(SparseArray<T_KEY, T_ITEM, T_ALLOCATOR> & sparse_array,
+                                                               T_KEY key)
   : m_sparse_array(sparse_array),
     m_key(key)
 {
@@ -497,10 +1536,10 @@ SparseArrayProxy<T_KEY, T_ITEM>::SparseArrayProxy(SparseArray<T_KEY, T_ITEM> & s
 //  SparseArrayProxy & operator =(const SparseArrayProxy & right_hand_side);
 //----------------------------------------------------------------------
 
-template <typename T_KEY, typename T_ITEM>
+template <typename T_KEY, typename T_ITEM, typename T_ALLOCATOR>
 
-SparseArrayProxy<T_KEY, T_ITEM> &
-    SparseArrayProxy<T_KEY, T_ITEM>::operator =(const SparseArrayProxy<T_KEY, T_ITEM> & right_hand_side)
+SparseArrayProxy<T_KEY, T_ITEM, T_ALLOCATOR> &
+    SparseArrayProxy<T_KEY, T_ITEM, T_ALLOCATOR>::operator =(const SparseArrayProxy<T_KEY, T_ITEM, T_ALLOCATOR> & right_hand_side)
 {
     //------------------------------------------------------------------
     //  If the item is the default item then clear the existing item
@@ -509,7 +1548,7 @@ SparseArrayProxy<T_KEY, T_ITEM> &
 
     if (T_ITEM(right_hand_side) == T_ITEM())
     {
-        typename SparseArray<T_KEY, T_ITEM>::iterator it = m_sparse_array.find(m_key);
+        typename SparseArray<T_KEY, T_ITEM, T_ALLOCATOR>::iterator it = m_sparse_array.find(m_key);
 
         if (it != m_sparse_array.end())
         {
@@ -522,7 +1561,7 @@ SparseArrayProxy<T_KEY, T_ITEM> &
         //  Add the item to the map at the specified key.
         //--------------------------------------------------------------
 
-        (static_cast<std::map< T_KEY, T_ITEM, std::less<T_KEY> > &>(m_sparse_array))[m_key] = right_hand_side;
+        (static_cast<std::map< T_KEY, T_ITEM, std::less<T_KEY>, T_ALLOCATOR > &>(m_sparse_array))[m_key] = right_hand_side;
     }
 
     return *this;
@@ -532,12 +1571,12 @@ SparseArrayProxy<T_KEY, T_ITEM> &
 //  SparseArrayProxy & operator =(T_ITEM & item);
 //----------------------------------------------------------------------
 
-template <typename T_KEY, typename T_ITEM>
+template <typename T_KEY, typename T_ITEM, typename T_ALLOCATOR>
 
-SparseArrayProxy<T_KEY, T_ITEM> &
-    SparseArrayProxy<T_KEY, T_ITEM>::operator =(T_ITEM item)
+SparseArrayProxy<T_KEY, T_ITEM, T_ALLOCATOR> &
+    SparseArrayProxy<T_KEY, T_ITEM, T_ALLOCATOR>::operator =(T_ITEM item)
 {
-    (static_cast<std::map< T_KEY, T_ITEM, std::less<T_KEY> > &>(m_sparse_array))[m_key] = item;
+    (static_cast<std::map< T_KEY, T_ITEM, std::less<T_KEY>, T_ALLOCATOR > &>(m_sparse_array))[m_key] = item;
     return *this;
 }
 
@@ -545,11 +1584,11 @@ SparseArrayProxy<T_KEY, T_ITEM> &
 //  operator T_ITEM() const;
 //----------------------------------------------------------------------
 
-template <typename T_KEY, typename T_ITEM>
+template <typename T_KEY, typename T_ITEM, typename T_ALLOCATOR>
 
-SparseArrayProxy<T_KEY, T_ITEM>::operator T_ITEM() const
+SparseArrayProxy<T_KEY, T_ITEM, T_ALLOCATOR>::operator T_ITEM() const
 {
-    typename SparseArray<T_KEY, T_ITEM>::iterator it = m_sparse_array.find(m_key);
+    typename SparseArray<T_KEY, T_ITEM, T_ALLOCATOR>::iterator it = m_sparse_array.find(m_key);
 
     if (it != m_sparse_array.end())
     {
@@ -567,24 +1606,26 @@ SparseArrayProxy<T_KEY, T_ITEM>::operator T_ITEM() const
 //  const SparseArrayProxy operator [](T_KEY key) const;
 //----------------------------------------------------------------------
 
-template <typename T_KEY, typename T_ITEM>
+template <typename T_KEY, typename T_ITEM, typename T_ALLOCATOR>
 
-const SparseArrayProxy<T_KEY, T_ITEM> SparseArray<T_KEY, T_ITEM>::operator [](T_KEY key) const
+const SparseArrayProxy<T_KEY, T_ITEM, T_ALLOCATOR> SparseArray<T_KEY, T_ITEM, T_ALLOCATOR>::operator [](T_KEY key) const
 {
-    return SparseArrayProxy<T_KEY, T_ITEM>(const_cast< SparseArray<T_KEY, T_ITEM> & >(*this), key);
+    return SparseArrayProxy<T_KEY, T_ITEM, T_ALLOCATOR>(const_cast< SparseArray<T_KEY, T_ITEM, T_ALLOCATOR> & >(*this), key);
 }
 
 //----------------------------------------------------------------------
-//  SparseArrayProxy<T_KEY, T_ITEM> operator [](T_KEY key);
+//  SparseArrayProxy<T_KEY, T_ITEM, T_ALLOCATOR> operator [](T_KEY key);
 //----------------------------------------------------------------------
 
-template <typename T_KEY, typename T_ITEM>
+template <typename T_KEY, typename T_ITEM, typename T_ALLOCATOR>
 
-SparseArrayProxy<T_KEY, T_ITEM> SparseArray<T_KEY, T_ITEM>::operator [](T_KEY key)
+SparseArrayProxy<T_KEY, T_ITEM, T_ALLOCATOR> SparseArray<T_KEY, T_ITEM, T_ALLOCATOR>::operator [](T_KEY key)
 {
-    return SparseArrayProxy<T_KEY, T_ITEM>(*this, key);
+    return SparseArrayProxy<T_KEY, T_ITEM, T_ALLOCATOR>(*this, key);
 }
 
+#endif
+
 #endif
 MPI_Datatype xslice, yslice;
 		MPI_Type_vector(block_step1 + 2, dim3, (block_step2 + 2) * dim3, MPI_DOUBLE, &xslice);
@@ -0,0 +1,1103 @@
+#include <math.h>
+#include <utility>
+#include "SparseLU.h"
+#include "ColumnOrdering.h"
+
+namespace
+{
+    //------------------------------------------------------------------
+    //  The diagonal element is used as the pivot when its magnitude is
+    //  at least this fraction of the largest magnitude in the column.
+    //------------------------------------------------------------------
+
+    const double f_DEFAULT_PIVOT_TOLERANCE = 0.1;
+}
+
+//======================================================================
+//  Constructor: SparseLU::SparseLU
+//======================================================================
+
+SparseLU::SparseLU()
+  : m_pivot_tolerance(f_DEFAULT_PIVOT_TOLERANCE)
+  , m_analyzed_flag(false)
+  , m_pattern_reused_flag(false)
+  , m_matrix_nonzeros(0)
+  , m_flop_count(0.0)
+{
+    m_structure.m_n = 0;
+}
+
+//======================================================================
+//  Destructor: SparseLU::~SparseLU
+//======================================================================
+
+SparseLU::~SparseLU()
+{
+}
+
+//======================================================================
+//  Member Function: SparseLU::SetPivotTolerance
+//
+//  Abstract:
+//
+//    This function sets the pivot tolerance. A value of one is
+//    partial pivoting and a value of zero always uses the diagonal
+//    element if it is not zero.
+//
+//======================================================================
+
+void SparseLU::SetPivotTolerance(double pivot_tolerance)
+{
+    m_pivot_tolerance = pivot_tolerance;
+    return;
+}
+
+//======================================================================
+//  Member Function: SparseLU::GetPivotTolerance
+//======================================================================
+
+double SparseLU::GetPivotTolerance() const
+{
+    return m_pivot_tolerance;
+}
+
+//======================================================================
+//  Member Function: SparseLU::Analyze
+//
+//  Abstract:
+//
+//    This function computes the column ordering from the nonzero
+//    pattern of the matrix. Any previous factor structure is removed.
+//
+//
+//  Input:
+//
+//    a_matrix      The matrix. Only the elements in the first n rows
+//                  and the first n columns are used.
+//
+//    n             The size of the matrix.
+//
+//  Output:
+//
+//    This function has no return value.
+//
+//======================================================================
+
+void SparseLU::Analyze(const FrozenSparseMatrix & a_matrix, int n)
+{
+    m_structure.m_n = n;
+    m_structure.m_row_pivot_vector.clear();
+    m_structure.m_lower_start_vector.clear();
+    m_structure.m_lower_index_vector.clear();
+    m_structure.m_upper_start_vector.clear();
+    m_structure.m_upper_index_vector.clear();
+    m_lower_value_vector.clear();
+    m_upper_value_vector.clear();
+
+    ColumnOrdering column_ordering;
+    column_ordering.Compute(a_matrix, n, m_structure.m_column_order_vector);
+    PostorderColumns(a_matrix);
+
+    m_analyzed_flag = true;
+    return;
+}
+
+//======================================================================
+//  Member Function: SparseLU::Factor
+//
+//  Abstract:
+//
+//    This function computes the LU factorization. The matrix must have
+//    the nonzero pattern that was analyzed. If the matrix was factored
+//    before then the factor structure is reused.
+//
+//
+//  Input:
+//
+//    a_matrix      The matrix.
+//
+//  Output:
+//
+//    This function returns a value of type 'Status_T'.
+//
+//======================================================================
+
+SparseLU::Status_T SparseLU::Factor(const FrozenSparseMatrix & a_matrix)
+{
+    int n = m_structure.m_n;
+    int number_of_columns = a_matrix.GetNumberOfColumns();
+    int k = 0;
+
+    m_flop_count = 0.0;
+    m_matrix_nonzeros = 0;
+    m_pattern_reused_flag = false;
+
+    for (k = 0; (k < n) && (k < number_of_columns); ++k)
+    {
+        SparseSlice column_slice = a_matrix.GetColumn(k);
+
+        for (SparseSlice::Iterator column_iter = column_slice.begin(); column_iter != column_slice.end(); ++column_iter)
+        {
+            if (column_iter.GetIndex() < n)
+            {
+                ++m_matrix_nonzeros;
+            }
+        }
+    }
+
+    if (IsStructureFactored() && (Refactor(a_matrix) == SUCCESS))
+    {
+        m_pattern_reused_flag = true;
+        return SUCCESS;
+    }
+
+    m_flop_count = 0.0;
+
+    return FactorWithPivoting(a_matrix);
+}
+
+//======================================================================
+//  Member Function: SparseLU::Solve
+//
+//  Abstract:
+//
+//    This function solves A x = B using the factors.
+//
+//
+//  Input:
+//
+//    b_vector      The B vector, which must have n elements.
+//
+//    x_vector      The solution.
+//
+//  Output:
+//
+//    This function has no return value.
+//
+//======================================================================
+
+void SparseLU::Solve(const std::vector<double> & b_vector,
+                     std::vector<double> & x_vector) const
+{
+    int n = m_structure.m_n;
+    const std::vector<size_t> & lower_start_vector = m_structure.m_lower_start_vector;
+    const std::vector<int> & lower_index_vector = m_structure.m_lower_index_vector;
+    const std::vector<size_t> & upper_start_vector = m_structure.m_upper_start_vector;
+    const std::vector<int> & upper_index_vector = m_structure.m_upper_index_vector;
+    std::vector<double> work_vector(n);
+    int j = 0;
+
+    for (j = 0; j < n; ++j)
+    {
+        work_vector[m_structure.m_row_pivot_vector[j]] = b_vector[j];
+    }
+
+    //------------------------------------------------------------------
+    //  Solve L y = P B.
+    //------------------------------------------------------------------
+
+    for (j = 0; j < n; ++j)
+    {
+        double y_value = work_vector[j];
+
+        if (y_value != 0.0)
+        {
+            for (size_t q = lower_start_vector[j] + 1; q < lower_start_vector[j + 1]; ++q)
+            {
+                work_vector[lower_index_vector[q]] -= m_lower_value_vector[q] * y_value;
+            }
+        }
+    }
+
+    //------------------------------------------------------------------
+    //  Solve U z = y.
+    //------------------------------------------------------------------
+
+    for (j = n - 1; j >= 0; --j)
+    {
+        size_t diagonal = upper_start_vector[j + 1] - 1;
+        double z_value = work_vector[j] / m_upper_value_vector[diagonal];
+        work_vector[j] = z_value;
+
+        if (z_value != 0.0)
+        {
+            for (size_t q = upper_start_vector[j]; q < diagonal; ++q)
+            {
+                work_vector[upper_index_vector[q]] -= m_upper_value_vector[q] * z_value;
+            }
+        }
+    }
+
+    //------------------------------------------------------------------
+    //  Undo the column permutation.
+    //------------------------------------------------------------------
+
+    x_vector.resize(n);
+
+    for (j = 0; j < n; ++j)
+    {
+        x_vector[m_structure.m_column_order_vector[j]] = work_vector[j];
+    }
+
+    return;
+}
+
+//======================================================================
+//  Member Function: SparseLU::SolveBlock
+//
+//  Abstract:
+//
+//    This function solves A X = B for a block of B vectors using the
+//    factors. The elements of the vectors are interleaved, so element
+//    i of every vector in the block is contiguous. Each element of L
+//    and U is then loaded once for the whole block and the inner loop
+//    over the vectors has unit stride.
+//
+//    Where the Solve method skips a column for a zero value, this
+//    function subtracts a positive zero instead, which does not change
+//    any value. The solution of each vector is the same as the
+//    solution from the Solve method.
+//
+//
+//  Input:
+//
+//    b_block_vector    The B vectors. Element i of vector r is at
+//                      index i * block_width + r.
+//
+//    block_width       The number of vectors in the block.
+//
+//    x_block_vector    The solutions, stored in the same way.
+//
+//  Output:
+//
+//    This function has no return value.
+//
+//======================================================================
+
+void SparseLU::SolveBlock(const std::vector<double> & b_block_vector,
+                          int block_width,
+                          std::vector<double> & x_block_vector) const
+{
+    int n = m_structure.m_n;
+    size_t width = (size_t)(block_width);
+    const std::vector<size_t> & lower_start_vector = m_structure.m_lower_start_vector;
+    const std::vector<int> & lower_index_vector = m_structure.m_lower_index_vector;
+    const std::vector<size_t> & upper_start_vector = m_structure.m_upper_start_vector;
+    const std::vector<int> & upper_index_vector = m_structure.m_upper_index_vector;
+    std::vector<double> work_vector(n * width);
+    double * work_ptr = work_vector.data();
+    size_t r = 0;
+    int j = 0;
+
+    for (j = 0; j < n; ++j)
+    {
+        const double * b_ptr = &b_block_vector[j * width];
+        double * row_ptr = work_ptr + m_structure.m_row_pivot_vector[j] * width;
+
+        for (r = 0; r < width; ++r)
+        {
+            row_ptr[r] = b_ptr[r];
+        }
+    }
+
+    //------------------------------------------------------------------
+    //  Solve L Y = P B.
+    //------------------------------------------------------------------
+
+    for (j = 0; j < n; ++j)
+    {
+        const double * y_ptr = work_ptr + j * width;
+
+        for (size_t q = lower_start_vector[j] + 1; q < lower_start_vector[j + 1]; ++q)
+        {
+            double lower_value = m_lower_value_vector[q];
+            double * row_ptr = work_ptr + lower_index_vector[q] * width;
+
+            for (r = 0; r < width; ++r)
+            {
+                row_ptr[r] -= (y_ptr[r] != 0.0) ? lower_value * y_ptr[r] : 0.0;
+            }
+        }
+    }
+
+    //------------------------------------------------------------------
+    //  Solve U Z = Y.
+    //------------------------------------------------------------------
+
+    for (j = n - 1; j >= 0; --j)
+    {
+        size_t diagonal = upper_start_vector[j + 1] - 1;
+        double diagonal_value = m_upper_value_vector[diagonal];
+        double * z_ptr = work_ptr + j * width;
+
+        for (r = 0; r < width; ++r)
+        {
+            z_ptr[r] = z_ptr[r] / diagonal_value;
+        }
+
+        for (size_t q = upper_start_vector[j]; q < diagonal; ++q)
+        {
+            double upper_value = m_upper_value_vector[q];
+            double * row_ptr = work_ptr + upper_index_vector[q] * width;
+
+            for (r = 0; r < width; ++r)
+            {
+                row_ptr[r] -= (z_ptr[r] != 0.0) ? upper_value * z_ptr[r] : 0.0;
+            }
+        }
+    }
+
+    //------------------------------------------------------------------
+    //  Undo the column permutation.
+    //------------------------------------------------------------------
+
+    x_block_vector.resize(n * width);
+
+    for (j = 0; j < n; ++j)
+    {
+        const double * z_ptr = work_ptr + j * width;
+        double * x_ptr = &x_block_vector[m_structure.m_column_order_vector[j] * width];
+
+        for (r = 0; r < width; ++r)
+        {
+            x_ptr[r] = z_ptr[r];
+        }
+    }
+
+    return;
+}
+
+//======================================================================
+//  Member Function: SparseLU::IsAnalyzed
+//======================================================================
+
+bool SparseLU::IsAnalyzed() const
+{
+    return m_analyzed_flag;
+}
+
+//======================================================================
+//  Member Function: SparseLU::IsStructureFactored
+//
+//  Abstract:
+//
+//    This function returns true if the factor structure includes the
+//    row pivots and the nonzero patterns of L and U.
+//
+//======================================================================
+
+bool SparseLU::IsStructureFactored() const
+{
+    return m_analyzed_flag
+        && (m_structure.m_lower_start_vector.size() == (size_t)(m_structure.m_n) + 1);
+}
+
+//======================================================================
+//  Member Function: SparseLU::WasPatternReused
+//
+//  Abstract:
+//
+//    This function returns true if the last factorization reused the
+//    row pivots and the nonzero patterns of L and U.
+//
+//======================================================================
+
+bool SparseLU::WasPatternReused() const
+{
+    return m_pattern_reused_flag;
+}
+
+//======================================================================
+//  Member Function: SparseLU::GetStructure
+//======================================================================
+
+const SparseLU::Structure_T & SparseLU::GetStructure() const
+{
+    return m_structure;
+}
+
+//======================================================================
+//  Member Function: SparseLU::SwapStructure
+//
+//  Abstract:
+//
+//    This function exchanges the factor structure with the passed
+//    factor structure. This is used to restore a factor structure
+//    that was saved, so the analysis can be skipped. The factor
+//    values are removed.
+//
+//======================================================================
+
+void SparseLU::SwapStructure(Structure_T & structure)
+{
+    std::swap(m_structure.m_n, structure.m_n);
+    m_structure.m_column_order_vector.swap(structure.m_column_order_vector);
+    m_structure.m_row_pivot_vector.swap(structure.m_row_pivot_vector);
+    m_structure.m_lower_start_vector.swap(structure.m_lower_start_vector);
+    m_structure.m_lower_index_vector.swap(structure.m_lower_index_vector);
+    m_structure.m_upper_start_vector.swap(structure.m_upper_start_vector);
+    m_structure.m_upper_index_vector.swap(structure.m_upper_index_vector);
+    m_lower_value_vector.clear();
+    m_upper_value_vector.clear();
+    m_analyzed_flag = true;
+    return;
+}
+
+//======================================================================
+//  Member Function: SparseLU::GetSize
+//======================================================================
+
+int SparseLU::GetSize() const
+{
+    return m_structure.m_n;
+}
+
+//======================================================================
+//  Member Function: SparseLU::GetNumberOfMatrixNonzeros
+//
+//  Abstract:
+//
+//    This function returns the number of stored elements of the
+//    matrix that were used by the factorization.
+//
+//======================================================================
+
+size_t SparseLU::GetNumberOfMatrixNonzeros() const
+{
+    return m_matrix_nonzeros;
+}
+
+//======================================================================
+//  Member Function: SparseLU::GetNumberOfLowerNonzeros
+//
+//  Abstract:
+//
+//    This function returns the number of elements of L, including
+//    the unit diagonal.
+//
+//======================================================================
+
+size_t SparseLU::GetNumberOfLowerNonzeros() const
+{
+    return m_structure.m_lower_index_vector.size();
+}
+
+//======================================================================
+//  Member Function: SparseLU::GetNumberOfUpperNonzeros
+//======================================================================
+
+size_t SparseLU::GetNumberOfUpperNonzeros() const
+{
+    return m_structure.m_upper_index_vector.size();
+}
+
+//======================================================================
+//  Member Function: SparseLU::GetFillIn
+//
+//  Abstract:
+//
+//    This function returns the number of elements of L and U that
+//    are not elements of the matrix. The unit diagonal of L is not
+//    counted.
+//
+//======================================================================
+
+size_t SparseLU::GetFillIn() const
+{
+    size_t factor_nonzeros = m_structure.m_lower_index_vector.size()
+        + m_structure.m_upper_index_vector.size();
+
+    if (factor_nonzeros < (size_t)(m_structure.m_n) + m_matrix_nonzeros)
+    {
+        return 0;
+    }
+
+    return factor_nonzeros - m_structure.m_n - m_matrix_nonzeros;
+}
+
+//======================================================================
+//  Member Function: SparseLU::GetFlopCount
+//
+//  Abstract:
+//
+//    This function returns the number of floating point operations
+//    done by the last factorization.
+//
+//======================================================================
+
+double SparseLU::GetFlopCount() const
+{
+    return m_flop_count;
+}
+
+//======================================================================
+//  Member Function: SparseLU::PostorderColumns
+//
+//  Abstract:
+//
+//    This function finds the column elimination tree, which is the
+//    elimination tree of transpose(A) A, for the columns in the
+//    current order, and then reorders the columns by a postorder of
+//    the tree. This does not change the fill, but the columns of each
+//    subtree become adjacent, so the columns of L that update a
+//    column are close together.
+//
+//    The tree is found without forming transpose(A) A. A row of A
+//    joins every column that it contains, so each column only needs
+//    to be linked to the last earlier column that shares a row.
+//
+//======================================================================
+
+void SparseLU::PostorderColumns(const FrozenSparseMatrix & a_matrix)
+{
+    int n = m_structure.m_n;
+    std::vector<int> & column_order_vector = m_structure.m_column_order_vector;
+    std::vector<int> parent_vector(n, -1);
+    std::vector<int> ancestor_vector(n, -1);
+    std::vector<int> previous_column_vector(n, -1);
+    int k = 0;
+
+    //------------------------------------------------------------------
+    //  Find the parent of each column. The ancestor vector is a path
+    //  compressed link to the root of each subtree.
+    //------------------------------------------------------------------
+
+    for (k = 0; k < n; ++k)
+    {
+        SparseSlice column_slice = GetOrderedColumn(a_matrix, k);
+
+        for (SparseSlice::Iterator column_iter = column_slice.begin(); column_iter != column_slice.end(); ++column_iter)
+        {
+            int row = column_iter.GetIndex();
+
+            if (row >= n)
+            {
+                continue;
+            }
+
+            int node = previous_column_vector[row];
+
+            while ((node != -1) && (node < k))
+            {
+                int next_node = ancestor_vector[node];
+                ancestor_vector[node] = k;
+
+                if (next_node == -1)
+                {
+                    parent_vector[node] = k;
+                }
+
+                node = next_node;
+            }
+
+            previous_column_vector[row] = k;
+        }
+    }
+
+    //------------------------------------------------------------------
+    //  Make the lists of children, with the children of each node in
+    //  increasing order.
+    //------------------------------------------------------------------
+
+    std::vector<int> child_head_vector(n, -1);
+    std::vector<int> child_next_vector(n, -1);
+
+    for (k = n - 1; k >= 0; --k)
+    {
+        if (parent_vector[k] != -1)
+        {
+            child_next_vector[k] = child_head_vector[parent_vector[k]];
+            child_head_vector[parent_vector[k]] = k;
+        }
+    }
+
+    //------------------------------------------------------------------
+    //  Postorder each tree using an explicit stack.
+    //------------------------------------------------------------------
+
+    std::vector<int> postorder_vector;
+    std::vector<int> stack_vector;
+    postorder_vector.reserve(n);
+    stack_vector.reserve(n);
+
+    for (k = 0; k < n; ++k)
+    {
+        if (parent_vector[k] != -1)
+        {
+            continue;
+        }
+
+        stack_vector.push_back(k);
+
+        while (! stack_vector.empty())
+        {
+            int node = stack_vector.back();
+            int child = child_head_vector[node];
+
+            if (child == -1)
+            {
+                stack_vector.pop_back();
+                postorder_vector.push_back(node);
+            }
+            else
+            {
+                child_head_vector[node] = child_next_vector[child];
+                stack_vector.push_back(child);
+            }
+        }
+    }
+
+    std::vector<int> ordered_column_vector(n);
+
+    for (k = 0; k < n; ++k)
+    {
+        ordered_column_vector[k] = column_order_vector[postorder_vector[k]];
+    }
+
+    column_order_vector.swap(ordered_column_vector);
+
+    return;
+}
+
+//======================================================================
+//  Member Function: SparseLU::FactorWithPivoting
+//
+//  Abstract:
+//
+//    This function computes the LU factorization, choosing the pivot
+//    rows and finding the nonzero patterns of L and U.
+//
+//
+//  Input:
+//
+//    a_matrix      The matrix.
+//
+//  Output:
+//
+//    This function returns a value of type 'Status_T'.
+//
+//======================================================================
+
+SparseLU::Status_T SparseLU::FactorWithPivoting(const FrozenSparseMatrix & a_matrix)
+{
+    int n = m_structure.m_n;
+    std::vector<int> & row_pivot_vector = m_structure.m_row_pivot_vector;
+    std::vector<size_t> & lower_start_vector = m_structure.m_lower_start_vector;
+    std::vector<int> & lower_index_vector = m_structure.m_lower_index_vector;
+    std::vector<size_t> & upper_start_vector = m_structure.m_upper_start_vector;
+    std::vector<int> & upper_index_vector = m_structure.m_upper_index_vector;
+
+    //------------------------------------------------------------------
+    //  Initialize the factors and the work space.
+    //------------------------------------------------------------------
+
+    row_pivot_vector.assign(n, -1);
+    lower_start_vector.assign(n + 1, 0);
+    upper_start_vector.assign(n + 1, 0);
+    lower_index_vector.clear();
+    upper_index_vector.clear();
+    m_lower_value_vector.clear();
+    m_upper_value_vector.clear();
+    lower_index_vector.reserve(m_matrix_nonzeros + n);
+    m_lower_value_vector.reserve(m_matrix_nonzeros + n);
+    upper_index_vector.reserve(m_matrix_nonzeros + n);
+    m_upper_value_vector.reserve(m_matrix_nonzeros + n);
+
+    m_x_vector.assign(n, 0.0);
+    m_reach_vector.assign(n, 0);
+    m_stack_vector.assign(n, 0);
+    m_stack_position_vector.assign(n, 0);
+    m_mark_vector.assign(n, -1);
+
+    std::vector<double> & x_vector = m_x_vector;
+
+    //------------------------------------------------------------------
+    //  Compute one column of L and U for each column of the matrix in
+    //  the column order.
+    //------------------------------------------------------------------
+
+    for (int k = 0; k < n; ++k)
+    {
+        lower_start_vector[k] = lower_index_vector.size();
+        upper_start_vector[k] = upper_index_vector.size();
+
+        int column = m_structure.m_column_order_vector[k];
+        SparseSlice column_slice = GetOrderedColumn(a_matrix, k);
+
+        //--------------------------------------------------------------
+        //  Solve L x = A(:, column) where the rows of L that have not
+        //  been chosen as pivot rows are taken as the identity.
+        //--------------------------------------------------------------
+
+        int top = Reach(column_slice, k);
+        int p = 0;
+
+        for (SparseSlice::Iterator column_iter = column_slice.begin(); column_iter != column_slice.end(); ++column_iter)
+        {
+            if (column_iter.GetIndex() < n)
+            {
+                x_vector[column_iter.GetIndex()] = column_iter.GetValue();
+            }
+        }
+
+        for (p = top; p < n; ++p)
+        {
+            int row = m_reach_vector[p];
+            int pivot_column = row_pivot_vector[row];
+            double x_value = x_vector[row];
+
+            if ((pivot_column < 0) || (x_value == 0.0))
+            {
+                continue;
+            }
+
+            size_t lower_end = lower_start_vector[pivot_column + 1];
+
+            for (size_t q = lower_start_vector[pivot_column] + 1; q < lower_end; ++q)
+            {
+                x_vector[lower_index_vector[q]] -= m_lower_value_vector[q] * x_value;
+            }
+
+            m_flop_count += 2.0 * (double)(lower_end - lower_start_vector[pivot_column] - 1);
+        }
+
+        //--------------------------------------------------------------
+        //  Store the part of the column in the pivot rows in U, and
+        //  find the largest element in the other rows.
+        //--------------------------------------------------------------
+
+        int pivot_row = -1;
+        double largest_magnitude = -1.0;
+
+        for (p = top; p < n; ++p)
+        {
+            int row = m_reach_vector[p];
+
+            if (row_pivot_vector[row] < 0)
+            {
+                double magnitude = fabs(x_vector[row]);
+
+                if (magnitude > largest_magnitude)
+                {
+                    largest_magnitude = magnitude;
+                    pivot_row = row;
+                }
+            }
+            else
+            {
+                upper_index_vector.push_back(row_pivot_vector[row]);
+                m_upper_value_vector.push_back(x_vector[row]);
+            }
+        }
+
+        if ((pivot_row < 0) || (largest_magnitude == 0.0))
+        {
+            lower_start_vector.clear();
+            return MATRIX_SINGULAR;
+        }
+
+        if ((column < n)
+            && (row_pivot_vector[column] < 0)
+            && (m_mark_vector[column] == k)
+            && (fabs(x_vector[column]) >= m_pivot_tolerance * largest_magnitude)
+            && (x_vector[column] != 0.0))
+        {
+            pivot_row = column;
+        }
+
+        //--------------------------------------------------------------
+        //  Store the pivot in U and the rest of the column, divided by
+        //  the pivot, in L.
+        //--------------------------------------------------------------
+
+        double pivot = x_vector[pivot_row];
+
+        upper_index_vector.push_back(k);
+        m_upper_value_vector.push_back(pivot);
+        row_pivot_vector[pivot_row] = k;
+
+        lower_index_vector.push_back(pivot_row);
+        m_lower_value_vector.push_back(1.0);
+
+        for (p = top; p < n; ++p)
+        {
+            int row = m_reach_vector[p];
+
+            if (row_pivot_vector[row] < 0)
+            {
+                lower_index_vector.push_back(row);
+                m_lower_value_vector.push_back(x_vector[row] / pivot);
+                m_flop_count += 1.0;
+            }
+
+            x_vector[row] = 0.0;
+        }
+    }
+
+    lower_start_vector[n] = lower_index_vector.size();
+    upper_start_vector[n] = upper_index_vector.size();
+
+    //------------------------------------------------------------------
+    //  Number the rows of L in the pivot order.
+    //------------------------------------------------------------------
+
+    for (size_t q = 0; q < lower_index_vector.size(); ++q)
+    {
+        lower_index_vector[q] = row_pivot_vector[lower_index_vector[q]];
+    }
+
+    return SUCCESS;
+}
+
+//======================================================================
+//  Member Function: SparseLU::Refactor
+//
+//  Abstract:
+//
+//    This function computes the values of L and U using the row
+//    pivots and the nonzero patterns of L and U from an earlier
+//    factorization. The elements of each column of U are in the
+//    order in which they were found, which is a topological order,
+//    so each column is a sparse triangular solve with no search.
+//
+//    The factorization fails if the matrix has an element outside of
+//    the patterns, or if a pivot is zero or fails the threshold test
+//    with the new values. The factors are not valid after a failure.
+//
+//
+//  Input:
+//
+//    a_matrix      The matrix.
+//
+//  Output:
+//
+//    This function returns a value of type 'Status_T'.
+//
+//======================================================================
+
+SparseLU::Status_T SparseLU::Refactor(const FrozenSparseMatrix & a_matrix)
+{
+    int n = m_structure.m_n;
+    const std::vector<int> & row_pivot_vector = m_structure.m_row_pivot_vector;
+    const std::vector<size_t> & lower_start_vector = m_structure.m_lower_start_vector;
+    const std::vector<int> & lower_index_vector = m_structure.m_lower_index_vector;
+    const std::vector<size_t> & upper_start_vector = m_structure.m_upper_start_vector;
+    const std::vector<int> & upper_index_vector = m_structure.m_upper_index_vector;
+
+    m_lower_value_vector.resize(lower_index_vector.size());
+    m_upper_value_vector.resize(upper_index_vector.size());
+    m_x_vector.assign(n, 0.0);
+    m_mark_vector.assign(n, -1);
+
+    std::vector<double> & x_vector = m_x_vector;
+    size_t q = 0;
+
+    for (int k = 0; k < n; ++k)
+    {
+        size_t lower_begin = lower_start_vector[k];
+        size_t lower_end = lower_start_vector[k + 1];
+        size_t upper_begin = upper_start_vector[k];
+        size_t diagonal = upper_start_vector[k + 1] - 1;
+
+        //--------------------------------------------------------------
+        //  Mark the rows of the patterns and copy the column of the
+        //  matrix, with the rows numbered in the pivot order.
+        //--------------------------------------------------------------
+
+        for (q = upper_begin; q <= diagonal; ++q)
+        {
+            m_mark_vector[upper_index_vector[q]] = k;
+        }
+
+        for (q = lower_begin; q < lower_end; ++q)
+        {
+            m_mark_vector[lower_index_vector[q]] = k;
+        }
+
+        SparseSlice column_slice = GetOrderedColumn(a_matrix, k);
+
+        for (SparseSlice::Iterator column_iter = column_slice.begin(); column_iter != column_slice.end(); ++column_iter)
+        {
+            if (column_iter.GetIndex() < n)
+            {
+                int row = row_pivot_vector[column_iter.GetIndex()];
+
+                if (m_mark_vector[row] != k)
+                {
+                    return MATRIX_SINGULAR;
+                }
+
+                x_vector[row] = column_iter.GetValue();
+            }
+        }
+
+        //--------------------------------------------------------------
+        //  Compute the column of U.
+        //--------------------------------------------------------------
+
+        for (q = upper_begin; q < diagonal; ++q)
+        {
+            int row = upper_index_vector[q];
+            double x_value = x_vector[row];
+
+            m_upper_value_vector[q] = x_value;
+            x_vector[row] = 0.0;
+
+            if (x_value != 0.0)
+            {
+                size_t row_lower_end = lower_start_vector[row + 1];
+
+                for (size_t r = lower_start_vector[row] + 1; r < row_lower_end; ++r)
+                {
+                    x_vector[lower_index_vector[r]] -= m_lower_value_vector[r] * x_value;
+                }
+
+                m_flop_count += 2.0 * (double)(row_lower_end - lower_start_vector[row] - 1);
+            }
+        }
+
+        //--------------------------------------------------------------
+        //  Test the pivot and compute the column of L.
+        //--------------------------------------------------------------
+
+        double pivot = x_vector[k];
+        double largest_magnitude = 0.0;
+
+        x_vector[k] = 0.0;
+
+        for (q = lower_begin + 1; q < lower_end; ++q)
+        {
+            double magnitude = fabs(x_vector[lower_index_vector[q]]);
+
+            if (magnitude > largest_magnitude)
+            {
+                largest_magnitude = magnitude;
+            }
+        }
+
+        if ((pivot == 0.0) || (fabs(pivot) < m_pivot_tolerance * largest_magnitude))
+        {
+            return MATRIX_SINGULAR;
+        }
+
+        m_upper_value_vector[diagonal] = pivot;
+        m_lower_value_vector[lower_begin] = 1.0;
+
+        for (q = lower_begin + 1; q < lower_end; ++q)
+        {
+            int row = lower_index_vector[q];
+            m_lower_value_vector[q] = x_vector[row] / pivot;
+            x_vector[row] = 0.0;
+        }
+
+        m_flop_count += (double)(lower_end - lower_begin - 1);
+    }
+
+    return SUCCESS;
+}
+
+//======================================================================
+//  Member Function: SparseLU::Reach
+//
+//  Abstract:
+//
+//    This function finds the rows that are nonzero in the solution of
+//    L x = A(:, column). These are the rows that can be reached in the
+//    graph of L from the rows of the elements of the column. The rows
+//    are returned in topological order in m_reach_vector[top] to
+//    m_reach_vector[n - 1]. The depth-first search uses an explicit
+//    stack so that long paths do not overflow the call stack.
+//
+//
+//  Input:
+//
+//    column_slice      The stored elements of the column.
+//
+//    column_number     The number of the column being factored, which
+//                      marks the visited rows.
+//
+//  Output:
+//
+//    The value of 'top'.
+//
+//======================================================================
+
+int SparseLU::Reach(const SparseSlice & column_slice, int column_number)
+{
+    int n = m_structure.m_n;
+    const std::vector<int> & row_pivot_vector = m_structure.m_row_pivot_vector;
+    const std::vector<size_t> & lower_start_vector = m_structure.m_lower_start_vector;
+    const std::vector<int> & lower_index_vector = m_structure.m_lower_index_vector;
+    int top = n;
+
+    for (SparseSlice::Iterator column_iter = column_slice.begin(); column_iter != column_slice.end(); ++column_iter)
+    {
+        int start_row = column_iter.GetIndex();
+
+        if ((start_row >= n) || (m_mark_vector[start_row] == column_number))
+        {
+            continue;
+        }
+
+        int head = 0;
+        m_stack_vector[0] = start_row;
+
+        while (head >= 0)
+        {
+            int row = m_stack_vector[head];
+            int pivot_column = row_pivot_vector[row];
+
+            if (m_mark_vector[row] != column_number)
+            {
+                m_mark_vector[row] = column_number;
+                m_stack_position_vector[head] = (pivot_column < 0) ? 0 : lower_start_vector[pivot_column] + 1;
+            }
+
+            size_t lower_end = (pivot_column < 0) ? 0 : lower_start_vector[pivot_column + 1];
+            bool finished_flag = true;
+
+            for (size_t q = m_stack_position_vector[head]; q < lower_end; ++q)
+            {
+                int next_row = lower_index_vector[q];
+
+                if (m_mark_vector[next_row] != column_number)
+                {
+                    m_stack_position_vector[head] = q + 1;
+                    m_stack_vector[++head] = next_row;
+                    finished_flag = false;
+                    break;
+                }
+            }
+
+            if (finished_flag)
+            {
+                --head;
+                m_reach_vector[--top] = row;
+            }
+        }
+    }
+
+    return top;
+}
+
+//======================================================================
+//  Member Function: SparseLU::GetOrderedColumn
+//
+//  Abstract:
+//
+//    This function returns the stored elements of the column that is
+//    k'th in the column order.
+//
+//======================================================================
+
+SparseSlice SparseLU::GetOrderedColumn(const FrozenSparseMatrix & a_matrix, int k) const
+{
+    int column = m_structure.m_column_order_vector[k];
+
+    if (column >= a_matrix.GetNumberOfColumns())
+    {
+        return SparseSlice(NULL, NULL, 0);
+    }
+
+    return a_matrix.GetColumn(column);
+}
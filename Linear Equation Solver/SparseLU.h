@@ -0,0 +1,147 @@
+#ifndef SPARSELU_H
+#define SPARSELU_H
+
+#include <stddef.h>
+#include <vector>
+#include "FrozenSparseMatrix.h"
+
+//======================================================================
+//  Class Definition
+//
+//  This class computes the sparse LU factorization P A Q = L U of a
+//  square matrix and solves equations with the factors.
+//
+//  The work is split into three steps. Analyze computes the column
+//  permutation Q, which is a fill-reducing ordering computed by the
+//  ColumnOrdering class and then postordered by the column elimination
+//  tree. Factor computes the values of L and U, and Solve uses the
+//  factors to solve equations.
+//
+//  The first factorization after an analysis is left-looking, as
+//  described by Gilbert and Peierls. Each column of L and U is found
+//  by a sparse triangular solve with the columns of L that have been
+//  computed, where the nonzero pattern of the result is found first
+//  by a depth-first search, so the work is proportional to the number
+//  of floating point operations. The row permutation P is chosen by
+//  threshold partial pivoting. The diagonal element is used as the
+//  pivot if its magnitude is at least the pivot tolerance times the
+//  largest magnitude in the column, as this keeps the fill found by
+//  the column ordering. Otherwise the element of largest magnitude is
+//  used.
+//
+//  The orderings and the nonzero patterns of L and U are the factor
+//  structure. Later factorizations of a matrix with the same nonzero
+//  pattern reuse the factor structure and only compute the values,
+//  which needs no depth-first search and no pivot search. If a pivot
+//  would fail the threshold test with the new values, the matrix is
+//  factored again with pivoting. The factor structure can be saved
+//  and restored, so it can be kept between runs of the program.
+//
+//  Both L and U are stored in compressed sparse column form. L has a
+//  unit diagonal, which is stored first in each column, and the
+//  diagonal of U is stored last in each column. The rows of L and U
+//  are numbered in the pivot order.
+//======================================================================
+
+class SparseLU
+{
+public:
+
+    enum Status_T
+    {
+        SUCCESS,
+        MATRIX_SINGULAR
+    };
+
+    //------------------------------------------------------------------
+    //  The factor structure. The row pivot vector and the patterns of
+    //  L and U are empty until the matrix has been factored.
+    //------------------------------------------------------------------
+
+    struct Structure_T
+    {
+        int m_n;
+        std::vector<int> m_column_order_vector;
+        std::vector<int> m_row_pivot_vector;
+        std::vector<size_t> m_lower_start_vector;
+        std::vector<int> m_lower_index_vector;
+        std::vector<size_t> m_upper_start_vector;
+        std::vector<int> m_upper_index_vector;
+    };
+
+    SparseLU();
+
+    virtual ~SparseLU();
+
+    void SetPivotTolerance(double pivot_tolerance);
+
+    double GetPivotTolerance() const;
+
+    void Analyze(const FrozenSparseMatrix & a_matrix, int n);
+
+    Status_T Factor(const FrozenSparseMatrix & a_matrix);
+
+    void Solve(const std::vector<double> & b_vector,
+               std::vector<double> & x_vector) const;
+
+    void SolveBlock(const std::vector<double> & b_block_vector,
+                    int block_width,
+                    std::vector<double> & x_block_vector) const;
+
+    bool IsAnalyzed() const;
+
+    bool IsStructureFactored() const;
+
+    bool WasPatternReused() const;
+
+    const Structure_T & GetStructure() const;
+
+    void SwapStructure(Structure_T & structure);
+
+    int GetSize() const;
+
+    size_t GetNumberOfMatrixNonzeros() const;
+
+    size_t GetNumberOfLowerNonzeros() const;
+
+    size_t GetNumberOfUpperNonzeros() const;
+
+    size_t GetFillIn() const;
+
+    double GetFlopCount() const;
+
+protected:
+
+    void PostorderColumns(const FrozenSparseMatrix & a_matrix);
+
+    Status_T FactorWithPivoting(const FrozenSparseMatrix & a_matrix);
+
+    Status_T Refactor(const FrozenSparseMatrix & a_matrix);
+
+    int Reach(const SparseSlice & column_slice, int column_number);
+
+    SparseSlice GetOrderedColumn(const FrozenSparseMatrix & a_matrix, int k) const;
+
+protected:
+
+    Structure_T m_structure;
+    double m_pivot_tolerance;
+    bool m_analyzed_flag;
+    bool m_pattern_reused_flag;
+    size_t m_matrix_nonzeros;
+    double m_flop_count;
+    std::vector<double> m_lower_value_vector;
+    std::vector<double> m_upper_value_vector;
+
+    //------------------------------------------------------------------
+    //  Work space for the factorization.
+    //------------------------------------------------------------------
+
+    std::vector<double> m_x_vector;
+    std::vector<int> m_reach_vector;
+    std::vector<int> m_stack_vector;
+    std::vector<size_t> m_stack_position_vector;
+    std::vector<int> m_mark_vector;
+};
+
+#endif
@@ -0,0 +1,672 @@
+#include <math.h>
+#include <algorithm>
+#include <utility>
+#include "CompressedSparseMatrix.h"
+#include "SubstitutionPresolve.h"
+
+namespace
+{
+    //------------------------------------------------------------------
+    //  A doubleton is only used to eliminate a variable that is in at
+    //  most this many other equations, because the other variable of
+    //  the doubleton can be added to each of them.
+    //------------------------------------------------------------------
+
+    const size_t f_MAXIMUM_SUBSTITUTION_COUNT = 16;
+
+    //------------------------------------------------------------------
+    //  The variable with the smaller coefficient of a doubleton is only
+    //  eliminated if its coefficient is at least this fraction of the
+    //  other coefficient, which bounds the multipliers of the other
+    //  variable.
+    //------------------------------------------------------------------
+
+    const double f_SUBSTITUTION_PIVOT_TOLERANCE = 0.1;
+}
+
+//======================================================================
+//  Constructor: SubstitutionPresolve::SubstitutionPresolve
+//======================================================================
+
+SubstitutionPresolve::SubstitutionPresolve()
+  : m_n(0),
+    m_number_of_right_hand_sides(0),
+    m_number_of_singletons(0),
+    m_number_of_substitutions(0)
+{
+}
+
+//======================================================================
+//  Destructor: SubstitutionPresolve::~SubstitutionPresolve
+//======================================================================
+
+SubstitutionPresolve::~SubstitutionPresolve()
+{
+}
+
+//======================================================================
+//  Member Function: SubstitutionPresolve::Reduce
+//
+//  Abstract:
+//
+//    This function eliminates variables with the singleton and
+//    doubleton equations and makes the reduced system.
+//
+//
+//  Input:
+//
+//    number_of_equations       The number of equations and variables.
+//                              Only the elements in the first
+//                              number_of_equations rows and columns
+//                              of A are used.
+//
+//    a_matrix                  The A matrix.
+//
+//    b_vectors                 The B vectors, one after another. Each
+//                              vector has number_of_equations
+//                              elements.
+//
+//    number_of_right_hand_sides    The number of B vectors.
+//
+//  Output:
+//
+//    This function returns a value of type 'int' that is the number
+//    of eliminated variables.
+//
+//======================================================================
+
+int SubstitutionPresolve::Reduce(unsigned int number_of_equations,
+                                 const FrozenSparseMatrix & a_matrix,
+                                 const std::vector<double> & b_vectors,
+                                 int number_of_right_hand_sides)
+{
+    int n = (int)(number_of_equations);
+    int number_of_rows = std::min(n, a_matrix.GetNumberOfRows());
+    int row = 0;
+
+    m_n = n;
+    m_number_of_right_hand_sides = number_of_right_hand_sides;
+    m_number_of_singletons = 0;
+    m_number_of_substitutions = 0;
+    m_step_vector.clear();
+    m_step_b_vector.clear();
+    m_candidate_row_vector.clear();
+
+    //------------------------------------------------------------------
+    //  Copy the elements of A that are not zero to the working system.
+    //------------------------------------------------------------------
+
+    m_row_element_vector.assign(n, std::vector<Element_T>());
+    m_column_row_vector.assign(n, std::vector<int>());
+    m_row_active_vector.assign(n, true);
+    m_column_active_vector.assign(n, true);
+    m_b_vectors.assign(b_vectors.begin(), b_vectors.begin() + (size_t)(n) * number_of_right_hand_sides);
+
+    for (row = 0; row < number_of_rows; ++row)
+    {
+        SparseSlice row_slice = a_matrix.GetRow(row);
+
+        for (SparseSlice::Iterator row_iter = row_slice.begin(); row_iter != row_slice.end(); ++row_iter)
+        {
+            if ((row_iter.GetIndex() < n) && (row_iter.GetValue() != 0.0))
+            {
+                Element_T element;
+                element.m_column = row_iter.GetIndex();
+                element.m_value = row_iter.GetValue();
+                m_row_element_vector[row].push_back(element);
+                m_column_row_vector[element.m_column].push_back(row);
+            }
+        }
+    }
+
+    //------------------------------------------------------------------
+    //  Eliminate with each candidate equation in turn. An elimination
+    //  adds the equations that it leaves with one or two variables to
+    //  the candidates.
+    //------------------------------------------------------------------
+
+    for (row = 0; row < n; ++row)
+    {
+        if ((m_row_element_vector[row].size() == 1) || (m_row_element_vector[row].size() == 2))
+        {
+            m_candidate_row_vector.push_back(row);
+        }
+    }
+
+    for (size_t next_candidate = 0; next_candidate < m_candidate_row_vector.size(); ++next_candidate)
+    {
+        row = m_candidate_row_vector[next_candidate];
+
+        if (! m_row_active_vector[row])
+        {
+            continue;
+        }
+
+        if (m_row_element_vector[row].size() == 1)
+        {
+            EliminateSingleton(row);
+        }
+        else if (m_row_element_vector[row].size() == 2)
+        {
+            EliminateDoubleton(row);
+        }
+    }
+
+    std::vector<int>().swap(m_candidate_row_vector);
+
+    MakeReducedSystem();
+
+    return GetNumberOfEliminatedVariables();
+}
+
+//======================================================================
+//  Member Function: SubstitutionPresolve::GetReducedNumberOfEquations
+//======================================================================
+
+unsigned int SubstitutionPresolve::GetReducedNumberOfEquations() const
+{
+    return (unsigned int)(m_reduced_row_vector.size());
+}
+
+//======================================================================
+//  Member Function: SubstitutionPresolve::GetReducedMatrix
+//======================================================================
+
+const FrozenSparseMatrix & SubstitutionPresolve::GetReducedMatrix() const
+{
+    return m_reduced_matrix;
+}
+
+//======================================================================
+//  Member Function: SubstitutionPresolve::GetReducedRightHandSides
+//
+//  Abstract:
+//
+//    This function returns the B vectors of the reduced system, one
+//    after another.
+//
+//======================================================================
+
+const std::vector<double> & SubstitutionPresolve::GetReducedRightHandSides() const
+{
+    return m_reduced_b_vectors;
+}
+
+//======================================================================
+//  Member Function: SubstitutionPresolve::Restore
+//
+//  Abstract:
+//
+//    This function makes the solutions of the original system from
+//    the solutions of the reduced system.
+//
+//
+//  Input:
+//
+//    reduced_x_vectors     The solutions of the reduced system, one
+//                          after another.
+//
+//    x_vectors             The solutions of the original system,
+//                          stored in the same way.
+//
+//  Output:
+//
+//    This function has no return value.
+//
+//======================================================================
+
+void SubstitutionPresolve::Restore(const std::vector<double> & reduced_x_vectors,
+                                   std::vector<double> & x_vectors) const
+{
+    size_t n = (size_t)(m_n);
+    size_t m = m_reduced_column_vector.size();
+    int number_of_right_hand_sides = m_number_of_right_hand_sides;
+    int r = 0;
+
+    x_vectors.assign(n * number_of_right_hand_sides, 0.0);
+
+    for (r = 0; r < number_of_right_hand_sides; ++r)
+    {
+        for (size_t j = 0; j < m; ++j)
+        {
+            x_vectors[n * r + m_reduced_column_vector[j]] = reduced_x_vectors[m * r + j];
+        }
+    }
+
+    //------------------------------------------------------------------
+    //  The other variable of a doubleton was eliminated later than the
+    //  variable of the doubleton, if at all, so it is known here.
+    //------------------------------------------------------------------
+
+    for (size_t s = m_step_vector.size(); s-- > 0; )
+    {
+        const Step_T & step = m_step_vector[s];
+
+        for (r = 0; r < number_of_right_hand_sides; ++r)
+        {
+            double value = m_step_b_vector[s * number_of_right_hand_sides + r];
+
+            if (step.m_other_column != -1)
+            {
+                value -= step.m_other_value * x_vectors[n * r + step.m_other_column];
+            }
+
+            x_vectors[n * r + step.m_column] = value / step.m_pivot;
+        }
+    }
+
+    return;
+}
+
+//======================================================================
+//  Member Function: SubstitutionPresolve::GetNumberOfEliminatedVariables
+//======================================================================
+
+int SubstitutionPresolve::GetNumberOfEliminatedVariables() const
+{
+    return (int)(m_step_vector.size());
+}
+
+//======================================================================
+//  Member Function: SubstitutionPresolve::GetNumberOfSingletons
+//======================================================================
+
+int SubstitutionPresolve::GetNumberOfSingletons() const
+{
+    return m_number_of_singletons;
+}
+
+//======================================================================
+//  Member Function: SubstitutionPresolve::GetNumberOfSubstitutions
+//======================================================================
+
+int SubstitutionPresolve::GetNumberOfSubstitutions() const
+{
+    return m_number_of_substitutions;
+}
+
+//======================================================================
+//  Member Function: SubstitutionPresolve::EliminateSingleton
+//
+//  Abstract:
+//
+//    This function eliminates the variable of an equation with one
+//    variable. The value of the variable times its coefficient is
+//    subtracted from the right side of every other equation with the
+//    variable.
+//
+//
+//  Input:
+//
+//    row                   The equation.
+//
+//  Output:
+//
+//    This function has no return value.
+//
+//======================================================================
+
+void SubstitutionPresolve::EliminateSingleton(int row)
+{
+    size_t n = (size_t)(m_n);
+    Element_T element = m_row_element_vector[row][0];
+    int r = 0;
+
+    Step_T step;
+    step.m_row = row;
+    step.m_column = element.m_column;
+    step.m_pivot = element.m_value;
+    step.m_other_column = -1;
+    step.m_other_value = 0.0;
+    m_step_vector.push_back(step);
+
+    for (r = 0; r < m_number_of_right_hand_sides; ++r)
+    {
+        m_step_b_vector.push_back(m_b_vectors[n * r + row]);
+    }
+
+    m_row_active_vector[row] = false;
+    m_column_active_vector[element.m_column] = false;
+    m_row_element_vector[row].clear();
+
+    std::vector<int> & column_row_vector = m_column_row_vector[element.m_column];
+
+    for (size_t k = 0; k < column_row_vector.size(); ++k)
+    {
+        int other_row = column_row_vector[k];
+        double value = 0.0;
+
+        if (m_row_active_vector[other_row])
+        {
+            RemoveElement(other_row, element.m_column, value);
+
+            if (value != 0.0)
+            {
+                for (r = 0; r < m_number_of_right_hand_sides; ++r)
+                {
+                    m_b_vectors[n * r + other_row] -= value * (m_b_vectors[n * r + row] / element.m_value);
+                }
+
+                if (m_row_element_vector[other_row].size() <= 2)
+                {
+                    m_candidate_row_vector.push_back(other_row);
+                }
+            }
+        }
+    }
+
+    std::vector<int>().swap(column_row_vector);
+
+    ++m_number_of_singletons;
+
+    return;
+}
+
+//======================================================================
+//  Member Function: SubstitutionPresolve::EliminateDoubleton
+//
+//  Abstract:
+//
+//    This function eliminates a variable of an equation with two
+//    variables. The variable with the larger coefficient is chosen
+//    unless it is in too many other equations. In every other
+//    equation with the variable, the variable is replaced by the
+//    other variable and a constant.
+//
+//
+//  Input:
+//
+//    row                   The equation.
+//
+//  Output:
+//
+//    This function returns a value of type 'bool' that is false if
+//    neither variable can be eliminated.
+//
+//======================================================================
+
+bool SubstitutionPresolve::EliminateDoubleton(int row)
+{
+    size_t n = (size_t)(m_n);
+    Element_T pivot_element = m_row_element_vector[row][0];
+    Element_T other_element = m_row_element_vector[row][1];
+    bool found_flag = false;
+    int r = 0;
+
+    if (fabs(other_element.m_value) > fabs(pivot_element.m_value))
+    {
+        std::swap(pivot_element, other_element);
+    }
+
+    for (int choice = 0; (choice < 2) && (! found_flag); ++choice)
+    {
+        if (choice == 1)
+        {
+            if (fabs(other_element.m_value) < f_SUBSTITUTION_PIVOT_TOLERANCE * fabs(pivot_element.m_value))
+            {
+                break;
+            }
+
+            std::swap(pivot_element, other_element);
+        }
+
+        //--------------------------------------------------------------
+        //  Count the other equations with the variable, and remove the
+        //  rows that no longer have the variable from its row list.
+        //--------------------------------------------------------------
+
+        std::vector<int> & column_row_vector = m_column_row_vector[pivot_element.m_column];
+        size_t number_of_kept_rows = 0;
+
+        for (size_t k = 0; k < column_row_vector.size(); ++k)
+        {
+            int other_row = column_row_vector[k];
+
+            if (m_row_active_vector[other_row])
+            {
+                const std::vector<Element_T> & element_vector = m_row_element_vector[other_row];
+
+                for (size_t q = 0; q < element_vector.size(); ++q)
+                {
+                    if (element_vector[q].m_column == pivot_element.m_column)
+                    {
+                        column_row_vector[number_of_kept_rows++] = other_row;
+                        break;
+                    }
+                }
+            }
+        }
+
+        column_row_vector.resize(number_of_kept_rows);
+
+        found_flag = number_of_kept_rows <= f_MAXIMUM_SUBSTITUTION_COUNT + 1;
+    }
+
+    if (! found_flag)
+    {
+        return false;
+    }
+
+    Step_T step;
+    step.m_row = row;
+    step.m_column = pivot_element.m_column;
+    step.m_pivot = pivot_element.m_value;
+    step.m_other_column = other_element.m_column;
+    step.m_other_value = other_element.m_value;
+    m_step_vector.push_back(step);
+
+    for (r = 0; r < m_number_of_right_hand_sides; ++r)
+    {
+        m_step_b_vector.push_back(m_b_vectors[n * r + row]);
+    }
+
+    m_row_active_vector[row] = false;
+    m_column_active_vector[pivot_element.m_column] = false;
+    m_row_element_vector[row].clear();
+
+    //------------------------------------------------------------------
+    //  Replace the variable in the other equations. The replacement
+    //  only adds to the row lists of the other variable.
+    //------------------------------------------------------------------
+
+    double ratio = other_element.m_value / pivot_element.m_value;
+    std::vector<int> & column_row_vector = m_column_row_vector[pivot_element.m_column];
+
+    for (size_t k = 0; k < column_row_vector.size(); ++k)
+    {
+        int other_row = column_row_vector[k];
+        double value = 0.0;
+
+        if (m_row_active_vector[other_row])
+        {
+            RemoveElement(other_row, pivot_element.m_column, value);
+
+            if (value != 0.0)
+            {
+                AddToElement(other_row, other_element.m_column, -value * ratio);
+
+                for (r = 0; r < m_number_of_right_hand_sides; ++r)
+                {
+                    m_b_vectors[n * r + other_row] -= value * (m_b_vectors[n * r + row] / pivot_element.m_value);
+                }
+
+                if (m_row_element_vector[other_row].size() <= 2)
+                {
+                    m_candidate_row_vector.push_back(other_row);
+                }
+            }
+        }
+    }
+
+    std::vector<int>().swap(column_row_vector);
+
+    ++m_number_of_substitutions;
+
+    return true;
+}
+
+//======================================================================
+//  Member Function: SubstitutionPresolve::RemoveElement
+//
+//  Abstract:
+//
+//    This function removes an element from a row of the working
+//    system and returns its value, or zero if the row has no element
+//    in the column.
+//
+//======================================================================
+
+void SubstitutionPresolve::RemoveElement(int row, int column, double & value)
+{
+    std::vector<Element_T> & element_vector = m_row_element_vector[row];
+
+    value = 0.0;
+
+    for (size_t q = 0; q < element_vector.size(); ++q)
+    {
+        if (element_vector[q].m_column == column)
+        {
+            value = element_vector[q].m_value;
+            element_vector[q] = element_vector.back();
+            element_vector.pop_back();
+            break;
+        }
+    }
+
+    return;
+}
+
+//======================================================================
+//  Member Function: SubstitutionPresolve::AddToElement
+//
+//  Abstract:
+//
+//    This function adds a value to an element of a row of the working
+//    system, adding the element if the row does not have it. An
+//    element whose value becomes zero is removed.
+//
+//======================================================================
+
+void SubstitutionPresolve::AddToElement(int row, int column, double value)
+{
+    std::vector<Element_T> & element_vector = m_row_element_vector[row];
+
+    for (size_t q = 0; q < element_vector.size(); ++q)
+    {
+        if (element_vector[q].m_column == column)
+        {
+            element_vector[q].m_value += value;
+
+            if (element_vector[q].m_value == 0.0)
+            {
+                element_vector[q] = element_vector.back();
+                element_vector.pop_back();
+            }
+
+            return;
+        }
+    }
+
+    Element_T element;
+    element.m_column = column;
+    element.m_value = value;
+    element_vector.push_back(element);
+    m_column_row_vector[column].push_back(row);
+
+    return;
+}
+
+//======================================================================
+//  Member Function: SubstitutionPresolve::MakeReducedSystem
+//
+//  Abstract:
+//
+//    This function copies the equations and variables that were not
+//    eliminated to the reduced system, and frees the working system.
+//
+//======================================================================
+
+void SubstitutionPresolve::MakeReducedSystem()
+{
+    size_t n = (size_t)(m_n);
+    int i = 0;
+
+    std::vector<int> reduced_index_vector(n, -1);
+
+    m_reduced_row_vector.clear();
+    m_reduced_column_vector.clear();
+
+    for (i = 0; i < m_n; ++i)
+    {
+        if (m_row_active_vector[i])
+        {
+            m_reduced_row_vector.push_back(i);
+        }
+
+        if (m_column_active_vector[i])
+        {
+            reduced_index_vector[i] = (int)(m_reduced_column_vector.size());
+            m_reduced_column_vector.push_back(i);
+        }
+    }
+
+    size_t m = m_reduced_row_vector.size();
+    std::vector<size_t> row_start_vector(1, 0);
+    std::vector<int> column_index_vector;
+    std::vector<double> value_vector;
+    std::vector< std::pair<int, double> > element_vector;
+
+    row_start_vector.reserve(m + 1);
+
+    for (size_t k = 0; k < m; ++k)
+    {
+        const std::vector<Element_T> & row_element_vector = m_row_element_vector[m_reduced_row_vector[k]];
+
+        element_vector.clear();
+
+        for (size_t q = 0; q < row_element_vector.size(); ++q)
+        {
+            element_vector.push_back(std::make_pair(reduced_index_vector[row_element_vector[q].m_column],
+                                                    row_element_vector[q].m_value));
+        }
+
+        std::sort(element_vector.begin(), element_vector.end());
+
+        for (size_t q = 0; q < element_vector.size(); ++q)
+        {
+            column_index_vector.push_back(element_vector[q].first);
+            value_vector.push_back(element_vector[q].second);
+        }
+
+        row_start_vector.push_back(column_index_vector.size());
+    }
+
+    CompressedSparseMatrix row_matrix;
+    row_matrix.Assign((int)(m),
+                      (int)(m_reduced_column_vector.size()),
+                      row_start_vector,
+                      column_index_vector,
+                      value_vector);
+
+    m_reduced_matrix.Freeze(row_matrix);
+
+    m_reduced_b_vectors.resize(m * m_number_of_right_hand_sides);
+
+    for (int r = 0; r < m_number_of_right_hand_sides; ++r)
+    {
+        for (size_t k = 0; k < m; ++k)
+        {
+            m_reduced_b_vectors[m * r + k] = m_b_vectors[n * r + m_reduced_row_vector[k]];
+        }
+    }
+
+    //------------------------------------------------------------------
+    //  Free the working system.
+    //------------------------------------------------------------------
+
+    std::vector< std::vector<Element_T> >().swap(m_row_element_vector);
+    std::vector< std::vector<int> >().swap(m_column_row_vector);
+    std::vector<double>().swap(m_b_vectors);
+
+    return;
+}
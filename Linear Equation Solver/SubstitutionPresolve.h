@@ -0,0 +1,139 @@
+#ifndef SUBSTITUTIONPRESOLVE_H
+#define SUBSTITUTIONPRESOLVE_H
+
+#include <stddef.h>
+#include <vector>
+#include "FrozenSparseMatrix.h"
+
+//======================================================================
+//  Class Definition
+//
+//  This class shrinks the simultaneous linear equations A x = B before
+//  they are factored, by eliminating variables with equations that
+//  have one or two variables.
+//
+//  An equation with one variable, such as "X = 5", is a singleton.
+//  It gives the value of the variable, which is moved to the right
+//  side of every other equation with the variable. An equation with
+//  two variables, such as "X = 2 Y + 1", is a doubleton. The variable
+//  with the larger coefficient is replaced in every other equation by
+//  the other variable and a constant. The replacement can add an
+//  element to an equation, so a doubleton is only used if the
+//  variable is in few other equations. Both kinds of elimination
+//  remove one equation and one variable and can make other equations
+//  singletons or doubletons, so the eliminations are repeated until
+//  no equation with one or two variables is left.
+//
+//  The equations and variables that are left are the reduced system,
+//  which keeps the order of the equations and of the variables. After
+//  the reduced system is solved, Restore finds the eliminated
+//  variables by solving the eliminating equations in the reverse
+//  order of the eliminations.
+//
+//  Each elimination removes one equation and one variable, so the
+//  reduced system is square if and only if the original system is.
+//  An equation whose variables are all eliminated is left in the
+//  reduced system as an empty equation, so a singular system stays
+//  singular.
+//======================================================================
+
+class SubstitutionPresolve
+{
+public:
+
+    SubstitutionPresolve();
+
+    virtual ~SubstitutionPresolve();
+
+    int Reduce(unsigned int number_of_equations,
+               const FrozenSparseMatrix & a_matrix,
+               const std::vector<double> & b_vectors,
+               int number_of_right_hand_sides);
+
+    unsigned int GetReducedNumberOfEquations() const;
+
+    const FrozenSparseMatrix & GetReducedMatrix() const;
+
+    const std::vector<double> & GetReducedRightHandSides() const;
+
+    void Restore(const std::vector<double> & reduced_x_vectors,
+                 std::vector<double> & x_vectors) const;
+
+    int GetNumberOfEliminatedVariables() const;
+
+    int GetNumberOfSingletons() const;
+
+    int GetNumberOfSubstitutions() const;
+
+protected:
+
+    struct Element_T
+    {
+        int m_column;
+        double m_value;
+    };
+
+    //------------------------------------------------------------------
+    //  One elimination. The variable in m_column was eliminated with
+    //  the equation in m_row, where its coefficient is m_pivot. For a
+    //  doubleton, m_other_column is the other variable and
+    //  m_other_value is its coefficient, otherwise m_other_column is
+    //  -1. The right side of the equation for each B vector is stored
+    //  in m_step_b_vector.
+    //------------------------------------------------------------------
+
+    struct Step_T
+    {
+        int m_row;
+        int m_column;
+        double m_pivot;
+        int m_other_column;
+        double m_other_value;
+    };
+
+    void EliminateSingleton(int row);
+
+    bool EliminateDoubleton(int row);
+
+    void RemoveElement(int row, int column, double & value);
+
+    void AddToElement(int row, int column, double value);
+
+    void MakeReducedSystem();
+
+protected:
+
+    int m_n;
+    int m_number_of_right_hand_sides;
+    int m_number_of_singletons;
+    int m_number_of_substitutions;
+
+    //------------------------------------------------------------------
+    //  The working system. Each row holds the elements of the active
+    //  columns. The row list of a column can hold rows that no longer
+    //  have an element in the column.
+    //------------------------------------------------------------------
+
+    std::vector< std::vector<Element_T> > m_row_element_vector;
+    std::vector< std::vector<int> > m_column_row_vector;
+    std::vector<bool> m_row_active_vector;
+    std::vector<bool> m_column_active_vector;
+    std::vector<double> m_b_vectors;
+    std::vector<int> m_candidate_row_vector;
+
+    std::vector<Step_T> m_step_vector;
+    std::vector<double> m_step_b_vector;
+
+    //------------------------------------------------------------------
+    //  The reduced system. Row i of the reduced system is row
+    //  m_reduced_row_vector[i] of A, and column j is column
+    //  m_reduced_column_vector[j].
+    //------------------------------------------------------------------
+
+    std::vector<int> m_reduced_row_vector;
+    std::vector<int> m_reduced_column_vector;
+    FrozenSparseMatrix m_reduced_matrix;
+    std::vector<double> m_reduced_b_vectors;
+};
+
+#endif
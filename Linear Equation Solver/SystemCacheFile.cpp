@@ -0,0 +1,626 @@
+#include <stdio.h>
+#include <string.h>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include "SystemCacheFile.h"
+#include "MappedFile.h"
+#include "CacheFileSection.h"
+
+namespace
+{
+    //------------------------------------------------------------------
+    //  The cache file identification and format version. Change the
+    //  version whenever the layout of the file changes.
+    //------------------------------------------------------------------
+
+    const char f_CACHE_MAGIC[8] = { 'L', 'E', 'S', 'C', 'A', 'C', 'H', 'E' };
+    const uint32_t f_CACHE_VERSION = 2;
+
+    //------------------------------------------------------------------
+    //  Mixing functions for the content hash.
+    //------------------------------------------------------------------
+
+    uint64_t RotateLeft(uint64_t value, int shift)
+    {
+        return (value << shift) | (value >> (64 - shift));
+    }
+
+    uint64_t MixWord(uint64_t hash, uint64_t word)
+    {
+        hash ^= word * 0x9E3779B97F4A7C15ULL;
+        return RotateLeft(hash, 31) * 0xC2B2AE3D27D4EB4FULL;
+    }
+}
+
+//======================================================================
+//  Member Function: SystemCacheFile::GetSourceStamp
+//
+//  Abstract:
+//
+//    This function gets the size, the modification time and the
+//    content hash of an equation file.
+//
+//
+//  Input:
+//
+//    source_file_name_ptr  A pointer to the name of the equation file.
+//
+//    source_stamp          The returned file stamp.
+//
+//
+//  Output:
+//
+//    This function returns a value of type 'bool' that is the value
+//    true if and only if the file exists and was read.
+//
+//======================================================================
+
+bool SystemCacheFile::GetSourceStamp(const char * source_file_name_ptr,
+                                     SourceStamp_T & source_stamp)
+{
+#ifdef _WIN32
+    struct __stat64 file_status;
+
+    if (_stat64(source_file_name_ptr, &file_status) != 0)
+    {
+        return false;
+    }
+#else
+    struct stat file_status;
+
+    if (stat(source_file_name_ptr, &file_status) != 0)
+    {
+        return false;
+    }
+#endif
+
+    MappedFile source_file;
+
+    if (! source_file.Open(source_file_name_ptr))
+    {
+        return false;
+    }
+
+    source_stamp.m_size = (uint64_t)(source_file.GetSize());
+    source_stamp.m_modification_time = (int64_t)(file_status.st_mtime);
+    source_stamp.m_content_hash = HashContent(source_file.GetData(), source_file.GetSize());
+
+    return true;
+}
+
+//======================================================================
+//  Member Function: SystemCacheFile::Write
+//
+//  Abstract:
+//
+//    This function writes a parsed system of equations to a cache
+//    file. The file is written under a temporary name and then
+//    renamed, so a partly written cache file is never read.
+//
+//
+//  Input:
+//
+//    cache_file_name_ptr   A pointer to the name of the cache file.
+//
+//    source_stamp          The stamp of the equation file.
+//
+//    symbol_table          The variable names.
+//
+//    a_matrix              The A matrix.
+//
+//    b_vector              The B vector.
+//
+//    right_hand_side_matrix    The extra right-hand sides, one in each
+//                              row.
+//
+//    number_of_equations   The number of equations.
+//
+//
+//  Output:
+//
+//    This function returns a value of type 'bool' that is the value
+//    true if and only if the cache file was written.
+//
+//======================================================================
+
+bool SystemCacheFile::Write(const char * cache_file_name_ptr,
+                            const SourceStamp_T & source_stamp,
+                            const VariableSymbolTable & symbol_table,
+                            const CompressedSparseMatrix & a_matrix,
+                            const MatrixPackage::SparseVector & b_vector,
+                            const CompressedSparseMatrix & right_hand_side_matrix,
+                            unsigned int number_of_equations)
+{
+    //------------------------------------------------------------------
+    //  Gather the variable names and the B vector into arrays.
+    //------------------------------------------------------------------
+
+    unsigned int number_of_variables = symbol_table.GetSize();
+    std::vector<uint64_t> name_offset_vector(number_of_variables + 1, 0);
+    std::vector<char> name_arena;
+    unsigned int i = 0;
+
+    for (i = 0; i < number_of_variables; ++i)
+    {
+        CharSpan name_span = symbol_table.GetName((int)(i));
+        name_arena.insert(name_arena.end(), name_span.Data(), name_span.Data() + name_span.Length());
+        name_offset_vector[i + 1] = name_arena.size();
+    }
+
+    std::vector<int32_t> b_index_vector;
+    std::vector<double> b_value_vector;
+
+    for (MatrixPackage::SparseVector::const_iterator b_iter = b_vector.begin();
+         b_iter != b_vector.end();
+         ++b_iter)
+    {
+        b_index_vector.push_back((int32_t)(b_iter->first));
+        b_value_vector.push_back(b_iter->second);
+    }
+
+    //------------------------------------------------------------------
+    //  Lay out the file.
+    //------------------------------------------------------------------
+
+    Header_T header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.m_magic, f_CACHE_MAGIC, sizeof(header.m_magic));
+    header.m_version = f_CACHE_VERSION;
+    header.m_header_size = (uint32_t)(sizeof(Header_T));
+    header.m_source_stamp = source_stamp;
+    header.m_number_of_equations = number_of_equations;
+    header.m_number_of_variables = number_of_variables;
+    header.m_number_of_b_elements = b_index_vector.size();
+    header.m_name_arena_size = name_arena.size();
+
+    header.m_name_offset_offset = CacheFileSection::AlignOffset(sizeof(Header_T));
+    header.m_name_arena_offset = CacheFileSection::AlignOffset(header.m_name_offset_offset + name_offset_vector.size() * sizeof(uint64_t));
+    header.m_b_index_offset = LayOutMatrix(a_matrix,
+                                           CacheFileSection::AlignOffset(header.m_name_arena_offset + name_arena.size()),
+                                           header.m_a_matrix_section);
+    header.m_b_value_offset = CacheFileSection::AlignOffset(header.m_b_index_offset + b_index_vector.size() * sizeof(int32_t));
+    header.m_file_size = LayOutMatrix(right_hand_side_matrix,
+                                      CacheFileSection::AlignOffset(header.m_b_value_offset + b_value_vector.size() * sizeof(double)),
+                                      header.m_right_hand_side_section);
+
+    //------------------------------------------------------------------
+    //  Write the file under a temporary name.
+    //------------------------------------------------------------------
+
+    std::string temporary_file_name = std::string(cache_file_name_ptr) + ".tmp";
+    std::ofstream cache_file(temporary_file_name.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+
+    if (cache_file.fail())
+    {
+        return false;
+    }
+
+    uint64_t position = 0;
+
+    CacheFileSection::Write(cache_file, &header, sizeof(header), position);
+    CacheFileSection::Write(cache_file, name_offset_vector.data(), name_offset_vector.size() * sizeof(uint64_t), position);
+    CacheFileSection::Write(cache_file, name_arena.data(), name_arena.size(), position);
+    WriteMatrix(cache_file, a_matrix, position);
+    CacheFileSection::Write(cache_file, b_index_vector.data(), b_index_vector.size() * sizeof(int32_t), position);
+    CacheFileSection::Write(cache_file, b_value_vector.data(), b_value_vector.size() * sizeof(double), position);
+    WriteMatrix(cache_file, right_hand_side_matrix, position);
+
+    cache_file.close();
+
+    if (cache_file.fail() || (position != header.m_file_size))
+    {
+        remove(temporary_file_name.c_str());
+        return false;
+    }
+
+    //------------------------------------------------------------------
+    //  Replace any previous cache file.
+    //------------------------------------------------------------------
+
+    return CacheFileSection::ReplaceFile(temporary_file_name.c_str(), cache_file_name_ptr);
+}
+
+//======================================================================
+//  Member Function: SystemCacheFile::Read
+//
+//  Abstract:
+//
+//    This function reads a parsed system of equations from a cache
+//    file. The cache file is memory-mapped and checked before any
+//    output is changed, then each array is copied once out of the
+//    mapped file, which is closed on return. The cache file is not
+//    used if it has a different format version, if it was made from
+//    an equation file with a different stamp, or if it is damaged.
+//
+//
+//  Input:
+//
+//    cache_file_name_ptr   A pointer to the name of the cache file.
+//
+//    source_stamp          The stamp of the current equation file.
+//
+//    symbol_table          The variable names are inserted into this
+//                          empty symbol table in index order.
+//
+//    a_matrix              The A matrix.
+//
+//    b_vector              The B vector. Any existing elements are
+//                          removed.
+//
+//    right_hand_side_matrix    The extra right-hand sides, one in each
+//                              row.
+//
+//    number_of_equations   The number of equations.
+//
+//
+//  Output:
+//
+//    This function returns a value of type 'bool' that is the value
+//    true if and only if the system was read from the cache file.
+//
+//======================================================================
+
+bool SystemCacheFile::Read(const char * cache_file_name_ptr,
+                           const SourceStamp_T & source_stamp,
+                           VariableSymbolTable & symbol_table,
+                           CompressedSparseMatrix & a_matrix,
+                           MatrixPackage::SparseVector & b_vector,
+                           CompressedSparseMatrix & right_hand_side_matrix,
+                           unsigned int & number_of_equations)
+{
+    MappedFile cache_file;
+
+    if ((! cache_file.Open(cache_file_name_ptr)) || (cache_file.GetSize() < sizeof(Header_T)))
+    {
+        return false;
+    }
+
+    //------------------------------------------------------------------
+    //  Check the header.
+    //------------------------------------------------------------------
+
+    const char * data_ptr = cache_file.GetData();
+    uint64_t file_size = cache_file.GetSize();
+
+    Header_T header;
+    memcpy(&header, data_ptr, sizeof(header));
+
+    if ((memcmp(header.m_magic, f_CACHE_MAGIC, sizeof(header.m_magic)) != 0)
+        || (header.m_version != f_CACHE_VERSION)
+        || (header.m_header_size != sizeof(Header_T))
+        || (header.m_file_size != file_size)
+        || (header.m_source_stamp.m_size != source_stamp.m_size)
+        || (header.m_source_stamp.m_modification_time != source_stamp.m_modification_time)
+        || (header.m_source_stamp.m_content_hash != source_stamp.m_content_hash))
+    {
+        return false;
+    }
+
+    if ((! CacheFileSection::IsInFile(header.m_name_offset_offset, (uint64_t)(header.m_number_of_variables) + 1, sizeof(uint64_t), file_size))
+        || (! CacheFileSection::IsInFile(header.m_name_arena_offset, header.m_name_arena_size, 1, file_size))
+        || (! CacheFileSection::IsInFile(header.m_b_index_offset, header.m_number_of_b_elements, sizeof(int32_t), file_size))
+        || (! CacheFileSection::IsInFile(header.m_b_value_offset, header.m_number_of_b_elements, sizeof(double), file_size))
+        || (! IsValidMatrix(data_ptr, file_size, header.m_a_matrix_section))
+        || (! IsValidMatrix(data_ptr, file_size, header.m_right_hand_side_section)))
+    {
+        return false;
+    }
+
+    //------------------------------------------------------------------
+    //  Check the variable names and the B vector.
+    //------------------------------------------------------------------
+
+    const uint64_t * name_offset_array = (const uint64_t *)(data_ptr + header.m_name_offset_offset);
+    const char * name_arena_ptr = data_ptr + header.m_name_arena_offset;
+    const int32_t * b_index_array = (const int32_t *)(data_ptr + header.m_b_index_offset);
+    const double * b_value_array = (const double *)(data_ptr + header.m_b_value_offset);
+
+    uint64_t i = 0;
+
+    if ((name_offset_array[0] != 0)
+        || (name_offset_array[header.m_number_of_variables] != header.m_name_arena_size))
+    {
+        return false;
+    }
+
+    for (i = 0; i < header.m_number_of_variables; ++i)
+    {
+        if (name_offset_array[i + 1] <= name_offset_array[i])
+        {
+            return false;
+        }
+    }
+
+    for (i = 0; i < header.m_number_of_b_elements; ++i)
+    {
+        if (b_index_array[i] < 0)
+        {
+            return false;
+        }
+    }
+
+    //------------------------------------------------------------------
+    //  Insert the variable names in index order.
+    //------------------------------------------------------------------
+
+    symbol_table.Clear();
+    symbol_table.Reserve(header.m_number_of_variables);
+
+    for (i = 0; i < header.m_number_of_variables; ++i)
+    {
+        CharSpan name_span(name_arena_ptr + name_offset_array[i],
+                           (unsigned int)(name_offset_array[i + 1] - name_offset_array[i]));
+
+        if (symbol_table.FindOrInsert(name_span) != (int)(i))
+        {
+            symbol_table.Clear();
+            return false;
+        }
+    }
+
+    //------------------------------------------------------------------
+    //  Copy the matrices and the vector.
+    //------------------------------------------------------------------
+
+    CopyMatrix(data_ptr, header.m_a_matrix_section, a_matrix);
+    CopyMatrix(data_ptr, header.m_right_hand_side_section, right_hand_side_matrix);
+
+    b_vector.clear();
+
+    for (i = 0; i < header.m_number_of_b_elements; ++i)
+    {
+        b_vector.insert(b_vector.end(),
+                        MatrixPackage::SparseVector::value_type(b_index_array[i], b_value_array[i]));
+    }
+
+    number_of_equations = header.m_number_of_equations;
+
+    return true;
+}
+
+//======================================================================
+//  Member Function: SystemCacheFile::LayOutMatrix
+//
+//  Abstract:
+//
+//    This function sets the size and the array offsets of a matrix
+//    that is written at an offset in the cache file.
+//
+//
+//  Input:
+//
+//    matrix            The matrix.
+//
+//    offset            The offset of the first array of the matrix.
+//
+//    section           The returned size and array offsets.
+//
+//
+//  Output:
+//
+//    This function returns a value of type 'uint64_t' that is the
+//    offset just after the last array of the matrix.
+//
+//======================================================================
+
+uint64_t SystemCacheFile::LayOutMatrix(const CompressedSparseMatrix & matrix,
+                                       uint64_t offset,
+                                       MatrixSection_T & section)
+{
+    uint64_t number_of_rows = (uint64_t)(matrix.GetNumberOfRows());
+    uint64_t number_of_nonzeros = matrix.GetNumberOfNonzeros();
+
+    section.m_number_of_rows = (uint32_t)(number_of_rows);
+    section.m_number_of_columns = (uint32_t)(matrix.GetNumberOfColumns());
+    section.m_number_of_nonzeros = number_of_nonzeros;
+    section.m_row_start_offset = offset;
+    section.m_column_index_offset = CacheFileSection::AlignOffset(section.m_row_start_offset + (number_of_rows + 1) * sizeof(uint64_t));
+    section.m_value_offset = CacheFileSection::AlignOffset(section.m_column_index_offset + number_of_nonzeros * sizeof(int32_t));
+
+    return CacheFileSection::AlignOffset(section.m_value_offset + number_of_nonzeros * sizeof(double));
+}
+
+//======================================================================
+//  Member Function: SystemCacheFile::WriteMatrix
+//
+//  Abstract:
+//
+//    This function writes the arrays of a matrix at the current
+//    position. The row starts and the column indices are stored with
+//    fixed widths that do not depend on the platform.
+//
+//
+//  Input:
+//
+//    cache_file        The open cache file.
+//
+//    matrix            The matrix.
+//
+//    position          The current position in the file, which is
+//                      advanced past the arrays.
+//
+//  Output:
+//
+//    This function has no return value.
+//
+//======================================================================
+
+void SystemCacheFile::WriteMatrix(std::ofstream & cache_file,
+                                  const CompressedSparseMatrix & matrix,
+                                  uint64_t & position)
+{
+    int number_of_rows = matrix.GetNumberOfRows();
+    uint64_t number_of_nonzeros = matrix.GetNumberOfNonzeros();
+
+    const size_t * row_start_array = matrix.GetRowStartArray();
+    std::vector<uint64_t> row_start_vector(row_start_array, row_start_array + number_of_rows + 1);
+    CacheFileSection::Write(cache_file, row_start_vector.data(), row_start_vector.size() * sizeof(uint64_t), position);
+
+    const int * column_index_array = matrix.GetColumnIndexArray();
+    std::vector<int32_t> column_index_vector(column_index_array, column_index_array + number_of_nonzeros);
+    CacheFileSection::Write(cache_file, column_index_vector.data(), number_of_nonzeros * sizeof(int32_t), position);
+
+    CacheFileSection::Write(cache_file, matrix.GetValueArray(), number_of_nonzeros * sizeof(double), position);
+
+    return;
+}
+
+//======================================================================
+//  Member Function: SystemCacheFile::IsValidMatrix
+//
+//  Abstract:
+//
+//    This function checks that the arrays of a matrix are inside of
+//    the cache file and that the row starts and the column indices
+//    are consistent.
+//
+//
+//  Input:
+//
+//    data_ptr          A pointer to the mapped cache file.
+//
+//    file_size         The size of the cache file.
+//
+//    section           The size and the array offsets of the matrix.
+//
+//
+//  Output:
+//
+//    This function returns a value of type 'bool' that is the value
+//    true if and only if the matrix can be read.
+//
+//======================================================================
+
+bool SystemCacheFile::IsValidMatrix(const char * data_ptr,
+                                    uint64_t file_size,
+                                    const MatrixSection_T & section)
+{
+    uint64_t number_of_rows = section.m_number_of_rows;
+    uint64_t number_of_nonzeros = section.m_number_of_nonzeros;
+
+    if ((! CacheFileSection::IsInFile(section.m_row_start_offset, number_of_rows + 1, sizeof(uint64_t), file_size))
+        || (! CacheFileSection::IsInFile(section.m_column_index_offset, number_of_nonzeros, sizeof(int32_t), file_size))
+        || (! CacheFileSection::IsInFile(section.m_value_offset, number_of_nonzeros, sizeof(double), file_size)))
+    {
+        return false;
+    }
+
+    const uint64_t * row_start_array = (const uint64_t *)(data_ptr + section.m_row_start_offset);
+    const int32_t * column_index_array = (const int32_t *)(data_ptr + section.m_column_index_offset);
+    uint64_t i = 0;
+
+    if ((row_start_array[0] != 0)
+        || (row_start_array[number_of_rows] != number_of_nonzeros))
+    {
+        return false;
+    }
+
+    for (i = 0; i < number_of_rows; ++i)
+    {
+        if (row_start_array[i + 1] < row_start_array[i])
+        {
+            return false;
+        }
+    }
+
+    for (i = 0; i < number_of_nonzeros; ++i)
+    {
+        if ((column_index_array[i] < 0) || ((uint32_t)(column_index_array[i]) >= section.m_number_of_columns))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//======================================================================
+//  Member Function: SystemCacheFile::CopyMatrix
+//
+//  Abstract:
+//
+//    This function copies a matrix that has been checked by the
+//    IsValidMatrix method out of the cache file.
+//
+//
+//  Input:
+//
+//    data_ptr          A pointer to the mapped cache file.
+//
+//    section           The size and the array offsets of the matrix.
+//
+//    matrix            The returned matrix.
+//
+//  Output:
+//
+//    This function has no return value.
+//
+//======================================================================
+
+void SystemCacheFile::CopyMatrix(const char * data_ptr,
+                                 const MatrixSection_T & section,
+                                 CompressedSparseMatrix & matrix)
+{
+    uint64_t number_of_rows = section.m_number_of_rows;
+    uint64_t number_of_nonzeros = section.m_number_of_nonzeros;
+
+    const uint64_t * row_start_array = (const uint64_t *)(data_ptr + section.m_row_start_offset);
+    const int32_t * column_index_array = (const int32_t *)(data_ptr + section.m_column_index_offset);
+    const double * value_array = (const double *)(data_ptr + section.m_value_offset);
+
+    std::vector<size_t> row_start_vector(row_start_array, row_start_array + number_of_rows + 1);
+    std::vector<int> column_index_vector(column_index_array, column_index_array + number_of_nonzeros);
+    std::vector<double> value_vector(value_array, value_array + number_of_nonzeros);
+
+    matrix.Assign((int)(number_of_rows),
+                  (int)(section.m_number_of_columns),
+                  row_start_vector,
+                  column_index_vector,
+                  value_vector);
+
+    return;
+}
+
+//======================================================================
+//  Member Function: SystemCacheFile::HashContent
+//
+//  Abstract:
+//
+//    This function calculates a 64 bit hash of a block of characters.
+//    The characters are mixed eight at a time. The value is stored in
+//    cache files, so changing this function requires a new format
+//    version.
+//
+//======================================================================
+
+uint64_t SystemCacheFile::HashContent(const char * data_ptr,
+                                      size_t data_size)
+{
+    uint64_t hash = 0x27D4EB2F165667C5ULL ^ (uint64_t)(data_size);
+    size_t position = 0;
+
+    for (position = 0; position + 8 <= data_size; position += 8)
+    {
+        uint64_t word = 0;
+        memcpy(&word, data_ptr + position, sizeof(word));
+        hash = MixWord(hash, word);
+    }
+
+    if (position < data_size)
+    {
+        uint64_t word = 0;
+        memcpy(&word, data_ptr + position, data_size - position);
+        hash = MixWord(hash, word);
+    }
+
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDULL;
+    hash ^= hash >> 33;
+    hash *= 0xC4CEB9FE1A85EC53ULL;
+    hash ^= hash >> 33;
+
+    return hash;
+}
@@ -0,0 +1,119 @@
+#ifndef SYSTEMCACHEFILE_H
+#define SYSTEMCACHEFILE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <fstream>
+#include "MatrixPackage.h"
+#include "VariableSymbolTable.h"
+#include "CompressedSparseMatrix.h"
+
+//======================================================================
+//  Class Definition
+//
+//  This class writes a parsed system of equations to a binary cache
+//  file and reads it back. The cache file holds the variable names in
+//  index order, the A matrix in compressed sparse row form, the B
+//  vector, the extra right-hand sides and the number of equations.
+//
+//  Each cache file also holds the size, the modification time and a
+//  hash of the contents of the equation file that it was made from.
+//  A cache file is only read if all three still match the equation
+//  file and the format version matches this program.
+//
+//  The file is laid out as described for the CacheFileSection class.
+//  The arrays are copied out of the mapped file, because the solver
+//  makes its own row and column copies of the A matrix in any case.
+//======================================================================
+
+class SystemCacheFile
+{
+public:
+
+    struct SourceStamp_T
+    {
+        uint64_t m_size;
+        int64_t m_modification_time;
+        uint64_t m_content_hash;
+    };
+
+    static bool GetSourceStamp(const char * source_file_name_ptr,
+                               SourceStamp_T & source_stamp);
+
+    static bool Write(const char * cache_file_name_ptr,
+                      const SourceStamp_T & source_stamp,
+                      const VariableSymbolTable & symbol_table,
+                      const CompressedSparseMatrix & a_matrix,
+                      const MatrixPackage::SparseVector & b_vector,
+                      const CompressedSparseMatrix & right_hand_side_matrix,
+                      unsigned int number_of_equations);
+
+    static bool Read(const char * cache_file_name_ptr,
+                     const SourceStamp_T & source_stamp,
+                     VariableSymbolTable & symbol_table,
+                     CompressedSparseMatrix & a_matrix,
+                     MatrixPackage::SparseVector & b_vector,
+                     CompressedSparseMatrix & right_hand_side_matrix,
+                     unsigned int & number_of_equations);
+
+    static uint64_t HashContent(const char * data_ptr,
+                                size_t data_size);
+
+protected:
+
+    //------------------------------------------------------------------
+    //  The size and the array offsets of a compressed sparse row
+    //  matrix. Every offset is from the start of the file.
+    //------------------------------------------------------------------
+
+    struct MatrixSection_T
+    {
+        uint32_t m_number_of_rows;
+        uint32_t m_number_of_columns;
+        uint64_t m_number_of_nonzeros;
+        uint64_t m_row_start_offset;
+        uint64_t m_column_index_offset;
+        uint64_t m_value_offset;
+    };
+
+    //------------------------------------------------------------------
+    //  The file header. Every offset is from the start of the file.
+    //------------------------------------------------------------------
+
+    struct Header_T
+    {
+        char m_magic[8];
+        uint32_t m_version;
+        uint32_t m_header_size;
+        SourceStamp_T m_source_stamp;
+        uint32_t m_number_of_equations;
+        uint32_t m_number_of_variables;
+        uint64_t m_number_of_b_elements;
+        uint64_t m_name_arena_size;
+        uint64_t m_name_offset_offset;
+        uint64_t m_name_arena_offset;
+        MatrixSection_T m_a_matrix_section;
+        uint64_t m_b_index_offset;
+        uint64_t m_b_value_offset;
+        MatrixSection_T m_right_hand_side_section;
+        uint64_t m_file_size;
+    };
+
+    static uint64_t LayOutMatrix(const CompressedSparseMatrix & matrix,
+                                 uint64_t offset,
+                                 MatrixSection_T & section);
+
+    static void WriteMatrix(std::ofstream & cache_file,
+                            const CompressedSparseMatrix & matrix,
+                            uint64_t & position);
+
+    static bool IsValidMatrix(const char * data_ptr,
+                              uint64_t file_size,
+                              const MatrixSection_T & section);
+
+    static void CopyMatrix(const char * data_ptr,
+                           const MatrixSection_T & section,
+                           CompressedSparseMatrix & matrix);
+};
+
+#endif
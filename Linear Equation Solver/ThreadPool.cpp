@@ -0,0 +1,211 @@
+#include "ThreadPool.h"
+
+//======================================================================
+//  Constructor: ThreadPool::ThreadPool
+//
+//  Input:
+//
+//    number_of_threads     The number of threads that run tasks,
+//                          including the thread that calls Run. If
+//                          this is zero then one thread per hardware
+//                          thread is used.
+//
+//======================================================================
+
+ThreadPool::ThreadPool(unsigned int number_of_threads)
+  : m_number_of_threads(number_of_threads),
+    m_task_ptr(0),
+    m_number_of_tasks(0),
+    m_next_task_index(0),
+    m_generation(0),
+    m_number_of_busy_workers(0),
+    m_stop_flag(false)
+{
+    if (m_number_of_threads == 0)
+    {
+        m_number_of_threads = std::thread::hardware_concurrency();
+    }
+
+    if (m_number_of_threads == 0)
+    {
+        m_number_of_threads = 1;
+    }
+
+    //------------------------------------------------------------------
+    //  The thread that calls Run is one of the threads.
+    //------------------------------------------------------------------
+
+    for (unsigned int t = 1; t < m_number_of_threads; ++t)
+    {
+        m_thread_vector.push_back(std::thread(&ThreadPool::WorkerLoop, this));
+    }
+}
+
+//======================================================================
+//  Destructor: ThreadPool::~ThreadPool
+//======================================================================
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop_flag = true;
+    }
+
+    m_work_condition.notify_all();
+
+    for (size_t t = 0; t < m_thread_vector.size(); ++t)
+    {
+        m_thread_vector[t].join();
+    }
+}
+
+//======================================================================
+//  Member Function: ThreadPool::Run
+//
+//  Abstract:
+//
+//    This function runs the tasks on the threads of the pool and
+//    returns when every task is done.
+//
+//
+//  Input:
+//
+//    number_of_tasks       The number of tasks.
+//
+//    task                  The task function, which is passed the
+//                          task number. The function is called from
+//                          several threads at once.
+//
+//  Output:
+//
+//    This function has no return value.
+//
+//======================================================================
+
+void ThreadPool::Run(size_t number_of_tasks, const Task_T & task)
+{
+    if (number_of_tasks == 0)
+    {
+        return;
+    }
+
+    //------------------------------------------------------------------
+    //  A single task, or a pool without workers, runs on this thread.
+    //------------------------------------------------------------------
+
+    if ((number_of_tasks == 1) || m_thread_vector.empty())
+    {
+        for (size_t task_index = 0; task_index < number_of_tasks; ++task_index)
+        {
+            task(task_index);
+        }
+
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_task_ptr = &task;
+        m_number_of_tasks = number_of_tasks;
+        m_next_task_index = 0;
+        m_number_of_busy_workers = (unsigned int)(m_thread_vector.size());
+        ++m_generation;
+    }
+
+    m_work_condition.notify_all();
+
+    RunTasks();
+
+    //------------------------------------------------------------------
+    //  Wait for the workers to finish their last tasks.
+    //------------------------------------------------------------------
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    while (m_number_of_busy_workers != 0)
+    {
+        m_done_condition.wait(lock);
+    }
+
+    m_task_ptr = 0;
+
+    return;
+}
+
+//======================================================================
+//  Member Function: ThreadPool::GetNumberOfThreads
+//======================================================================
+
+unsigned int ThreadPool::GetNumberOfThreads() const
+{
+    return m_number_of_threads;
+}
+
+//======================================================================
+//  Member Function: ThreadPool::WorkerLoop
+//
+//  Abstract:
+//
+//    This function is run by each worker thread. It waits for a new
+//    run, takes tasks until there are none left, and reports that it
+//    is done.
+//
+//======================================================================
+
+void ThreadPool::WorkerLoop()
+{
+    unsigned long generation = 0;
+
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+
+            while ((! m_stop_flag) && (m_generation == generation))
+            {
+                m_work_condition.wait(lock);
+            }
+
+            if (m_stop_flag)
+            {
+                break;
+            }
+
+            generation = m_generation;
+        }
+
+        RunTasks();
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            --m_number_of_busy_workers;
+        }
+
+        m_done_condition.notify_one();
+    }
+
+    return;
+}
+
+//======================================================================
+//  Member Function: ThreadPool::RunTasks
+//
+//  Abstract:
+//
+//    This function takes the next task number that has not been taken
+//    and runs the task, until there are no tasks left.
+//
+//======================================================================
+
+void ThreadPool::RunTasks()
+{
+    size_t task_index;
+
+    while ((task_index = m_next_task_index++) < m_number_of_tasks)
+    {
+        (*m_task_ptr)(task_index);
+    }
+
+    return;
+}
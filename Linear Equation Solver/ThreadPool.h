@@ -0,0 +1,81 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <stddef.h>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//======================================================================
+//  Class Definition
+//
+//  This class keeps a set of worker threads that run numbered tasks.
+//  The threads are started once, when the pool is constructed, and
+//  wait for work between calls to Run, so the pool can be used many
+//  times without the cost of starting threads.
+//
+//  Run calls a task function once for each task number from zero up
+//  to, but not including, the number of tasks. Each worker takes the
+//  next task number that has not been taken until there are none
+//  left, so the threads stay busy when the tasks take different
+//  amounts of time. The thread that calls Run also runs tasks, and
+//  Run returns when every task is done.
+//
+//  Only one thread at a time can call Run.
+//======================================================================
+
+class ThreadPool
+{
+public:
+
+    typedef std::function<void(size_t)> Task_T;
+
+    ThreadPool(unsigned int number_of_threads);
+
+    virtual ~ThreadPool();
+
+    void Run(size_t number_of_tasks, const Task_T & task);
+
+    unsigned int GetNumberOfThreads() const;
+
+private:
+
+    //------------------------------------------------------------------
+    //  Copying a thread pool is not allowed.
+    //------------------------------------------------------------------
+
+    ThreadPool(const ThreadPool &);
+
+    ThreadPool & operator =(const ThreadPool &);
+
+    void WorkerLoop();
+
+    void RunTasks();
+
+private:
+
+    unsigned int m_number_of_threads;
+    std::vector<std::thread> m_thread_vector;
+    std::mutex m_mutex;
+    std::condition_variable m_work_condition;
+    std::condition_variable m_done_condition;
+
+    //------------------------------------------------------------------
+    //  The current run. The generation number changes for each run so
+    //  that a worker runs tasks once per run. The number of busy
+    //  workers is the number of workers that have not finished with
+    //  the current run.
+    //------------------------------------------------------------------
+
+    const Task_T * m_task_ptr;
+    size_t m_number_of_tasks;
+    std::atomic<size_t> m_next_task_index;
+    unsigned long m_generation;
+    unsigned int m_number_of_busy_workers;
+    bool m_stop_flag;
+};
+
+#endif
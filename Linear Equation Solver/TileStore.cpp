@@ -0,0 +1,580 @@
+#include "TileStore.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    //------------------------------------------------------------------
+    //  The largest number of bytes passed to one read or write call.
+    //------------------------------------------------------------------
+
+    const size_t f_MAXIMUM_TRANSFER_SIZE = 1 << 30;
+}
+
+//======================================================================
+//  Constructor: TileStore::TileStore
+//======================================================================
+
+TileStore::TileStore()
+  : m_number_of_tile_rows(0),
+    m_number_of_tile_columns(0),
+    m_tile_size(0),
+    m_is_open_flag(false),
+    m_bytes_read(0),
+    m_bytes_written(0),
+#ifdef _WIN32
+    m_file_handle(INVALID_HANDLE_VALUE),
+#else
+    m_file_descriptor(-1),
+#endif
+    m_request_tile_column(0),
+    m_request_first_tile_row(0),
+    m_request_number_of_tile_rows(0),
+    m_request_tile_ptr(0),
+    m_request_pending_flag(false),
+    m_read_in_progress_flag(false),
+    m_read_succeeded_flag(true),
+    m_stop_flag(false)
+{
+}
+
+//======================================================================
+//  Destructor: TileStore::~TileStore
+//======================================================================
+
+TileStore::~TileStore()
+{
+    Close();
+}
+
+//======================================================================
+//  Member Function: TileStore::Create
+//
+//  Abstract:
+//
+//    This function creates the file for a matrix of tiles. Any file
+//    that is already open is closed first. The tiles must be written
+//    before they are read.
+//
+//
+//  Input:
+//
+//    file_name_ptr             A pointer to the name of the file. An
+//                              existing file is replaced.
+//
+//    number_of_tile_rows       The number of tile rows.
+//
+//    number_of_tile_columns    The number of tile columns.
+//
+//    tile_size                 The number of rows and of columns of
+//                              each tile.
+//
+//  Output:
+//
+//    This function returns a value of type 'bool' that is the value
+//    true if and only if the file was created.
+//
+//======================================================================
+
+bool TileStore::Create(const char * file_name_ptr,
+                       int number_of_tile_rows,
+                       int number_of_tile_columns,
+                       int tile_size)
+{
+    Close();
+
+    //------------------------------------------------------------------
+    //  The file is deleted by the system when it is closed, even if
+    //  the program stops without closing it.
+    //------------------------------------------------------------------
+
+#ifdef _WIN32
+    HANDLE file_handle = CreateFileA(file_name_ptr,
+                                     GENERIC_READ | GENERIC_WRITE,
+                                     0,
+                                     0,
+                                     CREATE_ALWAYS,
+                                     FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE,
+                                     0);
+
+    if (file_handle == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    m_file_handle = file_handle;
+#else
+    int file_descriptor = open(file_name_ptr, O_RDWR | O_CREAT | O_TRUNC, 0600);
+
+    if (file_descriptor < 0)
+    {
+        return false;
+    }
+
+    unlink(file_name_ptr);
+
+    m_file_descriptor = file_descriptor;
+#endif
+
+    m_number_of_tile_rows = number_of_tile_rows;
+    m_number_of_tile_columns = number_of_tile_columns;
+    m_tile_size = tile_size;
+    m_bytes_read = 0;
+    m_bytes_written = 0;
+    m_read_succeeded_flag = true;
+    m_is_open_flag = true;
+
+    return true;
+}
+
+//======================================================================
+//  Member Function: TileStore::Close
+//
+//  Abstract:
+//
+//    This function stops the prefetch thread, after any read that is
+//    in progress, and closes and deletes the file. It is safe to call
+//    this function if no file is open.
+//
+//
+//  Input:
+//
+//    None.
+//
+//  Output:
+//
+//    This function has no return value.
+//
+//======================================================================
+
+void TileStore::Close()
+{
+    if (m_prefetch_thread.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop_flag = true;
+        }
+
+        m_request_condition.notify_all();
+        m_prefetch_thread.join();
+        m_stop_flag = false;
+        m_request_pending_flag = false;
+        m_read_in_progress_flag = false;
+    }
+
+#ifdef _WIN32
+    if (m_file_handle != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(m_file_handle);
+        m_file_handle = INVALID_HANDLE_VALUE;
+    }
+#else
+    if (m_file_descriptor >= 0)
+    {
+        close(m_file_descriptor);
+        m_file_descriptor = -1;
+    }
+#endif
+
+    m_is_open_flag = false;
+
+    return;
+}
+
+//======================================================================
+//  Member Function: TileStore::IsOpen
+//======================================================================
+
+bool TileStore::IsOpen() const
+{
+    return m_is_open_flag;
+}
+
+//======================================================================
+//  Member Function: TileStore::ReadTiles
+//
+//  Abstract:
+//
+//    This function reads a range of tile rows of one tile column.
+//
+//
+//  Input:
+//
+//    tile_column           The tile column.
+//
+//    first_tile_row        The first tile row that is read.
+//
+//    number_of_tile_rows   The number of tile rows that are read.
+//
+//    tile_ptr              A pointer to space for the tiles.
+//
+//  Output:
+//
+//    This function returns a value of type 'bool' that is the value
+//    true if and only if the tiles were read.
+//
+//======================================================================
+
+bool TileStore::ReadTiles(int tile_column,
+                          int first_tile_row,
+                          int number_of_tile_rows,
+                          double * tile_ptr)
+{
+    size_t tile_elements = (size_t)(m_tile_size) * m_tile_size;
+
+    return ReadBytes(GetTileOffset(tile_column, first_tile_row),
+                     tile_ptr,
+                     tile_elements * number_of_tile_rows * sizeof(double));
+}
+
+//======================================================================
+//  Member Function: TileStore::WriteTiles
+//
+//  Abstract:
+//
+//    This function writes a range of tile rows of one tile column.
+//
+//
+//  Input:
+//
+//    tile_column           The tile column.
+//
+//    first_tile_row        The first tile row that is written.
+//
+//    number_of_tile_rows   The number of tile rows that are written.
+//
+//    tile_ptr              A pointer to the tiles.
+//
+//  Output:
+//
+//    This function returns a value of type 'bool' that is the value
+//    true if and only if the tiles were written.
+//
+//======================================================================
+
+bool TileStore::WriteTiles(int tile_column,
+                           int first_tile_row,
+                           int number_of_tile_rows,
+                           const double * tile_ptr)
+{
+    size_t tile_elements = (size_t)(m_tile_size) * m_tile_size;
+
+    return WriteBytes(GetTileOffset(tile_column, first_tile_row),
+                      tile_ptr,
+                      tile_elements * number_of_tile_rows * sizeof(double));
+}
+
+//======================================================================
+//  Member Function: TileStore::StartRead
+//
+//  Abstract:
+//
+//    This function starts to read a range of tile rows of one tile
+//    column on the prefetch thread and returns without waiting. The
+//    tiles must not be used, and the tile column must not be written,
+//    until FinishRead returns. Any earlier read must be finished.
+//
+//
+//  Input:
+//
+//    tile_column           The tile column.
+//
+//    first_tile_row        The first tile row that is read.
+//
+//    number_of_tile_rows   The number of tile rows that are read.
+//
+//    tile_ptr              A pointer to space for the tiles.
+//
+//  Output:
+//
+//    This function has no return value.
+//
+//======================================================================
+
+void TileStore::StartRead(int tile_column,
+                          int first_tile_row,
+                          int number_of_tile_rows,
+                          double * tile_ptr)
+{
+    if (! m_prefetch_thread.joinable())
+    {
+        m_prefetch_thread = std::thread(&TileStore::PrefetchLoop, this);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_request_tile_column = tile_column;
+        m_request_first_tile_row = first_tile_row;
+        m_request_number_of_tile_rows = number_of_tile_rows;
+        m_request_tile_ptr = tile_ptr;
+        m_request_pending_flag = true;
+        m_read_in_progress_flag = true;
+    }
+
+    m_request_condition.notify_one();
+
+    return;
+}
+
+//======================================================================
+//  Member Function: TileStore::FinishRead
+//
+//  Abstract:
+//
+//    This function waits for the read started by StartRead.
+//
+//
+//  Input:
+//
+//    None.
+//
+//  Output:
+//
+//    This function returns a value of type 'bool' that is the value
+//    true if and only if the tiles were read.
+//
+//======================================================================
+
+bool TileStore::FinishRead()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    while (m_read_in_progress_flag)
+    {
+        m_done_condition.wait(lock);
+    }
+
+    return m_read_succeeded_flag;
+}
+
+//======================================================================
+//  Member Function: TileStore::GetTileSize
+//======================================================================
+
+int TileStore::GetTileSize() const
+{
+    return m_tile_size;
+}
+
+//======================================================================
+//  Member Function: TileStore::GetBytesRead
+//======================================================================
+
+uint64_t TileStore::GetBytesRead() const
+{
+    return m_bytes_read;
+}
+
+//======================================================================
+//  Member Function: TileStore::GetBytesWritten
+//======================================================================
+
+uint64_t TileStore::GetBytesWritten() const
+{
+    return m_bytes_written;
+}
+
+//======================================================================
+//  Member Function: TileStore::GetTileOffset
+//
+//  Abstract:
+//
+//    This function returns the offset in the file of a tile.
+//
+//======================================================================
+
+uint64_t TileStore::GetTileOffset(int tile_column,
+                                  int first_tile_row) const
+{
+    uint64_t tile_index = (uint64_t)(tile_column) * m_number_of_tile_rows + first_tile_row;
+
+    return tile_index * m_tile_size * m_tile_size * sizeof(double);
+}
+
+//======================================================================
+//  Member Function: TileStore::ReadBytes
+//
+//  Abstract:
+//
+//    This function reads bytes from a position in the file. The
+//    position is passed to each call, so reads and writes from
+//    different threads do not share a file position.
+//
+//
+//  Input:
+//
+//    offset                The position in the file.
+//
+//    data_ptr              A pointer to space for the bytes.
+//
+//    size                  The number of bytes.
+//
+//  Output:
+//
+//    This function returns a value of type 'bool' that is the value
+//    true if and only if every byte was read.
+//
+//======================================================================
+
+bool TileStore::ReadBytes(uint64_t offset,
+                          void * data_ptr,
+                          size_t size)
+{
+    char * byte_ptr = (char *)(data_ptr);
+    size_t remaining_size = size;
+
+    while (remaining_size > 0)
+    {
+        size_t transfer_size = (remaining_size < f_MAXIMUM_TRANSFER_SIZE) ? remaining_size : f_MAXIMUM_TRANSFER_SIZE;
+
+#ifdef _WIN32
+        OVERLAPPED overlapped = { 0 };
+        DWORD bytes_transferred = 0;
+
+        overlapped.Offset = (DWORD)(offset & 0xFFFFFFFF);
+        overlapped.OffsetHigh = (DWORD)(offset >> 32);
+
+        if ((! ReadFile(m_file_handle, byte_ptr, (DWORD)(transfer_size), &bytes_transferred, &overlapped))
+            || (bytes_transferred == 0))
+        {
+            return false;
+        }
+#else
+        ssize_t bytes_transferred = pread(m_file_descriptor, byte_ptr, transfer_size, (off_t)(offset));
+
+        if (bytes_transferred <= 0)
+        {
+            return false;
+        }
+#endif
+
+        byte_ptr += bytes_transferred;
+        offset += bytes_transferred;
+        remaining_size -= bytes_transferred;
+    }
+
+    m_bytes_read += size;
+
+    return true;
+}
+
+//======================================================================
+//  Member Function: TileStore::WriteBytes
+//
+//  Abstract:
+//
+//    This function writes bytes at a position in the file.
+//
+//
+//  Input:
+//
+//    offset                The position in the file.
+//
+//    data_ptr              A pointer to the bytes.
+//
+//    size                  The number of bytes.
+//
+//  Output:
+//
+//    This function returns a value of type 'bool' that is the value
+//    true if and only if every byte was written.
+//
+//======================================================================
+
+bool TileStore::WriteBytes(uint64_t offset,
+                           const void * data_ptr,
+                           size_t size)
+{
+    const char * byte_ptr = (const char *)(data_ptr);
+    size_t remaining_size = size;
+
+    while (remaining_size > 0)
+    {
+        size_t transfer_size = (remaining_size < f_MAXIMUM_TRANSFER_SIZE) ? remaining_size : f_MAXIMUM_TRANSFER_SIZE;
+
+#ifdef _WIN32
+        OVERLAPPED overlapped = { 0 };
+        DWORD bytes_transferred = 0;
+
+        overlapped.Offset = (DWORD)(offset & 0xFFFFFFFF);
+        overlapped.OffsetHigh = (DWORD)(offset >> 32);
+
+        if ((! WriteFile(m_file_handle, byte_ptr, (DWORD)(transfer_size), &bytes_transferred, &overlapped))
+            || (bytes_transferred == 0))
+        {
+            return false;
+        }
+#else
+        ssize_t bytes_transferred = pwrite(m_file_descriptor, byte_ptr, transfer_size, (off_t)(offset));
+
+        if (bytes_transferred <= 0)
+        {
+            return false;
+        }
+#endif
+
+        byte_ptr += bytes_transferred;
+        offset += bytes_transferred;
+        remaining_size -= bytes_transferred;
+    }
+
+    m_bytes_written += size;
+
+    return true;
+}
+
+//======================================================================
+//  Member Function: TileStore::PrefetchLoop
+//
+//  Abstract:
+//
+//    This function is run by the prefetch thread. It waits for a read
+//    request, does the read, and signals that it is done, until the
+//    store is closed.
+//
+//======================================================================
+
+void TileStore::PrefetchLoop()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    while (true)
+    {
+        while ((! m_request_pending_flag) && (! m_stop_flag))
+        {
+            m_request_condition.wait(lock);
+        }
+
+        if (m_stop_flag)
+        {
+            break;
+        }
+
+        m_request_pending_flag = false;
+
+        int tile_column = m_request_tile_column;
+        int first_tile_row = m_request_first_tile_row;
+        int number_of_tile_rows = m_request_number_of_tile_rows;
+        double * tile_ptr = m_request_tile_ptr;
+
+        lock.unlock();
+
+        bool read_succeeded_flag = ReadTiles(tile_column, first_tile_row, number_of_tile_rows, tile_ptr);
+
+        lock.lock();
+
+        m_read_succeeded_flag = read_succeeded_flag;
+        m_read_in_progress_flag = false;
+        m_done_condition.notify_all();
+    }
+
+    return;
+}
@@ -0,0 +1,129 @@
+#ifndef TILESTORE_H
+#define TILESTORE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+//======================================================================
+//  Class Definition
+//
+//  This class stores a matrix of square tiles of doubles in a file.
+//  Each tile has tile_size rows of tile_size elements, stored by rows.
+//  The tiles of one tile column are stored one after another, from
+//  the first tile row to the last, so any range of tile rows of a
+//  tile column is one contiguous part of the file and is read or
+//  written with one call. The tile rows of a tile column are then the
+//  rows of an array with tile_size columns.
+//
+//  StartRead begins to read tiles on a prefetch thread and returns at
+//  once, so the caller can work on other tiles while the read is done.
+//  FinishRead waits for the read. Only one prefetch read can be in
+//  progress at a time.
+//
+//  The file is a temporary file. It is deleted when the store is
+//  closed or destroyed. The number of bytes read and written are
+//  counted.
+//======================================================================
+
+class TileStore
+{
+public:
+
+    TileStore();
+
+    virtual ~TileStore();
+
+    bool Create(const char * file_name_ptr,
+                int number_of_tile_rows,
+                int number_of_tile_columns,
+                int tile_size);
+
+    void Close();
+
+    bool IsOpen() const;
+
+    bool ReadTiles(int tile_column,
+                   int first_tile_row,
+                   int number_of_tile_rows,
+                   double * tile_ptr);
+
+    bool WriteTiles(int tile_column,
+                    int first_tile_row,
+                    int number_of_tile_rows,
+                    const double * tile_ptr);
+
+    void StartRead(int tile_column,
+                   int first_tile_row,
+                   int number_of_tile_rows,
+                   double * tile_ptr);
+
+    bool FinishRead();
+
+    int GetTileSize() const;
+
+    uint64_t GetBytesRead() const;
+
+    uint64_t GetBytesWritten() const;
+
+private:
+
+    //------------------------------------------------------------------
+    //  Copying a tile store is not allowed.
+    //------------------------------------------------------------------
+
+    TileStore(const TileStore &);
+
+    TileStore & operator =(const TileStore &);
+
+    uint64_t GetTileOffset(int tile_column,
+                           int first_tile_row) const;
+
+    bool ReadBytes(uint64_t offset,
+                   void * data_ptr,
+                   size_t size);
+
+    bool WriteBytes(uint64_t offset,
+                    const void * data_ptr,
+                    size_t size);
+
+    void PrefetchLoop();
+
+private:
+
+    int m_number_of_tile_rows;
+    int m_number_of_tile_columns;
+    int m_tile_size;
+    bool m_is_open_flag;
+    std::atomic<uint64_t> m_bytes_read;
+    std::atomic<uint64_t> m_bytes_written;
+
+#ifdef _WIN32
+    void * m_file_handle;
+#else
+    int m_file_descriptor;
+#endif
+
+    //------------------------------------------------------------------
+    //  The prefetch thread and its one read request. The thread is
+    //  started by the first call to StartRead.
+    //------------------------------------------------------------------
+
+    std::thread m_prefetch_thread;
+    std::mutex m_mutex;
+    std::condition_variable m_request_condition;
+    std::condition_variable m_done_condition;
+    int m_request_tile_column;
+    int m_request_first_tile_row;
+    int m_request_number_of_tile_rows;
+    double * m_request_tile_ptr;
+    bool m_request_pending_flag;
+    bool m_read_in_progress_flag;
+    bool m_read_succeeded_flag;
+    bool m_stop_flag;
+};
+
+#endif
@@ -0,0 +1,377 @@
+#include <string.h>
+#include <algorithm>
+#include "VariableSymbolTable.h"
+
+namespace
+{
+    const int f_EMPTY_SLOT = -1;
+    const size_t f_MINIMUM_NUMBER_OF_SLOTS = 64;
+
+    //------------------------------------------------------------------
+    //  Compare two variable names the same way that the CharString
+    //  less than operator does, so that sorting by name gives the same
+    //  order as the std::map that this table replaces.
+    //------------------------------------------------------------------
+
+    class NameLessThan
+    {
+    public:
+
+        NameLessThan(const VariableSymbolTable & symbol_table)
+          : m_symbol_table(symbol_table)
+        {
+        }
+
+        bool operator ()(int left_index, int right_index) const
+        {
+            CharSpan left_span = m_symbol_table.GetName(left_index);
+            CharSpan right_span = m_symbol_table.GetName(right_index);
+
+            unsigned int left_length = left_span.Length();
+            unsigned int right_length = right_span.Length();
+            unsigned int length = (std::min)(left_length, right_length);
+
+            int result = memcmp(left_span.Data(), right_span.Data(), length);
+
+            if (result == 0)
+            {
+                return left_length < right_length;
+            }
+
+            return result < 0;
+        }
+
+    private:
+
+        const VariableSymbolTable & m_symbol_table;
+    };
+}
+
+//======================================================================
+//  Constructor: VariableSymbolTable::VariableSymbolTable
+//======================================================================
+
+VariableSymbolTable::VariableSymbolTable()
+{
+    Clear();
+}
+
+//======================================================================
+//  Destructor: VariableSymbolTable::~VariableSymbolTable
+//======================================================================
+
+VariableSymbolTable::~VariableSymbolTable()
+{
+}
+
+//======================================================================
+//  Member Function: VariableSymbolTable::FindOrInsert
+//
+//  Abstract:
+//
+//    This function returns the index for a variable name. If the
+//    name is not already in the table then the name is added and
+//    is given the next index. Both cases use a single probe sequence.
+//
+//
+//  Input:
+//
+//    name_span     The variable name.
+//
+//
+//  Output:
+//
+//    This function returns a value of type 'int' that is the index
+//    of the variable name.
+//
+//======================================================================
+
+int VariableSymbolTable::FindOrInsert(const CharSpan & name_span)
+{
+    //------------------------------------------------------------------
+    //  Keep the load factor at or below one half so that probe
+    //  sequences stay short.
+    //------------------------------------------------------------------
+
+    if ((GetSize() + 1) * 2 > m_slot_vector.size())
+    {
+        Grow(m_slot_vector.size() * 2);
+    }
+
+    unsigned int hash = Hash(name_span);
+    size_t slot = ProbeForName(name_span, hash);
+
+    if (m_slot_vector[slot].m_index != f_EMPTY_SLOT)
+    {
+        return m_slot_vector[slot].m_index;
+    }
+
+    //------------------------------------------------------------------
+    //  This is a new name. Append the name to the arena.
+    //------------------------------------------------------------------
+
+    int index = (int)(GetSize());
+
+    m_name_arena.insert(m_name_arena.end(),
+                        name_span.Data(),
+                        name_span.Data() + name_span.Length());
+    m_name_offset_vector.push_back(m_name_arena.size());
+
+    m_slot_vector[slot].m_hash = hash;
+    m_slot_vector[slot].m_index = index;
+
+    return index;
+}
+
+//======================================================================
+//  Member Function: VariableSymbolTable::Find
+//
+//  Abstract:
+//
+//    This function returns the index for a variable name.
+//
+//
+//  Input:
+//
+//    name_span     The variable name.
+//
+//
+//  Output:
+//
+//    This function returns a value of type 'int' that is the index
+//    of the variable name, or -1 if the name is not in the table.
+//
+//======================================================================
+
+int VariableSymbolTable::Find(const CharSpan & name_span) const
+{
+    size_t slot = ProbeForName(name_span, Hash(name_span));
+    return m_slot_vector[slot].m_index;
+}
+
+//======================================================================
+//  Member Function: VariableSymbolTable::GetSize
+//======================================================================
+
+unsigned int VariableSymbolTable::GetSize() const
+{
+    return (unsigned int)(m_name_offset_vector.size() - 1);
+}
+
+//======================================================================
+//  Member Function: VariableSymbolTable::IsEmpty
+//======================================================================
+
+bool VariableSymbolTable::IsEmpty() const
+{
+    return GetSize() == 0;
+}
+
+//======================================================================
+//  Member Function: VariableSymbolTable::GetName
+//
+//  Abstract:
+//
+//    This function returns a view of the name for a variable index.
+//    The view is only valid until the next name is inserted.
+//
+//======================================================================
+
+CharSpan VariableSymbolTable::GetName(int index) const
+{
+    size_t start = m_name_offset_vector[index];
+    size_t end = m_name_offset_vector[index + 1];
+
+    return CharSpan(m_name_arena.data() + start, (unsigned int)(end - start));
+}
+
+//======================================================================
+//  Member Function: VariableSymbolTable::GetIndicesSortedByName
+//
+//  Abstract:
+//
+//    This function returns all variable indices ordered by the
+//    variable name. This is used to display the solution in the same
+//    order that the previous std::map based table did.
+//
+//
+//  Input:
+//
+//    sorted_index_vector   A reference to a vector that is filled
+//                          with the variable indices.
+//
+//  Output:
+//
+//    This function has no return value.
+//
+//======================================================================
+
+void VariableSymbolTable::GetIndicesSortedByName(std::vector<int> & sorted_index_vector) const
+{
+    unsigned int size = GetSize();
+
+    sorted_index_vector.resize(size);
+
+    for (unsigned int i = 0; i < size; ++i)
+    {
+        sorted_index_vector[i] = (int)(i);
+    }
+
+    std::sort(sorted_index_vector.begin(),
+              sorted_index_vector.end(),
+              NameLessThan(*this));
+
+    return;
+}
+
+//======================================================================
+//  Member Function: VariableSymbolTable::Reserve
+//
+//  Abstract:
+//
+//    This function sizes the hash table so that the specified number
+//    of names can be inserted without growing the table.
+//
+//======================================================================
+
+void VariableSymbolTable::Reserve(unsigned int number_of_names)
+{
+    size_t number_of_slots = m_slot_vector.size();
+
+    while (number_of_slots < (size_t)(number_of_names) * 2)
+    {
+        number_of_slots *= 2;
+    }
+
+    if (number_of_slots != m_slot_vector.size())
+    {
+        Grow(number_of_slots);
+    }
+
+    m_name_offset_vector.reserve(number_of_names + 1);
+
+    return;
+}
+
+//======================================================================
+//  Member Function: VariableSymbolTable::Clear
+//======================================================================
+
+void VariableSymbolTable::Clear()
+{
+    Slot_T empty_slot;
+    empty_slot.m_hash = 0;
+    empty_slot.m_index = f_EMPTY_SLOT;
+
+    m_slot_vector.assign(f_MINIMUM_NUMBER_OF_SLOTS, empty_slot);
+    m_slot_mask = f_MINIMUM_NUMBER_OF_SLOTS - 1;
+    m_name_arena.clear();
+    m_name_offset_vector.assign(1, 0);
+
+    return;
+}
+
+//======================================================================
+//  Member Function: VariableSymbolTable::Hash
+//
+//  Abstract:
+//
+//    This function calculates the 32-bit FNV-1a hash of a name.
+//
+//======================================================================
+
+unsigned int VariableSymbolTable::Hash(const CharSpan & name_span)
+{
+    unsigned int hash = 2166136261U;
+
+    for (unsigned int i = 0; i < name_span.Length(); ++i)
+    {
+        hash ^= (unsigned char)(name_span[i]);
+        hash *= 16777619U;
+    }
+
+    return hash;
+}
+
+//======================================================================
+//  Member Function: VariableSymbolTable::ProbeForName
+//
+//  Abstract:
+//
+//    This function returns the slot that holds the name, or if the
+//    name is not in the table, the empty slot where the name would be
+//    inserted.
+//
+//======================================================================
+
+size_t VariableSymbolTable::ProbeForName(const CharSpan & name_span,
+                                         unsigned int hash) const
+{
+    size_t slot = hash & m_slot_mask;
+
+    while (m_slot_vector[slot].m_index != f_EMPTY_SLOT)
+    {
+        if ((m_slot_vector[slot].m_hash == hash)
+            && IsNameAtIndex(name_span, m_slot_vector[slot].m_index))
+        {
+            break;
+        }
+
+        slot = (slot + 1) & m_slot_mask;
+    }
+
+    return slot;
+}
+
+//======================================================================
+//  Member Function: VariableSymbolTable::Grow
+//
+//  Abstract:
+//
+//    This function resizes the hash table. The number of slots must
+//    be a power of two. The stored hash values are used so that no
+//    name is hashed again.
+//
+//======================================================================
+
+void VariableSymbolTable::Grow(size_t number_of_slots)
+{
+    Slot_T empty_slot;
+    empty_slot.m_hash = 0;
+    empty_slot.m_index = f_EMPTY_SLOT;
+
+    std::vector<Slot_T> old_slot_vector(number_of_slots, empty_slot);
+    old_slot_vector.swap(m_slot_vector);
+    m_slot_mask = number_of_slots - 1;
+
+    for (size_t i = 0; i < old_slot_vector.size(); ++i)
+    {
+        if (old_slot_vector[i].m_index != f_EMPTY_SLOT)
+        {
+            size_t slot = old_slot_vector[i].m_hash & m_slot_mask;
+
+            while (m_slot_vector[slot].m_index != f_EMPTY_SLOT)
+            {
+                slot = (slot + 1) & m_slot_mask;
+            }
+
+            m_slot_vector[slot] = old_slot_vector[i];
+        }
+    }
+
+    return;
+}
+
+//======================================================================
+//  Member Function: VariableSymbolTable::IsNameAtIndex
+//======================================================================
+
+bool VariableSymbolTable::IsNameAtIndex(const CharSpan & name_span,
+                                        int index) const
+{
+    size_t start = m_name_offset_vector[index];
+    size_t length = m_name_offset_vector[index + 1] - start;
+
+    return (length == name_span.Length())
+        && (memcmp(m_name_arena.data() + start, name_span.Data(), length) == 0);
+}
@@ -0,0 +1,72 @@
+#ifndef VARIABLESYMBOLTABLE_H
+#define VARIABLESYMBOLTABLE_H
+
+#include <stddef.h>
+#include <vector>
+#include "CharSpan.h"
+
+//======================================================================
+//  Class Definition
+//
+//  This class interns variable names and assigns each distinct name
+//  an integer index in the order that the names are first inserted.
+//
+//  The names are stored back to back in a single character arena.
+//  The index of a name is found using an open addressing hash table
+//  with linear probing. Each slot holds the precomputed hash of the
+//  name so that the names only need to be compared when the hash
+//  values match, and so that growing the table never rehashes the
+//  names.
+//======================================================================
+
+class VariableSymbolTable
+{
+public:
+
+    VariableSymbolTable();
+
+    virtual ~VariableSymbolTable();
+
+    int FindOrInsert(const CharSpan & name_span);
+
+    int Find(const CharSpan & name_span) const;
+
+    unsigned int GetSize() const;
+
+    bool IsEmpty() const;
+
+    CharSpan GetName(int index) const;
+
+    void GetIndicesSortedByName(std::vector<int> & sorted_index_vector) const;
+
+    void Reserve(unsigned int number_of_names);
+
+    void Clear();
+
+    static unsigned int Hash(const CharSpan & name_span);
+
+protected:
+
+    struct Slot_T
+    {
+        unsigned int m_hash;
+        int m_index;
+    };
+
+    size_t ProbeForName(const CharSpan & name_span,
+                        unsigned int hash) const;
+
+    void Grow(size_t number_of_slots);
+
+    bool IsNameAtIndex(const CharSpan & name_span,
+                       int index) const;
+
+protected:
+
+    std::vector<Slot_T> m_slot_vector;
+    size_t m_slot_mask;
+    std::vector<char> m_name_arena;
+    std::vector<size_t> m_name_offset_vector;
+};
+
+#endif
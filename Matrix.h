@@ -0,0 +1,82 @@
+#pragma once
+#include<vector>
+#include<cstddef>
+#include "MatrixTaskGraph.h"
+
+class MatrixThreadPool;
+
+class Matrix
+{
+public:
+	Matrix();
+	Matrix(const Matrix& other);
+	Matrix& operator=(const Matrix& other);
+	~Matrix();
+
+	//reserves storage for rows of the given length, so that appending them does not copy the matrix
+	void reserve(int rows, int length);
+	void pushRow(const std::vector<double>& r);
+	//adds a zeroed row of the given length and returns it so it can be filled in place
+	double* appendRow(int length);
+	void displayMatrix();
+	void displayResults();
+	void displayRefinement();
+	std::vector<std::vector<double>> getMatrix();
+	void loadMatrix(const std::vector<std::vector<double>>& copyofM);
+	const std::vector<double>& getGaussSeidelResults();
+	const std::vector<double>& getGaussEliminationResults();
+	//row exchanged with row i at step i of the last gaussElimination or gaussEliminationBlocked
+	const std::vector<int>& getPivotRows();
+
+	void gaussSeidel();
+	void gaussElimination();
+	//right-looking LU in panels of panelWidth columns (0 for the default) with the pivots of gaussElimination, results in x2
+	void gaussEliminationBlocked(int panelWidth = 0);
+	//LU by square tiles of tileSize (0 for the default), with the pivots of gaussElimination, results in x2
+	//the panel factorizations, triangular solves and updates are tasks of a graph run on the threads of setThreadCount
+	void gaussEliminationTiled(int tileSize = 0);
+	//kinds of the tasks of gaussEliminationTiled in getTaskReport
+	enum TiledTask { tiledPanel, tiledSolve, tiledUpdate };
+	//tasks, times and thread utilization of the last gaussEliminationTiled
+	const MatrixTaskReport& getTaskReport();
+	//single precision factorization refined to double accuracy, results in x2
+	void gaussEliminationMixed();
+	int getRefinementIterations();
+	//threads used by gaussElimination and gaussSeidel, 0 for one per hardware thread, 1 (the default) for the calling thread only
+	void setThreadCount(int threads);
+	int getThreadCount();
+	double getBackwardError();
+
+private:
+	double computeResiduals(const std::vector<double>& x, std::vector<double>& r);
+	//F holds the single precision factors by rows, row i starts at F + i * ldF
+	void solveSingle(const float* F, int ldF, const std::vector<int>& perm, const std::vector<double>& b, std::vector<double>& x);
+	void reserveRows(int rows);
+	void releaseStorage();
+	//steps of the blocked and tiled LU: rows k0 to kEnd - 1 of the panel, columns j0 to j1 - 1
+	void factorPanel(int k0, int kEnd, int swapBegin, int swapEnd, int updateEnd);
+	void exchangeRows(int k0, int kEnd, int j0, int j1);
+	void solveRowsOfU(int k0, int kEnd, int j0, int j1);
+	void updateRows(int r0, int r1, int k0, int kEnd, int j0, int j1);
+	void backSubstitution();
+	double* row(int i) { return A + (size_t)i * ld; }
+	//started the first time an elimination runs on more than one thread
+	MatrixThreadPool* workers();
+
+	int n;
+	int b_columnIndex;
+	//the augmented system is stored by rows in one 64 byte aligned buffer, row i starts at A + i * ld
+	double* A;
+	int rowLength;
+	int ld;
+	int rowCapacity;
+	std::vector<double> x1;
+	std::vector<double> x2;
+	std::vector<int> pivotRows;
+	int refinementIterations;
+	double backwardError;
+	bool refinementFellBack;
+	int threadCount;
+	MatrixThreadPool* pool;
+	MatrixTaskReport taskReport;
+};
@@ -0,0 +1,574 @@
+#include "MatrixKernels.h"
+#include<cmath>
+#include<utility>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define MATRIX_KERNELS_X86
+#include<immintrin.h>
+#ifdef _MSC_VER
+#include<intrin.h>
+#endif
+#endif
+
+//the compiler generates AVX2 and AVX-512 code only in these functions, the rest of the program runs on any processor
+#if defined(_MSC_VER)
+#define TARGET_AVX2
+#define TARGET_AVX512
+#else
+#define TARGET_AVX2 __attribute__((target("avx2,fma")))
+#define TARGET_AVX512 __attribute__((target("avx512f")))
+#endif
+
+using namespace std;
+
+namespace MatrixKernels
+{
+	namespace
+	{
+		struct Kernels
+		{
+			Level level;
+			void (*axpy)(double* y, const double* x, double a, int count);
+			void (*axpy4)(double* y, const double* const* x, const double* a, int count);
+			void (*swapRows)(double* x, double* y, int count);
+			double (*dot)(const double* x, const double* y, int count);
+			int (*maxAbsIndex)(const double* x, ptrdiff_t stride, int count);
+			void (*axpyFloat)(float* y, const float* x, float a, int count);
+			int (*maxAbsIndexFloat)(const float* x, ptrdiff_t stride, int count);
+		};
+
+		void axpyScalar(double* y, const double* x, double a, int count)
+		{
+			for (int i = 0; i < count; i++)
+				y[i] += a * x[i];
+		}
+
+		void axpy4Scalar(double* y, const double* const* x, const double* a, int count)
+		{
+			const double* x0 = x[0];
+			const double* x1 = x[1];
+			const double* x2 = x[2];
+			const double* x3 = x[3];
+			for (int i = 0; i < count; i++)
+				y[i] += a[0] * x0[i] + a[1] * x1[i] + a[2] * x2[i] + a[3] * x3[i];
+		}
+
+		void swapRowsScalar(double* x, double* y, int count)
+		{
+			for (int i = 0; i < count; i++)
+				swap(x[i], y[i]);
+		}
+
+		double dotScalar(const double* x, const double* y, int count)
+		{
+			double sum = 0;
+			for (int i = 0; i < count; i++)
+				sum += x[i] * y[i];
+			return sum;
+		}
+
+		template<class T>
+		int maxAbsIndexScalar(const T* x, ptrdiff_t stride, int count)
+		{
+			//the search of gaussElimination, the first of equal elements wins
+			T maxElement = abs(x[0]);
+			int rowWithMax = 0;
+			for (int i = 1; i < count; i++)
+			{
+				if (abs(x[i * stride]) > maxElement)
+				{
+					maxElement = abs(x[i * stride]);
+					rowWithMax = i;
+				}
+			}
+			return rowWithMax;
+		}
+
+		void axpyFloatScalar(float* y, const float* x, float a, int count)
+		{
+			for (int i = 0; i < count; i++)
+				y[i] += a * x[i];
+		}
+
+		//largest lane of a vector search, the first index of equal lanes, then the elements after the last whole vector
+		//single precision elements are searched as doubles, which keeps their order
+		template<class T>
+		int finishMaxAbsIndex(const double* best, const double* bestIndex, int lanes, const T* x, ptrdiff_t stride, int first, int count)
+		{
+			double maxElement = best[0];
+			double rowWithMax = bestIndex[0];
+			for (int l = 1; l < lanes; l++)
+			{
+				if (best[l] > maxElement || (best[l] == maxElement && bestIndex[l] < rowWithMax))
+				{
+					maxElement = best[l];
+					rowWithMax = bestIndex[l];
+				}
+			}
+			for (int i = first; i < count; i++)
+			{
+				if (abs(x[i * stride]) > maxElement)
+				{
+					maxElement = abs(x[i * stride]);
+					rowWithMax = i;
+				}
+			}
+			return (int)rowWithMax;
+		}
+
+#ifdef MATRIX_KERNELS_X86
+		TARGET_AVX2 void axpyAvx2(double* y, const double* x, double a, int count)
+		{
+			__m256d va = _mm256_set1_pd(a);
+			int i = 0;
+			for (; i + 8 <= count; i += 8)
+			{
+				__m256d y0 = _mm256_fmadd_pd(va, _mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i));
+				__m256d y1 = _mm256_fmadd_pd(va, _mm256_loadu_pd(x + i + 4), _mm256_loadu_pd(y + i + 4));
+				_mm256_storeu_pd(y + i, y0);
+				_mm256_storeu_pd(y + i + 4, y1);
+			}
+			for (; i + 4 <= count; i += 4)
+				_mm256_storeu_pd(y + i, _mm256_fmadd_pd(va, _mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i)));
+			for (; i < count; i++)
+				y[i] = _mm_cvtsd_f64(_mm_fmadd_sd(_mm_set_sd(a), _mm_set_sd(x[i]), _mm_set_sd(y[i])));
+		}
+
+		TARGET_AVX2 void axpy4Avx2(double* y, const double* const* x, const double* a, int count)
+		{
+			const double* x0 = x[0];
+			const double* x1 = x[1];
+			const double* x2 = x[2];
+			const double* x3 = x[3];
+			__m256d a0 = _mm256_set1_pd(a[0]);
+			__m256d a1 = _mm256_set1_pd(a[1]);
+			__m256d a2 = _mm256_set1_pd(a[2]);
+			__m256d a3 = _mm256_set1_pd(a[3]);
+			int i = 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				__m256d vy = _mm256_fmadd_pd(a0, _mm256_loadu_pd(x0 + i), _mm256_loadu_pd(y + i));
+				vy = _mm256_fmadd_pd(a1, _mm256_loadu_pd(x1 + i), vy);
+				vy = _mm256_fmadd_pd(a2, _mm256_loadu_pd(x2 + i), vy);
+				vy = _mm256_fmadd_pd(a3, _mm256_loadu_pd(x3 + i), vy);
+				_mm256_storeu_pd(y + i, vy);
+			}
+			for (; i < count; i++)
+				y[i] += a[0] * x0[i] + a[1] * x1[i] + a[2] * x2[i] + a[3] * x3[i];
+		}
+
+		TARGET_AVX2 void swapRowsAvx2(double* x, double* y, int count)
+		{
+			int i = 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				__m256d vx = _mm256_loadu_pd(x + i);
+				__m256d vy = _mm256_loadu_pd(y + i);
+				_mm256_storeu_pd(x + i, vy);
+				_mm256_storeu_pd(y + i, vx);
+			}
+			for (; i < count; i++)
+				swap(x[i], y[i]);
+		}
+
+		TARGET_AVX2 double dotAvx2(const double* x, const double* y, int count)
+		{
+			__m256d sum0 = _mm256_setzero_pd();
+			__m256d sum1 = _mm256_setzero_pd();
+			int i = 0;
+			for (; i + 8 <= count; i += 8)
+			{
+				sum0 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i), sum0);
+				sum1 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i + 4), _mm256_loadu_pd(y + i + 4), sum1);
+			}
+			if (i + 4 <= count)
+			{
+				sum0 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i), sum0);
+				i += 4;
+			}
+			sum0 = _mm256_add_pd(sum0, sum1);
+			__m128d half = _mm_add_pd(_mm256_castpd256_pd128(sum0), _mm256_extractf128_pd(sum0, 1));
+			double sum = _mm_cvtsd_f64(_mm_add_sd(half, _mm_unpackhi_pd(half, half)));
+			for (; i < count; i++)
+				sum += x[i] * y[i];
+			return sum;
+		}
+
+		TARGET_AVX2 int maxAbsIndexAvx2(const double* x, ptrdiff_t stride, int count)
+		{
+			//a NaN first element is never replaced by the scalar search
+			if (count < 8 || !(abs(x[0]) >= 0))
+				return maxAbsIndexScalar(x, stride, count);
+
+			//gather four rows at a time, each lane keeps its largest element and the first row that has it
+			__m256d signMask = _mm256_set1_pd(-0.0);
+			__m256i offsets = _mm256_set_epi64x(3 * stride, 2 * stride, stride, 0);
+			__m256i step = _mm256_set1_epi64x(4 * stride);
+			__m256d index = _mm256_set_pd(3, 2, 1, 0);
+			__m256d four = _mm256_set1_pd(4);
+			__m256d best = _mm256_set1_pd(-1);
+			__m256d bestIndex = _mm256_setzero_pd();
+			int i = 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				__m256d v = _mm256_andnot_pd(signMask, _mm256_i64gather_pd(x, offsets, 8));
+				__m256d greater = _mm256_cmp_pd(v, best, _CMP_GT_OQ);
+				best = _mm256_blendv_pd(best, v, greater);
+				bestIndex = _mm256_blendv_pd(bestIndex, index, greater);
+				offsets = _mm256_add_epi64(offsets, step);
+				index = _mm256_add_pd(index, four);
+			}
+			double bestArray[4], bestIndexArray[4];
+			_mm256_storeu_pd(bestArray, best);
+			_mm256_storeu_pd(bestIndexArray, bestIndex);
+			return finishMaxAbsIndex(bestArray, bestIndexArray, 4, x, stride, i, count);
+		}
+
+		TARGET_AVX2 void axpyFloatAvx2(float* y, const float* x, float a, int count)
+		{
+			__m256 va = _mm256_set1_ps(a);
+			int i = 0;
+			for (; i + 16 <= count; i += 16)
+			{
+				__m256 y0 = _mm256_fmadd_ps(va, _mm256_loadu_ps(x + i), _mm256_loadu_ps(y + i));
+				__m256 y1 = _mm256_fmadd_ps(va, _mm256_loadu_ps(x + i + 8), _mm256_loadu_ps(y + i + 8));
+				_mm256_storeu_ps(y + i, y0);
+				_mm256_storeu_ps(y + i + 8, y1);
+			}
+			for (; i + 8 <= count; i += 8)
+				_mm256_storeu_ps(y + i, _mm256_fmadd_ps(va, _mm256_loadu_ps(x + i), _mm256_loadu_ps(y + i)));
+			for (; i < count; i++)
+				y[i] = _mm_cvtss_f32(_mm_fmadd_ss(_mm_set_ss(a), _mm_set_ss(x[i]), _mm_set_ss(y[i])));
+		}
+
+		TARGET_AVX2 int maxAbsIndexFloatAvx2(const float* x, ptrdiff_t stride, int count)
+		{
+			if (count < 8 || !(abs(x[0]) >= 0))
+				return maxAbsIndexScalar(x, stride, count);
+
+			//four rows at a time as in maxAbsIndexAvx2, the gathered elements are widened to double
+			__m256d signMask = _mm256_set1_pd(-0.0);
+			__m256i offsets = _mm256_set_epi64x(3 * stride, 2 * stride, stride, 0);
+			__m256i step = _mm256_set1_epi64x(4 * stride);
+			__m256d index = _mm256_set_pd(3, 2, 1, 0);
+			__m256d four = _mm256_set1_pd(4);
+			__m256d best = _mm256_set1_pd(-1);
+			__m256d bestIndex = _mm256_setzero_pd();
+			int i = 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				__m256d v = _mm256_andnot_pd(signMask, _mm256_cvtps_pd(_mm256_i64gather_ps(x, offsets, 4)));
+				__m256d greater = _mm256_cmp_pd(v, best, _CMP_GT_OQ);
+				best = _mm256_blendv_pd(best, v, greater);
+				bestIndex = _mm256_blendv_pd(bestIndex, index, greater);
+				offsets = _mm256_add_epi64(offsets, step);
+				index = _mm256_add_pd(index, four);
+			}
+			double bestArray[4], bestIndexArray[4];
+			_mm256_storeu_pd(bestArray, best);
+			_mm256_storeu_pd(bestIndexArray, bestIndex);
+			return finishMaxAbsIndex(bestArray, bestIndexArray, 4, x, stride, i, count);
+		}
+
+		TARGET_AVX512 void axpyAvx512(double* y, const double* x, double a, int count)
+		{
+			__m512d va = _mm512_set1_pd(a);
+			int i = 0;
+			for (; i + 16 <= count; i += 16)
+			{
+				__m512d y0 = _mm512_fmadd_pd(va, _mm512_loadu_pd(x + i), _mm512_loadu_pd(y + i));
+				__m512d y1 = _mm512_fmadd_pd(va, _mm512_loadu_pd(x + i + 8), _mm512_loadu_pd(y + i + 8));
+				_mm512_storeu_pd(y + i, y0);
+				_mm512_storeu_pd(y + i + 8, y1);
+			}
+			for (; i + 8 <= count; i += 8)
+				_mm512_storeu_pd(y + i, _mm512_fmadd_pd(va, _mm512_loadu_pd(x + i), _mm512_loadu_pd(y + i)));
+			if (i < count)
+			{
+				__mmask8 tail = (__mmask8)((1u << (count - i)) - 1);
+				__m512d vy = _mm512_fmadd_pd(va, _mm512_maskz_loadu_pd(tail, x + i), _mm512_maskz_loadu_pd(tail, y + i));
+				_mm512_mask_storeu_pd(y + i, tail, vy);
+			}
+		}
+
+		TARGET_AVX512 void axpy4Avx512(double* y, const double* const* x, const double* a, int count)
+		{
+			const double* x0 = x[0];
+			const double* x1 = x[1];
+			const double* x2 = x[2];
+			const double* x3 = x[3];
+			__m512d a0 = _mm512_set1_pd(a[0]);
+			__m512d a1 = _mm512_set1_pd(a[1]);
+			__m512d a2 = _mm512_set1_pd(a[2]);
+			__m512d a3 = _mm512_set1_pd(a[3]);
+			int i = 0;
+			for (; i + 8 <= count; i += 8)
+			{
+				__m512d vy = _mm512_fmadd_pd(a0, _mm512_loadu_pd(x0 + i), _mm512_loadu_pd(y + i));
+				vy = _mm512_fmadd_pd(a1, _mm512_loadu_pd(x1 + i), vy);
+				vy = _mm512_fmadd_pd(a2, _mm512_loadu_pd(x2 + i), vy);
+				vy = _mm512_fmadd_pd(a3, _mm512_loadu_pd(x3 + i), vy);
+				_mm512_storeu_pd(y + i, vy);
+			}
+			if (i < count)
+			{
+				__mmask8 tail = (__mmask8)((1u << (count - i)) - 1);
+				__m512d vy = _mm512_fmadd_pd(a0, _mm512_maskz_loadu_pd(tail, x0 + i), _mm512_maskz_loadu_pd(tail, y + i));
+				vy = _mm512_fmadd_pd(a1, _mm512_maskz_loadu_pd(tail, x1 + i), vy);
+				vy = _mm512_fmadd_pd(a2, _mm512_maskz_loadu_pd(tail, x2 + i), vy);
+				vy = _mm512_fmadd_pd(a3, _mm512_maskz_loadu_pd(tail, x3 + i), vy);
+				_mm512_mask_storeu_pd(y + i, tail, vy);
+			}
+		}
+
+		TARGET_AVX512 void swapRowsAvx512(double* x, double* y, int count)
+		{
+			int i = 0;
+			for (; i + 8 <= count; i += 8)
+			{
+				__m512d vx = _mm512_loadu_pd(x + i);
+				__m512d vy = _mm512_loadu_pd(y + i);
+				_mm512_storeu_pd(x + i, vy);
+				_mm512_storeu_pd(y + i, vx);
+			}
+			if (i < count)
+			{
+				__mmask8 tail = (__mmask8)((1u << (count - i)) - 1);
+				__m512d vx = _mm512_maskz_loadu_pd(tail, x + i);
+				__m512d vy = _mm512_maskz_loadu_pd(tail, y + i);
+				_mm512_mask_storeu_pd(x + i, tail, vy);
+				_mm512_mask_storeu_pd(y + i, tail, vx);
+			}
+		}
+
+		TARGET_AVX512 double dotAvx512(const double* x, const double* y, int count)
+		{
+			__m512d sum0 = _mm512_setzero_pd();
+			__m512d sum1 = _mm512_setzero_pd();
+			int i = 0;
+			for (; i + 16 <= count; i += 16)
+			{
+				sum0 = _mm512_fmadd_pd(_mm512_loadu_pd(x + i), _mm512_loadu_pd(y + i), sum0);
+				sum1 = _mm512_fmadd_pd(_mm512_loadu_pd(x + i + 8), _mm512_loadu_pd(y + i + 8), sum1);
+			}
+			for (; i + 8 <= count; i += 8)
+				sum0 = _mm512_fmadd_pd(_mm512_loadu_pd(x + i), _mm512_loadu_pd(y + i), sum0);
+			if (i < count)
+			{
+				__mmask8 tail = (__mmask8)((1u << (count - i)) - 1);
+				sum1 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(tail, x + i), _mm512_maskz_loadu_pd(tail, y + i), sum1);
+			}
+			return _mm512_reduce_add_pd(_mm512_add_pd(sum0, sum1));
+		}
+
+		TARGET_AVX512 int maxAbsIndexAvx512(const double* x, ptrdiff_t stride, int count)
+		{
+			if (count < 16 || !(abs(x[0]) >= 0))
+				return maxAbsIndexScalar(x, stride, count);
+
+			__m512i offsets = _mm512_set_epi64(7 * stride, 6 * stride, 5 * stride, 4 * stride, 3 * stride, 2 * stride, stride, 0);
+			__m512i step = _mm512_set1_epi64(8 * stride);
+			__m512d index = _mm512_set_pd(7, 6, 5, 4, 3, 2, 1, 0);
+			__m512d eight = _mm512_set1_pd(8);
+			__m512d best = _mm512_set1_pd(-1);
+			__m512d bestIndex = _mm512_setzero_pd();
+			int i = 0;
+			for (; i + 8 <= count; i += 8)
+			{
+				__m512d v = _mm512_abs_pd(_mm512_i64gather_pd(offsets, x, 8));
+				__mmask8 greater = _mm512_cmp_pd_mask(v, best, _CMP_GT_OQ);
+				best = _mm512_mask_mov_pd(best, greater, v);
+				bestIndex = _mm512_mask_mov_pd(bestIndex, greater, index);
+				offsets = _mm512_add_epi64(offsets, step);
+				index = _mm512_add_pd(index, eight);
+			}
+			double bestArray[8], bestIndexArray[8];
+			_mm512_storeu_pd(bestArray, best);
+			_mm512_storeu_pd(bestIndexArray, bestIndex);
+			return finishMaxAbsIndex(bestArray, bestIndexArray, 8, x, stride, i, count);
+		}
+
+		TARGET_AVX512 void axpyFloatAvx512(float* y, const float* x, float a, int count)
+		{
+			__m512 va = _mm512_set1_ps(a);
+			int i = 0;
+			for (; i + 32 <= count; i += 32)
+			{
+				__m512 y0 = _mm512_fmadd_ps(va, _mm512_loadu_ps(x + i), _mm512_loadu_ps(y + i));
+				__m512 y1 = _mm512_fmadd_ps(va, _mm512_loadu_ps(x + i + 16), _mm512_loadu_ps(y + i + 16));
+				_mm512_storeu_ps(y + i, y0);
+				_mm512_storeu_ps(y + i + 16, y1);
+			}
+			for (; i + 16 <= count; i += 16)
+				_mm512_storeu_ps(y + i, _mm512_fmadd_ps(va, _mm512_loadu_ps(x + i), _mm512_loadu_ps(y + i)));
+			if (i < count)
+			{
+				__mmask16 tail = (__mmask16)((1u << (count - i)) - 1);
+				__m512 vy = _mm512_fmadd_ps(va, _mm512_maskz_loadu_ps(tail, x + i), _mm512_maskz_loadu_ps(tail, y + i));
+				_mm512_mask_storeu_ps(y + i, tail, vy);
+			}
+		}
+
+		TARGET_AVX512 int maxAbsIndexFloatAvx512(const float* x, ptrdiff_t stride, int count)
+		{
+			if (count < 16 || !(abs(x[0]) >= 0))
+				return maxAbsIndexScalar(x, stride, count);
+
+			//eight rows at a time as in maxAbsIndexAvx512, the gathered elements are widened to double
+			__m512i offsets = _mm512_set_epi64(7 * stride, 6 * stride, 5 * stride, 4 * stride, 3 * stride, 2 * stride, stride, 0);
+			__m512i step = _mm512_set1_epi64(8 * stride);
+			__m512d index = _mm512_set_pd(7, 6, 5, 4, 3, 2, 1, 0);
+			__m512d eight = _mm512_set1_pd(8);
+			__m512d best = _mm512_set1_pd(-1);
+			__m512d bestIndex = _mm512_setzero_pd();
+			int i = 0;
+			for (; i + 8 <= count; i += 8)
+			{
+				__m512d v = _mm512_abs_pd(_mm512_cvtps_pd(_mm512_i64gather_ps(offsets, x, 4)));
+				__mmask8 greater = _mm512_cmp_pd_mask(v, best, _CMP_GT_OQ);
+				best = _mm512_mask_mov_pd(best, greater, v);
+				bestIndex = _mm512_mask_mov_pd(bestIndex, greater, index);
+				offsets = _mm512_add_epi64(offsets, step);
+				index = _mm512_add_pd(index, eight);
+			}
+			double bestArray[8], bestIndexArray[8];
+			_mm512_storeu_pd(bestArray, best);
+			_mm512_storeu_pd(bestIndexArray, bestIndex);
+			return finishMaxAbsIndex(bestArray, bestIndexArray, 8, x, stride, i, count);
+		}
+#endif
+
+		Level detectLevel()
+		{
+#if defined(MATRIX_KERNELS_X86) && defined(_MSC_VER)
+			//the instructions must be supported and the operating system must save the registers
+			int info[4];
+			__cpuid(info, 0);
+			if (info[0] < 7)
+				return scalar;
+			__cpuid(info, 1);
+			bool fma = (info[2] & (1 << 12)) != 0;
+			bool osxsave = (info[2] & (1 << 27)) != 0;
+			bool avx = (info[2] & (1 << 28)) != 0;
+			if (!osxsave || !avx)
+				return scalar;
+			unsigned long long xcr0 = _xgetbv(0);
+			__cpuidex(info, 7, 0);
+			bool hasAvx2 = (info[1] & (1 << 5)) != 0;
+			bool hasAvx512 = (info[1] & (1 << 16)) != 0;
+			if (hasAvx512 && (xcr0 & 0xE6) == 0xE6)
+				return avx512;
+			if (hasAvx2 && fma && (xcr0 & 0x6) == 0x6)
+				return avx2;
+			return scalar;
+#elif defined(MATRIX_KERNELS_X86)
+			__builtin_cpu_init();
+			if (__builtin_cpu_supports("avx512f"))
+				return avx512;
+			if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+				return avx2;
+			return scalar;
+#else
+			return scalar;
+#endif
+		}
+
+		Kernels kernelsFor(Level level)
+		{
+			Kernels kernels = { scalar, axpyScalar, axpy4Scalar, swapRowsScalar, dotScalar, maxAbsIndexScalar<double>,
+				axpyFloatScalar, maxAbsIndexScalar<float> };
+#ifdef MATRIX_KERNELS_X86
+			if (level == avx512)
+			{
+				Kernels avx512Kernels = { avx512, axpyAvx512, axpy4Avx512, swapRowsAvx512, dotAvx512, maxAbsIndexAvx512,
+					axpyFloatAvx512, maxAbsIndexFloatAvx512 };
+				kernels = avx512Kernels;
+			}
+			else if (level == avx2)
+			{
+				Kernels avx2Kernels = { avx2, axpyAvx2, axpy4Avx2, swapRowsAvx2, dotAvx2, maxAbsIndexAvx2,
+					axpyFloatAvx2, maxAbsIndexFloatAvx2 };
+				kernels = avx2Kernels;
+			}
+#endif
+			return kernels;
+		}
+
+		//chosen once, the first time a kernel is called
+		Kernels& selected()
+		{
+			static Kernels kernels = kernelsFor(supportedLevel());
+			return kernels;
+		}
+	}
+
+	Level supportedLevel()
+	{
+		static Level level = detectLevel();
+		return level;
+	}
+
+	Level getLevel()
+	{
+		return selected().level;
+	}
+
+	void setLevel(Level level)
+	{
+		if (level > supportedLevel())
+			level = supportedLevel();
+		selected() = kernelsFor(level);
+	}
+
+	const char* levelName(Level level)
+	{
+		switch (level)
+		{
+		case avx512:
+			return "AVX-512";
+		case avx2:
+			return "AVX2";
+		default:
+			return "scalar";
+		}
+	}
+
+	void axpy(double* y, const double* x, double a, int count)
+	{
+		selected().axpy(y, x, a, count);
+	}
+
+	void axpy4(double* y, const double* const* x, const double* a, int count)
+	{
+		selected().axpy4(y, x, a, count);
+	}
+
+	void swapRows(double* x, double* y, int count)
+	{
+		selected().swapRows(x, y, count);
+	}
+
+	double dot(const double* x, const double* y, int count)
+	{
+		return selected().dot(x, y, count);
+	}
+
+	int maxAbsIndex(const double* x, ptrdiff_t stride, int count)
+	{
+		if (count <= 0)
+			return 0;
+		return selected().maxAbsIndex(x, stride, count);
+	}
+
+	void axpy(float* y, const float* x, float a, int count)
+	{
+		selected().axpyFloat(y, x, a, count);
+	}
+
+	int maxAbsIndex(const float* x, ptrdiff_t stride, int count)
+	{
+		if (count <= 0)
+			return 0;
+		return selected().maxAbsIndexFloat(x, stride, count);
+	}
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include<cstddef>
+
+//row kernels of the Matrix elimination routines, in AVX-512, AVX2 with FMA and plain C++
+//the fastest set the processor supports is chosen the first time a kernel is called
+namespace MatrixKernels
+{
+	enum Level
+	{
+		scalar,
+		avx2,
+		avx512
+	};
+
+	Level supportedLevel();
+	Level getLevel();
+	//selects the kernels, a level the processor does not support selects the supported level
+	void setLevel(Level level);
+	const char* levelName(Level level);
+
+	//y += a * x
+	void axpy(double* y, const double* x, double a, int count);
+	//y += a[0] * x[0] + a[1] * x[1] + a[2] * x[2] + a[3] * x[3], y is loaded and stored once for the four rows
+	void axpy4(double* y, const double* const* x, const double* a, int count);
+	//exchanges x and y
+	void swapRows(double* x, double* y, int count);
+	//sum of x[i] * y[i]
+	double dot(const double* x, const double* y, int count);
+	//index of the first element of largest magnitude of x[0], x[stride], x[2 * stride] ...
+	int maxAbsIndex(const double* x, ptrdiff_t stride, int count);
+
+	//the single precision kernels of gaussEliminationMixed
+	void axpy(float* y, const float* x, float a, int count);
+	int maxAbsIndex(const float* x, ptrdiff_t stride, int count);
+}
@@ -0,0 +1,183 @@
+#include "MatrixTaskGraph.h"
+#include "MatrixThreadPool.h"
+#include<algorithm>
+#include<atomic>
+#include<chrono>
+#include<memory>
+#include<mutex>
+#include<thread>
+using namespace std;
+
+namespace
+{
+	const int idleSpins = 64;
+
+	//ready tasks of one thread, a heap with the task on the longest path on top, padded so that queues do not share a cache line
+	struct ReadyQueue
+	{
+		mutex lock;
+		vector<int> heap;
+		char padding[64];
+	};
+
+	struct ThreadTimes
+	{
+		vector<MatrixTaskTimes> kinds;
+		double busySeconds;
+		int steals;
+	};
+
+	double secondsSince(chrono::steady_clock::time_point start)
+	{
+		return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	}
+}
+
+int MatrixTaskGraph::addTask(int kind, double cost, const function<void()>& work)
+{
+	Task task;
+	task.kind = kind;
+	task.cost = cost;
+	task.work = work;
+	task.dependencies = 0;
+	tasks.push_back(task);
+	return (int)tasks.size() - 1;
+}
+
+void MatrixTaskGraph::addDependency(int before, int after)
+{
+	tasks[before].successors.push_back(after);
+	tasks[after].dependencies++;
+}
+
+int MatrixTaskGraph::getTaskCount()
+{
+	return (int)tasks.size();
+}
+
+void MatrixTaskGraph::run(MatrixThreadPool* pool, MatrixTaskReport& report)
+{
+	int taskCount = (int)tasks.size();
+	int threads = pool != 0 ? pool->getThreadCount() : 1;
+	int kindCount = 0;
+	for (int t = 0; t < taskCount; t++)
+		kindCount = max(kindCount, tasks[t].kind + 1);
+
+	//longest estimated path from the start of each task to the end of the graph, tasks only depend on tasks added before them
+	vector<double> priority(taskCount);
+	for (int t = taskCount - 1; t >= 0; t--)
+	{
+		double longest = 0;
+		for (size_t s = 0; s < tasks[t].successors.size(); s++)
+			longest = max(longest, priority[tasks[t].successors[s]]);
+		priority[t] = tasks[t].cost + longest;
+	}
+	auto lowerPriority = [&](int a, int b)
+	{
+		//equal paths run in the order they were added
+		return priority[a] < priority[b] || (priority[a] == priority[b] && a > b);
+	};
+
+	unique_ptr<atomic<int>[]> remaining(new atomic<int>[taskCount]);
+	vector<ReadyQueue> queues(threads);
+	vector<ThreadTimes> times(threads);
+	for (int t = 0; t < taskCount; t++)
+	{
+		remaining[t] = tasks[t].dependencies;
+		//the first tasks are dealt out to the threads
+		if (tasks[t].dependencies == 0)
+		{
+			vector<int>& heap = queues[t % threads].heap;
+			heap.push_back(t);
+			push_heap(heap.begin(), heap.end(), lowerPriority);
+		}
+	}
+	atomic<int> done(0);
+
+	auto takeFrom = [&](ReadyQueue& queue)
+	{
+		lock_guard<mutex> lock(queue.lock);
+		if (queue.heap.empty())
+			return -1;
+		pop_heap(queue.heap.begin(), queue.heap.end(), lowerPriority);
+		int t = queue.heap.back();
+		queue.heap.pop_back();
+		return t;
+	};
+
+	auto work = [&](int thread)
+	{
+		ThreadTimes& own = times[thread];
+		own.kinds.assign(kindCount, MatrixTaskTimes());
+		own.busySeconds = 0;
+		own.steals = 0;
+		int idle = 0;
+		while (done < taskCount)
+		{
+			//the own queue first, then the queues of the other threads in turn
+			int t = takeFrom(queues[thread]);
+			for (int v = 1; t < 0 && v < threads; v++)
+			{
+				t = takeFrom(queues[(thread + v) % threads]);
+				if (t >= 0)
+					own.steals++;
+			}
+			if (t < 0)
+			{
+				if (++idle < idleSpins)
+					continue;
+				this_thread::yield();
+				continue;
+			}
+			idle = 0;
+
+			chrono::steady_clock::time_point start = chrono::steady_clock::now();
+			tasks[t].work();
+			double seconds = secondsSince(start);
+			MatrixTaskTimes& kind = own.kinds[tasks[t].kind];
+			kind.count++;
+			kind.seconds += seconds;
+			kind.longest = max(kind.longest, seconds);
+			own.busySeconds += seconds;
+
+			//the tasks this one made ready go to this thread, which has their data in its cache
+			for (size_t s = 0; s < tasks[t].successors.size(); s++)
+			{
+				int successor = tasks[t].successors[s];
+				if (--remaining[successor] == 0)
+				{
+					lock_guard<mutex> lock(queues[thread].lock);
+					queues[thread].heap.push_back(successor);
+					push_heap(queues[thread].heap.begin(), queues[thread].heap.end(), lowerPriority);
+				}
+			}
+			done++;
+		}
+	};
+
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	if (pool != 0)
+		pool->run(work);
+	else
+		work(0);
+	double wallSeconds = secondsSince(start);
+
+	report.threads = threads;
+	report.tasks = taskCount;
+	report.steals = 0;
+	report.wallSeconds = wallSeconds;
+	report.busySeconds = 0;
+	report.kinds.assign(kindCount, MatrixTaskTimes());
+	for (int t = 0; t < threads; t++)
+	{
+		report.steals += times[t].steals;
+		report.busySeconds += times[t].busySeconds;
+		for (int k = 0; k < kindCount; k++)
+		{
+			report.kinds[k].count += times[t].kinds[k].count;
+			report.kinds[k].seconds += times[t].kinds[k].seconds;
+			report.kinds[k].longest = max(report.kinds[k].longest, times[t].kinds[k].longest);
+		}
+	}
+	report.utilization = wallSeconds > 0 ? report.busySeconds / (threads * wallSeconds) : 0;
+}
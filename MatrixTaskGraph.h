@@ -0,0 +1,55 @@
+#pragma once
+#include<functional>
+#include<vector>
+
+class MatrixThreadPool;
+
+//number and times of the tasks of one kind
+struct MatrixTaskTimes
+{
+	int count;
+	double seconds;
+	double longest;
+};
+
+//what a run of a task graph did, to choose the tile size
+struct MatrixTaskReport
+{
+	int threads;
+	int tasks;
+	//tasks a thread took from the queue of another thread
+	int steals;
+	double wallSeconds;
+	//sum of the task times of all threads
+	double busySeconds;
+	//busySeconds / (threads * wallSeconds)
+	double utilization;
+	//indexed by the kind of the task
+	std::vector<MatrixTaskTimes> kinds;
+};
+
+//tasks that depend on each other, run by threads that each keep a queue of ready tasks and take work from the others when theirs is empty
+//a thread runs the ready task with the longest estimated path to the end of the graph first, which keeps the critical path moving
+class MatrixTaskGraph
+{
+public:
+	//the cost is an estimate in any unit, used only to find the critical path; returns the number of the task
+	int addTask(int kind, double cost, const std::function<void()>& work);
+	//task after starts when task before is done, before must have been added first
+	void addDependency(int before, int after);
+	int getTaskCount();
+	//runs every task on the threads of the pool, or on the calling thread when pool is 0, and returns when all are done
+	void run(MatrixThreadPool* pool, MatrixTaskReport& report);
+
+private:
+	struct Task
+	{
+		int kind;
+		double cost;
+		std::function<void()> work;
+		std::vector<int> successors;
+		int dependencies;
+	};
+
+	std::vector<Task> tasks;
+};
@@ -0,0 +1,116 @@
+#include "MatrixThreadPool.h"
+#include<algorithm>
+#if defined(_M_X64) || defined(__x86_64__)
+#include<immintrin.h>
+#endif
+using namespace std;
+
+namespace
+{
+	//about a millisecond of spinning before a worker sleeps
+	const int workerSpins = 20000;
+
+	void relax()
+	{
+#if defined(_M_X64) || defined(__x86_64__)
+		_mm_pause();
+#else
+		this_thread::yield();
+#endif
+	}
+}
+
+MatrixThreadPool::MatrixThreadPool(int threads)
+{
+	if (threads <= 0)
+		threads = (int)thread::hardware_concurrency();
+	threadCount = max(threads, 1);
+	//spinning only helps when every thread has a processor, otherwise it takes the time of the threads that have work
+	spinCount = threadCount <= (int)thread::hardware_concurrency() ? workerSpins : 0;
+	task = 0;
+	generation = 0;
+	pending = 0;
+	stopping = false;
+	for (int t = 1; t < threadCount; t++)
+		workers.push_back(thread(&MatrixThreadPool::workerLoop, this, t));
+}
+
+MatrixThreadPool::~MatrixThreadPool()
+{
+	{
+		lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	wake.notify_all();
+	for (size_t t = 0; t < workers.size(); t++)
+		workers[t].join();
+}
+
+int MatrixThreadPool::getThreadCount()
+{
+	return threadCount;
+}
+
+void MatrixThreadPool::run(const function<void(int)>& t)
+{
+	if (threadCount == 1)
+	{
+		t(0);
+		return;
+	}
+
+	task = &t;
+	pending = threadCount - 1;
+	generation++;
+	//taking the lock makes sure a worker that is about to sleep sees the new generation or gets the notification
+	{
+		lock_guard<std::mutex> lock(mutex);
+	}
+	wake.notify_all();
+
+	t(0);
+
+	for (int spins = 0; pending != 0 && spins < spinCount; spins++)
+		relax();
+	if (pending != 0)
+	{
+		unique_lock<std::mutex> lock(mutex);
+		while (pending != 0)
+			done.wait(lock);
+	}
+	task = 0;
+}
+
+void MatrixThreadPool::splitRange(int first, int last, int index, int& begin, int& end)
+{
+	long long count = max(last - first, 0);
+	begin = first + (int)(count * index / threadCount);
+	end = first + (int)(count * (index + 1) / threadCount);
+}
+
+void MatrixThreadPool::workerLoop(int index)
+{
+	unsigned seen = 0;
+	for (;;)
+	{
+		for (int spins = 0; generation == seen && spins < spinCount; spins++)
+			relax();
+		if (generation == seen)
+		{
+			unique_lock<std::mutex> lock(mutex);
+			while (!stopping && generation == seen)
+				wake.wait(lock);
+			if (stopping)
+				return;
+		}
+		seen = generation;
+
+		(*task)(index);
+
+		if (--pending == 0)
+		{
+			lock_guard<std::mutex> lock(mutex);
+			done.notify_one();
+		}
+	}
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include<atomic>
+#include<condition_variable>
+#include<functional>
+#include<mutex>
+#include<thread>
+#include<vector>
+
+//threads that stay alive between the steps of an elimination, so a step costs a wake up and not a thread start
+//a worker spins for a short time after each step before it sleeps, because the next step follows within microseconds
+class MatrixThreadPool
+{
+public:
+	//threads includes the thread that calls run, 0 for one per hardware thread
+	explicit MatrixThreadPool(int threads);
+	~MatrixThreadPool();
+
+	int getThreadCount();
+	//calls task(thread) once for every thread from 0 to getThreadCount() - 1, thread 0 on the caller, and returns when all calls have returned
+	void run(const std::function<void(int)>& task);
+	//rows first to last - 1 split into one contiguous range per thread, the range of the thread with the given index
+	void splitRange(int first, int last, int index, int& begin, int& end);
+
+private:
+	MatrixThreadPool(const MatrixThreadPool&);
+	MatrixThreadPool& operator=(const MatrixThreadPool&);
+	void workerLoop(int index);
+
+	int threadCount;
+	int spinCount;
+	std::vector<std::thread> workers;
+	std::mutex mutex;
+	std::condition_variable wake;
+	std::condition_variable done;
+	const std::function<void(int)>* task;
+	//changes for every run, a worker runs the task once per generation
+	std::atomic<unsigned> generation;
+	std::atomic<int> pending;
+	bool stopping;
+};
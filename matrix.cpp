@@ -1,24 +1,236 @@
 #include "Matrix.h"
-#include"GameState.h"
+#include "MatrixKernels.h"
+#include "MatrixThreadPool.h"
+#include "MatrixTaskGraph.h"
 #include<iostream>
 #include<iomanip>
 #include<cmath>
+#include<limits>
+#include<utility>
+#include<algorithm>
+#include<new>
+#ifdef _WIN32
+#include<malloc.h>
+#else
+#include<cstdlib>
+#endif
 using namespace std;
 
+namespace
+{
+	const int alignment = 64;
+	const int lineElements = alignment / sizeof(double);
+	//columns factored together by gaussEliminationBlocked before the trailing matrix is updated
+	const int defaultPanelWidth = 64;
+	//the rows of U used by one column tile of the trailing update are sized to stay in the L2 cache
+	const int trailingTileBytes = 128 * 1024;
+	//rows and columns of a tile of gaussEliminationTiled
+	const int defaultTileSize = 128;
+	//elements updated by a step of gaussElimination or gaussSeidel below which the step runs on one thread, a step on the pool costs a few microseconds
+	const int parallelStepElements = 32 * 1024;
+
+	//largest element of the next pivot column in the rows one thread updated, padded so that threads do not share a cache line
+	struct PivotCandidate
+	{
+		double value;
+		int row;
+		char padding[alignment - sizeof(double) - sizeof(int)];
+	};
+
+	template<class T>
+	T* allocateAligned(size_t count)
+	{
+		void* p = 0;
+#ifdef _WIN32
+		p = _aligned_malloc(count * sizeof(T), alignment);
+#else
+		if (posix_memalign(&p, alignment, count * sizeof(T)) != 0)
+			p = 0;
+#endif
+		if (p == 0)
+			throw bad_alloc();
+		return (T*)p;
+	}
+
+	template<class T>
+	void freeAligned(T* p)
+	{
+#ifdef _WIN32
+		_aligned_free(p);
+#else
+		free(p);
+#endif
+	}
+
+	template<class T>
+	int paddedLength(int length)
+	{
+		//whole cache lines per row, and not a multiple of 4096 bytes, which would put the same column of every row in the same cache set
+		const int elements = alignment / sizeof(T);
+		int padded = (length + elements - 1) / elements * elements;
+		if (padded % (4096 / sizeof(T)) == 0)
+			padded += elements;
+		return padded;
+	}
+
+	//the single precision factors of gaussEliminationMixed, row i starts at data + i * ld
+	struct SingleFactors
+	{
+		float* data;
+		int ld;
+
+		SingleFactors(int rows, int length)
+		{
+			ld = paddedLength<float>(length);
+			data = allocateAligned<float>((size_t)rows * ld);
+		}
+		~SingleFactors()
+		{
+			freeAligned(data);
+		}
+		float* row(int i) const { return data + (size_t)i * ld; }
+
+	private:
+		SingleFactors(const SingleFactors&);
+		SingleFactors& operator=(const SingleFactors&);
+	};
+}
+
 Matrix::Matrix()
 {
 	n = 0;
+	b_columnIndex = 0;
+	A = 0;
+	rowLength = 0;
+	ld = 0;
+	rowCapacity = 0;
+	refinementIterations = 0;
+	backwardError = 0;
+	refinementFellBack = false;
+	threadCount = 1;
+	pool = 0;
+	taskReport = MatrixTaskReport();
+}
+
+Matrix::Matrix(const Matrix& other)
+{
+	n = 0;
+	A = 0;
+	rowCapacity = 0;
+	threadCount = 1;
+	pool = 0;
+	*this = other;
+}
+
+Matrix& Matrix::operator=(const Matrix& other)
+{
+	if (this != &other)
+	{
+		//the old rows are not kept, the new storage may have a different row length
+		releaseStorage();
+		n = 0;
+		rowLength = other.rowLength;
+		ld = other.ld;
+		reserveRows(other.n);
+		if (other.n > 0)
+			copy(other.A, other.A + (size_t)other.n * ld, A);
+		n = other.n;
+		b_columnIndex = other.b_columnIndex;
+		x1 = other.x1;
+		x2 = other.x2;
+		pivotRows = other.pivotRows;
+		taskReport = other.taskReport;
+		refinementIterations = other.refinementIterations;
+		backwardError = other.backwardError;
+		refinementFellBack = other.refinementFellBack;
+		//the copy starts its own threads when it needs them
+		setThreadCount(other.threadCount);
+	}
+	return *this;
 }
 
 Matrix::~Matrix()
 {
+	releaseStorage();
+	delete pool;
 }
 
-void Matrix::pushRow(vector<double>r)
+void Matrix::setThreadCount(int threads)
+{
+	if (threads < 0)
+		threads = 1;
+	if (threads == threadCount)
+		return;
+	delete pool;
+	pool = 0;
+	threadCount = threads;
+}
+
+int Matrix::getThreadCount()
+{
+	if (threadCount == 1)
+		return 1;
+	return workers()->getThreadCount();
+}
+
+MatrixThreadPool* Matrix::workers()
+{
+	if (threadCount == 1)
+		return 0;
+	if (pool == 0)
+		pool = new MatrixThreadPool(threadCount);
+	return pool;
+}
+
+void Matrix::releaseStorage()
+{
+	if (A != 0)
+		freeAligned(A);
+	A = 0;
+	rowCapacity = 0;
+}
+
+void Matrix::reserveRows(int rows)
+{
+	if (rows <= rowCapacity)
+		return;
+	//grow by doubling so that pushing rows one at a time copies each row a constant number of times
+	int capacity = max(rows, max(2 * rowCapacity, 16));
+	double* grown = allocateAligned<double>((size_t)capacity * ld);
+	if (n > 0)
+		copy(A, A + (size_t)n * ld, grown);
+	if (A != 0)
+		freeAligned(A);
+	A = grown;
+	rowCapacity = capacity;
+}
+
+void Matrix::reserve(int rows, int length)
+{
+	//the first row sets the row length, every row of the matrix has the same storage
+	if (n == 0 && length != rowLength)
+	{
+		releaseStorage();
+		rowLength = length;
+		ld = paddedLength<double>(length);
+	}
+	reserveRows(rows);
+}
+
+double* Matrix::appendRow(int length)
+{
+	reserve(n + 1, length);
+	double* r = row(n);
+	fill(r, r + ld, 0.0);
+	n++;
+	return r;
+}
+
+void Matrix::pushRow(const vector<double>& r)
 {
 	//add whole row to matrix at the end
-	M.push_back(r);
-	n++;	
+	double* dst = appendRow((int)r.size());
+	copy(r.begin(), r.begin() + min((int)r.size(), rowLength), dst);
 }
 
 void Matrix::displayMatrix()
@@ -28,7 +240,7 @@ void Matrix::displayMatrix()
 	{
 		for (int x = 0; x < b_columnIndex; x++)//n+1 because column of intercept is interesting also
 		{
-			cout << "|" <<setprecision(3)<< setw(8) << M[y][x];
+			cout << "|" <<setprecision(3)<< setw(8) << row(y)[x];
 		}cout << endl << endl;
 	}
 }
@@ -39,89 +251,475 @@ void Matrix::displayResults()
 	cout << "x(1,0,0) = Gaussian Elimination\t\t" << setprecision(36)  << x2[0] << endl;
 }
 
+void Matrix::displayRefinement()
+{
+	cout << "Refinement iterations = " << refinementIterations << endl;
+	cout << "Backward error = " << setprecision(3) << backwardError << endl;
+	if (refinementFellBack)
+		cout << "Refinement stalled, solved in double precision" << endl;
+}
+
+int Matrix::getRefinementIterations()
+{
+	return refinementIterations;
+}
+
+double Matrix::getBackwardError()
+{
+	return backwardError;
+}
+
+const vector<double>& Matrix::getGaussSeidelResults()
+{
+	return x1;
+}
+
+const vector<double>& Matrix::getGaussEliminationResults()
+{
+	return x2;
+}
+
+const vector<int>& Matrix::getPivotRows()
+{
+	return pivotRows;
+}
+
 vector<vector<double>> Matrix::getMatrix()
 {
-	return M;
+	vector<vector<double>> copyofM(n);
+	for (int i = 0; i < n; i++)
+		copyofM[i].assign(row(i), row(i) + rowLength);
+	return copyofM;
 }
 
-void Matrix::loadMatrix(vector<vector<double>> copyofM)
+void Matrix::loadMatrix(const vector<vector<double>>& copyofM)
 {
-	M = copyofM;
+	n = 0;
+	if (!copyofM.empty())
+		reserve((int)copyofM.size(), (int)copyofM[0].size());
+	for (size_t i = 0; i < copyofM.size(); i++)
+		pushRow(copyofM[i]);
 }
 
 void Matrix::gaussSeidel()
 {
 	b_columnIndex = n;
+	MatrixThreadPool* threads = workers();
 
-	for (int k = 0; k < n - 1; k++)
+	int k = 0;
+	//rows first to last - 1 of step k
+	auto eliminate = [&](int first, int last)
 	{
-		for (int i = k + 1; i < n; i++)
+		const double* rowK = row(k);
+		for (int i = first; i < last; i++)
 		{
-			double m = M[i][k] / M[k][k];
-			for (int j = k + 1; j < n; j++)
-				M[i][j] -= m * M[k][j];
-			M[i][b_columnIndex] -= m * M[k][b_columnIndex];
+			double* rowI = row(i);
+			double m = rowI[k] / rowK[k];
+			//the coefficients right of k and b
+			MatrixKernels::axpy(rowI + k + 1, rowK + k + 1, -m, b_columnIndex - k);
 		}
+	};
+	//the rows of a step are split between the threads, which keep running between steps
+	function<void(int)> step = [&](int thread)
+	{
+		int begin, end;
+		threads->splitRange(k + 1, n, thread, begin, end);
+		eliminate(begin, end);
+	};
+
+	for (k = 0; k < n - 1; k++)
+	{
+		if (threads != 0 && (long long)(n - k - 1) * (n - k) >= parallelStepElements)
+			threads->run(step);
+		else
+			eliminate(k + 1, n);
 	}
 	//reserve memory for results
 	x1.assign(n, 0);
-	x1[n - 1] = M[n - 1][b_columnIndex] / M[n - 1][b_columnIndex - 1];
+	x1[n - 1] = row(n - 1)[b_columnIndex] / row(n - 1)[b_columnIndex - 1];
 
 	for (int i = n - 2; i >= 0; i--)
 	{
-		x1[i] = M[i][b_columnIndex];//i albo l
-		for (int j = i + 1; j < n; j++)
-		{
-			x1[i] -= M[i][j] * x1[j];
-		}
-		x1[i] /= M[i][i];
+		const double* rowI = row(i);
+		x1[i] = rowI[b_columnIndex];//i albo l
+		x1[i] -= MatrixKernels::dot(rowI + i + 1, x1.data() + i + 1, n - i - 1);
+		x1[i] /= rowI[i];
 	}
 }
 
 void Matrix::gaussElimination()
 {
 	b_columnIndex = n;
+	pivotRows.assign(n, n - 1);
+	MatrixThreadPool* threads = workers();
+	vector<PivotCandidate> candidates(threads != 0 ? threads->getThreadCount() : 0);
+	bool searched = false;
+
+	int i = 0;
+	//make rows first to last - 1 0 in column i, and find the largest element of column i + 1 in them
+	auto eliminate = [&](int first, int last, PivotCandidate& candidate)
+	{
+		const double* rowI = row(i);
+		candidate.value = -1;
+		candidate.row = i + 1;
+		for (int k = first; k < last; k++) {
+			double* rowK = row(k);
+			double c = -rowK[i] / rowI[i];
+			rowK[i] = 0;
+			MatrixKernels::axpy(rowK + i + 1, rowI + i + 1, c, b_columnIndex - i);
+			if (abs(rowK[i + 1]) > candidate.value)
+			{
+				candidate.value = abs(rowK[i + 1]);
+				candidate.row = k;
+			}
+		}
+	};
+	//the rows of a step are split between the threads, which keep running between steps
+	function<void(int)> step = [&](int thread)
+	{
+		int begin, end;
+		threads->splitRange(i + 1, n, thread, begin, end);
+		eliminate(begin, end, candidates[thread]);
+	};
 
-	for (int i = 0; i < n - 1; i++)
+	for (i = 0; i < n - 1; i++)
 	{
-		//find max in 'i' column
-		double maxElement = abs(M[i][i]);
+		//find max in 'i' column, after a step on the threads from the largest element each thread found
 		int rowWithMax = i;
-		for (int k = i + 1; k < n; k++)
+		if (searched)
 		{
-			if (abs(M[k][i]) > maxElement)
+			double maxElement = abs(row(i)[i]);
+			for (size_t t = 0; t < candidates.size(); t++)
 			{
-				maxElement = abs(M[k][i]);
-				rowWithMax = k;
+				if (candidates[t].value > maxElement)
+				{
+					maxElement = candidates[t].value;
+					rowWithMax = candidates[t].row;
+				}
 			}
 		}
+		else
+			rowWithMax = i + MatrixKernels::maxAbsIndex(row(i) + i, ld, n - i);
+		pivotRows[i] = rowWithMax;
 
-		//swap maximum row with current row (column by column)
-		for (int k = i; k <= b_columnIndex; k++) {
-			double tmp = M[rowWithMax][k];
-			M[rowWithMax][k] = M[i][k];
-			M[i][k] = tmp;
-		}
+		//swap maximum row with current row
+		double* rowI = row(i);
+		if (rowWithMax != i)
+			MatrixKernels::swapRows(rowI + i, row(rowWithMax) + i, b_columnIndex - i + 1);
 
 		//make all rows below this one 0 in current column
-		for (int k = i + 1; k < n; k++) {
-			double c = -M[k][i] / M[i][i];
-			for (int j = i; j < n + 1; j++) {
-				if (i == j) {
-					M[k][j] = 0;
-				}
-				else {
-					M[k][j] += c * M[i][j];
-				}
-			}
+		searched = threads != 0 && (long long)(n - i - 1) * (n - i) >= parallelStepElements;
+		if (searched)
+			threads->run(step);
+		else
+		{
+			PivotCandidate unused;
+			eliminate(i + 1, n, unused);
 		}
 	}
 	// Solve equation Ax=b for an upper triangular matrix A
+	backSubstitution();
+}
+
+void Matrix::gaussEliminationBlocked(int panelWidth)
+{
+	b_columnIndex = n;
+	pivotRows.assign(n, 0);
+	if (panelWidth <= 0)
+		panelWidth = defaultPanelWidth;
+	int columns = n + 1;
+
+	for (int k0 = 0; k0 < n; k0 += panelWidth)
+	{
+		int kEnd = min(k0 + panelWidth, n);
+
+		//whole rows are swapped, so the multipliers to the left and the trailing columns follow the pivot
+		factorPanel(k0, kEnd, 0, columns, kEnd);
+
+		//update the columns right of the panel, including b, one column tile at a time
+		int tileColumns = trailingTileBytes / (int)(sizeof(double) * (kEnd - k0));
+		tileColumns = max(lineElements, tileColumns / lineElements * lineElements);
+		for (int j0 = kEnd; j0 < columns; j0 += tileColumns)
+		{
+			int j1 = min(j0 + tileColumns, columns);
+			solveRowsOfU(k0, kEnd, j0, j1);
+			updateRows(kEnd, n, k0, kEnd, j0, j1);
+		}
+	}
+
+	backSubstitution();
+}
+
+void Matrix::gaussEliminationTiled(int tileSize)
+{
+	b_columnIndex = n;
+	pivotRows.assign(n, 0);
+	if (tileSize <= 0)
+		tileSize = defaultTileSize;
+	int columns = n + 1;
+	//b is in the last column of tiles, with the last columns of the matrix when they do not fill a tile
+	int tileRows = (n + tileSize - 1) / tileSize;
+	int tileColumns = (columns + tileSize - 1) / tileSize;
+
+	//the graph of a right-looking LU by tiles, a task starts as soon as the tiles it reads and writes are ready, so the panel of the next
+	//step is factored while the updates of the current step are still running on the columns further right
+	MatrixTaskGraph graph;
+	//last update of each tile in the steps added so far
+	vector<int> lastUpdate((size_t)tileRows * tileColumns, -1);
+	for (int k = 0; k < tileRows; k++)
+	{
+		int k0 = k * tileSize;
+		int kEnd = min(k0 + tileSize, n);
+		int c1 = min(k0 + tileSize, columns);
+		double width = kEnd - k0;
+
+		//the row exchanges of a panel are applied to each column of tiles by its solve task, the multipliers of earlier panels are not exchanged
+		int panel = graph.addTask(tiledPanel, (n - k0) * width * width, [=]() { factorPanel(k0, kEnd, k0, c1, c1); });
+		for (int i = k; i < tileRows; i++)
+			if (lastUpdate[(size_t)i * tileColumns + k] >= 0)
+				graph.addDependency(lastUpdate[(size_t)i * tileColumns + k], panel);
+
+		for (int j = k + 1; j < tileColumns; j++)
+		{
+			int j0 = j * tileSize;
+			int j1 = min(j0 + tileSize, columns);
+			int solve = graph.addTask(tiledSolve, width * width * (j1 - j0), [=]()
+			{
+				exchangeRows(k0, kEnd, j0, j1);
+				solveRowsOfU(k0, kEnd, j0, j1);
+			});
+			graph.addDependency(panel, solve);
+			for (int i = k; i < tileRows; i++)
+				if (lastUpdate[(size_t)i * tileColumns + j] >= 0)
+					graph.addDependency(lastUpdate[(size_t)i * tileColumns + j], solve);
+
+			for (int i = k + 1; i < tileRows; i++)
+			{
+				int r0 = i * tileSize;
+				int r1 = min(r0 + tileSize, n);
+				int update = graph.addTask(tiledUpdate, 2 * (r1 - r0) * width * (j1 - j0), [=]() { updateRows(r0, r1, k0, kEnd, j0, j1); });
+				graph.addDependency(solve, update);
+				lastUpdate[(size_t)i * tileColumns + j] = update;
+			}
+		}
+	}
+
+	graph.run(workers(), taskReport);
+	backSubstitution();
+}
+
+const MatrixTaskReport& Matrix::getTaskReport()
+{
+	return taskReport;
+}
+
+void Matrix::factorPanel(int k0, int kEnd, int swapBegin, int swapEnd, int updateEnd)
+{
+	//multipliers are stored below the diagonal and only the columns before updateEnd are updated
+	for (int i = k0; i < kEnd; i++)
+	{
+		//find max in 'i' column, the same search as gaussElimination
+		int rowWithMax = i + MatrixKernels::maxAbsIndex(row(i) + i, ld, n - i);
+		pivotRows[i] = rowWithMax;
+
+		if (rowWithMax != i)
+			MatrixKernels::swapRows(row(i) + swapBegin, row(rowWithMax) + swapBegin, swapEnd - swapBegin);
+
+		const double* rowI = row(i);
+		for (int k = i + 1; k < n; k++)
+		{
+			double* rowK = row(k);
+			double c = rowK[i] / rowI[i];
+			rowK[i] = c;
+			MatrixKernels::axpy(rowK + i + 1, rowI + i + 1, -c, updateEnd - i - 1);
+		}
+	}
+}
+
+void Matrix::exchangeRows(int k0, int kEnd, int j0, int j1)
+{
+	for (int i = k0; i < kEnd; i++)
+		if (pivotRows[i] != i)
+			MatrixKernels::swapRows(row(i) + j0, row(pivotRows[i]) + j0, j1 - j0);
+}
+
+void Matrix::solveRowsOfU(int k0, int kEnd, int j0, int j1)
+{
+	//rows of U: solve with the unit lower triangle of the panel
+	for (int i = k0 + 1; i < kEnd; i++)
+	{
+		double* rowI = row(i);
+		for (int p = k0; p < i; p++)
+			MatrixKernels::axpy(rowI + j0, row(p) + j0, -rowI[p], j1 - j0);
+	}
+}
+
+void Matrix::updateRows(int r0, int r1, int k0, int kEnd, int j0, int j1)
+{
+	//subtract the multipliers times the rows of U, four rows of U at a time so each element is loaded and stored once per four
+	for (int k = r0; k < r1; k++)
+	{
+		double* rowK = row(k);
+		int p = k0;
+		for (; p + 3 < kEnd; p += 4)
+		{
+			const double c[4] = { -rowK[p], -rowK[p + 1], -rowK[p + 2], -rowK[p + 3] };
+			const double* u[4] = { row(p) + j0, row(p + 1) + j0, row(p + 2) + j0, row(p + 3) + j0 };
+			MatrixKernels::axpy4(rowK + j0, u, c, j1 - j0);
+		}
+		for (; p < kEnd; p++)
+			MatrixKernels::axpy(rowK + j0, row(p) + j0, -rowK[p], j1 - j0);
+	}
+}
+
+void Matrix::backSubstitution()
+{
+	// Solve equation Ux=y, y is the last column after the elimination
 	x2.assign(n, 0);
-	for (int i = n - 1; i >= 0; i--) {
-		x2[i] = M[i][n] / M[i][i];
-		for (int k = i - 1; k >= 0; k--) {
-			M[k][n] -= M[k][i] * x2[i];
+	for (int i = n - 1; i >= 0; i--)
+	{
+		const double* rowI = row(i);
+		x2[i] = (rowI[n] - MatrixKernels::dot(rowI + i + 1, x2.data() + i + 1, n - i - 1)) / rowI[i];
+	}
+}
+
+void Matrix::gaussEliminationMixed()
+{
+	b_columnIndex = n;
+	refinementIterations = 0;
+	refinementFellBack = false;
+
+	//factor a single precision copy of A in one aligned buffer with padded rows, multipliers are stored below the diagonal
+	SingleFactors F(n, n);
+	vector<int> perm(n);
+	for (int i = 0; i < n; i++)
+	{
+		perm[i] = i;
+		const double* rowI = row(i);
+		float* rowF = F.row(i);
+		for (int j = 0; j < n; j++)
+			rowF[j] = (float)rowI[j];
+	}
+
+	bool factored = true;
+	for (int i = 0; i < n && factored; i++)
+	{
+		int rowWithMax = i + MatrixKernels::maxAbsIndex(F.row(i) + i, F.ld, n - i);
+		float pivot = F.row(rowWithMax)[i];
+		if (!(abs(pivot) > 0) || !isfinite(pivot))
+		{
+			factored = false;
+			break;
+		}
+		if (rowWithMax != i)
+			swap_ranges(F.row(i), F.row(i) + n, F.row(rowWithMax));
+		swap(perm[rowWithMax], perm[i]);
+
+		const float* pivotRow = F.row(i);
+		for (int k = i + 1; k < n; k++)
+		{
+			float* rowK = F.row(k);
+			float c = rowK[i] / pivotRow[i];
+			rowK[i] = c;
+			//twice as many lanes per vector as double
+			MatrixKernels::axpy(rowK + i + 1, pivotRow + i + 1, -c, n - i - 1);
+		}
+	}
+
+	//refine with residuals in double until the backward error is at the double precision level
+	const int maxIterations = 30;
+	double tolerance = sqrt((double)n) * numeric_limits<double>::epsilon();
+	vector<double> b(n), x, r, d;
+	bool stalled = !factored;
+	if (factored)
+	{
+		for (int i = 0; i < n; i++)
+			b[i] = row(i)[b_columnIndex];
+		solveSingle(F.data, F.ld, perm, b, x);
+		backwardError = computeResiduals(x, r);
+
+		//written so that a NaN backward error also counts as not converged
+		while (!(backwardError <= tolerance))
+		{
+			if (refinementIterations == maxIterations)
+			{
+				stalled = true;
+				break;
+			}
+			solveSingle(F.data, F.ld, perm, r, d);
+			for (int i = 0; i < n; i++)
+				x[i] += d[i];
+			refinementIterations++;
+
+			double previousError = backwardError;
+			backwardError = computeResiduals(x, r);
+			if (!(backwardError <= 0.5 * previousError))
+			{
+				stalled = true;
+				break;
+			}
+		}
+	}
+
+	if (stalled)
+	{
+		//fall back to the double precision elimination, which overwrites M, so keep a copy for the residual
+		refinementFellBack = true;
+		vector<double> original(A, A + (size_t)n * ld);
+		gaussElimination();
+		copy(original.begin(), original.end(), A);
+		backwardError = computeResiduals(x2, r);
+	}
+	else
+	{
+		x2 = x;
+	}
+}
+
+void Matrix::solveSingle(const float* F, int ldF, const vector<int>& perm, const vector<double>& b, vector<double>& x)
+{
+	//forward substitution with the unit lower triangle, then back substitution
+	vector<float> y(n);
+	for (int i = 0; i < n; i++)
+	{
+		const float* rowF = F + (size_t)i * ldF;
+		float sum = (float)b[perm[i]];
+		for (int j = 0; j < i; j++)
+			sum -= rowF[j] * y[j];
+		y[i] = sum;
+	}
+	for (int i = n - 1; i >= 0; i--)
+	{
+		const float* rowF = F + (size_t)i * ldF;
+		float sum = y[i];
+		for (int j = i + 1; j < n; j++)
+			sum -= rowF[j] * y[j];
+		y[i] = sum / rowF[i];
+	}
+	x.assign(y.begin(), y.end());
+}
+
+double Matrix::computeResiduals(const vector<double>& x, vector<double>& r)
+{
+	//r = b - Ax in double, returns the normwise backward error |r| / (|A| |x| + |b|)
+	double normA = 0, normX = 0, normB = 0, normR = 0;
+	r.assign(n, 0);
+	for (int i = 0; i < n; i++)
+	{
+		const double* rowI = row(i);
+		double sum = rowI[b_columnIndex];
+		double rowSum = 0;
+		for (int j = 0; j < n; j++)
+		{
+			sum -= rowI[j] * x[j];
+			rowSum += abs(rowI[j]);
 		}
+		r[i] = sum;
+		normA = max(normA, rowSum);
+		normB = max(normB, abs(rowI[b_columnIndex]));
+		normR = max(normR, abs(sum));
+		normX = max(normX, abs(x[i]));
 	}
+	double denominator = normA * normX + normB;
+	return denominator > 0 ? normR / denominator : normR;
 }